@@ -3,22 +3,23 @@
 layout(binding = 0) uniform CameraUBO {
     mat4 view;
     mat4 proj;
+    // Corner of the camera's chunk, which view is relative to
+    ivec4 renderOrigin;
 } cam;
 
-layout(push_constant) uniform PushModel {
-    // per-draw (chunks), identity for models
-    mat4 model;
-} pc;
-
 layout(location=0) in vec3 inPosition;
 layout(location=1) in vec3 inColor;
 layout(location=2) in vec2 inTexCoord;
+// Per instance (instance rate). A mat4 takes locations 3 to 6
+layout(location=3) in mat4 inModel;
 
 layout(location=0) out vec3 fragColor;
 layout(location=1) out vec2 fragTexCoord;
 
 void main() {
-    gl_Position = cam.proj * cam.view * pc.model * vec4(inPosition, 1.0);
+    // Models are placed with float matrices, so they only get as precise as those are
+    vec4 world = inModel * vec4(inPosition, 1.0);
+    gl_Position = cam.proj * cam.view * vec4(world.xyz - vec3(cam.renderOrigin.xyz), 1.0);
     fragColor = inColor;
     fragTexCoord = inTexCoord;
 }
\ No newline at end of file
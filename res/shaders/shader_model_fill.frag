@@ -2,7 +2,12 @@
 // https://vulkan-tutorial.com/Vertex_buffers/Vertex_input_description
 // It is important to know that some types, like dvec3 64 bit vectors, use multiple slots.
 // That means that the index after it must be at least 2 higher.
-layout(binding = 1) uniform sampler2D texSampler;
+// Every model's texture. Size is DESCRIPTOR_POOL_MODEL_TEXTURE_MAX
+layout(binding = 1) uniform sampler2D texSamplers[16];
+
+layout(push_constant) uniform ModelPushConstants {
+    uint textureIndex;
+} pc;
 
 layout(location = 0) in vec3 fragColor;
 layout(location = 1) in vec2 fragTexCoord;
@@ -10,5 +15,5 @@ layout(location = 1) in vec2 fragTexCoord;
 layout(location = 0) out vec4 outColor;
 
 void main() {
-    outColor = texture(texSampler, fragTexCoord);
+    outColor = texture(texSamplers[pc.textureIndex], fragTexCoord);
 }
\ No newline at end of file
@@ -3,24 +3,29 @@
 layout(binding = 0) uniform CameraUBO {
     mat4 view;
     mat4 proj;
+    // Corner of the camera's chunk, which view is relative to
+    ivec4 renderOrigin;
 } cam;
 
-layout(push_constant) uniform PushModel {
-    mat4 model;
-} pc;
-
 layout(location=0) in vec3 inPosition;
 layout(location=1) in vec3 inColor;
 layout(location=2) in vec2 inTexCoord;
-layout(location=3) in int inFaceID;
+layout(location=3) in uint inTextureLayer;
+layout(location=4) in int inFaceID;
+// Per chunk (instance rate)
+layout(location=5) in ivec3 inChunkOrigin;
 
 layout(location=0) out vec3 fragColor;
 layout(location=1) out vec2 fragTexCoord;
 layout(location=2) flat out int faceID;
+layout(location=3) flat out uint fragTextureLayer;
 
 void main() {
-    gl_Position = cam.proj * cam.view * pc.model * vec4(inPosition, 1.0);
+    // Subtracted as integers so only the small camera relative offset ever becomes a float
+    vec3 relativeOrigin = vec3(inChunkOrigin - cam.renderOrigin.xyz);
+    gl_Position = cam.proj * cam.view * vec4(inPosition + relativeOrigin, 1.0);
     fragColor = inColor;
     fragTexCoord = inTexCoord;
     faceID = inFaceID;
+    fragTextureLayer = inTextureLayer;
 }
\ No newline at end of file
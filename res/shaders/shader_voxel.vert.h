@@ -4,136 +4,160 @@
 #include <stdint.h>
 
 static const uint32_t shaderVoxelVertCode[] = {
-0x07230203,0x00010000,0x000d000b,0x0000003d,
+0x07230203,0x00010000,0x000d000b,0x0000004b,
 0x00000000,0x00020011,0x00000001,0x0006000b,
 0x00000001,0x4c534c47,0x6474732e,0x3035342e,
 0x00000000,0x0003000e,0x00000000,0x00000001,
-0x000d000f,0x00000000,0x00000004,0x6e69616d,
-0x00000000,0x0000000d,0x00000024,0x0000002f,
-0x00000030,0x00000034,0x00000036,0x00000039,
-0x0000003b,0x00030003,0x00000002,0x000001cc,
-0x000a0004,0x475f4c47,0x4c474f4f,0x70635f45,
-0x74735f70,0x5f656c79,0x656e696c,0x7269645f,
-0x69746365,0x00006576,0x00080004,0x475f4c47,
-0x4c474f4f,0x6e695f45,0x64756c63,0x69645f65,
-0x74636572,0x00657669,0x00040005,0x00000004,
-0x6e69616d,0x00000000,0x00060005,0x0000000b,
+0x0010000f,0x00000000,0x00000004,0x6e69616d,
+0x00000000,0x0000000d,0x00000021,0x0000002b,
+0x00000038,0x00000039,0x0000003d,0x0000003f,
+0x00000042,0x00000044,0x00000047,0x00000049,
+0x00030003,0x00000002,0x000001cc,0x000a0004,
+0x475f4c47,0x4c474f4f,0x70635f45,0x74735f70,
+0x5f656c79,0x656e696c,0x7269645f,0x69746365,
+0x00006576,0x00080004,0x475f4c47,0x4c474f4f,
+0x6e695f45,0x64756c63,0x69645f65,0x74636572,
+0x00657669,0x00040005,0x00000004,0x6e69616d,
+0x00000000,0x00060005,0x00000009,0x616c6572,
+0x65766974,0x6769724f,0x00006e69,0x00060005,
+0x0000000d,0x68436e69,0x4f6b6e75,0x69676972,
+0x0000006e,0x00050005,0x00000012,0x656d6143,
+0x42556172,0x0000004f,0x00050006,0x00000012,
+0x00000000,0x77656976,0x00000000,0x00050006,
+0x00000012,0x00000001,0x6a6f7270,0x00000000,
+0x00070006,0x00000012,0x00000002,0x646e6572,
+0x724f7265,0x6e696769,0x00000000,0x00030005,
+0x00000014,0x006d6163,0x00060005,0x0000001f,
 0x505f6c67,0x65567265,0x78657472,0x00000000,
-0x00060006,0x0000000b,0x00000000,0x505f6c67,
-0x7469736f,0x006e6f69,0x00070006,0x0000000b,
+0x00060006,0x0000001f,0x00000000,0x505f6c67,
+0x7469736f,0x006e6f69,0x00070006,0x0000001f,
 0x00000001,0x505f6c67,0x746e696f,0x657a6953,
-0x00000000,0x00070006,0x0000000b,0x00000002,
+0x00000000,0x00070006,0x0000001f,0x00000002,
 0x435f6c67,0x4470696c,0x61747369,0x0065636e,
-0x00070006,0x0000000b,0x00000003,0x435f6c67,
+0x00070006,0x0000001f,0x00000003,0x435f6c67,
 0x446c6c75,0x61747369,0x0065636e,0x00030005,
-0x0000000d,0x00000000,0x00050005,0x00000011,
-0x656d6143,0x42556172,0x0000004f,0x00050006,
-0x00000011,0x00000000,0x77656976,0x00000000,
-0x00050006,0x00000011,0x00000001,0x6a6f7270,
-0x00000000,0x00030005,0x00000013,0x006d6163,
-0x00050005,0x0000001b,0x68737550,0x65646f4d,
-0x0000006c,0x00050006,0x0000001b,0x00000000,
-0x65646f6d,0x0000006c,0x00030005,0x0000001d,
-0x00006370,0x00050005,0x00000024,0x6f506e69,
-0x69746973,0x00006e6f,0x00050005,0x0000002f,
-0x67617266,0x6f6c6f43,0x00000072,0x00040005,
-0x00000030,0x6f436e69,0x00726f6c,0x00060005,
-0x00000034,0x67617266,0x43786554,0x64726f6f,
-0x00000000,0x00050005,0x00000036,0x65546e69,
-0x6f6f4378,0x00006472,0x00040005,0x00000039,
-0x65636166,0x00004449,0x00050005,0x0000003b,
-0x61466e69,0x44496563,0x00000000,0x00030047,
-0x0000000b,0x00000002,0x00050048,0x0000000b,
-0x00000000,0x0000000b,0x00000000,0x00050048,
-0x0000000b,0x00000001,0x0000000b,0x00000001,
-0x00050048,0x0000000b,0x00000002,0x0000000b,
-0x00000003,0x00050048,0x0000000b,0x00000003,
-0x0000000b,0x00000004,0x00030047,0x00000011,
-0x00000002,0x00040048,0x00000011,0x00000000,
-0x00000005,0x00050048,0x00000011,0x00000000,
-0x00000007,0x00000010,0x00050048,0x00000011,
-0x00000000,0x00000023,0x00000000,0x00040048,
-0x00000011,0x00000001,0x00000005,0x00050048,
-0x00000011,0x00000001,0x00000007,0x00000010,
-0x00050048,0x00000011,0x00000001,0x00000023,
-0x00000040,0x00040047,0x00000013,0x00000021,
-0x00000000,0x00040047,0x00000013,0x00000022,
-0x00000000,0x00030047,0x0000001b,0x00000002,
-0x00040048,0x0000001b,0x00000000,0x00000005,
-0x00050048,0x0000001b,0x00000000,0x00000007,
-0x00000010,0x00050048,0x0000001b,0x00000000,
-0x00000023,0x00000000,0x00040047,0x00000024,
-0x0000001e,0x00000000,0x00040047,0x0000002f,
-0x0000001e,0x00000000,0x00040047,0x00000030,
-0x0000001e,0x00000001,0x00040047,0x00000034,
-0x0000001e,0x00000001,0x00040047,0x00000036,
-0x0000001e,0x00000002,0x00030047,0x00000039,
-0x0000000e,0x00040047,0x00000039,0x0000001e,
-0x00000002,0x00040047,0x0000003b,0x0000001e,
-0x00000003,0x00020013,0x00000002,0x00030021,
-0x00000003,0x00000002,0x00030016,0x00000006,
-0x00000020,0x00040017,0x00000007,0x00000006,
-0x00000004,0x00040015,0x00000008,0x00000020,
-0x00000000,0x0004002b,0x00000008,0x00000009,
-0x00000001,0x0004001c,0x0000000a,0x00000006,
-0x00000009,0x0006001e,0x0000000b,0x00000007,
-0x00000006,0x0000000a,0x0000000a,0x00040020,
-0x0000000c,0x00000003,0x0000000b,0x0004003b,
-0x0000000c,0x0000000d,0x00000003,0x00040015,
-0x0000000e,0x00000020,0x00000001,0x0004002b,
-0x0000000e,0x0000000f,0x00000000,0x00040018,
-0x00000010,0x00000007,0x00000004,0x0004001e,
-0x00000011,0x00000010,0x00000010,0x00040020,
-0x00000012,0x00000002,0x00000011,0x0004003b,
-0x00000012,0x00000013,0x00000002,0x0004002b,
-0x0000000e,0x00000014,0x00000001,0x00040020,
-0x00000015,0x00000002,0x00000010,0x0003001e,
-0x0000001b,0x00000010,0x00040020,0x0000001c,
-0x00000009,0x0000001b,0x0004003b,0x0000001c,
-0x0000001d,0x00000009,0x00040020,0x0000001e,
-0x00000009,0x00000010,0x00040017,0x00000022,
-0x00000006,0x00000003,0x00040020,0x00000023,
-0x00000001,0x00000022,0x0004003b,0x00000023,
-0x00000024,0x00000001,0x0004002b,0x00000006,
-0x00000026,0x3f800000,0x00040020,0x0000002c,
-0x00000003,0x00000007,0x00040020,0x0000002e,
-0x00000003,0x00000022,0x0004003b,0x0000002e,
-0x0000002f,0x00000003,0x0004003b,0x00000023,
-0x00000030,0x00000001,0x00040017,0x00000032,
-0x00000006,0x00000002,0x00040020,0x00000033,
-0x00000003,0x00000032,0x0004003b,0x00000033,
-0x00000034,0x00000003,0x00040020,0x00000035,
-0x00000001,0x00000032,0x0004003b,0x00000035,
-0x00000036,0x00000001,0x00040020,0x00000038,
-0x00000003,0x0000000e,0x0004003b,0x00000038,
-0x00000039,0x00000003,0x00040020,0x0000003a,
-0x00000001,0x0000000e,0x0004003b,0x0000003a,
-0x0000003b,0x00000001,0x00050036,0x00000002,
-0x00000004,0x00000000,0x00000003,0x000200f8,
-0x00000005,0x00050041,0x00000015,0x00000016,
-0x00000013,0x00000014,0x0004003d,0x00000010,
-0x00000017,0x00000016,0x00050041,0x00000015,
-0x00000018,0x00000013,0x0000000f,0x0004003d,
-0x00000010,0x00000019,0x00000018,0x00050092,
-0x00000010,0x0000001a,0x00000017,0x00000019,
-0x00050041,0x0000001e,0x0000001f,0x0000001d,
-0x0000000f,0x0004003d,0x00000010,0x00000020,
-0x0000001f,0x00050092,0x00000010,0x00000021,
-0x0000001a,0x00000020,0x0004003d,0x00000022,
-0x00000025,0x00000024,0x00050051,0x00000006,
-0x00000027,0x00000025,0x00000000,0x00050051,
-0x00000006,0x00000028,0x00000025,0x00000001,
-0x00050051,0x00000006,0x00000029,0x00000025,
-0x00000002,0x00070050,0x00000007,0x0000002a,
-0x00000027,0x00000028,0x00000029,0x00000026,
-0x00050091,0x00000007,0x0000002b,0x00000021,
-0x0000002a,0x00050041,0x0000002c,0x0000002d,
-0x0000000d,0x0000000f,0x0003003e,0x0000002d,
-0x0000002b,0x0004003d,0x00000022,0x00000031,
-0x00000030,0x0003003e,0x0000002f,0x00000031,
-0x0004003d,0x00000032,0x00000037,0x00000036,
-0x0003003e,0x00000034,0x00000037,0x0004003d,
-0x0000000e,0x0000003c,0x0000003b,0x0003003e,
-0x00000039,0x0000003c,0x000100fd,0x00010038
+0x00000021,0x00000000,0x00050005,0x0000002b,
+0x6f506e69,0x69746973,0x00006e6f,0x00050005,
+0x00000038,0x67617266,0x6f6c6f43,0x00000072,
+0x00040005,0x00000039,0x6f436e69,0x00726f6c,
+0x00060005,0x0000003d,0x67617266,0x43786554,
+0x64726f6f,0x00000000,0x00050005,0x0000003f,
+0x65546e69,0x6f6f4378,0x00006472,0x00040005,
+0x00000042,0x65636166,0x00004449,0x00050005,
+0x00000044,0x61466e69,0x44496563,0x00000000,
+0x00070005,0x00000047,0x67617266,0x74786554,
+0x4c657275,0x72657961,0x00000000,0x00060005,
+0x00000049,0x65546e69,0x72757478,0x79614c65,
+0x00007265,0x00040047,0x0000000d,0x0000001e,
+0x00000005,0x00030047,0x00000012,0x00000002,
+0x00040048,0x00000012,0x00000000,0x00000005,
+0x00050048,0x00000012,0x00000000,0x00000007,
+0x00000010,0x00050048,0x00000012,0x00000000,
+0x00000023,0x00000000,0x00040048,0x00000012,
+0x00000001,0x00000005,0x00050048,0x00000012,
+0x00000001,0x00000007,0x00000010,0x00050048,
+0x00000012,0x00000001,0x00000023,0x00000040,
+0x00050048,0x00000012,0x00000002,0x00000023,
+0x00000080,0x00040047,0x00000014,0x00000021,
+0x00000000,0x00040047,0x00000014,0x00000022,
+0x00000000,0x00030047,0x0000001f,0x00000002,
+0x00050048,0x0000001f,0x00000000,0x0000000b,
+0x00000000,0x00050048,0x0000001f,0x00000001,
+0x0000000b,0x00000001,0x00050048,0x0000001f,
+0x00000002,0x0000000b,0x00000003,0x00050048,
+0x0000001f,0x00000003,0x0000000b,0x00000004,
+0x00040047,0x0000002b,0x0000001e,0x00000000,
+0x00040047,0x00000038,0x0000001e,0x00000000,
+0x00040047,0x00000039,0x0000001e,0x00000001,
+0x00040047,0x0000003d,0x0000001e,0x00000001,
+0x00040047,0x0000003f,0x0000001e,0x00000002,
+0x00030047,0x00000042,0x0000000e,0x00040047,
+0x00000042,0x0000001e,0x00000002,0x00040047,
+0x00000044,0x0000001e,0x00000004,0x00030047,
+0x00000047,0x0000000e,0x00040047,0x00000047,
+0x0000001e,0x00000003,0x00040047,0x00000049,
+0x0000001e,0x00000003,0x00020013,0x00000002,
+0x00030021,0x00000003,0x00000002,0x00030016,
+0x00000006,0x00000020,0x00040017,0x00000007,
+0x00000006,0x00000003,0x00040020,0x00000008,
+0x00000007,0x00000007,0x00040015,0x0000000a,
+0x00000020,0x00000001,0x00040017,0x0000000b,
+0x0000000a,0x00000003,0x00040020,0x0000000c,
+0x00000001,0x0000000b,0x0004003b,0x0000000c,
+0x0000000d,0x00000001,0x00040017,0x0000000f,
+0x00000006,0x00000004,0x00040018,0x00000010,
+0x0000000f,0x00000004,0x00040017,0x00000011,
+0x0000000a,0x00000004,0x0005001e,0x00000012,
+0x00000010,0x00000010,0x00000011,0x00040020,
+0x00000013,0x00000002,0x00000012,0x0004003b,
+0x00000013,0x00000014,0x00000002,0x0004002b,
+0x0000000a,0x00000015,0x00000002,0x00040020,
+0x00000016,0x00000002,0x00000011,0x00040015,
+0x0000001c,0x00000020,0x00000000,0x0004002b,
+0x0000001c,0x0000001d,0x00000001,0x0004001c,
+0x0000001e,0x00000006,0x0000001d,0x0006001e,
+0x0000001f,0x0000000f,0x00000006,0x0000001e,
+0x0000001e,0x00040020,0x00000020,0x00000003,
+0x0000001f,0x0004003b,0x00000020,0x00000021,
+0x00000003,0x0004002b,0x0000000a,0x00000022,
+0x00000000,0x0004002b,0x0000000a,0x00000023,
+0x00000001,0x00040020,0x00000024,0x00000002,
+0x00000010,0x00040020,0x0000002a,0x00000001,
+0x00000007,0x0004003b,0x0000002a,0x0000002b,
+0x00000001,0x0004002b,0x00000006,0x0000002f,
+0x3f800000,0x00040020,0x00000035,0x00000003,
+0x0000000f,0x00040020,0x00000037,0x00000003,
+0x00000007,0x0004003b,0x00000037,0x00000038,
+0x00000003,0x0004003b,0x0000002a,0x00000039,
+0x00000001,0x00040017,0x0000003b,0x00000006,
+0x00000002,0x00040020,0x0000003c,0x00000003,
+0x0000003b,0x0004003b,0x0000003c,0x0000003d,
+0x00000003,0x00040020,0x0000003e,0x00000001,
+0x0000003b,0x0004003b,0x0000003e,0x0000003f,
+0x00000001,0x00040020,0x00000041,0x00000003,
+0x0000000a,0x0004003b,0x00000041,0x00000042,
+0x00000003,0x00040020,0x00000043,0x00000001,
+0x0000000a,0x0004003b,0x00000043,0x00000044,
+0x00000001,0x00040020,0x00000046,0x00000003,
+0x0000001c,0x0004003b,0x00000046,0x00000047,
+0x00000003,0x00040020,0x00000048,0x00000001,
+0x0000001c,0x0004003b,0x00000048,0x00000049,
+0x00000001,0x00050036,0x00000002,0x00000004,
+0x00000000,0x00000003,0x000200f8,0x00000005,
+0x0004003b,0x00000008,0x00000009,0x00000007,
+0x0004003d,0x0000000b,0x0000000e,0x0000000d,
+0x00050041,0x00000016,0x00000017,0x00000014,
+0x00000015,0x0004003d,0x00000011,0x00000018,
+0x00000017,0x0008004f,0x0000000b,0x00000019,
+0x00000018,0x00000018,0x00000000,0x00000001,
+0x00000002,0x00050082,0x0000000b,0x0000001a,
+0x0000000e,0x00000019,0x0004006f,0x00000007,
+0x0000001b,0x0000001a,0x0003003e,0x00000009,
+0x0000001b,0x00050041,0x00000024,0x00000025,
+0x00000014,0x00000023,0x0004003d,0x00000010,
+0x00000026,0x00000025,0x00050041,0x00000024,
+0x00000027,0x00000014,0x00000022,0x0004003d,
+0x00000010,0x00000028,0x00000027,0x00050092,
+0x00000010,0x00000029,0x00000026,0x00000028,
+0x0004003d,0x00000007,0x0000002c,0x0000002b,
+0x0004003d,0x00000007,0x0000002d,0x00000009,
+0x00050081,0x00000007,0x0000002e,0x0000002c,
+0x0000002d,0x00050051,0x00000006,0x00000030,
+0x0000002e,0x00000000,0x00050051,0x00000006,
+0x00000031,0x0000002e,0x00000001,0x00050051,
+0x00000006,0x00000032,0x0000002e,0x00000002,
+0x00070050,0x0000000f,0x00000033,0x00000030,
+0x00000031,0x00000032,0x0000002f,0x00050091,
+0x0000000f,0x00000034,0x00000029,0x00000033,
+0x00050041,0x00000035,0x00000036,0x00000021,
+0x00000022,0x0003003e,0x00000036,0x00000034,
+0x0004003d,0x00000007,0x0000003a,0x00000039,
+0x0003003e,0x00000038,0x0000003a,0x0004003d,
+0x0000003b,0x00000040,0x0000003f,0x0003003e,
+0x0000003d,0x00000040,0x0004003d,0x0000000a,
+0x00000045,0x00000044,0x0003003e,0x00000042,
+0x00000045,0x0004003d,0x0000001c,0x0000004a,
+0x00000049,0x0003003e,0x00000047,0x0000004a,
+0x000100fd,0x00010038
 };
 static const size_t shaderVoxelVertCodeSize = sizeof(shaderVoxelVertCode);
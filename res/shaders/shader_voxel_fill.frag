@@ -1,15 +1,17 @@
 #version 460
 
-layout(binding = 1) uniform sampler2D texSampler;
+// One layer per atlas tile
+layout(binding = 1) uniform sampler2DArray texSampler;
 
 layout(location = 0) in vec3 fragColor;
 layout(location = 1) in vec2 fragTexCoord;
 layout(location = 2) flat in int faceID;
+layout(location = 3) flat in uint fragTextureLayer;
 
 const float shadeLUT[6] = float[](1.0, 0.5, 0.8, 0.8, 0.6, 0.6);
 
 layout(location = 0) out vec4 outColor;
 
 void main() {
-    outColor = texture(texSampler, fragTexCoord) * shadeLUT[faceID];
+    outColor = texture(texSampler, vec3(fragTexCoord, float(fragTextureLayer))) * shadeLUT[faceID];
 }
\ No newline at end of file
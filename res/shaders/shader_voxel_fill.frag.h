@@ -4,76 +4,87 @@
 #include <stdint.h>
 
 static const uint32_t shaderVoxelFillFragCode[] = {
-0x07230203,0x00010000,0x000d000b,0x00000029,
+0x07230203,0x00010000,0x000d000b,0x00000030,
 0x00000000,0x00020011,0x00000001,0x0006000b,
 0x00000001,0x4c534c47,0x6474732e,0x3035342e,
 0x00000000,0x0003000e,0x00000000,0x00000001,
-0x0009000f,0x00000004,0x00000004,0x6e69616d,
-0x00000000,0x00000009,0x00000011,0x0000001e,
-0x00000028,0x00030010,0x00000004,0x00000007,
-0x00030003,0x00000002,0x000001cc,0x000a0004,
-0x475f4c47,0x4c474f4f,0x70635f45,0x74735f70,
-0x5f656c79,0x656e696c,0x7269645f,0x69746365,
-0x00006576,0x00080004,0x475f4c47,0x4c474f4f,
-0x6e695f45,0x64756c63,0x69645f65,0x74636572,
-0x00657669,0x00040005,0x00000004,0x6e69616d,
-0x00000000,0x00050005,0x00000009,0x4374756f,
-0x726f6c6f,0x00000000,0x00050005,0x0000000d,
-0x53786574,0x6c706d61,0x00007265,0x00060005,
-0x00000011,0x67617266,0x43786554,0x64726f6f,
-0x00000000,0x00040005,0x0000001e,0x65636166,
-0x00004449,0x00050005,0x00000021,0x65646e69,
-0x6c626178,0x00000065,0x00050005,0x00000028,
+0x000a000f,0x00000004,0x00000004,0x6e69616d,
+0x00000000,0x00000009,0x00000011,0x00000015,
+0x00000026,0x0000002f,0x00030010,0x00000004,
+0x00000007,0x00030003,0x00000002,0x000001cc,
+0x000a0004,0x475f4c47,0x4c474f4f,0x70635f45,
+0x74735f70,0x5f656c79,0x656e696c,0x7269645f,
+0x69746365,0x00006576,0x00080004,0x475f4c47,
+0x4c474f4f,0x6e695f45,0x64756c63,0x69645f65,
+0x74636572,0x00657669,0x00040005,0x00000004,
+0x6e69616d,0x00000000,0x00050005,0x00000009,
+0x4374756f,0x726f6c6f,0x00000000,0x00050005,
+0x0000000d,0x53786574,0x6c706d61,0x00007265,
+0x00060005,0x00000011,0x67617266,0x43786554,
+0x64726f6f,0x00000000,0x00070005,0x00000015,
+0x67617266,0x74786554,0x4c657275,0x72657961,
+0x00000000,0x00040005,0x00000026,0x65636166,
+0x00004449,0x00050005,0x00000029,0x65646e69,
+0x6c626178,0x00000065,0x00050005,0x0000002f,
 0x67617266,0x6f6c6f43,0x00000072,0x00040047,
 0x00000009,0x0000001e,0x00000000,0x00040047,
 0x0000000d,0x00000021,0x00000001,0x00040047,
 0x0000000d,0x00000022,0x00000000,0x00040047,
 0x00000011,0x0000001e,0x00000001,0x00030047,
-0x0000001e,0x0000000e,0x00040047,0x0000001e,
-0x0000001e,0x00000002,0x00040047,0x00000028,
-0x0000001e,0x00000000,0x00020013,0x00000002,
-0x00030021,0x00000003,0x00000002,0x00030016,
-0x00000006,0x00000020,0x00040017,0x00000007,
-0x00000006,0x00000004,0x00040020,0x00000008,
-0x00000003,0x00000007,0x0004003b,0x00000008,
-0x00000009,0x00000003,0x00090019,0x0000000a,
-0x00000006,0x00000001,0x00000000,0x00000000,
-0x00000000,0x00000001,0x00000000,0x0003001b,
-0x0000000b,0x0000000a,0x00040020,0x0000000c,
-0x00000000,0x0000000b,0x0004003b,0x0000000c,
-0x0000000d,0x00000000,0x00040017,0x0000000f,
-0x00000006,0x00000002,0x00040020,0x00000010,
-0x00000001,0x0000000f,0x0004003b,0x00000010,
-0x00000011,0x00000001,0x00040015,0x00000014,
-0x00000020,0x00000000,0x0004002b,0x00000014,
-0x00000015,0x00000006,0x0004001c,0x00000016,
-0x00000006,0x00000015,0x0004002b,0x00000006,
-0x00000017,0x3f800000,0x0004002b,0x00000006,
-0x00000018,0x3f000000,0x0004002b,0x00000006,
-0x00000019,0x3f4ccccd,0x0004002b,0x00000006,
-0x0000001a,0x3f19999a,0x0009002c,0x00000016,
-0x0000001b,0x00000017,0x00000018,0x00000019,
-0x00000019,0x0000001a,0x0000001a,0x00040015,
-0x0000001c,0x00000020,0x00000001,0x00040020,
-0x0000001d,0x00000001,0x0000001c,0x0004003b,
-0x0000001d,0x0000001e,0x00000001,0x00040020,
-0x00000020,0x00000007,0x00000016,0x00040020,
-0x00000022,0x00000007,0x00000006,0x00040017,
-0x00000026,0x00000006,0x00000003,0x00040020,
-0x00000027,0x00000001,0x00000026,0x0004003b,
-0x00000027,0x00000028,0x00000001,0x00050036,
-0x00000002,0x00000004,0x00000000,0x00000003,
-0x000200f8,0x00000005,0x0004003b,0x00000020,
-0x00000021,0x00000007,0x0004003d,0x0000000b,
-0x0000000e,0x0000000d,0x0004003d,0x0000000f,
-0x00000012,0x00000011,0x00050057,0x00000007,
-0x00000013,0x0000000e,0x00000012,0x0004003d,
-0x0000001c,0x0000001f,0x0000001e,0x0003003e,
-0x00000021,0x0000001b,0x00050041,0x00000022,
-0x00000023,0x00000021,0x0000001f,0x0004003d,
-0x00000006,0x00000024,0x00000023,0x0005008e,
-0x00000007,0x00000025,0x00000013,0x00000024,
-0x0003003e,0x00000009,0x00000025,0x000100fd,
-0x00010038
+0x00000015,0x0000000e,0x00040047,0x00000015,
+0x0000001e,0x00000003,0x00030047,0x00000026,
+0x0000000e,0x00040047,0x00000026,0x0000001e,
+0x00000002,0x00040047,0x0000002f,0x0000001e,
+0x00000000,0x00020013,0x00000002,0x00030021,
+0x00000003,0x00000002,0x00030016,0x00000006,
+0x00000020,0x00040017,0x00000007,0x00000006,
+0x00000004,0x00040020,0x00000008,0x00000003,
+0x00000007,0x0004003b,0x00000008,0x00000009,
+0x00000003,0x00090019,0x0000000a,0x00000006,
+0x00000001,0x00000000,0x00000001,0x00000000,
+0x00000001,0x00000000,0x0003001b,0x0000000b,
+0x0000000a,0x00040020,0x0000000c,0x00000000,
+0x0000000b,0x0004003b,0x0000000c,0x0000000d,
+0x00000000,0x00040017,0x0000000f,0x00000006,
+0x00000002,0x00040020,0x00000010,0x00000001,
+0x0000000f,0x0004003b,0x00000010,0x00000011,
+0x00000001,0x00040015,0x00000013,0x00000020,
+0x00000000,0x00040020,0x00000014,0x00000001,
+0x00000013,0x0004003b,0x00000014,0x00000015,
+0x00000001,0x00040017,0x0000001a,0x00000006,
+0x00000003,0x0004002b,0x00000013,0x0000001d,
+0x00000006,0x0004001c,0x0000001e,0x00000006,
+0x0000001d,0x0004002b,0x00000006,0x0000001f,
+0x3f800000,0x0004002b,0x00000006,0x00000020,
+0x3f000000,0x0004002b,0x00000006,0x00000021,
+0x3f4ccccd,0x0004002b,0x00000006,0x00000022,
+0x3f19999a,0x0009002c,0x0000001e,0x00000023,
+0x0000001f,0x00000020,0x00000021,0x00000021,
+0x00000022,0x00000022,0x00040015,0x00000024,
+0x00000020,0x00000001,0x00040020,0x00000025,
+0x00000001,0x00000024,0x0004003b,0x00000025,
+0x00000026,0x00000001,0x00040020,0x00000028,
+0x00000007,0x0000001e,0x00040020,0x0000002a,
+0x00000007,0x00000006,0x00040020,0x0000002e,
+0x00000001,0x0000001a,0x0004003b,0x0000002e,
+0x0000002f,0x00000001,0x00050036,0x00000002,
+0x00000004,0x00000000,0x00000003,0x000200f8,
+0x00000005,0x0004003b,0x00000028,0x00000029,
+0x00000007,0x0004003d,0x0000000b,0x0000000e,
+0x0000000d,0x0004003d,0x0000000f,0x00000012,
+0x00000011,0x0004003d,0x00000013,0x00000016,
+0x00000015,0x00040070,0x00000006,0x00000017,
+0x00000016,0x00050051,0x00000006,0x00000018,
+0x00000012,0x00000000,0x00050051,0x00000006,
+0x00000019,0x00000012,0x00000001,0x00060050,
+0x0000001a,0x0000001b,0x00000018,0x00000019,
+0x00000017,0x00050057,0x00000007,0x0000001c,
+0x0000000e,0x0000001b,0x0004003d,0x00000024,
+0x00000027,0x00000026,0x0003003e,0x00000029,
+0x00000023,0x00050041,0x0000002a,0x0000002b,
+0x00000029,0x00000027,0x0004003d,0x00000006,
+0x0000002c,0x0000002b,0x0005008e,0x00000007,
+0x0000002d,0x0000001c,0x0000002c,0x0003003e,
+0x00000009,0x0000002d,0x000100fd,0x00010038
 };
 static const size_t shaderVoxelFillFragCodeSize = sizeof(shaderVoxelFillFragCode);
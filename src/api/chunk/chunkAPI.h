@@ -4,6 +4,7 @@
 #include "api/chunk/chunkSource_t.h"
 #include "api/chunk/chunkSourceVTable_t.h"
 #include "api/chunk/chunkState_e.h"
+#include "api/chunk/chunkMeshFlags_e.h"
 #pragma endregion
 #pragma region VTable Wrappers
 /// @brief To actually call the vtable function, the following contract is promised (verified by this wrapper):
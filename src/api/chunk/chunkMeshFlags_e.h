@@ -0,0 +1,13 @@
+#pragma once
+
+/// @brief Bit flags tracking where a chunk is in the (asynchronous) remesh pipeline. Main thread only.
+typedef enum ChunkMeshFlags_e
+{
+    CHUNK_MESH_FLAG_NONE = 0,
+    // A worker is currently meshing a snapshot of this chunk
+    CHUNK_MESH_FLAG_JOB_IN_FLIGHT = 1 << 0,
+    // The chunk (or a neighbor border) changed after the in-flight snapshot was taken. Remesh again once it lands
+    CHUNK_MESH_FLAG_STALE = 1 << 1,
+    // The chunk is in the remesh queue. Makes membership checks O(1)
+    CHUNK_MESH_FLAG_QUEUED = 1 << 2,
+} ChunkMeshFlags_e;
@@ -17,4 +17,11 @@ typedef struct Chunk_t
     // This is stored in the chunk itself instead of the render chunk so that lighting calculations and such can be done
     // separate from rendering
     struct ChunkSolidityGrid_t *pTransparencyGrid;
+    // 6x6 matrix of which faces can see each other through the chunk (bit A * 6 + B, see chunkVisibility.h). Built alongside the
+    // transparency grid and all set until then
+    uint64_t faceConnectivity;
+    // ChunkMeshFlags_e bits. Only touched by the main thread
+    uint8_t meshFlags;
+    // Level of detail the chunk is (being) meshed at. Picked by the chunk renderer from the camera distance
+    uint8_t meshLod;
 } Chunk_t;
\ No newline at end of file
@@ -20,8 +20,9 @@
 #include "core/randomNoise.h"
 #include "cmath/weightedMaps.h"
 #include "rendering/chunk/chunkRenderer.h"
-#include "rendering/renderGC.h"
 #include "core/cpuManager.h"
+#include "threading/threading.h"
+#include "threading/threadPool.h"
 
 void app_init(State_t *restrict pState)
 {
@@ -36,6 +37,12 @@ void app_init(State_t *restrict pState)
     cmath_instantiate();
     weightedMaps_instantiate();
 
+    // Leave a core for the main thread
+    const uint32_t CORE_COUNT = threading_cpu_coreCount();
+    pState->pThreadPool = threadPool_create(CORE_COUNT > 1 ? CORE_COUNT - 1 : 1);
+    if (!pState->pThreadPool)
+        logs_log(LOG_WARN, "Failed to create the thread pool. Chunk meshing will run on the main thread.");
+
     glfwInstance_init();
 
     vulkan_init(pState);
@@ -84,14 +91,25 @@ void app_loop_render(State_t *restrict pState)
 
 void app_loop_main(State_t *restrict pState)
 {
+    // GLFW's clock has been running since glfwInit, which is close enough to launch to time startup with
+    const double SINCE_LAUNCH_S = glfwGetTime();
+
     // Initalize time right before starting the actual user-facing part of the program
     time_init(&pState->time);
+    // time_init restarts the clock at 0, which puts launch that far before the new zero
+    const double LAUNCH_S = -SINCE_LAUNCH_S;
 
+    bool firstFramePresented = false;
     while (!win_shouldClose(&pState->window))
     {
         world_loop(pState);
         phys_loop(pState);
         app_loop_render(pState);
+        if (!firstFramePresented && pState->renderer.frameNumber > 0)
+        {
+            firstFramePresented = true;
+            logs_log(LOG_INFO, "First frame presented %.1f ms after launch.", (glfwGetTime() - LAUNCH_S) * 1000.0);
+        }
         cpuManager_captureDeltaTime(pState);
         // logs_log(LOG_DEBUG, "FPS: %lf Frame: %d", state->time.CPU_framesPerSecond, state->renderer.currentFrame);
     }
@@ -102,7 +120,8 @@ void app_cleanup(State_t *restrict pState)
     scene_destroy(pState);
     world_destroy(pState);
 
-    renderGC_destroy(pState);
+    threadPool_destroy(pState->pThreadPool);
+    pState->pThreadPool = NULL;
 
     // Order matters here (including order inside of destroy functions)because of potential physical device and interdependency.
     // vulkan_init() is called first for init vulkan so it must be destroyed last. Last In First Out / First In Last Out.
@@ -5,6 +5,7 @@
 #include "rendering/chunk/chunkRendering.h"
 #include "world/voxel/block_t.h"
 #include "world/chunkSolidityGrid.h"
+#include "world/chunkVisibility.h"
 #include "collection/linkedList_t.h"
 #pragma endregion
 #pragma region Defines
@@ -99,6 +100,7 @@ Chunk_t *chunk_world_create(const Vec3i_t CHUNK_POS)
     chunkState_set(pChunk, CHUNK_STATE_CPU_EMPTY);
     pChunk->pBlockVoxels = calloc(CMATH_CHUNK_BLOCK_CAPACITY, sizeof(BlockVoxel_t));
     pChunk->chunkPos = CHUNK_POS;
+    pChunk->faceConnectivity = CHUNK_VISIBILITY_ALL;
 
 #if defined(DEBUG_CHUNK)
     chunkAllocatedCount++;
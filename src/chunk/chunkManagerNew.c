@@ -33,6 +33,7 @@ void chunkManager_chunk_register(ChunkManager_t *restrict pChunkManager, Chunk_t
         return;
     }
     addedChunks++;
+    pChunkManager->generation++;
 }
 
 void chunkManager_chunk_deregister(ChunkManager_t *restrict pChunkManager, Chunk_t *restrict pChunk)
@@ -46,6 +47,7 @@ void chunkManager_chunk_deregister(ChunkManager_t *restrict pChunkManager, Chunk
         logs_log(LOG_ERROR, "Removed chunk %p from chunk manager %p's chunk linked list.", pChunk, pChunkManager);
 #endif
         addedChunks--;
+        pChunkManager->generation++;
     }
 }
 #pragma endregion
@@ -1,8 +1,11 @@
 #pragma once
 
+#include <stdint.h>
 #include "collection/linkedList_t.h"
 
 typedef struct ChunkManager_t
 {
     LinkedList_t *pChunksLL;
+    // Bumped whenever a chunk is registered or deregistered, so the renderer can tell the loaded set changed without walking it
+    uint64_t generation;
 } ChunkManager_t;
\ No newline at end of file
@@ -1048,6 +1048,70 @@ static inline Mat4c_t cmath_perspective(float fovYRad, float aspect, float nearC
     return result;
 }
 #pragma endregion
+#pragma region Frustum
+#define CMATH_FRUSTUM_PLANES 6
+/// @brief View frustum as planes (xyz is the inward facing unit normal, w the distance). A point P is inside a plane when
+/// dot(xyz, P) + w >= 0. Order is left, right, bottom, top, near, far (in clip space)
+typedef struct Frustumf_t
+{
+    Vec4f_t pPlanes[CMATH_FRUSTUM_PLANES];
+} Frustumf_t;
+
+/// @brief Extracts the frustum planes from a Vulkan (z clip space [0, 1]) view-projection matrix (projection * view)
+static inline Frustumf_t cmath_frustum_fromViewProjection(const Mat4c_t VIEW_PROJECTION)
+{
+    // Rows of the column-major matrix
+    const Mat4c_t M = VIEW_PROJECTION;
+    const Vec4f_t R0 = {M.m[0].x, M.m[1].x, M.m[2].x, M.m[3].x};
+    const Vec4f_t R1 = {M.m[0].y, M.m[1].y, M.m[2].y, M.m[3].y};
+    const Vec4f_t R2 = {M.m[0].z, M.m[1].z, M.m[2].z, M.m[3].z};
+    const Vec4f_t R3 = {M.m[0].w, M.m[1].w, M.m[2].w, M.m[3].w};
+
+    Frustumf_t frustum = {
+        .pPlanes = {
+            {R3.x + R0.x, R3.y + R0.y, R3.z + R0.z, R3.w + R0.w},
+            {R3.x - R0.x, R3.y - R0.y, R3.z - R0.z, R3.w - R0.w},
+            {R3.x + R1.x, R3.y + R1.y, R3.z + R1.z, R3.w + R1.w},
+            {R3.x - R1.x, R3.y - R1.y, R3.z - R1.z, R3.w - R1.w},
+            // Clip space z starts at 0 rather than -w, so the near plane is the z row alone
+            {R2.x, R2.y, R2.z, R2.w},
+            {R3.x - R2.x, R3.y - R2.y, R3.z - R2.z, R3.w - R2.w},
+        }};
+
+    for (int i = 0; i < CMATH_FRUSTUM_PLANES; i++)
+    {
+        Vec4f_t *pPlane = &frustum.pPlanes[i];
+        const float LENGTH = sqrtf(pPlane->x * pPlane->x + pPlane->y * pPlane->y + pPlane->z * pPlane->z);
+        if (LENGTH > CMATH_EPSILON_F)
+        {
+            pPlane->x /= LENGTH;
+            pPlane->y /= LENGTH;
+            pPlane->z /= LENGTH;
+            pPlane->w /= LENGTH;
+        }
+    }
+
+    return frustum;
+}
+
+/// @brief Conservative test of whether the box [MIN, MAX] touches the frustum. Boxes that straddle a corner of the frustum
+/// may pass while being just outside of it
+static inline bool cmath_frustum_AABB_intersects(const Frustumf_t *pFRUSTUM, const Vec3f_t MIN, const Vec3f_t MAX)
+{
+    for (int i = 0; i < CMATH_FRUSTUM_PLANES; i++)
+    {
+        const Vec4f_t PLANE = pFRUSTUM->pPlanes[i];
+        // Corner of the box furthest along the plane normal
+        const float X = PLANE.x >= 0.0F ? MAX.x : MIN.x;
+        const float Y = PLANE.y >= 0.0F ? MAX.y : MIN.y;
+        const float Z = PLANE.z >= 0.0F ? MAX.z : MIN.z;
+        if (PLANE.x * X + PLANE.y * Y + PLANE.z * Z + PLANE.w < 0.0F)
+            return false;
+    }
+
+    return true;
+}
+#pragma endregion
 #pragma region Geometry
 /// @brief How many faces are on a cube
 #define CMATH_GEOM_CUBE_FACES 6
@@ -1172,6 +1236,31 @@ static inline Vec3u8_t cmath_chunk_wrapLocalPos(uint8_t nx, uint8_t ny, uint8_t
     return (Vec3u8_t){0, 0, 0};
 }
 
+/// @brief Gets the local position of the block at (U, V) on the FACE side of a chunk. U and V are the two axes along the face
+/// in x, y, z order.
+static inline Vec3u8_t cmath_chunk_faceBorderPos(const CubeFace_e FACE, const uint8_t U, const uint8_t V)
+{
+    const uint8_t MAX = (uint8_t)(CMATH_CHUNK_AXIS_LENGTH - 1);
+    switch (FACE)
+    {
+    case CUBE_FACE_LEFT:
+        return (Vec3u8_t){0, U, V};
+    case CUBE_FACE_RIGHT:
+        return (Vec3u8_t){MAX, U, V};
+    case CUBE_FACE_TOP:
+        return (Vec3u8_t){U, MAX, V};
+    case CUBE_FACE_BOTTOM:
+        return (Vec3u8_t){U, 0, V};
+    case CUBE_FACE_FRONT:
+        return (Vec3u8_t){U, V, MAX};
+    case CUBE_FACE_BACK:
+        return (Vec3u8_t){U, V, 0};
+    }
+
+    // This should never happen
+    return (Vec3u8_t){0, 0, 0};
+}
+
 /// @brief Converts CHUNK_POS to world (Vec3i)
 static inline Vec3i_t cmath_chunk_chunkPos_2_worldPosI(const Vec3i_t CHUNK_POS)
 {
@@ -0,0 +1,177 @@
+#pragma region Includes
+#pragma once
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#pragma endregion
+#pragma region Defines
+#define BUDDY_TREE_MAX_LEVELS 24
+#define BUDDY_TREE_INVALID SIZE_MAX
+/// @brief Buddy allocator over a range of (1 << levels) units. Tracks offsets only, so it can manage memory it can't touch
+/// (GPU memory). Every node at order k is 1 << k units long and starts at a multiple of its own size.
+typedef struct BuddyTree_t
+{
+    uint8_t levels;
+    size_t nodeCount;
+    // Per node (heap order, root at 0): 0 if nothing in the subtree is free, otherwise the order of the largest free node in
+    // the subtree + 1
+    uint8_t *pLongest;
+    // One bit per node, set on the exact node buddyTree_alloc handed out. A full interior node has pLongest 0 as well, so
+    // this is what tells a real allocation (and its order) apart from one that is only full through its children
+    uint8_t *pAllocated;
+} BuddyTree_t;
+#pragma endregion
+#pragma region Operations
+/// @brief Index of the first node at DEPTH
+static inline size_t buddyTree_depthFirst(const uint8_t DEPTH)
+{
+    return ((size_t)1 << DEPTH) - 1;
+}
+
+static inline bool buddyTree_allocated_get(const BuddyTree_t *pTREE, const size_t NODE)
+{
+    return (pTREE->pAllocated[NODE >> 3] >> (NODE & 7)) & 1;
+}
+
+static inline void buddyTree_allocated_set(BuddyTree_t *pTree, const size_t NODE, const bool ALLOCATED)
+{
+    const uint8_t BIT = (uint8_t)(1 << (NODE & 7));
+    if (ALLOCATED)
+        pTree->pAllocated[NODE >> 3] |= BIT;
+    else
+        pTree->pAllocated[NODE >> 3] &= (uint8_t)~BIT;
+}
+
+/// @brief Recomputes the parents of NODE after it changed, merging two fully free buddies back into one free parent.
+static inline void buddyTree_parents_update(BuddyTree_t *pTree, size_t node, uint8_t order)
+{
+    while (node > 0)
+    {
+        node = (node - 1) / 2;
+
+        const uint8_t LEFT = pTree->pLongest[node * 2 + 1];
+        const uint8_t RIGHT = pTree->pLongest[node * 2 + 2];
+        const uint8_t FREE_CHILD = (uint8_t)(order + 1);
+        order++;
+
+        if (LEFT == FREE_CHILD && RIGHT == FREE_CHILD)
+            pTree->pLongest[node] = (uint8_t)(order + 1);
+        else
+            pTree->pLongest[node] = LEFT > RIGHT ? LEFT : RIGHT;
+    }
+}
+
+/// @brief Reserves a node of ORDER and returns its offset in units, or BUDDY_TREE_INVALID if no node that big is free.
+static inline size_t buddyTree_alloc(BuddyTree_t *pTree, const uint8_t ORDER)
+{
+    if (!pTree || !pTree->pLongest || ORDER > pTree->levels || pTree->pLongest[0] < ORDER + 1)
+        return BUDDY_TREE_INVALID;
+
+    size_t node = 0;
+    uint8_t nodeOrder = pTree->levels;
+    while (nodeOrder > ORDER)
+    {
+        // Prefer the left child so allocations pack toward the start of the range
+        const size_t LEFT = node * 2 + 1;
+        node = pTree->pLongest[LEFT] >= ORDER + 1 ? LEFT : LEFT + 1;
+        nodeOrder--;
+    }
+
+    pTree->pLongest[node] = 0;
+    buddyTree_allocated_set(pTree, node, true);
+    buddyTree_parents_update(pTree, node, ORDER);
+
+    return (node - buddyTree_depthFirst((uint8_t)(pTree->levels - ORDER))) << ORDER;
+}
+
+/// @brief Releases the node of ORDER at OFFSET (units) that buddyTree_alloc returned. Returns false for anything else,
+/// including an offset that was allocated with a different order.
+static inline bool buddyTree_free(BuddyTree_t *pTree, const size_t OFFSET, const uint8_t ORDER)
+{
+    if (!pTree || !pTree->pLongest || !pTree->pAllocated || ORDER > pTree->levels)
+        return false;
+
+    // Not the start of a node of this order
+    if (OFFSET & (((size_t)1 << ORDER) - 1))
+        return false;
+
+    const size_t NODE = buddyTree_depthFirst((uint8_t)(pTree->levels - ORDER)) + (OFFSET >> ORDER);
+    if (NODE >= pTree->nodeCount || !buddyTree_allocated_get(pTree, NODE))
+        return false;
+
+    buddyTree_allocated_set(pTree, NODE, false);
+    pTree->pLongest[NODE] = (uint8_t)(ORDER + 1);
+    buddyTree_parents_update(pTree, NODE, ORDER);
+
+    return true;
+}
+
+/// @brief Order of the largest free node, or -1 if the tree is full
+static inline int buddyTree_largestFreeOrder(const BuddyTree_t *pTREE)
+{
+    if (!pTREE || !pTREE->pLongest)
+        return -1;
+
+    return (int)pTREE->pLongest[0] - 1;
+}
+
+/// @brief Checks if nothing is allocated
+static inline bool buddyTree_isEmpty(const BuddyTree_t *pTREE)
+{
+    return buddyTree_largestFreeOrder(pTREE) == (int)pTREE->levels;
+}
+
+/// @brief Smallest order whose nodes hold UNITS units
+static inline uint8_t buddyTree_order_forUnits(const size_t UNITS)
+{
+    uint8_t order = 0;
+    while (((size_t)1 << order) < UNITS)
+        order++;
+
+    return order;
+}
+#pragma endregion
+#pragma region Create/Destroy
+/// @brief Creates a fully free tree spanning (1 << levels) units. levels [0, BUDDY_TREE_MAX_LEVELS]
+static inline BuddyTree_t *buddyTree_create(const uint8_t LEVELS)
+{
+    if (LEVELS > BUDDY_TREE_MAX_LEVELS)
+        return NULL;
+
+    BuddyTree_t *pTree = calloc(1, sizeof(BuddyTree_t));
+    if (!pTree)
+        return NULL;
+
+    pTree->levels = LEVELS;
+    pTree->nodeCount = ((size_t)1 << (LEVELS + 1)) - 1;
+    pTree->pLongest = malloc(pTree->nodeCount);
+    pTree->pAllocated = calloc((pTree->nodeCount + 7) / 8, 1);
+    if (!pTree->pLongest || !pTree->pAllocated)
+    {
+        free(pTree->pLongest);
+        free(pTree->pAllocated);
+        free(pTree);
+        return NULL;
+    }
+
+    for (uint8_t depth = 0; depth <= LEVELS; depth++)
+    {
+        const size_t FIRST = buddyTree_depthFirst(depth);
+        const size_t LAST = buddyTree_depthFirst((uint8_t)(depth + 1));
+        for (size_t node = FIRST; node < LAST; node++)
+            pTree->pLongest[node] = (uint8_t)(LEVELS - depth + 1);
+    }
+
+    return pTree;
+}
+
+static inline void buddyTree_destroy(BuddyTree_t *pTree)
+{
+    if (!pTree)
+        return;
+
+    free(pTree->pLongest);
+    free(pTree->pAllocated);
+    free(pTree);
+}
+#pragma endregion
@@ -0,0 +1,130 @@
+#pragma region Includes
+#pragma once
+#include <stdlib.h>
+#include <stdbool.h>
+#include "cmath/cmath.h"
+#pragma endregion
+#pragma region Defines
+#define RING_QUEUE_MAX_CAPACITY 65536
+#define RING_QUEUE_RESIZE_FACTOR 2
+/// @brief FIFO of data pointers backed by a growable ring buffer. Push to either end, pop from the front.
+typedef struct RingQueue_t
+{
+    size_t capacity;
+    // Index of the front element
+    size_t head;
+    size_t count;
+    void **ppCollection;
+} RingQueue_t;
+#pragma endregion
+#pragma region Operations
+/// @brief Grows the ring, unwrapping it so the front element lands at index 0. Size [1, RING_QUEUE_MAX_CAPACITY]
+static inline bool ringQueue_resize(RingQueue_t *pQueue, size_t newSize)
+{
+    if (!pQueue || !pQueue->ppCollection || newSize == 0)
+        return false;
+
+    const size_t CLAMPED = cmath_clampSizet(newSize, 1, RING_QUEUE_MAX_CAPACITY);
+
+    // Resize would truncate the data
+    if (CLAMPED < pQueue->count)
+        return false;
+
+    if (CLAMPED == pQueue->capacity)
+        // Tried to grow but hit max cap, otherwise no-op resize
+        return newSize <= pQueue->capacity;
+
+    void **ppNew = malloc(sizeof(void *) * CLAMPED);
+    if (!ppNew)
+        return false;
+
+    for (size_t i = 0; i < pQueue->count; i++)
+        ppNew[i] = pQueue->ppCollection[(pQueue->head + i) % pQueue->capacity];
+
+    free(pQueue->ppCollection);
+    pQueue->ppCollection = ppNew;
+    pQueue->capacity = CLAMPED;
+    pQueue->head = 0;
+
+    return true;
+}
+
+/// @brief Adds pData to the back of the queue, growing by RING_QUEUE_RESIZE_FACTOR if full.
+static inline bool ringQueue_pushBack(RingQueue_t *restrict pQueue, void *restrict pData)
+{
+    if (!pQueue || !pQueue->ppCollection || !pData)
+        return false;
+
+    if (pQueue->count == pQueue->capacity && !ringQueue_resize(pQueue, pQueue->capacity * RING_QUEUE_RESIZE_FACTOR))
+        return false;
+
+    pQueue->ppCollection[(pQueue->head + pQueue->count) % pQueue->capacity] = pData;
+    pQueue->count++;
+
+    return true;
+}
+
+/// @brief Adds pData to the front of the queue (it will be the next one popped), growing by RING_QUEUE_RESIZE_FACTOR if full.
+static inline bool ringQueue_pushFront(RingQueue_t *restrict pQueue, void *restrict pData)
+{
+    if (!pQueue || !pQueue->ppCollection || !pData)
+        return false;
+
+    if (pQueue->count == pQueue->capacity && !ringQueue_resize(pQueue, pQueue->capacity * RING_QUEUE_RESIZE_FACTOR))
+        return false;
+
+    pQueue->head = (pQueue->head + pQueue->capacity - 1) % pQueue->capacity;
+    pQueue->ppCollection[pQueue->head] = pData;
+    pQueue->count++;
+
+    return true;
+}
+
+/// @brief Removes and returns the front data pointer, or NULL if the queue is empty.
+static inline void *ringQueue_popFront(RingQueue_t *pQueue)
+{
+    if (!pQueue || !pQueue->ppCollection || pQueue->count == 0)
+        return NULL;
+
+    void *pData = pQueue->ppCollection[pQueue->head];
+    pQueue->head = (pQueue->head + 1) % pQueue->capacity;
+    pQueue->count--;
+
+    return pData;
+}
+#pragma endregion
+#pragma region Create/Destroy
+/// @brief Creates a queue with capacity [1, RING_QUEUE_MAX_CAPACITY]
+static inline RingQueue_t *ringQueue_create(size_t capacity)
+{
+    capacity = cmath_clampSizet(capacity, 1, RING_QUEUE_MAX_CAPACITY);
+
+    RingQueue_t *pQueue = calloc(1, sizeof(RingQueue_t));
+    if (!pQueue)
+        return NULL;
+
+    pQueue->ppCollection = calloc(capacity, sizeof(void *));
+    if (!pQueue->ppCollection)
+    {
+        free(pQueue);
+        return NULL;
+    }
+
+    pQueue->capacity = capacity;
+
+    return pQueue;
+}
+
+/// @brief Destroys the queue. DOES NOT free the data tracked in the queue. (Doesn't own those pointers)
+static inline void ringQueue_destroy(RingQueue_t *pQueue)
+{
+    if (!pQueue)
+        return;
+
+    free(pQueue->ppCollection);
+    free(pQueue);
+}
+#pragma endregion
+#pragma region Undefines
+#undef RING_QUEUE_RESIZE_FACTOR
+#pragma endregion
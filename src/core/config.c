@@ -88,10 +88,10 @@ static AppConfig_t s_AppConfig = {
     .cameraFOV = 70.0F,
     .resetCursorOnMenuExit = true,
     .mouseSensitivity = 1.0,
-    .atlasPaddingPx = 8,
     .cameraFarClippingPlane = 500.0F,
     .cameraNearClippingPlane = 0.1F,
     .chunkRenderDistance = 12,
+    .chunkUploadBudgetMs = 4.0,
 };
 
 static WorldConfig_t s_WorldConfig = {
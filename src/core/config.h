@@ -34,7 +34,8 @@ typedef struct AppConfig_t
     // Size in pixels of each subtexture on the texture atlas. Minecraft is 16px
     uint32_t subtextureSize;
     double mouseSensitivity;
-    uint32_t atlasPaddingPx;
+    // Main thread time (ms) allowed per frame for uploading finished chunk meshes. At least one mesh is always uploaded.
+    double chunkUploadBudgetMs;
 } AppConfig_t;
 
 struct State_t;
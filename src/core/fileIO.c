@@ -1,4 +1,5 @@
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
 #include <stdbool.h>
@@ -11,6 +12,7 @@
 #ifdef _WIN32
 #include <direct.h>
 #include <io.h>
+#include <windows.h>
 #define MKDIR(path) _mkdir(path)
 #else
 #include <unistd.h>
@@ -66,6 +68,55 @@ FileIO_Result_e fileIO_file_open(FILE **ppFile, const char *pPATH, const char *p
     return FILE_IO_RESULT_SUCCESS;
 }
 
+void *fileIO_file_read(const char *pPATH, size_t *pSize, const char *pDEBUG_NAME)
+{
+    *pSize = 0;
+
+    FILE *pFile = NULL;
+    if (fileIO_file_open(&pFile, pPATH, "rb", pDEBUG_NAME) != FILE_IO_RESULT_SUCCESS)
+        return NULL;
+
+    void *pData = NULL;
+    do
+    {
+        if (fseek(pFile, 0, SEEK_END) != 0)
+            break;
+
+        const long LENGTH = ftell(pFile);
+        if (LENGTH <= 0 || fseek(pFile, 0, SEEK_SET) != 0)
+            break;
+
+        pData = malloc((size_t)LENGTH);
+        if (!pData)
+            break;
+
+        if (fread(pData, 1, (size_t)LENGTH, pFile) != (size_t)LENGTH)
+        {
+            free(pData);
+            pData = NULL;
+            break;
+        }
+
+        *pSize = (size_t)LENGTH;
+    } while (0);
+
+    fileIO_file_close(pFile, pDEBUG_NAME);
+    return pData;
+}
+
+uint64_t fileIO_hash(const void *pDATA, const size_t SIZE, const uint64_t HASH)
+{
+    uint64_t hash = HASH;
+    const uint8_t *pBYTES = pDATA;
+    for (size_t i = 0; pBYTES && i < SIZE; i++)
+    {
+        hash ^= pBYTES[i];
+        hash *= 0x100000001B3ULL;
+    }
+
+    return hash;
+}
+
 bool fileIO_dir_exists(const char *pFOLDER_NAME, char *pFullDir)
 {
     snprintf(pFullDir, MAX_DIR_PATH_LENGTH, "%s%s", pBASE_PATH, pFOLDER_NAME);
@@ -121,6 +172,31 @@ FileIO_Result_e fileIO_dir_create(const char *pFOLDER_NAME, char *pFullDir)
     return FILE_IO_RESULT_DIR_ALREADY_EXISTS;
 }
 
+FileIO_Result_e fileIO_file_replace(const char *pTEMP_PATH, const char *pPATH, const char *pDEBUG_NAME)
+{
+    if (!pTEMP_PATH || !pPATH)
+    {
+        logs_log(LOG_ERROR, "Received invalid parameters (tempPath=%p, path=%p) [%s]", pTEMP_PATH, pPATH, pDEBUG_NAME);
+        return FILE_IO_RESULT_FAILURE;
+    }
+
+#ifdef _WIN32
+    // The CRT rename refuses to overwrite an existing file
+    const bool REPLACED = MoveFileExA(pTEMP_PATH, pPATH, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    const bool REPLACED = rename(pTEMP_PATH, pPATH) == 0;
+#endif
+
+    if (!REPLACED)
+    {
+        logs_log(LOG_ERROR, "Failed to move '%s' over '%s' [%s]", pTEMP_PATH, pPATH, pDEBUG_NAME);
+        remove(pTEMP_PATH);
+        return FILE_IO_RESULT_FAILURE;
+    }
+
+    return FILE_IO_RESULT_SUCCESS;
+}
+
 FileIO_Result_e fileIO_file_create(FILE **ppFile, const char *pFOLDER_NAME, const char *pFILE_NAME)
 {
     logs_log(LOG_DEBUG, "Checking if '%s' exists before creating %s", pFOLDER_NAME, pFILE_NAME);
@@ -1,8 +1,12 @@
 #include <stdio.h>
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 
 #define MAX_FILE_NAME_LENGTH 256
 #define MAX_DIR_PATH_LENGTH 512
+// 64 bit FNV-1a offset basis. Start every new fileIO_hash from it
+#define FILE_IO_HASH_SEED 0xCBF29CE484222325ULL
 
 /// @brief SUCCESS | DIR/FILE CREATED | FAILURE | DIR/FILE ALREADY EXISTS
 typedef enum FileIO_Result_e
@@ -36,6 +40,17 @@ bool fileIO_file_exists(const char *pFOLDER_NAME, const char *pFILE_NAME, char *
 /// @return FileIO_Result_e
 FileIO_Result_e fileIO_dir_create(const char *pFOLDER_NAME, char *pFullDir);
 
+/// @brief Moves the fully written file at pTEMP_PATH over pPATH in one step, so a crash mid-save never leaves a truncated
+/// pPATH behind. The temp file is removed if the move fails.
+/// @return FileIO_Result_e
+FileIO_Result_e fileIO_file_replace(const char *pTEMP_PATH, const char *pPATH, const char *pDEBUG_NAME);
+
 /// @brief Creates the file
 /// @return FileIO_Result_e
-FileIO_Result_e fileIO_file_create(FILE **ppFile, const char *pFOLDER_NAME, const char *pFILE_NAME);
\ No newline at end of file
+FileIO_Result_e fileIO_file_create(FILE **ppFile, const char *pFOLDER_NAME, const char *pFILE_NAME);
+
+/// @brief Reads the whole file (binary) into a malloc'd buffer that the caller frees. NULL when it can't be read
+void *fileIO_file_read(const char *pPATH, size_t *pSize, const char *pDEBUG_NAME);
+
+/// @brief 64 bit FNV-1a of the data, continuing from HASH so several files can key one cache. Not for anything adversarial
+uint64_t fileIO_hash(const void *pDATA, const size_t SIZE, const uint64_t HASH);
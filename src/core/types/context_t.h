@@ -13,9 +13,13 @@ typedef struct
     VkPhysicalDeviceFeatures physicalDeviceSupportedFeatures;
     VkPhysicalDeviceFeatures physicalDeviceEnabledFeatures;
     VkQueue graphicsQueue;
+    // Queue on a dedicated transfer family for uploads. Same as graphicsQueue when the device doesn't have one
+    VkQueue transferQueue;
     // This is always null right now so that Vulkan uses its own allocator
     VkAllocationCallbacks *pAllocator;
     /// @brief UINT32_MAX means no family assigned (set to max during creation)
     uint32_t queueFamily;
+    /// @brief Family of transferQueue. Equal to queueFamily when uploads fall back to the graphics queue
+    uint32_t transferQueueFamily;
     Camera_t camera;
 } Context_t;
\ No newline at end of file
@@ -4,9 +4,20 @@
 #include <stdint.h>
 #include <vulkan/vulkan.h>
 #include "core/config.h"
-#include "core/types/atlasRegion_t.h"
+#include "cmath/cmath.h"
 #include "rendering/types/graphicsPipeline_t.h"
 #include "rendering/types/anisotropicFilteringOptions_t.h"
+#include "rendering/types/gpuAllocation_t.h"
+#include "rendering/types/renderFrameStats_t.h"
+
+struct GpuAllocator_t;
+struct ChunkGeometryPool_t;
+struct StagingRing_t;
+struct ChunkDrawList_t;
+struct ChunkCulling_t;
+struct ChunkOcclusion_t;
+struct GpuProfiler_t;
+struct SecondaryCommandBuffers_t;
 
 typedef struct
 {
@@ -23,6 +34,8 @@ typedef struct
     VkPipelineLayout pipelineLayoutWireframeVoxel;
 
     GraphicsPipeline_e activeGraphicsPipeline;
+    // Loaded from and saved to the config folder so pipelines don't recompile every launch
+    VkPipelineCache pipelineCache;
 
     uint32_t renderpassAttachmentCount;
     VkRenderPass pRenderPass;
@@ -30,22 +43,63 @@ typedef struct
     VkFramebuffer *pFramebuffers;
     VkCommandPool commandPool;
     VkCommandBuffer *pCommandBuffers;
+    // Per-thread pools and the secondaries the frame's draws are recorded into
+    struct SecondaryCommandBuffers_t *pSecondaryCommandBuffers;
     VkSemaphore *pImageAcquiredSemaphores;
     VkSemaphore *pRenderFinishedSemaphores;
     VkFence *pInFlightFences;
     VkFence *pImagesInFlight;
+    // Every buffer's memory is sub-allocated from here
+    struct GpuAllocator_t *pGpuAllocator;
+    // Every chunk mesh lives in one of this pool's shared buffers
+    struct ChunkGeometryPool_t *pChunkGeometryPool;
+    // Persistently mapped staging memory, one slice per frame in flight
+    struct StagingRing_t *pStagingRing;
+    // Visible chunk draws, handed to the GPU through per-frame indirect buffers
+    struct ChunkDrawList_t *pChunkDrawList;
+    // Flat per-frame chunk bounds that get frustum tested before drawing
+    struct ChunkCulling_t *pChunkCulling;
+    // Dense per-frame grid of chunk face connectivity, searched from the camera to skip chunks hidden behind solid ground
+    struct ChunkOcclusion_t *pChunkOcclusion;
+    // Timestamp queries around the frame's passes and uploads. NULL when the graphics queue can't write timestamps
+    struct GpuProfiler_t *pGpuProfiler;
     VkBuffer vertexBuffer;
-    VkDeviceMemory vertexBufferMemory;
+    GpuAllocation_t vertexBufferAllocation;
     VkBuffer indexBuffer;
-    VkDeviceMemory indexBufferMemory;
+    GpuAllocation_t indexBufferAllocation;
     VkDescriptorSetLayout descriptorSetLayout;
     VkBuffer *pUniformBuffers;
-    VkDeviceMemory *pUniformBufferMemories;
+    GpuAllocation_t *pUniformBufferAllocations;
     // Array of pointers that Vulkan uses to access uniform buffers and their memory
     void **ppUniformBuffersMapped;
     uint32_t currentFrame;
+    // Frames presented since startup. Unlike currentFrame it never wraps
+    uint64_t frameNumber;
+    // Frames the GPU is known to have finished, going by the in-flight fences. Frame N is done once this is above N
+    uint64_t framesCompleted;
+    // Binds and draws of the frame being recorded. Reset when recording starts
+    RenderFrameStats_t frameStats;
+    // Planes of the camera's view-projection as of the last uniform buffer update, relative to renderOrigin like the shaders
+    Frustumf_t cameraFrustum;
+    // Corner of the chunk the camera was in at the last uniform buffer update. Culled bounds are taken relative to it
+    Vec3i_t renderOrigin;
     VkDescriptorPool descriptorPool;
     VkDescriptorSet *pDescriptorSets;
+    // Every model draws with the frame's one model set: the UBO and a table of all model textures
+    VkDescriptorSetLayout modelDescriptorSetLayout;
+    VkDescriptorSet *pModelDescriptorSets;
+    // Free slots of the model texture table chained through pModelTextureNextFree, ended by DESCRIPTOR_POOL_MODEL_TEXTURE_INVALID
+    uint32_t modelTextureFreeSlot;
+    uint32_t *pModelTextureNextFree;
+    // What every slot of the model table should name. Changes only reach a frame's set in descriptorPool_modelTexture_flush, once
+    // that frame's fence has signaled, so no set is rewritten while a frame in flight still reads it
+    VkDescriptorImageInfo *pModelTextureInfos;
+    // Per frame in flight, a bit per model table slot that still has to be written into that frame's set
+    uint32_t *pModelTextureDirtyMasks;
+    // 1x1 texture every slot nothing owns points at, so the statically used table never holds a destroyed view
+    VkImage modelFallbackImage;
+    VkDeviceMemory modelFallbackImageMemory;
+    VkImageView modelFallbackImageView;
     // Change these to arrays once more than one texture is loaded
     VkImage atlasTextureImage;
     VkDeviceMemory atlasTextureImageMemory;
@@ -56,8 +110,7 @@ typedef struct
     VkImage depthImage;
     VkDeviceMemory depthImageMemory;
     VkImageView depthImageView;
-    uint32_t atlasRegionCount;
-    uint32_t atlasWidthInTiles;
-    uint32_t atlasHeightInTiles;
-    AtlasRegion_t *pAtlasRegions;
+    // One layer per atlas tile, indexed by AtlasFace_e
+    uint32_t atlasLayerCount;
+    uint32_t atlasMipLevels;
 } Renderer_t;
\ No newline at end of file
@@ -1,15 +1,50 @@
 #pragma once
 
 #include <stdint.h>
+#include <vulkan/vulkan.h>
 #include "rendering/types/renderModel_t.h"
+#include "rendering/types/gpuAllocation_t.h"
+#include "rendering/renderQueue.h"
 #include "scene/SceneModelInstance_t.h"
 
+/// @brief A run of instances sharing a model. They sit back to back in pModelInstances and go out as one instanced draw
+typedef struct SceneModelBatch_t
+{
+    RenderModel_t *pModel;
+    uint32_t firstInstance;
+    uint32_t instanceCount;
+} SceneModelBatch_t;
+
+/// @brief Instance transforms for one frame in flight. Persistently mapped and only written while recording that frame
+typedef struct SceneInstanceFrame_t
+{
+    VkBuffer buffer;
+    GpuAllocation_t allocation;
+    uint32_t capacity;
+} SceneInstanceFrame_t;
+
 typedef struct Scene_t
 {
+    // Kept grouped by model on add/remove so drawing never has to sort
     SceneModelInstance_t *pModelInstances;
     uint32_t instCount;
     uint32_t instCap;
+    // Handle slots, so callers can keep naming an instance while the array above shifts
+    SceneInstanceSlot_t *pSlots;
+    uint32_t slotCount;
+    uint32_t slotCap;
+    // Head of the free slot chain, UINT32_MAX when empty. Only valid once pSlots exists
+    uint32_t freeSlot;
+    SceneModelBatch_t *pBatches;
+    uint32_t batchCount;
+    uint32_t batchCap;
+    // Batch draw order for the frame being recorded, plus the sort's scratch space
+    RenderQueueItem_t *pBatchOrder;
+    RenderQueueItem_t *pBatchOrderScratch;
+    uint32_t batchOrderCap;
+    SceneInstanceFrame_t *pInstanceFrames;
+    uint32_t instanceFrameCount;
     RenderModel_t **ppModels;
     uint32_t modelCount;
     uint32_t modelCap;
-} Scene_t;
\ No newline at end of file
+} Scene_t;
@@ -32,4 +32,6 @@ typedef struct State_t
     Scene_t scene;
     struct WorldState_t *pWorldState;
     struct WorldConfig_t *pWorldConfig;
+    // Worker threads for off-main-thread CPU work (chunk meshing)
+    struct ThreadPool_t *pThreadPool;
 } State_t;
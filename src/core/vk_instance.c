@@ -166,6 +166,27 @@ static void logicOps_tryEnable(State_t *pState)
     else
         logs_log(LOG_WARN, "Device does not support logic operations! Some graphics features will be disabled.");
 }
+
+/// @brief Enable batching chunk draws into indirect draws if supported
+static void drawIndirect_tryEnable(State_t *pState)
+{
+    if (pState->context.physicalDeviceSupportedFeatures.multiDrawIndirect)
+        pState->context.physicalDeviceEnabledFeatures.multiDrawIndirect = VK_TRUE;
+    else
+        logs_log(LOG_WARN, "Device does not support multi draw indirect (one indirect call per chunk draw).");
+
+    if (pState->context.physicalDeviceSupportedFeatures.drawIndirectFirstInstance)
+        pState->context.physicalDeviceEnabledFeatures.drawIndirectFirstInstance = VK_TRUE;
+    else
+        logs_log(LOG_WARN, "Device does not support indirect first instance (chunks will be drawn directly).");
+}
+
+/// @brief Enable indexing sampler arrays by push constants, which the shared model texture table relies on. Required by
+/// physicalDevice_select, so always supported here
+static void sampledImageArrayDynamicIndexing_enable(State_t *pState)
+{
+    pState->context.physicalDeviceEnabledFeatures.shaderSampledImageArrayDynamicIndexing = VK_TRUE;
+}
 #pragma endregion
 #pragma region Device Creation
 /// @brief Creates a physicial device and assigns it to the state
@@ -177,20 +198,33 @@ static bool device_create(State_t *pState)
     anisotropicFilteringOptions_tryEnable(pState);
     wireframeDrawing_tryEnable(pState);
     logicOps_tryEnable(pState);
+    drawIndirect_tryEnable(pState);
+    sampledImageArrayDynamicIndexing_enable(pState);
 
-    const VkDeviceQueueCreateInfo QUEUE_CREATE_INFO = {
-        .sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO,
-        .queueFamilyIndex = pState->context.queueFamily,
-        // Only need to use the 1 queue
-        .queueCount = 1,
-        // Address to a 1.0 float because there is only the one queue
-        .pQueuePriorities = &(float){1.0},
+    const VkDeviceQueueCreateInfo pQUEUE_CREATE_INFOS[] = {
+        {
+            .sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO,
+            .queueFamilyIndex = pState->context.queueFamily,
+            // Only need to use the 1 queue
+            .queueCount = 1,
+            // Address to a 1.0 float because there is only the one queue
+            .pQueuePriorities = &(float){1.0},
+        },
+        {
+            .sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO,
+            .queueFamilyIndex = pState->context.transferQueueFamily,
+            .queueCount = 1,
+            .pQueuePriorities = &(float){1.0},
+        },
     };
 
+    // The transfer queue only gets its own create info when it is on a different family
+    const bool DEDICATED_TRANSFER = pState->context.transferQueueFamily != pState->context.queueFamily;
+
     const VkDeviceCreateInfo DEVICE_CREATE_INFO = {
         .sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO,
-        .pQueueCreateInfos = &QUEUE_CREATE_INFO,
-        .queueCreateInfoCount = 1,
+        .pQueueCreateInfos = pQUEUE_CREATE_INFOS,
+        .queueCreateInfoCount = DEDICATED_TRANSFER ? 2 : 1,
         .enabledExtensionCount = (uint32_t)s_REQUIRED_EXTENSIONS_COUNT,
         .ppEnabledExtensionNames = s_pREQUIRED_EXTENSIONS,
         .pEnabledFeatures = &pState->context.physicalDeviceEnabledFeatures,
@@ -216,9 +250,30 @@ static void device_getQueue(State_t *pState)
     // actually using those queues (workforce distribution)
     uint32_t queueIndex = 0;
     vkGetDeviceQueue(pState->context.device, pState->context.queueFamily, queueIndex, &pState->context.graphicsQueue);
+
+    if (pState->context.transferQueueFamily != pState->context.queueFamily)
+        vkGetDeviceQueue(pState->context.device, pState->context.transferQueueFamily, queueIndex, &pState->context.transferQueue);
+    else
+        pState->context.transferQueue = pState->context.graphicsQueue;
 }
 #pragma endregion
 #pragma region Dev. Compatibility
+/// @brief Checks the features the renderer cannot draw without
+static bool features_supported(VkPhysicalDevice physicalDevice)
+{
+    VkPhysicalDeviceFeatures features = {0};
+    vkGetPhysicalDeviceFeatures(physicalDevice, &features);
+
+    // Models pick their texture out of one shared table with a push constant index
+    if (!features.shaderSampledImageArrayDynamicIndexing)
+    {
+        logs_log(LOG_WARN, "Skipping a Vulkan physical device without dynamic sampler array indexing.");
+        return false;
+    }
+
+    return true;
+}
+
 static bool extensions_supported(VkPhysicalDevice physicalDevice)
 {
     uint32_t count = 0;
@@ -303,6 +358,40 @@ static bool queue_families_supported(const VkInstance INSTANCE, VkPhysicalDevice
     free(pQueueFamilies);
     return supported;
 }
+
+/// @brief Finds a family other than GRAPHICS_FAMILY that can transfer but not draw. Those usually map to the DMA engines, which
+/// copy in parallel with rendering. Prefers transfer-only families over compute ones. Returns GRAPHICS_FAMILY if there is none.
+static uint32_t queue_family_transfer_find(VkPhysicalDevice physicalDevice, const uint32_t GRAPHICS_FAMILY)
+{
+    uint32_t count = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &count, NULL);
+
+    VkQueueFamilyProperties *pQueueFamilies = malloc((sizeof(VkQueueFamilyProperties) * count));
+    if (!pQueueFamilies)
+        return GRAPHICS_FAMILY;
+
+    vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &count, pQueueFamilies);
+
+    uint32_t best = GRAPHICS_FAMILY;
+    bool bestIsTransferOnly = false;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        const VkQueueFlags FLAGS = pQueueFamilies[i].queueFlags;
+        if (i == GRAPHICS_FAMILY || pQueueFamilies[i].queueCount == 0 || !(FLAGS & VK_QUEUE_TRANSFER_BIT) ||
+            (FLAGS & VK_QUEUE_GRAPHICS_BIT))
+            continue;
+
+        const bool TRANSFER_ONLY = !(FLAGS & VK_QUEUE_COMPUTE_BIT);
+        if (best == GRAPHICS_FAMILY || (TRANSFER_ONLY && !bestIsTransferOnly))
+        {
+            best = i;
+            bestIsTransferOnly = TRANSFER_ONLY;
+        }
+    }
+
+    free(pQueueFamilies);
+    return best;
+}
 #pragma endregion
 #pragma region Device Selection
 /// @brief Selects the best physical device
@@ -363,7 +452,7 @@ static bool physicalDevice_select(State_t *pState)
 
         uint32_t queueFamily = 0;
         if (!queue_families_supported(pState->context.instance, pPhysicalDevices[i], &queueFamily) ||
-            !extensions_supported(pPhysicalDevices[i]))
+            !extensions_supported(pPhysicalDevices[i]) || !features_supported(pPhysicalDevices[i]))
             continue;
         else
             logs_log(LOG_DEBUG, "The best Queue Family for device %" PRIu32 " is %" PRIu32 " for use with Vulkan and GLFW.",
@@ -428,8 +517,13 @@ static bool physicalDevice_select(State_t *pState)
 
     pState->context.physicalDevice = pPhysicalDevices[bestIndex];
     pState->context.queueFamily = bestQueueFamily;
+    pState->context.transferQueueFamily = queue_family_transfer_find(pState->context.physicalDevice, (uint32_t)bestQueueFamily);
 
     logs_log(LOG_DEBUG, "Device %" PRIu32 " will be used with queue family %" PRIu32 ".", bestIndex, bestQueueFamily);
+    if (pState->context.transferQueueFamily != pState->context.queueFamily)
+        logs_log(LOG_DEBUG, "Uploads will use the dedicated transfer queue family %" PRIu32 ".", pState->context.transferQueueFamily);
+    else
+        logs_log(LOG_DEBUG, "No dedicated transfer queue family. Uploads will use the graphics queue.");
 
     free(pPhysicalDevices);
     return true;
@@ -8,6 +8,8 @@
 #include "gui/window.h"
 #include "core/crash_handler.h"
 #include "rendering/renderGC.h"
+#include "rendering/chunk/chunkGeometryPool.h"
+#include "rendering/pools/descriptor_pool.h"
 #pragma endregion
 #pragma region Presentation
 void swapchain_image_acquireNext(State_t *pState)
@@ -29,7 +31,14 @@ void swapchain_image_acquireNext(State_t *pState)
             break;
         }
 
-        renderGC_flushGarbage(pState, FRAME_INDEX, false);
+        // The frame that last used this slot is done, and so is everything submitted before it
+        const uint64_t FRAMES_IN_FLIGHT = pState->config.maxFramesInFlight;
+        if (pState->renderer.frameNumber >= FRAMES_IN_FLIGHT)
+            pState->renderer.framesCompleted = pState->renderer.frameNumber - FRAMES_IN_FLIGHT + 1;
+
+        renderGC_flushGarbage(pState, false);
+        chunkGeometryPool_flush(pState, FRAME_INDEX);
+        descriptorPool_modelTexture_flush(pState, FRAME_INDEX);
 
         VkFence fence = VK_NULL_HANDLE;
         VkResult result = vkAcquireNextImageKHR(pState->context.device, pState->window.swapchain.handle, IMAGE_TIMEOUT,
@@ -88,6 +97,7 @@ void swapchain_image_present(State_t *pState)
 
         // Advance to the next frame-in-flight slot
         pState->renderer.currentFrame = (pState->renderer.currentFrame + 1) % pState->config.maxFramesInFlight;
+        pState->renderer.frameNumber++;
         return;
     } while (0);
 
@@ -0,0 +1,225 @@
+#pragma region Includes
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include "core/logs.h"
+#include "core/fileIO.h"
+#include "rendering/atlas_bake.h"
+#pragma endregion
+#pragma region Defines
+static const char *pATLAS_CACHE_FOLDER_NAME = "config";
+static const char *pATLAS_CACHE_FILE_NAME = "atlas.cache";
+// "VXAT"
+#define CACHE_MAGIC 0x54415856U
+// Bump whenever the bake's output changes, so older caches get rebaked
+#define CACHE_VERSION 2U
+// Largest tile side. Well past what any device can sample anyway
+#define MAX_TILE_SIDE 16384U
+// Bounds the bake's size. Devices may allow fewer, which the texture checks against its own limits
+#define MAX_LAYERS 65536U
+#pragma endregion
+#pragma region Layout
+uint32_t atlasBake_levelCount(const uint32_t TILE_PX)
+{
+    if (TILE_PX == 0)
+        return 0;
+
+    uint32_t levels = 1;
+    while (levels < ATLAS_BAKE_MAX_LEVELS && TILE_PX % (1U << levels) == 0)
+        levels++;
+
+    return levels;
+}
+
+bool atlasBake_layout_get(const uint32_t TILE_PX, const uint32_t TILES_X, const uint32_t TILES_Y, AtlasBakeLayout_t *pLayout)
+{
+    if (!pLayout || TILE_PX == 0 || TILE_PX > MAX_TILE_SIDE || TILES_X == 0 || TILES_Y == 0 ||
+        (uint64_t)TILES_X * TILES_Y > MAX_LAYERS)
+        return false;
+
+    *pLayout = (AtlasBakeLayout_t){
+        .tilePx = TILE_PX,
+        .tilesX = TILES_X,
+        .tilesY = TILES_Y,
+        .layerCount = TILES_X * TILES_Y,
+        .levelCount = atlasBake_levelCount(TILE_PX),
+    };
+
+    size_t offset = 0;
+    for (uint32_t level = 0; level < pLayout->levelCount; level++)
+    {
+        pLayout->pLevelSizes[level] = TILE_PX >> level;
+        pLayout->pLevelOffsets[level] = offset;
+        offset += (size_t)pLayout->pLevelSizes[level] * pLayout->pLevelSizes[level] * ATLAS_BAKE_BPP * pLayout->layerCount;
+    }
+
+    pLayout->totalSize = offset;
+    return true;
+}
+#pragma endregion
+#pragma region Bake
+static inline uint8_t *atlasBake_pixel(uint8_t *pLayer, const uint32_t SIDE, const uint32_t X, const uint32_t Y)
+{
+    return pLayer + ((size_t)Y * SIDE + X) * ATLAS_BAKE_BPP;
+}
+
+static inline uint8_t atlasBake_linear_toSrgb(const float LINEAR)
+{
+    const float SRGB = LINEAR <= 0.0031308F ? LINEAR * 12.92F : 1.055F * powf(LINEAR, 1.0F / 2.4F) - 0.055F;
+    const float CLAMPED = SRGB < 0.0F ? 0.0F : (SRGB > 1.0F ? 1.0F : SRGB);
+    return (uint8_t)(CLAMPED * 255.0F + 0.5F);
+}
+
+void atlasBake_bake(const uint8_t *restrict pSRC, const AtlasBakeLayout_t *restrict pLAYOUT, uint8_t *restrict pDst)
+{
+    if (!pSRC || !pLAYOUT || !pDst || pLAYOUT->levelCount == 0)
+        return;
+
+    const uint32_t TILE_PX = pLAYOUT->tilePx;
+    const uint32_t SRC_WIDTH = pLAYOUT->tilesX * TILE_PX;
+    const size_t TILE_ROW_BYTES = (size_t)TILE_PX * ATLAS_BAKE_BPP;
+    const size_t LAYER_BYTES_0 = TILE_ROW_BYTES * TILE_PX;
+
+    // Level 0 is every tile cut out of the source into its own layer
+    for (uint32_t ty = 0; ty < pLAYOUT->tilesY; ty++)
+        for (uint32_t tx = 0; tx < pLAYOUT->tilesX; tx++)
+        {
+            uint8_t *pLayer = pDst + (size_t)(ty * pLAYOUT->tilesX + tx) * LAYER_BYTES_0;
+            for (uint32_t y = 0; y < TILE_PX; y++)
+                memcpy(atlasBake_pixel(pLayer, TILE_PX, 0, y),
+                       pSRC + ((size_t)(ty * TILE_PX + y) * SRC_WIDTH + tx * TILE_PX) * ATLAS_BAKE_BPP, TILE_ROW_BYTES);
+        }
+
+    // Averaging sRGB values directly darkens every level, so colors are averaged as linear light
+    float pSrgbToLinear[256];
+    for (uint32_t i = 0; i < 256; i++)
+    {
+        const float C = (float)i / 255.0F;
+        pSrgbToLinear[i] = C <= 0.04045F ? C / 12.92F : powf((C + 0.055F) / 1.055F, 2.4F);
+    }
+
+    for (uint32_t level = 1; level < pLAYOUT->levelCount; level++)
+    {
+        const uint32_t SIDE_ABOVE = pLAYOUT->pLevelSizes[level - 1];
+        const uint32_t SIDE = pLAYOUT->pLevelSizes[level];
+        const size_t LAYER_BYTES_ABOVE = (size_t)SIDE_ABOVE * SIDE_ABOVE * ATLAS_BAKE_BPP;
+        const size_t LAYER_BYTES = (size_t)SIDE * SIDE * ATLAS_BAKE_BPP;
+
+        // Layers never share texels, so nothing can bleed between tiles however far down the chain goes
+        for (uint32_t layer = 0; layer < pLAYOUT->layerCount; layer++)
+        {
+            uint8_t *pAbove = pDst + pLAYOUT->pLevelOffsets[level - 1] + layer * LAYER_BYTES_ABOVE;
+            uint8_t *pLayer = pDst + pLAYOUT->pLevelOffsets[level] + layer * LAYER_BYTES;
+
+            for (uint32_t y = 0; y < SIDE; y++)
+                for (uint32_t x = 0; x < SIDE; x++)
+                {
+                    const uint8_t *ppQUAD[4] = {
+                        atlasBake_pixel(pAbove, SIDE_ABOVE, 2 * x, 2 * y),
+                        atlasBake_pixel(pAbove, SIDE_ABOVE, 2 * x + 1, 2 * y),
+                        atlasBake_pixel(pAbove, SIDE_ABOVE, 2 * x, 2 * y + 1),
+                        atlasBake_pixel(pAbove, SIDE_ABOVE, 2 * x + 1, 2 * y + 1),
+                    };
+
+                    uint8_t *pOut = atlasBake_pixel(pLayer, SIDE, x, y);
+                    for (uint32_t channel = 0; channel < 3; channel++)
+                    {
+                        const float SUM = pSrgbToLinear[ppQUAD[0][channel]] + pSrgbToLinear[ppQUAD[1][channel]] +
+                                          pSrgbToLinear[ppQUAD[2][channel]] + pSrgbToLinear[ppQUAD[3][channel]];
+                        pOut[channel] = atlasBake_linear_toSrgb(SUM * 0.25F);
+                    }
+
+                    // Alpha is already linear
+                    const uint32_t ALPHA = (uint32_t)ppQUAD[0][3] + ppQUAD[1][3] + ppQUAD[2][3] + ppQUAD[3][3];
+                    pOut[3] = (uint8_t)((ALPHA + 2) / 4);
+                }
+        }
+    }
+}
+#pragma endregion
+#pragma region Cache
+bool atlasBake_header_valid(const AtlasBakeHeader_t *pHEADER, const uint64_t SOURCE_HASH, const uint32_t TILE_PX)
+{
+    return pHEADER && pHEADER->magic == CACHE_MAGIC && pHEADER->version == CACHE_VERSION && pHEADER->sourceHash == SOURCE_HASH &&
+           pHEADER->tilePx == TILE_PX;
+}
+
+FILE *atlasBake_cache_open(const uint64_t SOURCE_HASH, const uint32_t TILE_PX, AtlasBakeLayout_t *pLayout)
+{
+    if (!pLayout)
+        return NULL;
+
+    char pPath[MAX_DIR_PATH_LENGTH];
+    if (!fileIO_file_exists(pATLAS_CACHE_FOLDER_NAME, pATLAS_CACHE_FILE_NAME, pPath))
+        return NULL;
+
+    FILE *pFile = NULL;
+    if (fileIO_file_open(&pFile, pPath, "rb", pATLAS_CACHE_FILE_NAME) != FILE_IO_RESULT_SUCCESS)
+        return NULL;
+
+    AtlasBakeHeader_t header;
+    if (fread(&header, sizeof(header), 1, pFile) == 1 && atlasBake_header_valid(&header, SOURCE_HASH, TILE_PX) &&
+        atlasBake_layout_get(TILE_PX, header.tilesX, header.tilesY, pLayout) && header.levelCount == pLayout->levelCount &&
+        header.dataSize == (uint64_t)pLayout->totalSize)
+        return pFile;
+
+    logs_log(LOG_DEBUG, "The baked atlas cache is stale and will be rebaked.");
+    fileIO_file_close(pFile, pATLAS_CACHE_FILE_NAME);
+    return NULL;
+}
+
+bool atlasBake_cache_read(FILE *pFile, const AtlasBakeLayout_t *restrict pLAYOUT, void *restrict pDst)
+{
+    if (!pFile)
+        return false;
+
+    const bool READ = pLAYOUT && pDst && fread(pDst, 1, pLAYOUT->totalSize, pFile) == pLAYOUT->totalSize;
+    if (!READ)
+        logs_log(LOG_WARN, "Failed to read the baked atlas cache. It will be rebaked.");
+
+    fileIO_file_close(pFile, pATLAS_CACHE_FILE_NAME);
+    return READ;
+}
+
+void atlasBake_cache_write(const uint64_t SOURCE_HASH, const AtlasBakeLayout_t *restrict pLAYOUT, const void *restrict pDATA)
+{
+    if (!pLAYOUT || !pDATA)
+        return;
+
+    char pFullDir[MAX_DIR_PATH_LENGTH];
+    if (fileIO_dir_create(pATLAS_CACHE_FOLDER_NAME, pFullDir) == FILE_IO_RESULT_FAILURE)
+        return;
+
+    char pPath[MAX_DIR_PATH_LENGTH];
+    snprintf(pPath, sizeof(pPath), "%s/%s", pFullDir, pATLAS_CACHE_FILE_NAME);
+
+    FILE *pFile = NULL;
+    if (fileIO_file_open(&pFile, pPath, "wb", pATLAS_CACHE_FILE_NAME) != FILE_IO_RESULT_SUCCESS)
+        return;
+
+    const AtlasBakeHeader_t HEADER = {
+        .magic = CACHE_MAGIC,
+        .version = CACHE_VERSION,
+        .sourceHash = SOURCE_HASH,
+        .tilePx = pLAYOUT->tilePx,
+        .tilesX = pLAYOUT->tilesX,
+        .tilesY = pLAYOUT->tilesY,
+        .levelCount = pLAYOUT->levelCount,
+        .dataSize = pLAYOUT->totalSize,
+    };
+
+    if (fwrite(&HEADER, sizeof(HEADER), 1, pFile) != 1 || fwrite(pDATA, 1, pLAYOUT->totalSize, pFile) != pLAYOUT->totalSize)
+        logs_log(LOG_WARN, "Failed to write the baked atlas to '%s'.", pPath);
+    else
+        logs_log(LOG_DEBUG, "Saved %zu bytes of baked atlas to '%s'.", pLAYOUT->totalSize, pPath);
+
+    fileIO_file_close(pFile, pATLAS_CACHE_FILE_NAME);
+}
+#pragma endregion
+#pragma region Undefines
+#undef CACHE_MAGIC
+#undef CACHE_VERSION
+#undef MAX_TILE_SIDE
+#undef MAX_LAYERS
+#pragma endregion
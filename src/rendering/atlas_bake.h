@@ -0,0 +1,65 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+// RGBA8
+#define ATLAS_BAKE_BPP 4
+// Enough for tiles up to 2^15 px
+#define ATLAS_BAKE_MAX_LEVELS 16
+
+/// @brief Where every mip level of the layered atlas sits in the baked data. Levels are tightly packed, largest first, and each
+/// level holds all of its layers back to back in layer order, which is what a single buffer to image copy per level expects
+typedef struct AtlasBakeLayout_t
+{
+    uint32_t tilePx;
+    // Source grid. Tile (x, y) becomes layer y * tilesX + x
+    uint32_t tilesX;
+    uint32_t tilesY;
+    uint32_t layerCount;
+    uint32_t levelCount;
+    // Side of every layer at each level
+    uint32_t pLevelSizes[ATLAS_BAKE_MAX_LEVELS];
+    size_t pLevelOffsets[ATLAS_BAKE_MAX_LEVELS];
+    size_t totalSize;
+} AtlasBakeLayout_t;
+
+/// @brief Start of a baked atlas cache file, followed by AtlasBakeLayout_t.totalSize bytes of level data
+typedef struct AtlasBakeHeader_t
+{
+    uint32_t magic;
+    uint32_t version;
+    // Of the source PNG's bytes
+    uint64_t sourceHash;
+    uint32_t tilePx;
+    uint32_t tilesX;
+    uint32_t tilesY;
+    uint32_t levelCount;
+    uint64_t dataSize;
+} AtlasBakeHeader_t;
+
+/// @brief Mip levels a tile can have. Every level halves the tile, which stops once its side is odd. Power of two tiles go all
+/// the way down to 1x1
+uint32_t atlasBake_levelCount(const uint32_t TILE_PX);
+
+/// @brief False when the tile size or grid is 0, or the tile is too big to address
+bool atlasBake_layout_get(const uint32_t TILE_PX, const uint32_t TILES_X, const uint32_t TILES_Y, AtlasBakeLayout_t *pLayout);
+
+/// @brief Copies every tile of pSRC (tilesX * tilePx wide, RGBA8 sRGB) into its own layer, then builds each following level by
+/// averaging the one above it in linear space. pDst must hold pLAYOUT->totalSize bytes
+void atlasBake_bake(const uint8_t *restrict pSRC, const AtlasBakeLayout_t *restrict pLAYOUT, uint8_t *restrict pDst);
+
+/// @brief Checks that a cache header belongs to this bake version, source and tile size
+bool atlasBake_header_valid(const AtlasBakeHeader_t *pHEADER, const uint64_t SOURCE_HASH, const uint32_t TILE_PX);
+
+/// @brief Opens the cache when it was baked from SOURCE_HASH with this tile size and fills pLayout from it. The file is left at
+/// the level data for atlasBake_cache_read. NULL when there's no usable cache
+FILE *atlasBake_cache_open(const uint64_t SOURCE_HASH, const uint32_t TILE_PX, AtlasBakeLayout_t *pLayout);
+
+/// @brief Reads the level data into pDst and closes the file
+bool atlasBake_cache_read(FILE *pFile, const AtlasBakeLayout_t *restrict pLAYOUT, void *restrict pDst);
+
+/// @brief Writes the baked atlas to the config folder. Failing only costs the next launch a bake
+void atlasBake_cache_write(const uint64_t SOURCE_HASH, const AtlasBakeLayout_t *restrict pLAYOUT, const void *restrict pDATA);
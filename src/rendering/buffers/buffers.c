@@ -1,10 +1,10 @@
 #include <vulkan/vulkan.h>
 #include "core/logs.h"
-#include "core/vk_instance.h"
 #include "rendering/buffers/command_buffer.h"
+#include "rendering/memory/gpuAllocator.h"
 
 void bufferCreate(State_t *state, VkDeviceSize bufferSize, VkBufferUsageFlags usageFlags, VkMemoryPropertyFlags propertyFlags,
-                  VkBuffer *buffer, VkDeviceMemory *bufferMemory)
+                  VkBuffer *buffer, GpuAllocation_t *pAllocation)
 {
     VkBufferCreateInfo createInfo = {
         .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
@@ -20,20 +20,26 @@ void bufferCreate(State_t *state, VkDeviceSize bufferSize, VkBufferUsageFlags us
     VkMemoryRequirements memoryRequirements;
     vkGetBufferMemoryRequirements(state->context.device, *buffer, &memoryRequirements);
 
-    uint32_t memoryType = vulkan_device_physicalMemoryType_get(state, memoryRequirements.memoryTypeBits, propertyFlags);
+    if (!gpuAllocator_allocate(state, &memoryRequirements, propertyFlags, pAllocation))
+    {
+        logs_log(LOG_ERROR, "Failed to allocate buffer memory!");
+        return;
+    }
 
-    VkMemoryAllocateInfo allocateInfo = {
-        .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
-        .allocationSize = memoryRequirements.size,
-        .memoryTypeIndex = memoryType,
-    };
+    // The allocator already aligned the offset to memoryRequirements.alignment
+    logs_logIfError(vkBindBufferMemory(state->context.device, *buffer, pAllocation->memory, pAllocation->offset),
+                    "Failed to bind buffer memory!");
+}
 
-    logs_logIfError(vkAllocateMemory(state->context.device, &allocateInfo, state->context.pAllocator, bufferMemory),
-                    "Failed to allocate buffer memory!");
+void bufferDestroy(State_t *state, VkBuffer *buffer, GpuAllocation_t *pAllocation)
+{
+    if (buffer && *buffer != VK_NULL_HANDLE)
+    {
+        vkDestroyBuffer(state->context.device, *buffer, state->context.pAllocator);
+        *buffer = VK_NULL_HANDLE;
+    }
 
-    // No offset required. If there was an offset, it would have to be divisible by memoryRequirements.alignment
-    logs_logIfError(vkBindBufferMemory(state->context.device, *buffer, *bufferMemory, 0),
-                    "Failed to bind buffer memory!");
+    gpuAllocator_free(state, pAllocation);
 }
 
 void bufferCopy(State_t *state, VkBuffer sourceBuffer, VkBuffer destinationBuffer, VkDeviceSize size)
@@ -79,3 +85,13 @@ void bufferCopyToImage(State_t *state, VkBuffer buffer, VkImage image, uint32_t
 
     commandBuffer_singleTime_end(state, commandBuffer);
 }
+
+void bufferCopyToImageRegions(State_t *state, VkBuffer buffer, VkImage image, const VkBufferImageCopy *pREGIONS, uint32_t regionCount)
+{
+    if (!pREGIONS || regionCount == 0)
+        return;
+
+    VkCommandBuffer commandBuffer = commandBuffer_singleTime_start(state);
+    vkCmdCopyBufferToImage(commandBuffer, buffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, regionCount, pREGIONS);
+    commandBuffer_singleTime_end(state, commandBuffer);
+}
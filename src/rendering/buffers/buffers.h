@@ -3,10 +3,19 @@
 #include <vulkan/vulkan.h>
 #include "core/types/state_t.h"
 #include "rendering/buffers/command_buffer.h"
+#include "rendering/types/gpuAllocation_t.h"
 
+/// @brief Creates the buffer and binds it to memory sub-allocated from the GPU allocator. Host visible memory comes back
+/// already mapped in pAllocation->pMapped.
 void bufferCreate(State_t *state, VkDeviceSize bufferSize, VkBufferUsageFlags usageFlags, VkMemoryPropertyFlags propertyFlags,
-                  VkBuffer *buffer, VkDeviceMemory *bufferMemory);
+                  VkBuffer *buffer, GpuAllocation_t *pAllocation);
+
+/// @brief Destroys the buffer and returns its memory to the GPU allocator. Both are reset to null
+void bufferDestroy(State_t *state, VkBuffer *buffer, GpuAllocation_t *pAllocation);
 
 void bufferCopy(State_t *state, VkBuffer sourceBuffer, VkBuffer destinationBuffer, VkDeviceSize size);
 
 void bufferCopyToImage(State_t *state, VkBuffer buffer, VkImage image, uint32_t width, uint32_t height);
+
+/// @brief Copies every region in one submit, such as all the mip levels of an image. The image must be in TRANSFER_DST_OPTIMAL
+void bufferCopyToImageRegions(State_t *state, VkBuffer buffer, VkImage image, const VkBufferImageCopy *pREGIONS, uint32_t regionCount);
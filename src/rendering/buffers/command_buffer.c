@@ -12,43 +12,59 @@
 #include "rendering/types/graphicsPipeline_t.h"
 #include "rendering/chunk/chunkRendering.h"
 #include "scene/scene.h"
+#include "rendering/renderQueue.h"
+#include "rendering/gpuProfiler.h"
+#include "rendering/buffers/command_buffer.h"
+#include "rendering/buffers/secondary_command_buffer.h"
+#pragma endregion
+#pragma region Defines
+#if defined(DEBUG)
+// #define DEBUG_RENDER_QUEUE
+#endif
 #pragma endregion
 #pragma region Binding
-static void pipeline_bind(State_t *pState, VkCommandBuffer *pCmd, VkPipelineLayout *pPipelineLayout, const GraphicsTarget_e TARGET)
+void commandBuffer_pipeline_bind(const State_t *restrict pSTATE, VkCommandBuffer cmd, VkPipelineLayout *restrict pPipelineLayout,
+                                 const GraphicsTarget_e TARGET, RenderFrameStats_t *restrict pStats)
 {
-    if (!pState || !pCmd || !pPipelineLayout)
+    if (!pSTATE || cmd == VK_NULL_HANDLE || !pPipelineLayout || !pStats)
         return;
 
     // Bind the render pipeline to the active graphics pipeline (instead of compute)
     VkPipeline pPipelines[GRAPHICS_PIPELINE_COUNT];
     VkPipelineLayout pPipelineLayouts[GRAPHICS_PIPELINE_COUNT];
-    switch (pState->renderer.activeGraphicsPipeline)
+    switch (pSTATE->renderer.activeGraphicsPipeline)
     {
     case GRAPHICS_PIPELINE_VOXEL_FILL:
     case GRAPHICS_PIPELINE_MODEL_FILL:
-        pPipelines[GRAPHICS_TARGET_MODEL] = pState->renderer.graphicsPipelineFillModel;
-        pPipelineLayouts[GRAPHICS_TARGET_MODEL] = pState->renderer.pipelineLayoutFillModel;
-        pPipelines[GRAPHICS_TARGET_VOXEL] = pState->renderer.graphicsPipelineFillVoxel;
-        pPipelineLayouts[GRAPHICS_TARGET_VOXEL] = pState->renderer.pipelineLayoutFillVoxel;
+        pPipelines[GRAPHICS_TARGET_MODEL] = pSTATE->renderer.graphicsPipelineFillModel;
+        pPipelineLayouts[GRAPHICS_TARGET_MODEL] = pSTATE->renderer.pipelineLayoutFillModel;
+        pPipelines[GRAPHICS_TARGET_VOXEL] = pSTATE->renderer.graphicsPipelineFillVoxel;
+        pPipelineLayouts[GRAPHICS_TARGET_VOXEL] = pSTATE->renderer.pipelineLayoutFillVoxel;
         break;
     case GRAPHICS_PIPELINE_WIREFRAME:
-        pPipelines[GRAPHICS_TARGET_MODEL] = pState->renderer.graphicsPipelineWireframeModel;
-        pPipelineLayouts[GRAPHICS_TARGET_MODEL] = pState->renderer.pipelineLayoutWireframeModel;
-        pPipelines[GRAPHICS_TARGET_VOXEL] = pState->renderer.graphicsPipelineWireframeVoxel;
-        pPipelineLayouts[GRAPHICS_TARGET_VOXEL] = pState->renderer.pipelineLayoutWireframeVoxel;
+        pPipelines[GRAPHICS_TARGET_MODEL] = pSTATE->renderer.graphicsPipelineWireframeModel;
+        pPipelineLayouts[GRAPHICS_TARGET_MODEL] = pSTATE->renderer.pipelineLayoutWireframeModel;
+        pPipelines[GRAPHICS_TARGET_VOXEL] = pSTATE->renderer.graphicsPipelineWireframeVoxel;
+        pPipelineLayouts[GRAPHICS_TARGET_VOXEL] = pSTATE->renderer.pipelineLayoutWireframeVoxel;
         break;
     }
 
     *pPipelineLayout = pPipelineLayouts[TARGET];
-    vkCmdBindPipeline(*pCmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pPipelines[TARGET]);
+    vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pPipelines[TARGET]);
+    pStats->pipelineBinds++;
+
+    // Models all share one set too, picking their texture out of its table with a push constant
+    const VkDescriptorSet *pSETS = TARGET == GRAPHICS_TARGET_MODEL ? pSTATE->renderer.pModelDescriptorSets
+                                                                   : pSTATE->renderer.pDescriptorSets;
 
     const uint32_t FIRST_DESC_SET = 0;
     const uint32_t DESC_SET_COUNT = 1;
     const uint32_t DYNAMIC_OFFSET_COUNT = 0;
     const uint32_t *pDYNAMIC_OFFSETS = VK_NULL_HANDLE;
-    vkCmdBindDescriptorSets(*pCmd, VK_PIPELINE_BIND_POINT_GRAPHICS, *pPipelineLayout,
-                            FIRST_DESC_SET, DESC_SET_COUNT, &pState->renderer.pDescriptorSets[pState->renderer.currentFrame],
+    vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, *pPipelineLayout,
+                            FIRST_DESC_SET, DESC_SET_COUNT, &pSETS[pSTATE->renderer.currentFrame],
                             DYNAMIC_OFFSET_COUNT, pDYNAMIC_OFFSETS);
+    pStats->descriptorSetBinds++;
 }
 #pragma endregion
 #pragma region Record
@@ -75,6 +91,7 @@ void commandBuffer_record(State_t *pState)
         .flags = 0};
 
     const uint32_t FRAME_INDEX = pState->renderer.currentFrame;
+    pState->renderer.frameStats = (RenderFrameStats_t){0};
 
     int crashLine = 0;
     do
@@ -103,6 +120,10 @@ void commandBuffer_record(State_t *pState)
             break;
         }
 
+        // Query resets can't go inside the render pass
+        gpuProfiler_frame_begin(pState, cmd);
+        gpuProfiler_scope_begin(pState, cmd, GPU_PROFILER_SCOPE_FRAME);
+
         // ALL vkCmd functions (commands) MUST go between the begin and end command buffer functions (obviously)
         const VkRenderPassBeginInfo RP_BEGIN_INFO = {
             .sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
@@ -114,49 +135,57 @@ void commandBuffer_record(State_t *pState)
         };
 
 #pragma region Render Pass Begin
-        // If secondary command buffers are used, use VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS
-        vkCmdBeginRenderPass(cmd, &RP_BEGIN_INFO, VK_SUBPASS_CONTENTS_INLINE);
-
-        // Required because the viewport is dynamic (resizeable)
-        const VkViewport VIEWPORT = {
-            .x = 0.0F,
-            .y = 0.0F,
-            .width = (float)pState->window.swapchain.imageExtent.width,
-            .height = (float)pState->window.swapchain.imageExtent.height,
-            .minDepth = 0.0F,
-            .maxDepth = 1.0F};
-        const uint32_t FIRST_VIEWPORT = 0;
-        const uint32_t VIEWPORT_COUNT = 1;
-        vkCmdSetViewport(cmd, FIRST_VIEWPORT, VIEWPORT_COUNT, &VIEWPORT);
-
-        const VkRect2D SCISSOR = {
-            .offset = {0, 0},
-            .extent = pState->window.swapchain.imageExtent};
-        const uint32_t FIRST_SCISSOR = 0;
-        const uint32_t SCISSOR_COUNT = 1;
-        vkCmdSetScissor(cmd, FIRST_SCISSOR, SCISSOR_COUNT, &SCISSOR);
+        // Every draw is recorded into secondaries, chunks across the thread pool, so the pass only executes them
+        vkCmdBeginRenderPass(cmd, &RP_BEGIN_INFO, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+
+        VkCommandBuffer pSecondaries[SECONDARY_COMMAND_BUFFER_MAX_SLOTS];
+        uint32_t secondaryCount = 0;
 
         // DRAW ! ! ! ! !
+        // Pipelines go in sort key order. Terrain first, since it covers most of the screen and fills the depth buffer that lets
+        // models behind it skip shading
+        // The last slot is left for the models
+        secondaryCount += chunkRendering_drawChunks(pState, pSecondaries, SECONDARY_COMMAND_BUFFER_MAX_SLOTS - 1);
+
+        if (pState->scene.batchCount > 0)
         {
             // Models
-            VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
-            pipeline_bind(pState, &cmd, &pipelineLayout, GRAPHICS_TARGET_MODEL);
-            scene_drawModels(pState, &cmd, &pipelineLayout);
-        }
+            VkCommandBuffer modelCmd = secondaryCommandBuffers_begin(pState, SECONDARY_COMMAND_BUFFER_SLOT_MODELS, false);
+            if (modelCmd == VK_NULL_HANDLE)
+            {
+                crashLine = __LINE__;
+                logs_log(LOG_ERROR, "Failed to begin the model secondary command buffer for frame %" PRIu32 "!", FRAME_INDEX);
+                break;
+            }
 
-        {
-            // Voxel
             VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
-            pipeline_bind(pState, &cmd, &pipelineLayout, GRAPHICS_TARGET_VOXEL);
-            chunkRendering_drawChunks(pState, &cmd, &pipelineLayout);
+            gpuProfiler_scope_begin(pState, modelCmd, GPU_PROFILER_SCOPE_MODELS);
+            commandBuffer_pipeline_bind(pState, modelCmd, &pipelineLayout, GRAPHICS_TARGET_MODEL, &pState->renderer.frameStats);
+            scene_drawModels(pState, &modelCmd, &pipelineLayout);
+            gpuProfiler_scope_end(pState, modelCmd, GPU_PROFILER_SCOPE_MODELS);
+
+            if (!secondaryCommandBuffers_end(modelCmd))
+            {
+                crashLine = __LINE__;
+                logs_log(LOG_ERROR, "An error occured while recording the model secondary command buffer for frame %" PRIu32 "!",
+                         FRAME_INDEX);
+                break;
+            }
+
+            pSecondaries[secondaryCount++] = modelCmd;
         }
 
+        if (secondaryCount > 0)
+            vkCmdExecuteCommands(cmd, secondaryCount, pSecondaries);
+
 #pragma endregion
 #pragma region Render Pass End
         // Must end the render pass if has begun (obviously)
         vkCmdEndRenderPass(cmd);
 #pragma endregion
 
+        gpuProfiler_scope_end(pState, cmd, GPU_PROFILER_SCOPE_FRAME);
+
         // All errors generated from vkCmd functions will populate here. The vkCmd functions themselves are all void.
         if (vkEndCommandBuffer(cmd) != VK_SUCCESS)
         {
@@ -164,6 +193,10 @@ void commandBuffer_record(State_t *pState)
             logs_log(LOG_ERROR, "An error occured during execution of the command buffer for frame %" PRIu32 "!",
                      FRAME_INDEX);
         }
+
+#if defined(DEBUG_RENDER_QUEUE)
+        renderQueue_stats_log(&pState->renderer.frameStats);
+#endif
     } while (0);
 
     if (crashLine != 0)
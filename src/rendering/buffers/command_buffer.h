@@ -2,6 +2,13 @@
 
 #include <vulkan/vulkan.h>
 #include "core/types/state_t.h"
+#include "rendering/types/graphicsPipeline_t.h"
+#include "rendering/types/renderFrameStats_t.h"
+
+/// @brief Binds the active pipeline for TARGET and, for voxels, the frame's shared descriptor set. The binds are counted in pStats,
+/// so each recording thread can count into its own
+void commandBuffer_pipeline_bind(const State_t *restrict pSTATE, VkCommandBuffer cmd, VkPipelineLayout *restrict pPipelineLayout,
+                                 const GraphicsTarget_e TARGET, RenderFrameStats_t *restrict pStats);
 
 /// @brief Record the command buffer for the current frame
 void commandBuffer_record(State_t *pState);
@@ -0,0 +1,189 @@
+#pragma region Includes
+#include <stdlib.h>
+#include <vulkan/vulkan.h>
+#include "core/logs.h"
+#include "core/crash_handler.h"
+#include "core/types/state_t.h"
+#include "threading/threadPool.h"
+#include "rendering/buffers/secondary_command_buffer.h"
+#pragma endregion
+#pragma region Defines
+typedef struct SecondaryCommandSlot_t
+{
+    VkCommandPool pool;
+    VkCommandBuffer cmd;
+} SecondaryCommandSlot_t;
+
+typedef struct SecondaryCommandBuffers_t
+{
+    // frameCount * slotCount, grouped by frame
+    SecondaryCommandSlot_t *pSlots;
+    uint32_t frameCount;
+    uint32_t slotCount;
+} SecondaryCommandBuffers_t;
+#pragma endregion
+#pragma region Record
+uint32_t secondaryCommandBuffers_slotCount(const State_t *pSTATE)
+{
+    if (!pSTATE || !pSTATE->renderer.pSecondaryCommandBuffers)
+        return 0;
+
+    return pSTATE->renderer.pSecondaryCommandBuffers->slotCount;
+}
+
+VkCommandBuffer secondaryCommandBuffers_begin(State_t *pState, const uint32_t SLOT, const bool REUSABLE)
+{
+    if (!pState || !pState->renderer.pSecondaryCommandBuffers)
+        return VK_NULL_HANDLE;
+
+    const SecondaryCommandBuffers_t *pBUFFERS = pState->renderer.pSecondaryCommandBuffers;
+    if (SLOT >= pBUFFERS->slotCount || pState->window.swapchain.imageAcquiredIndex >= pState->renderer.framebufferCount)
+        return VK_NULL_HANDLE;
+
+    const uint32_t FRAME = pState->renderer.currentFrame % pBUFFERS->frameCount;
+    const SecondaryCommandSlot_t *pSLOT = &pBUFFERS->pSlots[FRAME * pBUFFERS->slotCount + SLOT];
+
+    // Resetting the whole pool hands its memory back in one go instead of buffer by buffer
+    if (vkResetCommandPool(pState->context.device, pSLOT->pool, 0) != VK_SUCCESS)
+    {
+        logs_log(LOG_ERROR, "Failed to reset secondary command pool %u for frame %u!", SLOT, FRAME);
+        return VK_NULL_HANDLE;
+    }
+
+    const VkCommandBufferInheritanceInfo INHERITANCE_INFO = {
+        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO,
+        .renderPass = pState->renderer.pRenderPass,
+        .subpass = 0,
+        // The framebuffer is only a hint, and naming it would tie a reused secondary to one swapchain image
+        .framebuffer = REUSABLE ? VK_NULL_HANDLE : pState->renderer.pFramebuffers[pState->window.swapchain.imageAcquiredIndex],
+    };
+
+    const VkCommandBufferUsageFlags ONE_TIME = REUSABLE ? 0 : VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    const VkCommandBufferBeginInfo BEGIN_INFO = {
+        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+        .flags = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT | ONE_TIME,
+        .pInheritanceInfo = &INHERITANCE_INFO,
+    };
+
+    if (vkBeginCommandBuffer(pSLOT->cmd, &BEGIN_INFO) != VK_SUCCESS)
+    {
+        logs_log(LOG_ERROR, "Failed to begin secondary command buffer %u for frame %u!", SLOT, FRAME);
+        return VK_NULL_HANDLE;
+    }
+
+    // Dynamic state isn't inherited from the primary, so every secondary sets its own
+    const VkViewport VIEWPORT = {
+        .x = 0.0F,
+        .y = 0.0F,
+        .width = (float)pState->window.swapchain.imageExtent.width,
+        .height = (float)pState->window.swapchain.imageExtent.height,
+        .minDepth = 0.0F,
+        .maxDepth = 1.0F};
+    vkCmdSetViewport(pSLOT->cmd, 0, 1, &VIEWPORT);
+
+    const VkRect2D SCISSOR = {
+        .offset = {0, 0},
+        .extent = pState->window.swapchain.imageExtent};
+    vkCmdSetScissor(pSLOT->cmd, 0, 1, &SCISSOR);
+
+    return pSLOT->cmd;
+}
+
+bool secondaryCommandBuffers_end(VkCommandBuffer cmd)
+{
+    return cmd != VK_NULL_HANDLE && vkEndCommandBuffer(cmd) == VK_SUCCESS;
+}
+#pragma endregion
+#pragma region Create/Destroy
+void secondaryCommandBuffers_create(State_t *pState)
+{
+    int crashLine = 0;
+    do
+    {
+        SecondaryCommandBuffers_t *pBuffers = calloc(1, sizeof(SecondaryCommandBuffers_t));
+        if (!pBuffers)
+        {
+            crashLine = __LINE__;
+            break;
+        }
+
+        // Hooked up first so destroy can clean up a partially created set
+        pState->renderer.pSecondaryCommandBuffers = pBuffers;
+
+        // Every worker plus the main thread can take a share of the chunks, and the models get their own
+        const uint32_t RECORDING_THREADS = (pState->pThreadPool ? threadPool_threadCount(pState->pThreadPool) : 0) + 1;
+        const uint32_t SLOT_COUNT = SECONDARY_COMMAND_BUFFER_SLOT_CHUNKS_FIRST + RECORDING_THREADS;
+        pBuffers->slotCount = SLOT_COUNT < SECONDARY_COMMAND_BUFFER_MAX_SLOTS ? SLOT_COUNT : SECONDARY_COMMAND_BUFFER_MAX_SLOTS;
+        pBuffers->frameCount = pState->config.maxFramesInFlight;
+        pBuffers->pSlots = calloc((size_t)pBuffers->frameCount * pBuffers->slotCount, sizeof(SecondaryCommandSlot_t));
+        if (!pBuffers->pSlots)
+        {
+            crashLine = __LINE__;
+            break;
+        }
+
+        const VkCommandPoolCreateInfo POOL_INFO = {
+            .sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
+            .queueFamilyIndex = pState->context.queueFamily,
+            // Rerecorded every frame, and reset as a whole rather than per buffer
+            .flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT,
+        };
+
+        for (uint32_t i = 0; i < pBuffers->frameCount * pBuffers->slotCount; i++)
+        {
+            SecondaryCommandSlot_t *pSlot = &pBuffers->pSlots[i];
+            if (vkCreateCommandPool(pState->context.device, &POOL_INFO, pState->context.pAllocator, &pSlot->pool) != VK_SUCCESS)
+            {
+                crashLine = __LINE__;
+                logs_log(LOG_ERROR, "Failed to create secondary command pool %u!", i);
+                break;
+            }
+
+            const VkCommandBufferAllocateInfo ALLOCATE_INFO = {
+                .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+                .commandPool = pSlot->pool,
+                .level = VK_COMMAND_BUFFER_LEVEL_SECONDARY,
+                .commandBufferCount = 1,
+            };
+
+            if (vkAllocateCommandBuffers(pState->context.device, &ALLOCATE_INFO, &pSlot->cmd) != VK_SUCCESS)
+            {
+                crashLine = __LINE__;
+                logs_log(LOG_ERROR, "Failed to allocate secondary command buffer %u!", i);
+                break;
+            }
+        }
+
+        if (crashLine != 0)
+            break;
+
+        logs_log(LOG_DEBUG, "Created %u secondary command buffer slots for each of %u frames in flight.", pBuffers->slotCount,
+                 pBuffers->frameCount);
+    } while (0);
+
+    if (crashLine != 0)
+        crashHandler_crash_graceful(CRASH_LOCATION_LINE(crashLine),
+                                    "The program cannot continue without secondary command buffers to record draws into.");
+}
+
+void secondaryCommandBuffers_destroy(State_t *pState)
+{
+    if (!pState || !pState->renderer.pSecondaryCommandBuffers)
+        return;
+
+    SecondaryCommandBuffers_t *pBuffers = pState->renderer.pSecondaryCommandBuffers;
+    if (pBuffers->pSlots)
+    {
+        // Destroying a pool frees the buffers allocated from it
+        for (uint32_t i = 0; i < pBuffers->frameCount * pBuffers->slotCount; i++)
+        {
+            if (pBuffers->pSlots[i].pool != VK_NULL_HANDLE)
+                vkDestroyCommandPool(pState->context.device, pBuffers->pSlots[i].pool, pState->context.pAllocator);
+        }
+    }
+
+    free(pBuffers->pSlots);
+    free(pBuffers);
+    pState->renderer.pSecondaryCommandBuffers = NULL;
+}
+#pragma endregion
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <vulkan/vulkan.h>
+#include "core/types/state_t.h"
+
+// Most secondaries a frame can record. One is the models', the rest are for chunk draws
+#define SECONDARY_COMMAND_BUFFER_MAX_SLOTS 16
+#define SECONDARY_COMMAND_BUFFER_SLOT_MODELS 0
+#define SECONDARY_COMMAND_BUFFER_SLOT_CHUNKS_FIRST 1
+
+/// @brief Slots in use, models included. Chunk draws may spread over the slots from SECONDARY_COMMAND_BUFFER_SLOT_CHUNKS_FIRST up
+uint32_t secondaryCommandBuffers_slotCount(const State_t *pSTATE);
+
+/// @brief Resets SLOT's pool for the current frame and begins its secondary inside the render pass, with the viewport and scissor
+/// already set. A REUSABLE one isn't tied to the swapchain image and may be executed again in later frames of the same frame slot
+/// until it is begun again. Returns VK_NULL_HANDLE on failure. Safe from any thread as long as no two threads use the same slot at
+/// once. The current frame's fence must have been waited on.
+VkCommandBuffer secondaryCommandBuffers_begin(State_t *pState, const uint32_t SLOT, const bool REUSABLE);
+
+/// @brief False when the driver reported an error while recording
+bool secondaryCommandBuffers_end(VkCommandBuffer cmd);
+
+/// @brief One command pool per slot per frame in flight, so every thread records into a pool nobody else touches
+void secondaryCommandBuffers_create(State_t *pState);
+
+void secondaryCommandBuffers_destroy(State_t *pState);
@@ -0,0 +1,615 @@
+#pragma region Includes
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <vulkan/vulkan.h>
+#include "core/logs.h"
+#include "core/crash_handler.h"
+#include "rendering/buffers/buffers.h"
+#include "rendering/buffers/staging_ring.h"
+#include "rendering/gpuProfiler.h"
+#pragma endregion
+#pragma region Defines
+#if defined(DEBUG)
+// #define DEBUG_STAGING_RING
+#endif
+// Fits the largest possible chunk mesh (~4.5 MiB) with room to spare
+#define SLICE_SIZE ((VkDeviceSize)8 * 1024 * 1024)
+// Keeps every copy source on a friendly boundary for the transfer engine
+#define COPY_ALIGNMENT ((VkDeviceSize)16)
+#define DEFAULT_COPY_CAPACITY 64
+
+/// @brief One host visible buffer split into a slice per frame in flight. Writes go to the current slice and the copies out of it
+/// are batched until the next flush. Each flush is numbered (its serial) and signals the slice's fence when the GPU is done.
+typedef struct StagingRing_t
+{
+    VkBuffer buffer;
+    GpuAllocation_t allocation;
+    // Bytes used in the current slice
+    VkDeviceSize head;
+    // Serial of the last flush submitted, and of the last one known to have finished
+    uint64_t submittedSerial;
+    uint64_t completedSerial;
+    // Per slice: the serial of its last flush, the frame it was flushed on, the fence that flush signals, and the command buffer
+    // its copies were recorded into
+    uint64_t *pSliceSerials;
+    uint64_t *pSliceFrames;
+    VkFence *pFences;
+    VkCommandBuffer *pCommandBuffers;
+    // Only with a dedicated transfer queue: the graphics side command buffers that acquire what the copies released, and the
+    // semaphores that order them after the copies
+    VkCommandBuffer *pAcquireCommandBuffers;
+    VkSemaphore *pSemaphores;
+    // Transfer family pool. VK_NULL_HANDLE when copies run on the graphics queue
+    VkCommandPool transferCommandPool;
+    // Parallel arrays so runs of copies into the same buffer can be handed to vkCmdCopyBuffer as is
+    VkBuffer *pDestinations;
+    VkBufferCopy *pRegions;
+    // Ownership transfer barriers, one per copy. Scratch space rebuilt every flush
+    VkBufferMemoryBarrier *pBarriers;
+    StagingRingStats_t stats;
+    uint32_t copyCount;
+    uint32_t copyCapacity;
+    uint32_t sliceCount;
+    uint32_t slice;
+} StagingRing_t;
+#pragma endregion
+#pragma region Stats
+/// @brief Records how many frames passed between flushing SLICE and seeing it finish
+static void stagingRing_latency_record(const State_t *restrict pSTATE, StagingRing_t *restrict pRing, const uint32_t SLICE)
+{
+    const uint64_t FRAMES = pSTATE->renderer.frameNumber - pRing->pSliceFrames[SLICE];
+    pRing->stats.latencyFramesTotal += FRAMES;
+    pRing->stats.completedFlushCount++;
+    if (FRAMES > pRing->stats.latencyFramesMax)
+        pRing->stats.latencyFramesMax = FRAMES;
+}
+
+StagingRingStats_t stagingRing_stats_get(const State_t *pSTATE)
+{
+    if (!pSTATE || !pSTATE->renderer.pStagingRing)
+        return (StagingRingStats_t){0};
+
+    return pSTATE->renderer.pStagingRing->stats;
+}
+
+void stagingRing_stats_log(const State_t *pSTATE)
+{
+    const StagingRingStats_t STATS = stagingRing_stats_get(pSTATE);
+    const double AVERAGE = STATS.completedFlushCount ? (double)STATS.latencyFramesTotal / (double)STATS.completedFlushCount : 0.0;
+
+    logs_log(LOG_DEBUG, "Staging ring (%s queue): %" PRIu64 " flushes, %" PRIu64 " copies, %" PRIu64 " bytes. Upload latency %.2f frames "
+                        "average, %" PRIu64 " max.",
+             STATS.dedicatedTransferQueue ? "transfer" : "graphics", STATS.flushCount, STATS.copyCount, STATS.bytesUploaded,
+             AVERAGE, STATS.latencyFramesMax);
+}
+#pragma endregion
+#pragma region Operations
+static bool stagingRing_copies_grow(StagingRing_t *pRing)
+{
+    const uint32_t NEW_CAPACITY = pRing->copyCapacity ? pRing->copyCapacity * 2 : DEFAULT_COPY_CAPACITY;
+
+    VkBuffer *pNewDestinations = realloc(pRing->pDestinations, sizeof(VkBuffer) * NEW_CAPACITY);
+    if (!pNewDestinations)
+        return false;
+    pRing->pDestinations = pNewDestinations;
+
+    VkBufferCopy *pNewRegions = realloc(pRing->pRegions, sizeof(VkBufferCopy) * NEW_CAPACITY);
+    if (!pNewRegions)
+        return false;
+    pRing->pRegions = pNewRegions;
+
+    VkBufferMemoryBarrier *pNewBarriers = realloc(pRing->pBarriers, sizeof(VkBufferMemoryBarrier) * NEW_CAPACITY);
+    if (!pNewBarriers)
+        return false;
+    pRing->pBarriers = pNewBarriers;
+
+    pRing->copyCapacity = NEW_CAPACITY;
+    return true;
+}
+
+void *stagingRing_reserve(State_t *pState, VkBuffer destination, const VkDeviceSize DESTINATION_OFFSET, const VkDeviceSize SIZE)
+{
+    if (!pState || !pState->renderer.pStagingRing || destination == VK_NULL_HANDLE || SIZE == 0)
+        return NULL;
+
+    StagingRing_t *pRing = pState->renderer.pStagingRing;
+    if (SIZE > SLICE_SIZE)
+    {
+        logs_log(LOG_ERROR, "A %" PRIu64 " byte upload doesn't fit in a staging ring slice!", (uint64_t)SIZE);
+        return NULL;
+    }
+
+    VkDeviceSize start = (pRing->head + COPY_ALIGNMENT - 1) & ~(COPY_ALIGNMENT - 1);
+    if (start + SIZE > SLICE_SIZE)
+    {
+        // Slice is full. Send off what is in it and carry on in the next one
+        stagingRing_flush(pState);
+        start = 0;
+    }
+
+    if (pRing->copyCount == pRing->copyCapacity && !stagingRing_copies_grow(pRing))
+    {
+        logs_log(LOG_ERROR, "Failed to grow the staging ring's copy list!");
+        return NULL;
+    }
+
+    const VkDeviceSize RING_OFFSET = SLICE_SIZE * pRing->slice + start;
+    pRing->pDestinations[pRing->copyCount] = destination;
+    pRing->pRegions[pRing->copyCount] = (VkBufferCopy){
+        .srcOffset = RING_OFFSET,
+        .dstOffset = DESTINATION_OFFSET,
+        .size = SIZE,
+    };
+    pRing->copyCount++;
+    pRing->head = start + SIZE;
+
+    return (uint8_t *)pRing->allocation.pMapped + RING_OFFSET;
+}
+
+/// @brief Blocks until SLICE's last flush has finished and readies its fence for reuse. Only waits when the ring wraps around
+/// faster than the GPU copies.
+static void stagingRing_slice_acquire(State_t *restrict pState, StagingRing_t *restrict pRing, const uint32_t SLICE)
+{
+    const uint64_t SERIAL = pRing->pSliceSerials[SLICE];
+    if (SERIAL == 0)
+        return;
+
+    if (SERIAL > pRing->completedSerial)
+    {
+        logs_logIfError(vkWaitForFences(pState->context.device, 1, &pRing->pFences[SLICE], VK_TRUE, UINT64_MAX),
+                        "Failed to wait for a staging ring fence!");
+        stagingRing_latency_record(pState, pRing, SLICE);
+        pRing->completedSerial = SERIAL;
+    }
+
+    logs_logIfError(vkResetFences(pState->context.device, 1, &pRing->pFences[SLICE]),
+                    "Failed to reset a staging ring fence!");
+    pRing->pSliceSerials[SLICE] = 0;
+}
+
+/// @brief Fills pBarriers with one ownership transfer per copy destination range, from the transfer family to the graphics
+/// family. The same barriers are recorded as the release on the transfer queue and as the acquire on the graphics queue.
+static void stagingRing_barriers_build(const State_t *restrict pSTATE, StagingRing_t *restrict pRing,
+                                       const VkAccessFlags SRC_ACCESS, const VkAccessFlags DST_ACCESS)
+{
+    for (uint32_t i = 0; i < pRing->copyCount; i++)
+    {
+        pRing->pBarriers[i] = (VkBufferMemoryBarrier){
+            .sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
+            .srcAccessMask = SRC_ACCESS,
+            .dstAccessMask = DST_ACCESS,
+            .srcQueueFamilyIndex = pSTATE->context.transferQueueFamily,
+            .dstQueueFamilyIndex = pSTATE->context.queueFamily,
+            .buffer = pRing->pDestinations[i],
+            .offset = pRing->pRegions[i].dstOffset,
+            .size = pRing->pRegions[i].size,
+        };
+    }
+}
+
+static bool stagingRing_commandBuffer_begin(VkCommandBuffer commandBuffer)
+{
+    const VkCommandBufferBeginInfo BEGIN_INFO = {
+        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+        .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+    };
+
+    return vkResetCommandBuffer(commandBuffer, 0) == VK_SUCCESS && vkBeginCommandBuffer(commandBuffer, &BEGIN_INFO) == VK_SUCCESS;
+}
+
+void stagingRing_flush(State_t *pState)
+{
+    if (!pState || !pState->renderer.pStagingRing)
+        return;
+
+    StagingRing_t *pRing = pState->renderer.pStagingRing;
+    if (pRing->copyCount == 0)
+        return;
+
+    const bool DEDICATED = pRing->transferCommandPool != VK_NULL_HANDLE;
+    const uint32_t SLICE = pRing->slice;
+
+    int crashLine = 0;
+    do
+    {
+        VkCommandBuffer commandBuffer = pRing->pCommandBuffers[SLICE];
+        if (!stagingRing_commandBuffer_begin(commandBuffer))
+        {
+            crashLine = __LINE__;
+            logs_log(LOG_ERROR, "Failed to begin the staging ring command buffer!");
+            break;
+        }
+
+        // Queries can only be reset on a graphics or compute queue, so uploads are only timed when they run on the graphics queue
+        if (!DEDICATED)
+            gpuProfiler_upload_begin(pState, commandBuffer, SLICE);
+
+        // One vkCmdCopyBuffer per run of copies going to the same buffer
+        uint32_t runStart = 0;
+        for (uint32_t i = 1; i <= pRing->copyCount; i++)
+        {
+            if (i < pRing->copyCount && pRing->pDestinations[i] == pRing->pDestinations[runStart])
+                continue;
+
+            vkCmdCopyBuffer(commandBuffer, pRing->buffer, pRing->pDestinations[runStart], i - runStart, &pRing->pRegions[runStart]);
+            runStart = i;
+        }
+
+        if (DEDICATED)
+        {
+            // Release the written ranges to the graphics family. The access that follows is up to the acquire
+            stagingRing_barriers_build(pState, pRing, VK_ACCESS_TRANSFER_WRITE_BIT, 0);
+            vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, NULL,
+                                 pRing->copyCount, pRing->pBarriers, 0, NULL);
+        }
+        else
+        {
+            // Makes the copies visible to the vertex input of every draw submitted after this
+            const VkMemoryBarrier BARRIER = {
+                .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+                .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+                .dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT,
+            };
+            vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, 0, 1, &BARRIER,
+                                 0, NULL, 0, NULL);
+            gpuProfiler_upload_end(pState, commandBuffer, SLICE);
+        }
+
+        if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS)
+        {
+            crashLine = __LINE__;
+            logs_log(LOG_ERROR, "Failed to end the staging ring command buffer!");
+            break;
+        }
+
+        if (!DEDICATED)
+        {
+            const VkSubmitInfo SUBMIT_INFO = {
+                .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+                .commandBufferCount = 1,
+                .pCommandBuffers = &commandBuffer,
+            };
+
+            // Nothing waits on the queue here. The fence says when the slice (and everything copied out of it) is done
+            if (vkQueueSubmit(pState->context.graphicsQueue, 1, &SUBMIT_INFO, pRing->pFences[SLICE]) != VK_SUCCESS)
+            {
+                crashLine = __LINE__;
+                logs_log(LOG_ERROR, "Failed to submit the staging ring copies!");
+                break;
+            }
+
+            // The graphics queue already owns what it copied
+            break;
+        }
+
+        // Copies run on the transfer queue next to rendering, then the graphics queue takes ownership of what they wrote
+        const VkSubmitInfo TRANSFER_SUBMIT_INFO = {
+            .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+            .commandBufferCount = 1,
+            .pCommandBuffers = &commandBuffer,
+            .signalSemaphoreCount = 1,
+            .pSignalSemaphores = &pRing->pSemaphores[SLICE],
+        };
+
+        if (vkQueueSubmit(pState->context.transferQueue, 1, &TRANSFER_SUBMIT_INFO, VK_NULL_HANDLE) != VK_SUCCESS)
+        {
+            crashLine = __LINE__;
+            logs_log(LOG_ERROR, "Failed to submit the staging ring copies to the transfer queue!");
+            break;
+        }
+
+        VkCommandBuffer acquireCommandBuffer = pRing->pAcquireCommandBuffers[SLICE];
+        if (!stagingRing_commandBuffer_begin(acquireCommandBuffer))
+        {
+            crashLine = __LINE__;
+            logs_log(LOG_ERROR, "Failed to begin the staging ring acquire command buffer!");
+            break;
+        }
+
+        stagingRing_barriers_build(pState, pRing, 0, VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT);
+        vkCmdPipelineBarrier(acquireCommandBuffer, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, 0, 0, NULL,
+                             pRing->copyCount, pRing->pBarriers, 0, NULL);
+
+        if (vkEndCommandBuffer(acquireCommandBuffer) != VK_SUCCESS)
+        {
+            crashLine = __LINE__;
+            logs_log(LOG_ERROR, "Failed to end the staging ring acquire command buffer!");
+            break;
+        }
+
+        const VkPipelineStageFlags WAIT_STAGE = VK_PIPELINE_STAGE_VERTEX_INPUT_BIT;
+        const VkSubmitInfo ACQUIRE_SUBMIT_INFO = {
+            .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+            .waitSemaphoreCount = 1,
+            .pWaitSemaphores = &pRing->pSemaphores[SLICE],
+            .pWaitDstStageMask = &WAIT_STAGE,
+            .commandBufferCount = 1,
+            .pCommandBuffers = &acquireCommandBuffer,
+        };
+
+        // The fence goes on the acquire, so a finished serial means the data is both copied and owned by the graphics queue
+        if (vkQueueSubmit(pState->context.graphicsQueue, 1, &ACQUIRE_SUBMIT_INFO, pRing->pFences[SLICE]) != VK_SUCCESS)
+        {
+            crashLine = __LINE__;
+            logs_log(LOG_ERROR, "Failed to submit the staging ring acquire!");
+            break;
+        }
+    } while (0);
+
+    if (crashLine != 0)
+        crashHandler_crash_graceful(CRASH_LOCATION_LINE(crashLine), "The program cannot continue without uploading to the GPU!");
+
+#if defined(DEBUG_STAGING_RING)
+    logs_log(LOG_DEBUG, "Flushed %" PRIu32 " staging copies (%" PRIu64 " bytes) from slice %" PRIu32 " as serial %" PRIu64 ".",
+             pRing->copyCount, (uint64_t)pRing->head, SLICE, pRing->submittedSerial + 1);
+#endif
+
+    pRing->stats.flushCount++;
+    pRing->stats.copyCount += pRing->copyCount;
+    for (uint32_t i = 0; i < pRing->copyCount; i++)
+        pRing->stats.bytesUploaded += pRing->pRegions[i].size;
+
+    pRing->pSliceSerials[SLICE] = ++pRing->submittedSerial;
+    pRing->pSliceFrames[SLICE] = pState->renderer.frameNumber;
+    pRing->copyCount = 0;
+    pRing->head = 0;
+    pRing->slice = (SLICE + 1) % pRing->sliceCount;
+
+    stagingRing_slice_acquire(pState, pRing, pRing->slice);
+}
+
+uint64_t stagingRing_serial_pending(const State_t *pSTATE)
+{
+    if (!pSTATE || !pSTATE->renderer.pStagingRing)
+        return 0;
+
+    return pSTATE->renderer.pStagingRing->submittedSerial + 1;
+}
+
+uint64_t stagingRing_serial_completed(State_t *pState)
+{
+    if (!pState || !pState->renderer.pStagingRing)
+        return 0;
+
+    StagingRing_t *pRing = pState->renderer.pStagingRing;
+    if (pRing->completedSerial == pRing->submittedSerial)
+        return pRing->completedSerial;
+
+    // Flushes finish in the order they were submitted, so everything before the oldest unfinished one is done
+    uint64_t completed = pRing->submittedSerial;
+    for (uint32_t i = 0; i < pRing->sliceCount; i++)
+    {
+        const uint64_t SERIAL = pRing->pSliceSerials[i];
+        if (SERIAL <= pRing->completedSerial || SERIAL > completed)
+            continue;
+
+        if (vkGetFenceStatus(pState->context.device, pRing->pFences[i]) != VK_SUCCESS)
+            completed = SERIAL - 1;
+    }
+
+    for (uint32_t i = 0; i < pRing->sliceCount; i++)
+    {
+        const uint64_t SERIAL = pRing->pSliceSerials[i];
+        if (SERIAL > pRing->completedSerial && SERIAL <= completed)
+            stagingRing_latency_record(pState, pRing, i);
+    }
+
+    pRing->completedSerial = completed;
+    return completed;
+}
+#pragma endregion
+#pragma region Create/Destroy
+/// @brief Sets up the command pool, acquire command buffers and semaphores the dedicated transfer queue needs
+static bool stagingRing_transfer_create(State_t *restrict pState, StagingRing_t *restrict pRing)
+{
+    const VkCommandPoolCreateInfo POOL_CREATE_INFO = {
+        .sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
+        .queueFamilyIndex = pState->context.transferQueueFamily,
+        // Each slice's command buffer is re-recorded every time the ring comes back around to it
+        .flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT,
+    };
+
+    if (vkCreateCommandPool(pState->context.device, &POOL_CREATE_INFO, pState->context.pAllocator,
+                            &pRing->transferCommandPool) != VK_SUCCESS)
+    {
+        logs_log(LOG_ERROR, "Failed to create the transfer command pool!");
+        return false;
+    }
+
+    pRing->pAcquireCommandBuffers = calloc(pRing->sliceCount, sizeof(VkCommandBuffer));
+    pRing->pSemaphores = calloc(pRing->sliceCount, sizeof(VkSemaphore));
+    if (!pRing->pAcquireCommandBuffers || !pRing->pSemaphores)
+        return false;
+
+    const VkCommandBufferAllocateInfo ACQUIRE_ALLOCATE_INFO = {
+        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+        .level = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+        .commandPool = pState->renderer.commandPool,
+        .commandBufferCount = pRing->sliceCount,
+    };
+
+    if (vkAllocateCommandBuffers(pState->context.device, &ACQUIRE_ALLOCATE_INFO, pRing->pAcquireCommandBuffers) != VK_SUCCESS)
+    {
+        logs_log(LOG_ERROR, "Failed to allocate the staging ring acquire command buffers!");
+        return false;
+    }
+
+    const VkSemaphoreCreateInfo SEMAPHORE_CREATE_INFO = {
+        .sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO,
+    };
+
+    for (uint32_t i = 0; i < pRing->sliceCount; i++)
+    {
+        if (vkCreateSemaphore(pState->context.device, &SEMAPHORE_CREATE_INFO, pState->context.pAllocator,
+                              &pRing->pSemaphores[i]) != VK_SUCCESS)
+        {
+            logs_log(LOG_ERROR, "Failed to create a staging ring semaphore!");
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/// @brief Releases whatever stagingRing_transfer_create made, even if it only got partway. Uploads then use the graphics queue
+static void stagingRing_transfer_destroy(State_t *restrict pState, StagingRing_t *restrict pRing)
+{
+    if (pRing->pSemaphores)
+    {
+        for (uint32_t i = 0; i < pRing->sliceCount; i++)
+        {
+            if (pRing->pSemaphores[i] != VK_NULL_HANDLE)
+                vkDestroySemaphore(pState->context.device, pRing->pSemaphores[i], pState->context.pAllocator);
+        }
+    }
+
+    if (pRing->pAcquireCommandBuffers && pRing->pAcquireCommandBuffers[0] != VK_NULL_HANDLE)
+        vkFreeCommandBuffers(pState->context.device, pState->renderer.commandPool, pRing->sliceCount, pRing->pAcquireCommandBuffers);
+
+    if (pRing->transferCommandPool != VK_NULL_HANDLE)
+        vkDestroyCommandPool(pState->context.device, pRing->transferCommandPool, pState->context.pAllocator);
+
+    free(pRing->pSemaphores);
+    free(pRing->pAcquireCommandBuffers);
+    pRing->pSemaphores = NULL;
+    pRing->pAcquireCommandBuffers = NULL;
+    pRing->transferCommandPool = VK_NULL_HANDLE;
+}
+
+void stagingRing_create(State_t *pState)
+{
+    int crashLine = 0;
+    do
+    {
+        StagingRing_t *pRing = calloc(1, sizeof(StagingRing_t));
+        if (!pRing)
+        {
+            crashLine = __LINE__;
+            break;
+        }
+
+        // Hooked up first so destroy can clean up a partially created ring
+        pState->renderer.pStagingRing = pRing;
+        pRing->sliceCount = pState->config.maxFramesInFlight ? pState->config.maxFramesInFlight : 1;
+
+        if (!stagingRing_copies_grow(pRing))
+        {
+            crashLine = __LINE__;
+            break;
+        }
+
+        pRing->pSliceSerials = calloc(pRing->sliceCount, sizeof(uint64_t));
+        pRing->pSliceFrames = calloc(pRing->sliceCount, sizeof(uint64_t));
+        pRing->pFences = calloc(pRing->sliceCount, sizeof(VkFence));
+        pRing->pCommandBuffers = calloc(pRing->sliceCount, sizeof(VkCommandBuffer));
+        if (!pRing->pSliceSerials || !pRing->pSliceFrames || !pRing->pFences || !pRing->pCommandBuffers)
+        {
+            crashLine = __LINE__;
+            break;
+        }
+
+        // Falls back to the graphics queue if the transfer queue can't be set up
+        if (pState->context.transferQueueFamily != pState->context.queueFamily && !stagingRing_transfer_create(pState, pRing))
+        {
+            logs_log(LOG_WARN, "Failed to set up transfer queue uploads. Falling back to the graphics queue.");
+            stagingRing_transfer_destroy(pState, pRing);
+        }
+        pRing->stats.dedicatedTransferQueue = pRing->transferCommandPool != VK_NULL_HANDLE;
+
+        const VkCommandBufferAllocateInfo ALLOCATE_INFO = {
+            .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+            .level = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+            .commandPool = pRing->stats.dedicatedTransferQueue ? pRing->transferCommandPool : pState->renderer.commandPool,
+            .commandBufferCount = pRing->sliceCount,
+        };
+
+        if (vkAllocateCommandBuffers(pState->context.device, &ALLOCATE_INFO, pRing->pCommandBuffers) != VK_SUCCESS)
+        {
+            crashLine = __LINE__;
+            logs_log(LOG_ERROR, "Failed to allocate the staging ring command buffers!");
+            break;
+        }
+
+        const VkFenceCreateInfo FENCE_CREATE_INFO = {
+            .sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO,
+        };
+
+        for (uint32_t i = 0; i < pRing->sliceCount && crashLine == 0; i++)
+        {
+            if (vkCreateFence(pState->context.device, &FENCE_CREATE_INFO, pState->context.pAllocator, &pRing->pFences[i]) != VK_SUCCESS)
+            {
+                crashLine = __LINE__;
+                logs_log(LOG_ERROR, "Failed to create a staging ring fence!");
+            }
+        }
+        if (crashLine != 0)
+            break;
+
+        bufferCreate(pState, SLICE_SIZE * pRing->sliceCount, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                     VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                     &pRing->buffer, &pRing->allocation);
+
+        if (!pRing->allocation.pMapped)
+        {
+            crashLine = __LINE__;
+            logs_log(LOG_ERROR, "Failed to map the staging ring!");
+            break;
+        }
+    } while (0);
+
+    if (crashLine != 0)
+        crashHandler_crash_graceful(CRASH_LOCATION_LINE(crashLine), "The program cannot continue without a staging ring!");
+}
+
+void stagingRing_destroy(State_t *pState)
+{
+    if (!pState || !pState->renderer.pStagingRing)
+        return;
+
+    StagingRing_t *pRing = pState->renderer.pStagingRing;
+    if (pRing->copyCount > 0)
+        logs_log(LOG_WARN, "Destroying the staging ring with %" PRIu32 " copies that were never flushed!", pRing->copyCount);
+
+    // Anything still copying has to finish before its command buffers and semaphores go away
+    if (pRing->transferCommandPool != VK_NULL_HANDLE)
+        logs_logIfError(vkQueueWaitIdle(pState->context.transferQueue),
+                        "Failed to wait for the transfer queue to idle!");
+
+#if defined(DEBUG_STAGING_RING)
+    stagingRing_stats_log(pState);
+#endif
+
+    // The queues are idle by now, so every fence has either signaled or was never submitted
+    if (pRing->pFences)
+    {
+        for (uint32_t i = 0; i < pRing->sliceCount; i++)
+        {
+            if (pRing->pFences[i] != VK_NULL_HANDLE)
+                vkDestroyFence(pState->context.device, pRing->pFences[i], pState->context.pAllocator);
+        }
+    }
+
+    // Transfer family command buffers go away with their pool
+    if (pRing->pCommandBuffers && pRing->pCommandBuffers[0] != VK_NULL_HANDLE && pRing->transferCommandPool == VK_NULL_HANDLE)
+        vkFreeCommandBuffers(pState->context.device, pState->renderer.commandPool, pRing->sliceCount, pRing->pCommandBuffers);
+    stagingRing_transfer_destroy(pState, pRing);
+
+    bufferDestroy(pState, &pRing->buffer, &pRing->allocation);
+    free(pRing->pSliceSerials);
+    free(pRing->pSliceFrames);
+    free(pRing->pFences);
+    free(pRing->pCommandBuffers);
+    free(pRing->pDestinations);
+    free(pRing->pRegions);
+    free(pRing->pBarriers);
+
+    free(pRing);
+    pState->renderer.pStagingRing = NULL;
+}
+#pragma endregion
+#pragma region Undefines
+#undef SLICE_SIZE
+#undef COPY_ALIGNMENT
+#undef DEFAULT_COPY_CAPACITY
+#pragma endregion
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <stdbool.h>
+#include <vulkan/vulkan.h>
+#include "core/types/state_t.h"
+
+typedef struct StagingRingStats_t
+{
+    uint64_t flushCount;
+    uint64_t copyCount;
+    uint64_t bytesUploaded;
+    // Frames between a flush and seeing it finish, summed over every finished flush, and the worst case
+    uint64_t latencyFramesTotal;
+    uint64_t latencyFramesMax;
+    uint64_t completedFlushCount;
+    // Copies run on a dedicated transfer queue rather than the graphics queue
+    bool dedicatedTransferQueue;
+} StagingRingStats_t;
+
+/// @brief Reserves SIZE bytes of the current frame's slice of the staging ring and queues a copy of them into DESTINATION at
+/// DESTINATION_OFFSET. Returns the persistently mapped bytes to write the data into, or NULL if SIZE can't fit in a slice.
+/// Flushes early if the slice is full. MAIN THREAD ONLY.
+void *stagingRing_reserve(State_t *pState, VkBuffer destination, const VkDeviceSize DESTINATION_OFFSET, const VkDeviceSize SIZE);
+
+/// @brief Records every queued copy into one command buffer and submits it without waiting, then moves on to the next slice.
+/// With a dedicated transfer queue the copies run there and the graphics queue acquires the written ranges. MAIN THREAD ONLY.
+void stagingRing_flush(State_t *pState);
+
+/// @brief Serial the copies being queued right now will be submitted under
+uint64_t stagingRing_serial_pending(const State_t *pSTATE);
+
+/// @brief Serial of the newest flush the GPU has finished. Every copy with a serial at or below it has landed.
+uint64_t stagingRing_serial_completed(State_t *pState);
+
+StagingRingStats_t stagingRing_stats_get(const State_t *pSTATE);
+
+void stagingRing_stats_log(const State_t *pSTATE);
+
+/// @brief Must be called after the GPU allocator and the command pool are created
+void stagingRing_create(State_t *pState);
+
+void stagingRing_destroy(State_t *pState);
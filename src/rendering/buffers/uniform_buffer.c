@@ -22,12 +22,19 @@ void uniformBuffer_update(State_t *pState)
             break;
         }
 
+        const Vec3i_t RENDER_ORIGIN = camera_renderOrigin_get(pState);
         const UniformBufferObject_t CAMERA_UBO = {
-            .view = camera_viewMatrix_get(pState),
-            .projection = camera_projectionMatrix_get(pState)};
+            .view = camera_viewMatrix_get(pState, RENDER_ORIGIN),
+            .projection = camera_projectionMatrix_get(pState),
+            .pRenderOrigin = {RENDER_ORIGIN.x, RENDER_ORIGIN.y, RENDER_ORIGIN.z, 0}};
 
         memcpy(pState->renderer.ppUniformBuffersMapped[pState->renderer.currentFrame], &CAMERA_UBO, sizeof(CAMERA_UBO));
 
+        // Culling has to use exactly what the shaders will see this frame, so it works relative to the same render origin
+        pState->renderer.renderOrigin = RENDER_ORIGIN;
+        pState->renderer.cameraFrustum =
+            cmath_frustum_fromViewProjection(cmath_mat_mult_mat(CAMERA_UBO.projection, CAMERA_UBO.view));
+
         return;
     } while (0);
 
@@ -43,9 +50,9 @@ void uniformBuffers_create(State_t *pState)
     do
     {
         pState->renderer.pUniformBuffers = malloc(sizeof(VkBuffer) * pState->config.maxFramesInFlight);
-        pState->renderer.pUniformBufferMemories = malloc(sizeof(VkDeviceMemory) * pState->config.maxFramesInFlight);
+        pState->renderer.pUniformBufferAllocations = calloc(pState->config.maxFramesInFlight, sizeof(GpuAllocation_t));
         pState->renderer.ppUniformBuffersMapped = malloc(sizeof(void *) * pState->config.maxFramesInFlight);
-        if (!pState->renderer.pUniformBuffers || !pState->renderer.pUniformBufferMemories || !pState->renderer.ppUniformBuffersMapped)
+        if (!pState->renderer.pUniformBuffers || !pState->renderer.pUniformBufferAllocations || !pState->renderer.ppUniformBuffersMapped)
         {
             crashLine = __LINE__;
             logs_log(LOG_ERROR, "Failed to allocate memory for the uniform buffers!");
@@ -56,12 +63,11 @@ void uniformBuffers_create(State_t *pState)
         {
             bufferCreate(pState, BUFFER_SIZE, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
                          VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                         &pState->renderer.pUniformBuffers[i], &pState->renderer.pUniformBufferMemories[i]);
+                         &pState->renderer.pUniformBuffers[i], &pState->renderer.pUniformBufferAllocations[i]);
 
-            const uint32_t FLAGS = 0;
-            const uint32_t OFFSET = 0;
-            if (vkMapMemory(pState->context.device, pState->renderer.pUniformBufferMemories[i], OFFSET, BUFFER_SIZE, FLAGS,
-                            &pState->renderer.ppUniformBuffersMapped[i]) != VK_SUCCESS)
+            // Host visible allocations are persistently mapped by the GPU allocator
+            pState->renderer.ppUniformBuffersMapped[i] = pState->renderer.pUniformBufferAllocations[i].pMapped;
+            if (!pState->renderer.ppUniformBuffersMapped[i])
             {
                 crashLine = __LINE__;
                 logs_log(LOG_ERROR, "Failed to map memory for uniform buffer %" PRIu32 "!");
@@ -83,16 +89,14 @@ void uniformBuffers_destroy(State_t *pState)
 {
     for (size_t i = 0; i < pState->config.maxFramesInFlight; i++)
     {
-        vkDestroyBuffer(pState->context.device, pState->renderer.pUniformBuffers[i], pState->context.pAllocator);
-        vkUnmapMemory(pState->context.device, pState->renderer.pUniformBufferMemories[i]);
-        vkFreeMemory(pState->context.device, pState->renderer.pUniformBufferMemories[i], pState->context.pAllocator);
+        bufferDestroy(pState, &pState->renderer.pUniformBuffers[i], &pState->renderer.pUniformBufferAllocations[i]);
         pState->renderer.ppUniformBuffersMapped[i] = NULL;
     }
 
     free(pState->renderer.pUniformBuffers);
     pState->renderer.pUniformBuffers = NULL;
-    free(pState->renderer.pUniformBufferMemories);
-    pState->renderer.pUniformBufferMemories = NULL;
+    free(pState->renderer.pUniformBufferAllocations);
+    pState->renderer.pUniformBufferAllocations = NULL;
     free(pState->renderer.ppUniformBuffersMapped);
     pState->renderer.ppUniformBuffersMapped = NULL;
 }
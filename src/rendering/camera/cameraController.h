@@ -4,17 +4,31 @@
 #include "cmath/cmath.h"
 #include "character/character.h"
 
-/// @brief Calculates the camera's perspective view matrix based off of the state's player position and camera rotation
-static inline Mat4c_t camera_viewMatrix_get(const State_t *pSTATE)
+/// @brief World position of the corner of the chunk the camera is in. Everything is drawn relative to it, so the floats the GPU
+/// works with stay small (and precise) however far from the world origin the camera goes
+static inline Vec3i_t camera_renderOrigin_get(const State_t *pSTATE)
+{
+    return cmath_chunk_chunkPos_2_worldPosI(cmath_chunk_worldPosF_2_chunkPos(character_player_positionLerped_get(pSTATE)));
+}
+
+/// @brief Calculates the camera's perspective view matrix based off of the state's player position and camera rotation. The
+/// camera is placed relative to ORIGIN, so pass {0} for world space or camera_renderOrigin_get for what the shaders expect
+static inline Mat4c_t camera_viewMatrix_get(const State_t *pSTATE, const Vec3i_t ORIGIN)
 {
     // Derive forward/up vectors from quaternion orientation
     const Quaternionf_t CAMERA_ROTATION = pSTATE->context.camera.rotation;
     const Vec3f_t CAMERA_FWD = cmath_quat_rotateVec3(CAMERA_ROTATION, VEC3F_FORWARD);
     const Vec3f_t CAMERA_UP = cmath_quat_rotateVec3(CAMERA_ROTATION, VEC3F_UP);
 
+    // The origin is a whole chunk corner close to the player, so this subtraction loses nothing the position still had
     const Vec3f_t PLAYER_POSITION = character_player_positionLerped_get(pSTATE);
+    const Vec3f_t EYE = {
+        .x = PLAYER_POSITION.x - (float)ORIGIN.x,
+        .y = PLAYER_POSITION.y - (float)ORIGIN.y,
+        .z = PLAYER_POSITION.z - (float)ORIGIN.z,
+    };
 
-    return cmath_lookAt(PLAYER_POSITION, cmath_vec3f_add_vec3f(PLAYER_POSITION, CAMERA_FWD), CAMERA_UP);
+    return cmath_lookAt(EYE, cmath_vec3f_add_vec3f(EYE, CAMERA_FWD), CAMERA_UP);
 }
 
 /// @brief Calculates the camera's projection matrix based off of the camera's clipping planes and the image aspect
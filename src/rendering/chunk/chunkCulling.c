@@ -0,0 +1,272 @@
+#pragma region Includes
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include "core/logs.h"
+#include "core/crash_handler.h"
+#include "rendering/chunk/chunkCulling.h"
+#pragma endregion
+#pragma region Defines
+#if defined(DEBUG)
+// #define DEBUG_CHUNK_CULLING
+#endif
+// x64 always has SSE, and MSVC only says so for 32-bit builds
+#if defined(__SSE__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define CHUNK_CULLING_SSE
+#include <xmmintrin.h>
+#endif
+#define DEFAULT_CAPACITY 1024
+
+typedef struct ChunkCulling_t
+{
+    // Gathered chunks and the minimum corners of their bounds, kept as flat arrays so they can be tested in batches
+    Chunk_t **ppChunks;
+    float *pMinX;
+    float *pMinY;
+    float *pMinZ;
+    uint8_t *pVisible;
+    uint32_t count;
+    uint32_t capacity;
+    ChunkCullingStats_t stats;
+} ChunkCulling_t;
+#pragma endregion
+#pragma region Frustum Test
+/// @brief Every box is a chunk, so a plane's test reduces to dot(normal, min) + K >= 0 where K folds in the plane distance and how
+/// far the box reaches along the normal from its minimum corner
+static inline float chunkCulling_plane_offset(const Vec4f_t PLANE)
+{
+    const float SIZE = (float)CMATH_CHUNK_AXIS_LENGTH;
+    return PLANE.w + SIZE * ((PLANE.x > 0.0F ? PLANE.x : 0.0F) + (PLANE.y > 0.0F ? PLANE.y : 0.0F) + (PLANE.z > 0.0F ? PLANE.z : 0.0F));
+}
+
+uint32_t chunkCulling_frustum_test(const Frustumf_t *restrict pFRUSTUM, const float *restrict pMIN_X, const float *restrict pMIN_Y,
+                                   const float *restrict pMIN_Z, const uint32_t COUNT, uint8_t *restrict pVisible)
+{
+    if (!pFRUSTUM || !pMIN_X || !pMIN_Y || !pMIN_Z || !pVisible)
+        return 0;
+
+    float pOffsets[CMATH_FRUSTUM_PLANES];
+    for (int p = 0; p < CMATH_FRUSTUM_PLANES; p++)
+        pOffsets[p] = chunkCulling_plane_offset(pFRUSTUM->pPlanes[p]);
+
+    uint32_t visibleCount = 0;
+    uint32_t i = 0;
+
+#if defined(CHUNK_CULLING_SSE)
+    __m128 pNormalX[CMATH_FRUSTUM_PLANES];
+    __m128 pNormalY[CMATH_FRUSTUM_PLANES];
+    __m128 pNormalZ[CMATH_FRUSTUM_PLANES];
+    __m128 pOffsetsWide[CMATH_FRUSTUM_PLANES];
+    for (int p = 0; p < CMATH_FRUSTUM_PLANES; p++)
+    {
+        pNormalX[p] = _mm_set1_ps(pFRUSTUM->pPlanes[p].x);
+        pNormalY[p] = _mm_set1_ps(pFRUSTUM->pPlanes[p].y);
+        pNormalZ[p] = _mm_set1_ps(pFRUSTUM->pPlanes[p].z);
+        pOffsetsWide[p] = _mm_set1_ps(pOffsets[p]);
+    }
+
+    const __m128 ZERO = _mm_setzero_ps();
+    for (; i + 4 <= COUNT; i += 4)
+    {
+        const __m128 X = _mm_loadu_ps(&pMIN_X[i]);
+        const __m128 Y = _mm_loadu_ps(&pMIN_Y[i]);
+        const __m128 Z = _mm_loadu_ps(&pMIN_Z[i]);
+
+        // Lanes stay set while their box is inside every plane so far
+        __m128 inside = _mm_cmpeq_ps(ZERO, ZERO);
+        for (int p = 0; p < CMATH_FRUSTUM_PLANES; p++)
+        {
+            __m128 distance = _mm_add_ps(_mm_mul_ps(X, pNormalX[p]), pOffsetsWide[p]);
+            distance = _mm_add_ps(distance, _mm_mul_ps(Y, pNormalY[p]));
+            distance = _mm_add_ps(distance, _mm_mul_ps(Z, pNormalZ[p]));
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, ZERO));
+        }
+
+        const int MASK = _mm_movemask_ps(inside);
+        for (uint32_t lane = 0; lane < 4; lane++)
+        {
+            const uint8_t VISIBLE = (uint8_t)((MASK >> lane) & 1);
+            pVisible[i + lane] = VISIBLE;
+            visibleCount += VISIBLE;
+        }
+    }
+#endif
+
+    // Leftovers that don't fill a batch (or everything without SSE)
+    for (; i < COUNT; i++)
+    {
+        uint8_t visible = 1;
+        for (int p = 0; p < CMATH_FRUSTUM_PLANES && visible; p++)
+        {
+            const Vec4f_t PLANE = pFRUSTUM->pPlanes[p];
+            visible = PLANE.x * pMIN_X[i] + PLANE.y * pMIN_Y[i] + PLANE.z * pMIN_Z[i] + pOffsets[p] >= 0.0F;
+        }
+
+        pVisible[i] = visible;
+        visibleCount += visible;
+    }
+
+    return visibleCount;
+}
+#pragma endregion
+#pragma region Gathering
+void chunkCulling_begin(State_t *pState)
+{
+    if (!pState || !pState->renderer.pChunkCulling)
+        return;
+
+    pState->renderer.pChunkCulling->count = 0;
+}
+
+static bool chunkCulling_grow(ChunkCulling_t *pCulling)
+{
+    const uint32_t NEW_CAPACITY = pCulling->capacity ? pCulling->capacity * 2 : DEFAULT_CAPACITY;
+
+    Chunk_t **ppNewChunks = realloc(pCulling->ppChunks, sizeof(Chunk_t *) * NEW_CAPACITY);
+    if (!ppNewChunks)
+        return false;
+    pCulling->ppChunks = ppNewChunks;
+
+    float **pppAxes[] = {&pCulling->pMinX, &pCulling->pMinY, &pCulling->pMinZ};
+    for (size_t i = 0; i < sizeof(pppAxes) / sizeof(*pppAxes); i++)
+    {
+        float *pNewAxis = realloc(*pppAxes[i], sizeof(float) * NEW_CAPACITY);
+        if (!pNewAxis)
+            return false;
+        *pppAxes[i] = pNewAxis;
+    }
+
+    uint8_t *pNewVisible = realloc(pCulling->pVisible, NEW_CAPACITY);
+    if (!pNewVisible)
+        return false;
+    pCulling->pVisible = pNewVisible;
+
+    pCulling->capacity = NEW_CAPACITY;
+    return true;
+}
+
+void chunkCulling_chunk_add(State_t *restrict pState, Chunk_t *restrict pChunk)
+{
+    if (!pState || !pState->renderer.pChunkCulling || !pChunk)
+        return;
+
+    ChunkCulling_t *pCulling = pState->renderer.pChunkCulling;
+    if (pCulling->count == pCulling->capacity && !chunkCulling_grow(pCulling))
+    {
+        logs_log(LOG_ERROR, "Failed to grow the chunk culling arrays!");
+        return;
+    }
+
+    // The difference from the render origin is taken in integers, so only small offsets are ever converted to float
+    const Boundsi_t BOUNDS = cmath_chunk_getBoundsi(pChunk->chunkPos);
+    const Vec3i_t ORIGIN = pState->renderer.renderOrigin;
+    const uint32_t INDEX = pCulling->count++;
+    pCulling->ppChunks[INDEX] = pChunk;
+    pCulling->pMinX[INDEX] = (float)(BOUNDS.A.x - ORIGIN.x);
+    pCulling->pMinY[INDEX] = (float)(BOUNDS.A.y - ORIGIN.y);
+    pCulling->pMinZ[INDEX] = (float)(BOUNDS.A.z - ORIGIN.z);
+}
+
+Chunk_t **chunkCulling_cull(State_t *restrict pState, uint32_t *restrict pVisibleCount)
+{
+    if (pVisibleCount)
+        *pVisibleCount = 0;
+    if (!pState || !pState->renderer.pChunkCulling || !pVisibleCount)
+        return NULL;
+
+    ChunkCulling_t *pCulling = pState->renderer.pChunkCulling;
+    const uint32_t VISIBLE_COUNT = chunkCulling_frustum_test(&pState->renderer.cameraFrustum, pCulling->pMinX, pCulling->pMinY,
+                                                             pCulling->pMinZ, pCulling->count, pCulling->pVisible);
+
+    // Compact the survivors to the front, keeping their order
+    uint32_t kept = 0;
+    for (uint32_t i = 0; i < pCulling->count; i++)
+    {
+        if (pCulling->pVisible[i])
+            pCulling->ppChunks[kept++] = pCulling->ppChunks[i];
+    }
+
+    ChunkCullingStats_t *pStats = &pCulling->stats;
+    pStats->tested = pCulling->count;
+    pStats->drawn = VISIBLE_COUNT;
+    pStats->culled = pCulling->count - VISIBLE_COUNT;
+    pStats->frames++;
+    pStats->testedTotal += pStats->tested;
+    pStats->culledTotal += pStats->culled;
+
+    *pVisibleCount = kept;
+    return pCulling->ppChunks;
+}
+#pragma endregion
+#pragma region Stats
+ChunkCullingStats_t chunkCulling_stats_get(const State_t *pSTATE)
+{
+    if (!pSTATE || !pSTATE->renderer.pChunkCulling)
+        return (ChunkCullingStats_t){0};
+
+    return pSTATE->renderer.pChunkCulling->stats;
+}
+
+void chunkCulling_stats_log(const State_t *pSTATE)
+{
+    const ChunkCullingStats_t STATS = chunkCulling_stats_get(pSTATE);
+    const double CULLED_PERCENT = STATS.testedTotal ? 100.0 * (double)STATS.culledTotal / (double)STATS.testedTotal : 0.0;
+
+    logs_log(LOG_DEBUG, "Chunk culling: %u of %u chunks drawn last frame. %.1f%% culled over %" PRIu64 " frames.", STATS.drawn,
+             STATS.tested, CULLED_PERCENT, STATS.frames);
+}
+#pragma endregion
+#pragma region Create/Destroy
+void chunkCulling_create(State_t *pState)
+{
+    int crashLine = 0;
+    do
+    {
+        ChunkCulling_t *pCulling = calloc(1, sizeof(ChunkCulling_t));
+        if (!pCulling)
+        {
+            crashLine = __LINE__;
+            break;
+        }
+
+        // Hooked up first so destroy can clean up partially grown arrays
+        pState->renderer.pChunkCulling = pCulling;
+
+        if (!chunkCulling_grow(pCulling))
+        {
+            crashLine = __LINE__;
+            break;
+        }
+    } while (0);
+
+    if (crashLine != 0)
+        crashHandler_crash_graceful(CRASH_LOCATION_LINE(crashLine), "The program cannot continue without chunk culling!");
+}
+
+void chunkCulling_destroy(State_t *pState)
+{
+    if (!pState || !pState->renderer.pChunkCulling)
+        return;
+
+    ChunkCulling_t *pCulling = pState->renderer.pChunkCulling;
+
+#if defined(DEBUG_CHUNK_CULLING)
+    chunkCulling_stats_log(pState);
+#endif
+
+    free(pCulling->ppChunks);
+    free(pCulling->pMinX);
+    free(pCulling->pMinY);
+    free(pCulling->pMinZ);
+    free(pCulling->pVisible);
+
+    free(pCulling);
+    pState->renderer.pChunkCulling = NULL;
+}
+#pragma endregion
+#pragma region Undefines
+#undef DEFAULT_CAPACITY
+#if defined(CHUNK_CULLING_SSE)
+#undef CHUNK_CULLING_SSE
+#endif
+#pragma endregion
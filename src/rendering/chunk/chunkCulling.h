@@ -0,0 +1,42 @@
+#pragma once
+
+#include <stdint.h>
+#include "cmath/cmath.h"
+#include "core/types/state_t.h"
+#include "api/chunk/chunkAPI.h"
+
+typedef struct ChunkCullingStats_t
+{
+    // Last culled frame
+    uint32_t tested;
+    uint32_t culled;
+    uint32_t drawn;
+    // Since startup
+    uint64_t frames;
+    uint64_t testedTotal;
+    uint64_t culledTotal;
+} ChunkCullingStats_t;
+
+/// @brief Tests COUNT chunk sized boxes, given by the flat arrays of their minimum corners, against the frustum. pVisible[i] is set
+/// to 1 when box i touches the frustum and 0 otherwise. Batched 4 at a time with SSE where available. Returns how many are visible
+uint32_t chunkCulling_frustum_test(const Frustumf_t *restrict pFRUSTUM, const float *restrict pMIN_X, const float *restrict pMIN_Y,
+                                   const float *restrict pMIN_Z, const uint32_t COUNT, uint8_t *restrict pVisible);
+
+/// @brief Clears the chunks gathered for the last frame. MAIN THREAD ONLY.
+void chunkCulling_begin(State_t *pState);
+
+/// @brief Gathers a chunk with something to draw to be tested by the next cull, with its bounds relative to the render origin
+/// the camera frustum was built at. MAIN THREAD ONLY.
+void chunkCulling_chunk_add(State_t *restrict pState, Chunk_t *restrict pChunk);
+
+/// @brief Tests every gathered chunk against the camera frustum and returns the ones inside, with their count in pVisibleCount.
+/// The array stays valid until the next begin. MAIN THREAD ONLY.
+Chunk_t **chunkCulling_cull(State_t *restrict pState, uint32_t *restrict pVisibleCount);
+
+ChunkCullingStats_t chunkCulling_stats_get(const State_t *pSTATE);
+
+void chunkCulling_stats_log(const State_t *pSTATE);
+
+void chunkCulling_create(State_t *pState);
+
+void chunkCulling_destroy(State_t *pState);
@@ -0,0 +1,581 @@
+#pragma region Includes
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include <vulkan/vulkan.h>
+#include "core/logs.h"
+#include "core/crash_handler.h"
+#include "rendering/buffers/buffers.h"
+#include "rendering/renderGC.h"
+#include "rendering/renderQueue.h"
+#include "rendering/chunk/chunkDrawList.h"
+#include "rendering/chunk/chunkGeometryPool.h"
+#include "rendering/types/chunkGeometryRange_t.h"
+#include "rendering/types/shaderVertexVoxel_t.h"
+#include "rendering/types/graphicsPipeline_t.h"
+#include "rendering/buffers/command_buffer.h"
+#include "rendering/buffers/secondary_command_buffer.h"
+#include "rendering/gpuProfiler.h"
+#include "threading/threadPool.h"
+#pragma endregion
+#pragma region Defines
+#if defined(DEBUG)
+// #define DEBUG_CHUNK_DRAW_LIST
+#endif
+#define DEFAULT_DRAW_CAPACITY 1024
+#define DEFAULT_INSTANCE_CAPACITY 512
+// Fewer draws than this per secondary and handing them to a worker costs more than recording them
+#define MIN_DRAWS_PER_SECONDARY 256
+
+typedef struct ChunkDraw_t
+{
+    VkDrawIndexedIndirectCommand command;
+    // Page first so a page is bound once, then the chunk's depth
+    uint64_t key;
+    uint16_t page;
+} ChunkDraw_t;
+
+/// @brief One vkCmdDraw* call. Indirect calls carry COUNT commands from FIRST in the sorted order, direct ones the single draw at FIRST
+typedef struct ChunkDrawCall_t
+{
+    uint32_t first;
+    uint32_t count;
+    uint16_t page;
+} ChunkDrawCall_t;
+
+/// @brief GPU side of the list for one frame in flight. Only grown while recording that frame, after its fence has signaled
+typedef struct ChunkDrawFrame_t
+{
+    VkBuffer indirectBuffer;
+    GpuAllocation_t indirectAllocation;
+    uint32_t indirectCapacity;
+    VkBuffer instanceBuffer;
+    GpuAllocation_t instanceAllocation;
+    uint32_t instanceCapacity;
+    // What the secondaries below were recorded from. While the list, extent and pipeline are unchanged they're executed again as they are
+    uint64_t version;
+    VkExtent2D extent;
+    GraphicsPipeline_e pipeline;
+    bool recorded;
+    uint32_t secondaryCount;
+    VkCommandBuffer pSecondaries[SECONDARY_COMMAND_BUFFER_MAX_SLOTS];
+    // What recording them counted, added to every frame that reuses them
+    RenderFrameStats_t stats;
+} ChunkDrawFrame_t;
+
+/// @brief A run of calls recorded into one secondary, on a worker or the main thread
+typedef struct ChunkRecordJob_t
+{
+    State_t *pState;
+    const struct ChunkDrawList_t *pLIST;
+    const ChunkDrawFrame_t *pFRAME;
+    uint32_t firstCall;
+    uint32_t endCall;
+    uint32_t slot;
+    // The first range starts the GPU timing and is always recorded on the main thread. The last one ends it
+    bool scopeBegin;
+    bool scopeEnd;
+    VkCommandBuffer cmd;
+    RenderFrameStats_t stats;
+} ChunkRecordJob_t;
+
+typedef struct ChunkDrawList_t
+{
+    ChunkDraw_t *pDraws;
+    uint32_t drawCount;
+    uint32_t drawCapacity;
+    ShaderInstanceVoxel_t *pInstances;
+    uint32_t instanceCount;
+    uint32_t instanceCapacity;
+    // Alongside pInstances, but CPU only
+    uint32_t *pInstanceDepths;
+    uint32_t instanceDepthCapacity;
+    // Draw order for the frame being recorded, plus the sort's scratch space
+    RenderQueueItem_t *pOrder;
+    RenderQueueItem_t *pOrderScratch;
+    uint32_t orderCapacity;
+    uint32_t orderScratchCapacity;
+    ChunkDrawCall_t *pCalls;
+    uint32_t callCount;
+    uint32_t callCapacity;
+    ChunkRecordJob_t pJobs[SECONDARY_COMMAND_BUFFER_MAX_SLOTS];
+    ChunkDrawFrame_t *pFrames;
+    uint32_t frameCount;
+    // Most draws a single indirect call may carry. 1 without the multiDrawIndirect feature
+    uint32_t maxDrawsPerCall;
+    // Without drawIndirectFirstInstance an indirect draw can't pick its instance, so the list is drawn directly instead
+    bool indirectFirstInstance;
+    // What the draws were gathered from, and a count of gathers so each frame slot can tell if its secondaries are current
+    ChunkDrawListSource_t source;
+    bool sourceValid;
+    uint64_t version;
+    uint64_t framesReused;
+    uint64_t framesRecorded;
+} ChunkDrawList_t;
+#pragma endregion
+#pragma region Growth
+/// @brief Doubles the array until it holds at least COUNT elements
+static bool chunkDrawList_array_reserve(void **ppArray, uint32_t *pCapacity, const uint32_t COUNT, const size_t ELEMENT_SIZE)
+{
+    if (COUNT <= *pCapacity)
+        return true;
+
+    uint32_t capacity = *pCapacity ? *pCapacity : 1;
+    while (capacity < COUNT)
+        capacity *= 2;
+
+    void *pNew = realloc(*ppArray, ELEMENT_SIZE * capacity);
+    if (!pNew)
+        return false;
+
+    *ppArray = pNew;
+    *pCapacity = capacity;
+    return true;
+}
+
+/// @brief Swaps the frame buffer for a bigger one when COUNT elements don't fit. The old one goes back to the render GC, so frames
+/// that grow to the same size take turns reusing buffers instead of creating new ones
+static bool chunkDrawList_frameBuffer_reserve(State_t *restrict pState, VkBuffer *restrict pBuffer, GpuAllocation_t *restrict pAllocation,
+                                              uint32_t *restrict pCapacity, const uint32_t COUNT, const size_t ELEMENT_SIZE,
+                                              const VkBufferUsageFlags USAGE)
+{
+    if (COUNT <= *pCapacity && *pBuffer != VK_NULL_HANDLE)
+        return true;
+
+    const VkMemoryPropertyFlags PROPERTIES = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+
+    uint32_t capacity = *pCapacity ? *pCapacity : 1;
+    while (capacity < COUNT)
+        capacity *= 2;
+
+    renderGC_buffer_release(pState, (VkDeviceSize)ELEMENT_SIZE * *pCapacity, USAGE, PROPERTIES, pBuffer, pAllocation);
+    *pCapacity = 0;
+
+    const VkDeviceSize SIZE = renderGC_buffer_acquire(pState, (VkDeviceSize)ELEMENT_SIZE * capacity, USAGE, PROPERTIES, pBuffer,
+                                                      pAllocation);
+    if (SIZE == 0 || !pAllocation->pMapped)
+    {
+        bufferDestroy(pState, pBuffer, pAllocation);
+        return false;
+    }
+
+    // The GC rounds sizes up, and whatever it adds is free room
+    *pCapacity = (uint32_t)(SIZE / ELEMENT_SIZE);
+    return true;
+}
+#pragma endregion
+#pragma region Building
+bool chunkDrawList_source_matches(const State_t *restrict pSTATE, const ChunkDrawListSource_t *restrict pSOURCE)
+{
+    if (!pSTATE || !pSTATE->renderer.pChunkDrawList || !pSOURCE)
+        return false;
+
+    const ChunkDrawList_t *pLIST = pSTATE->renderer.pChunkDrawList;
+    const ChunkDrawListSource_t *pLAST = &pLIST->source;
+    return pLIST->sourceValid && cmath_vec3i_equals(pLAST->cameraChunkPos, pSOURCE->cameraChunkPos, 0) &&
+           pLAST->chunkSetGeneration == pSOURCE->chunkSetGeneration &&
+           pLAST->completedUploadSerial == pSOURCE->completedUploadSerial &&
+           memcmp(&pLAST->frustum, &pSOURCE->frustum, sizeof(Frustumf_t)) == 0;
+}
+
+void chunkDrawList_invalidate(State_t *pState)
+{
+    if (!pState || !pState->renderer.pChunkDrawList)
+        return;
+
+    pState->renderer.pChunkDrawList->sourceValid = false;
+}
+
+void chunkDrawList_begin(State_t *restrict pState, const ChunkDrawListSource_t *restrict pSOURCE)
+{
+    if (!pState || !pState->renderer.pChunkDrawList || !pSOURCE)
+        return;
+
+    ChunkDrawList_t *pList = pState->renderer.pChunkDrawList;
+    pList->drawCount = 0;
+    pList->instanceCount = 0;
+    pList->source = *pSOURCE;
+    pList->sourceValid = true;
+    pList->version++;
+}
+
+uint32_t chunkDrawList_instance_add(State_t *pState, const Vec3i_t CHUNK_ORIGIN, const uint32_t DEPTH)
+{
+    if (!pState || !pState->renderer.pChunkDrawList)
+        return CHUNK_DRAW_LIST_INSTANCE_NONE;
+
+    ChunkDrawList_t *pList = pState->renderer.pChunkDrawList;
+    if (!chunkDrawList_array_reserve((void **)&pList->pInstances, &pList->instanceCapacity, pList->instanceCount + 1,
+                                     sizeof(ShaderInstanceVoxel_t)) ||
+        !chunkDrawList_array_reserve((void **)&pList->pInstanceDepths, &pList->instanceDepthCapacity, pList->instanceCount + 1,
+                                     sizeof(uint32_t)))
+    {
+        logs_log(LOG_ERROR, "Failed to grow the chunk draw list's instances!");
+        return CHUNK_DRAW_LIST_INSTANCE_NONE;
+    }
+
+    pList->pInstances[pList->instanceCount] = (ShaderInstanceVoxel_t){.chunkOrigin = CHUNK_ORIGIN};
+    pList->pInstanceDepths[pList->instanceCount] = DEPTH;
+    return pList->instanceCount++;
+}
+
+void chunkDrawList_draw_add(State_t *pState, const uint16_t PAGE, const uint32_t INDEX_COUNT, const uint32_t FIRST_INDEX,
+                            const int32_t VERTEX_OFFSET, const uint32_t INSTANCE)
+{
+    if (!pState || !pState->renderer.pChunkDrawList || PAGE >= CHUNK_GEOMETRY_MAX_PAGES || INSTANCE == CHUNK_DRAW_LIST_INSTANCE_NONE ||
+        INDEX_COUNT == 0)
+        return;
+
+    ChunkDrawList_t *pList = pState->renderer.pChunkDrawList;
+    if (INSTANCE >= pList->instanceCount)
+        return;
+
+    if (!chunkDrawList_array_reserve((void **)&pList->pDraws, &pList->drawCapacity, pList->drawCount + 1, sizeof(ChunkDraw_t)))
+    {
+        logs_log(LOG_ERROR, "Failed to grow the chunk draw list's draws!");
+        return;
+    }
+
+    pList->pDraws[pList->drawCount++] = (ChunkDraw_t){
+        .command = {
+            .indexCount = INDEX_COUNT,
+            .instanceCount = 1,
+            .firstIndex = FIRST_INDEX,
+            .vertexOffset = VERTEX_OFFSET,
+            .firstInstance = INSTANCE,
+        },
+        .key = renderQueue_key_make(GRAPHICS_TARGET_VOXEL, PAGE, pList->pInstanceDepths[INSTANCE]),
+        .page = PAGE,
+    };
+}
+#pragma endregion
+#pragma region Record
+/// @brief Binds PAGE as the vertex (binding 0) and index buffer. False when the page doesn't exist
+static bool chunkDrawList_page_bind(State_t *restrict pState, VkCommandBuffer cmd, const uint16_t PAGE,
+                                    RenderFrameStats_t *restrict pStats)
+{
+    VkBuffer pageBuffer = chunkGeometryPool_buffer_get(pState, PAGE);
+    if (pageBuffer == VK_NULL_HANDLE)
+        return false;
+
+    const VkDeviceSize OFFSET = 0;
+    vkCmdBindVertexBuffers(cmd, 0, 1, &pageBuffer, &OFFSET);
+    vkCmdBindIndexBuffer(cmd, pageBuffer, 0, VK_INDEX_TYPE_UINT32);
+    pStats->vertexBufferBinds++;
+    pStats->indexBufferBinds++;
+    return true;
+}
+
+/// @brief Appends a call, growing the array as needed
+static bool chunkDrawList_call_add(ChunkDrawList_t *pList, const uint16_t PAGE, const uint32_t FIRST, const uint32_t COUNT)
+{
+    if (!chunkDrawList_array_reserve((void **)&pList->pCalls, &pList->callCapacity, pList->callCount + 1, sizeof(ChunkDrawCall_t)))
+        return false;
+
+    pList->pCalls[pList->callCount++] = (ChunkDrawCall_t){.first = FIRST, .count = COUNT, .page = PAGE};
+    return true;
+}
+
+/// @brief Appends the calls for sorted draws FIRST_DRAW to END_DRAW. One per draw without drawIndirectFirstInstance, otherwise
+/// one per page or per maxDrawsPerCall of a page
+static bool chunkDrawList_calls_build(ChunkDrawList_t *pList, const uint32_t FIRST_DRAW, const uint32_t END_DRAW)
+{
+    for (uint32_t first = FIRST_DRAW; first < END_DRAW;)
+    {
+        const uint16_t PAGE = pList->pDraws[pList->pOrder[first].index].page;
+        uint32_t end = first + 1;
+        while (end < END_DRAW && pList->pDraws[pList->pOrder[end].index].page == PAGE)
+            end++;
+
+        const uint32_t MAX_PER_CALL = pList->indirectFirstInstance ? pList->maxDrawsPerCall : 1;
+        for (uint32_t drawn = first; drawn < end;)
+        {
+            const uint32_t COUNT = end - drawn < MAX_PER_CALL ? end - drawn : MAX_PER_CALL;
+            if (!chunkDrawList_call_add(pList, PAGE, drawn, COUNT))
+                return false;
+            drawn += COUNT;
+        }
+
+        first = end;
+    }
+
+    return true;
+}
+
+/// @brief Records the job's calls into its own secondary. Only reads the list, so any number of these can run at once
+static void chunkDrawList_job_record(void *pCtx)
+{
+    ChunkRecordJob_t *pJob = pCtx;
+    const ChunkDrawList_t *pLIST = pJob->pLIST;
+
+    pJob->stats = (RenderFrameStats_t){0};
+    pJob->cmd = secondaryCommandBuffers_begin(pJob->pState, pJob->slot, true);
+    if (pJob->cmd == VK_NULL_HANDLE)
+        return;
+
+    VkCommandBuffer cmd = pJob->cmd;
+    if (pJob->scopeBegin)
+        gpuProfiler_scope_begin(pJob->pState, cmd, GPU_PROFILER_SCOPE_CHUNKS);
+
+    VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
+    commandBuffer_pipeline_bind(pJob->pState, cmd, &pipelineLayout, GRAPHICS_TARGET_VOXEL, &pJob->stats);
+
+    const VkDeviceSize INSTANCE_OFFSET = 0;
+    vkCmdBindVertexBuffers(cmd, 1, 1, &pJob->pFRAME->instanceBuffer, &INSTANCE_OFFSET);
+    pJob->stats.vertexBufferBinds++;
+
+    const uint32_t STRIDE = (uint32_t)sizeof(VkDrawIndexedIndirectCommand);
+    uint16_t boundPage = CHUNK_GEOMETRY_PAGE_NONE;
+    bool pageValid = false;
+    for (uint32_t i = pJob->firstCall; i < pJob->endCall; i++)
+    {
+        const ChunkDrawCall_t *pCALL = &pLIST->pCalls[i];
+        if (pCALL->page != boundPage)
+        {
+            pageValid = chunkDrawList_page_bind(pJob->pState, cmd, pCALL->page, &pJob->stats);
+            boundPage = pCALL->page;
+        }
+
+        if (!pageValid)
+            continue;
+
+        if (pLIST->indirectFirstInstance)
+            vkCmdDrawIndexedIndirect(cmd, pJob->pFRAME->indirectBuffer, (VkDeviceSize)pCALL->first * STRIDE, pCALL->count, STRIDE);
+        else
+        {
+            // Fallback for devices that can't set firstInstance from an indirect draw
+            const VkDrawIndexedIndirectCommand *pCOMMAND = &pLIST->pDraws[pLIST->pOrder[pCALL->first].index].command;
+            vkCmdDrawIndexed(cmd, pCOMMAND->indexCount, 1, pCOMMAND->firstIndex, pCOMMAND->vertexOffset, pCOMMAND->firstInstance);
+        }
+
+        pJob->stats.drawCalls++;
+        pJob->stats.drawCommands += pCALL->count;
+    }
+
+    if (pJob->scopeEnd)
+        gpuProfiler_scope_end(pJob->pState, cmd, GPU_PROFILER_SCOPE_CHUNKS);
+
+    if (!secondaryCommandBuffers_end(cmd))
+        pJob->cmd = VK_NULL_HANDLE;
+}
+
+uint32_t chunkDrawList_record(State_t *restrict pState, VkCommandBuffer *restrict pSecondaries, const uint32_t MAX_SECONDARIES)
+{
+    if (!pState || !pState->renderer.pChunkDrawList || !pSecondaries || MAX_SECONDARIES == 0)
+        return 0;
+
+    ChunkDrawList_t *pList = pState->renderer.pChunkDrawList;
+    if (pList->drawCount == 0)
+        return 0;
+
+    // The frame's buffers and secondaries are left exactly as the GPU last used them until the list is gathered again, so a camera
+    // that stays put skips the sort, the buffer writes and the recording. Viewport, scissor and pipeline are baked in as well
+    ChunkDrawFrame_t *pFrame = &pList->pFrames[pState->renderer.currentFrame % pList->frameCount];
+    const VkExtent2D EXTENT = pState->window.swapchain.imageExtent;
+    const GraphicsPipeline_e PIPELINE = pState->renderer.activeGraphicsPipeline;
+    if (pFrame->recorded && pFrame->version == pList->version && pFrame->extent.width == EXTENT.width &&
+        pFrame->extent.height == EXTENT.height && pFrame->pipeline == PIPELINE && pFrame->secondaryCount <= MAX_SECONDARIES)
+    {
+        memcpy(pSecondaries, pFrame->pSecondaries, sizeof(VkCommandBuffer) * pFrame->secondaryCount);
+        renderQueue_stats_add(&pState->renderer.frameStats, &pFrame->stats);
+        gpuProfiler_scope_reuse(pState, GPU_PROFILER_SCOPE_CHUNKS);
+        pList->framesReused++;
+        return pFrame->secondaryCount;
+    }
+
+    pFrame->recorded = false;
+    pList->framesRecorded++;
+
+    if (!chunkDrawList_array_reserve((void **)&pList->pOrder, &pList->orderCapacity, pList->drawCount, sizeof(RenderQueueItem_t)) ||
+        !chunkDrawList_array_reserve((void **)&pList->pOrderScratch, &pList->orderScratchCapacity, pList->drawCount,
+                                     sizeof(RenderQueueItem_t)))
+    {
+        logs_log(LOG_ERROR, "Failed to grow the chunk draw order to %u draws!", pList->drawCount);
+        return 0;
+    }
+
+    // Sorted by page and then depth, so every page's draws sit back to back (one indirect call each) and go front to back
+    for (uint32_t i = 0; i < pList->drawCount; i++)
+        pList->pOrder[i] = (RenderQueueItem_t){.key = pList->pDraws[i].key, .index = i};
+    renderQueue_sort(pList->pOrder, pList->pOrderScratch, pList->drawCount);
+
+    // Buffers are only grown and written here on the main thread. The jobs just record commands that point into them
+    if (!chunkDrawList_frameBuffer_reserve(pState, &pFrame->instanceBuffer, &pFrame->instanceAllocation, &pFrame->instanceCapacity,
+                                           pList->instanceCount, sizeof(ShaderInstanceVoxel_t), VK_BUFFER_USAGE_VERTEX_BUFFER_BIT))
+    {
+        logs_log(LOG_ERROR, "Failed to grow the chunk instance buffer to %u instances!", pList->instanceCount);
+        return 0;
+    }
+
+    memcpy(pFrame->instanceAllocation.pMapped, pList->pInstances, sizeof(ShaderInstanceVoxel_t) * pList->instanceCount);
+
+    if (pList->indirectFirstInstance)
+    {
+        if (!chunkDrawList_frameBuffer_reserve(pState, &pFrame->indirectBuffer, &pFrame->indirectAllocation, &pFrame->indirectCapacity,
+                                               pList->drawCount, sizeof(VkDrawIndexedIndirectCommand),
+                                               VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT))
+        {
+            logs_log(LOG_ERROR, "Failed to grow the chunk indirect buffer to %u draws!", pList->drawCount);
+            return 0;
+        }
+
+        VkDrawIndexedIndirectCommand *pCommands = pFrame->indirectAllocation.pMapped;
+        for (uint32_t i = 0; i < pList->drawCount; i++)
+            pCommands[i] = pList->pDraws[pList->pOrder[i].index].command;
+    }
+
+    const uint32_t SLOT_COUNT = secondaryCommandBuffers_slotCount(pState);
+    if (SLOT_COUNT <= SECONDARY_COMMAND_BUFFER_SLOT_CHUNKS_FIRST)
+        return 0;
+
+    // Split by draws rather than calls. With multiDrawIndirect a whole page is one call, so counting calls would keep every
+    // frame in a single secondary. Enough draws for every range to be worth a secondary, capped by the slots there are
+    uint32_t rangeCount = (pList->drawCount + MIN_DRAWS_PER_SECONDARY - 1) / MIN_DRAWS_PER_SECONDARY;
+    if (rangeCount > SLOT_COUNT - SECONDARY_COMMAND_BUFFER_SLOT_CHUNKS_FIRST)
+        rangeCount = SLOT_COUNT - SECONDARY_COMMAND_BUFFER_SLOT_CHUNKS_FIRST;
+    if (rangeCount > MAX_SECONDARIES)
+        rangeCount = MAX_SECONDARIES;
+
+    // Calls never cross a range boundary, so each range covers its own slice of the indirect buffer
+    pList->callCount = 0;
+    for (uint32_t range = 0; range < rangeCount; range++)
+    {
+        const uint32_t FIRST_CALL = pList->callCount;
+        if (!chunkDrawList_calls_build(pList, (uint32_t)((uint64_t)pList->drawCount * range / rangeCount),
+                                       (uint32_t)((uint64_t)pList->drawCount * (range + 1) / rangeCount)))
+        {
+            logs_log(LOG_ERROR, "Failed to grow the chunk draw calls for %u draws!", pList->drawCount);
+            return 0;
+        }
+
+        pList->pJobs[range] = (ChunkRecordJob_t){
+            .pState = pState,
+            .pLIST = pList,
+            .pFRAME = pFrame,
+            .firstCall = FIRST_CALL,
+            .endCall = pList->callCount,
+            .slot = SECONDARY_COMMAND_BUFFER_SLOT_CHUNKS_FIRST + range,
+            .scopeBegin = range == 0,
+            .scopeEnd = range == rangeCount - 1,
+        };
+    }
+
+    // Every range but the first goes to the workers while the main thread records the first
+    ThreadPoolGroup_t group = {0};
+    for (uint32_t range = 1; range < rangeCount; range++)
+    {
+        if (!pState->pThreadPool || !threadPool_submitGroup(pState->pThreadPool, &group, chunkDrawList_job_record, &pList->pJobs[range]))
+            chunkDrawList_job_record(&pList->pJobs[range]);
+    }
+
+    chunkDrawList_job_record(&pList->pJobs[0]);
+
+    if (pState->pThreadPool)
+        threadPool_waitGroup(pState->pThreadPool, &group);
+
+    pFrame->stats = (RenderFrameStats_t){0};
+    for (uint32_t range = 0; range < rangeCount; range++)
+    {
+        if (pList->pJobs[range].cmd == VK_NULL_HANDLE)
+            crashHandler_crash_graceful(CRASH_LOCATION, "The program cannot continue with a failed chunk secondary command buffer.");
+
+        pSecondaries[range] = pList->pJobs[range].cmd;
+        pFrame->pSecondaries[range] = pList->pJobs[range].cmd;
+        renderQueue_stats_add(&pFrame->stats, &pList->pJobs[range].stats);
+    }
+
+    renderQueue_stats_add(&pState->renderer.frameStats, &pFrame->stats);
+    pFrame->secondaryCount = rangeCount;
+    pFrame->version = pList->version;
+    pFrame->extent = EXTENT;
+    pFrame->pipeline = PIPELINE;
+    pFrame->recorded = true;
+
+#if defined(DEBUG_CHUNK_DRAW_LIST)
+    logs_log(LOG_DEBUG, "Chunk draw list: %u draws over %u chunks in %u calls, recorded into %u secondaries. %" PRIu64
+             " frames recorded and %" PRIu64 " reused so far.", pList->drawCount, pList->instanceCount, pList->callCount, rangeCount,
+             pList->framesRecorded, pList->framesReused);
+#endif
+
+    return rangeCount;
+}
+#pragma endregion
+#pragma region Create/Destroy
+void chunkDrawList_create(State_t *pState)
+{
+    int crashLine = 0;
+    do
+    {
+        ChunkDrawList_t *pList = calloc(1, sizeof(ChunkDrawList_t));
+        if (!pList)
+        {
+            crashLine = __LINE__;
+            break;
+        }
+
+        // Hooked up first so destroy can clean up a partially created list
+        pState->renderer.pChunkDrawList = pList;
+
+        pList->frameCount = pState->config.maxFramesInFlight;
+        pList->pFrames = calloc(pList->frameCount, sizeof(ChunkDrawFrame_t));
+        if (!pList->pFrames ||
+            !chunkDrawList_array_reserve((void **)&pList->pDraws, &pList->drawCapacity, DEFAULT_DRAW_CAPACITY, sizeof(ChunkDraw_t)) ||
+            !chunkDrawList_array_reserve((void **)&pList->pInstances, &pList->instanceCapacity, DEFAULT_INSTANCE_CAPACITY,
+                                         sizeof(ShaderInstanceVoxel_t)) ||
+            !chunkDrawList_array_reserve((void **)&pList->pInstanceDepths, &pList->instanceDepthCapacity, DEFAULT_INSTANCE_CAPACITY,
+                                         sizeof(uint32_t)))
+        {
+            crashLine = __LINE__;
+            break;
+        }
+
+        VkPhysicalDeviceProperties properties;
+        vkGetPhysicalDeviceProperties(pState->context.physicalDevice, &properties);
+
+        const VkPhysicalDeviceFeatures FEATURES = pState->context.physicalDeviceEnabledFeatures;
+        pList->maxDrawsPerCall = FEATURES.multiDrawIndirect ? properties.limits.maxDrawIndirectCount : 1;
+        if (pList->maxDrawsPerCall == 0)
+            pList->maxDrawsPerCall = 1;
+        pList->indirectFirstInstance = FEATURES.drawIndirectFirstInstance == VK_TRUE;
+
+        logs_log(LOG_DEBUG, "Chunks draw %s (up to %u draws per call).",
+                 pList->indirectFirstInstance ? "indirectly" : "directly", pList->maxDrawsPerCall);
+    } while (0);
+
+    if (crashLine != 0)
+        crashHandler_crash_graceful(CRASH_LOCATION_LINE(crashLine), "The program cannot continue without a chunk draw list!");
+}
+
+void chunkDrawList_destroy(State_t *pState)
+{
+    if (!pState || !pState->renderer.pChunkDrawList)
+        return;
+
+    ChunkDrawList_t *pList = pState->renderer.pChunkDrawList;
+
+    if (pList->pFrames)
+    {
+        for (uint32_t i = 0; i < pList->frameCount; i++)
+        {
+            bufferDestroy(pState, &pList->pFrames[i].indirectBuffer, &pList->pFrames[i].indirectAllocation);
+            bufferDestroy(pState, &pList->pFrames[i].instanceBuffer, &pList->pFrames[i].instanceAllocation);
+        }
+    }
+    free(pList->pFrames);
+    free(pList->pDraws);
+    free(pList->pInstances);
+    free(pList->pInstanceDepths);
+    free(pList->pOrder);
+    free(pList->pOrderScratch);
+    free(pList->pCalls);
+
+    free(pList);
+    pState->renderer.pChunkDrawList = NULL;
+}
+#pragma endregion
+#pragma region Undefines
+#undef DEFAULT_DRAW_CAPACITY
+#undef DEFAULT_INSTANCE_CAPACITY
+#undef MIN_DRAWS_PER_SECONDARY
+#pragma endregion
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <stdint.h>
+#include <vulkan/vulkan.h>
+#include "cmath/cmath.h"
+#include "core/types/state_t.h"
+
+#define CHUNK_DRAW_LIST_INSTANCE_NONE UINT32_MAX
+
+/// @brief Everything outside the chunks' geometry that decides which draws get gathered. While it stays the same and nothing
+/// invalidated the list, the draws gathered last time are still right
+typedef struct ChunkDrawListSource_t
+{
+    Frustumf_t frustum;
+    Vec3i_t cameraChunkPos;
+    // ChunkManager_t::generation, so loading or unloading a chunk (which opens or closes ways through it) gathers again
+    uint64_t chunkSetGeneration;
+    // Landed uploads are swapped in while gathering
+    uint64_t completedUploadSerial;
+} ChunkDrawListSource_t;
+
+/// @brief True when the list was gathered from the same source and hasn't been invalidated since, so gathering it again
+/// would produce the same draws. MAIN THREAD ONLY.
+bool chunkDrawList_source_matches(const State_t *restrict pSTATE, const ChunkDrawListSource_t *restrict pSOURCE);
+
+/// @brief Marks the gathered draws as out of date. Called whenever chunk geometry that may be drawn changes. MAIN THREAD ONLY.
+void chunkDrawList_invalidate(State_t *pState);
+
+/// @brief Clears the list so it can be gathered again from pSOURCE. MAIN THREAD ONLY.
+void chunkDrawList_begin(State_t *restrict pState, const ChunkDrawListSource_t *restrict pSOURCE);
+
+/// @brief Adds a chunk's per-instance data. DEPTH orders the chunk's draws front to back among those sharing a geometry page, and is
+/// the squared distance in chunks from the camera. Returns the instance its draws should use, or CHUNK_DRAW_LIST_INSTANCE_NONE when
+/// the list couldn't grow. MAIN THREAD ONLY.
+uint32_t chunkDrawList_instance_add(State_t *pState, const Vec3i_t CHUNK_ORIGIN, const uint32_t DEPTH);
+
+/// @brief Adds an indexed draw out of the geometry pool's PAGE. MAIN THREAD ONLY.
+void chunkDrawList_draw_add(State_t *pState, const uint16_t PAGE, const uint32_t INDEX_COUNT, const uint32_t FIRST_INDEX,
+                            const int32_t VERTEX_OFFSET, const uint32_t INSTANCE);
+
+/// @brief Sorts the list by geometry page and then depth, writes it into the current frame's indirect and instance buffers, and
+/// records it with one indirect draw per geometry page. The calls are split into ranges recorded into secondaries across the thread
+/// pool, each binding the voxel pipeline itself. Writes up to MAX_SECONDARIES of them to pSecondaries in execution order and
+/// returns how many. A frame slot whose secondaries were recorded from the same gather executes them again as they are. The current
+/// frame's fence must have been waited on. MAIN THREAD ONLY.
+uint32_t chunkDrawList_record(State_t *restrict pState, VkCommandBuffer *restrict pSecondaries, const uint32_t MAX_SECONDARIES);
+
+/// @brief Must be called after the GPU allocator is created
+void chunkDrawList_create(State_t *pState);
+
+void chunkDrawList_destroy(State_t *pState);
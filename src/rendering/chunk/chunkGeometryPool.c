@@ -0,0 +1,345 @@
+#pragma region Includes
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <vulkan/vulkan.h>
+#include "core/logs.h"
+#include "core/crash_handler.h"
+#include "collection/buddyTree_t.h"
+#include "rendering/buffers/buffers.h"
+#include "rendering/buffers/staging_ring.h"
+#include "rendering/chunk/chunkGeometryPool.h"
+#pragma endregion
+#pragma region Defines
+#if defined(DEBUG)
+// #define DEBUG_CHUNK_GEOMETRY_POOL
+#endif
+// Size classes are powers of two of these. A unit is 16 quads worth of vertices and a bit over 21 quads worth of indices
+#define VERTICES_PER_UNIT 64
+#define INDICES_PER_UNIT 128
+// 1M vertices (40 MiB) and 2M indices (8 MiB) per page
+#define VERTEX_LEVELS 14
+#define INDEX_LEVELS 14
+#define VERTEX_REGION_SIZE ((VkDeviceSize)sizeof(ShaderVertexVoxel_t) * VERTICES_PER_UNIT * ((VkDeviceSize)1 << VERTEX_LEVELS))
+#define INDEX_REGION_SIZE ((VkDeviceSize)sizeof(uint32_t) * INDICES_PER_UNIT * ((VkDeviceSize)1 << INDEX_LEVELS))
+// The index region starts right after the vertex region. In indices, since that's what firstIndex counts in
+#define INDEX_REGION_FIRST ((uint32_t)(VERTEX_REGION_SIZE / sizeof(uint32_t)))
+#define DEFAULT_PENDING_CAPACITY 256
+
+/// @brief One device local buffer holding the vertex region followed by the index region, each carved up by its own buddy tree
+typedef struct ChunkGeometryPage_t
+{
+    VkBuffer buffer;
+    GpuAllocation_t allocation;
+    BuddyTree_t *pVertexTree;
+    BuddyTree_t *pIndexTree;
+} ChunkGeometryPage_t;
+
+/// @brief A freed range waiting for the GPU to stop touching it
+typedef struct PendingRangeFree_t
+{
+    // Staging ring serial that may still be copying into the range
+    uint64_t uploadSerial;
+    ChunkGeometryRange_t range;
+} PendingRangeFree_t;
+
+typedef struct ChunkGeometryPool_t
+{
+    ChunkGeometryPage_t *pPages;
+    uint32_t pageCount;
+    // Ranges freed during each frame in flight. Released once that frame's fence has signaled and any upload into them landed
+    PendingRangeFree_t **ppPendingFrees;
+    size_t *pPendingCounts;
+    size_t *pPendingCapacities;
+    uint32_t frameCount;
+} ChunkGeometryPool_t;
+#pragma endregion
+#pragma region Pages
+static bool chunkGeometryPool_page_add(State_t *restrict pState, ChunkGeometryPool_t *restrict pPool)
+{
+    if (pPool->pageCount >= CHUNK_GEOMETRY_MAX_PAGES)
+    {
+        logs_log(LOG_ERROR, "The chunk geometry pool is out of pages (%d)!", CHUNK_GEOMETRY_MAX_PAGES);
+        return false;
+    }
+
+    ChunkGeometryPage_t page = {
+        .pVertexTree = buddyTree_create(VERTEX_LEVELS),
+        .pIndexTree = buddyTree_create(INDEX_LEVELS),
+    };
+
+    if (page.pVertexTree && page.pIndexTree)
+        bufferCreate(pState, VERTEX_REGION_SIZE + INDEX_REGION_SIZE,
+                     VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+                     VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &page.buffer, &page.allocation);
+
+    if (page.allocation.memory == VK_NULL_HANDLE)
+    {
+        logs_log(LOG_ERROR, "Failed to create a chunk geometry page!");
+        bufferDestroy(pState, &page.buffer, &page.allocation);
+        buddyTree_destroy(page.pVertexTree);
+        buddyTree_destroy(page.pIndexTree);
+        return false;
+    }
+
+    ChunkGeometryPage_t *pNew = realloc(pPool->pPages, sizeof(ChunkGeometryPage_t) * (pPool->pageCount + 1));
+    if (!pNew)
+    {
+        bufferDestroy(pState, &page.buffer, &page.allocation);
+        buddyTree_destroy(page.pVertexTree);
+        buddyTree_destroy(page.pIndexTree);
+        return false;
+    }
+
+    pPool->pPages = pNew;
+    pPool->pPages[pPool->pageCount++] = page;
+
+#if defined(DEBUG_CHUNK_GEOMETRY_POOL)
+    logs_log(LOG_DEBUG, "Added chunk geometry page %" PRIu32 " (%" PRIu64 " bytes).", pPool->pageCount - 1,
+             (uint64_t)(VERTEX_REGION_SIZE + INDEX_REGION_SIZE));
+#endif
+
+    return true;
+}
+
+/// @brief Tries to fit both halves of the range into PAGE
+static bool chunkGeometryPool_page_alloc(ChunkGeometryPool_t *restrict pPool, const uint16_t PAGE, const uint8_t VERTEX_ORDER,
+                                         const uint8_t INDEX_ORDER, ChunkGeometryRange_t *restrict pOutRange)
+{
+    ChunkGeometryPage_t *pPage = &pPool->pPages[PAGE];
+    if (buddyTree_largestFreeOrder(pPage->pVertexTree) < (int)VERTEX_ORDER ||
+        buddyTree_largestFreeOrder(pPage->pIndexTree) < (int)INDEX_ORDER)
+        return false;
+
+    const size_t VERTEX_UNIT = buddyTree_alloc(pPage->pVertexTree, VERTEX_ORDER);
+    const size_t INDEX_UNIT = buddyTree_alloc(pPage->pIndexTree, INDEX_ORDER);
+
+    *pOutRange = (ChunkGeometryRange_t){
+        .firstVertex = (uint32_t)(VERTEX_UNIT * VERTICES_PER_UNIT),
+        .firstIndex = INDEX_REGION_FIRST + (uint32_t)(INDEX_UNIT * INDICES_PER_UNIT),
+        .page = PAGE,
+        .vertexOrder = VERTEX_ORDER,
+        .indexOrder = INDEX_ORDER,
+    };
+
+    return true;
+}
+
+static void chunkGeometryPool_range_release(ChunkGeometryPool_t *pPool, const ChunkGeometryRange_t RANGE)
+{
+    if (RANGE.page >= pPool->pageCount)
+        return;
+
+    ChunkGeometryPage_t *pPage = &pPool->pPages[RANGE.page];
+    const size_t VERTEX_UNIT = RANGE.firstVertex / VERTICES_PER_UNIT;
+    const size_t INDEX_UNIT = (RANGE.firstIndex - INDEX_REGION_FIRST) / INDICES_PER_UNIT;
+
+    if (!buddyTree_free(pPage->pVertexTree, VERTEX_UNIT, RANGE.vertexOrder) ||
+        !buddyTree_free(pPage->pIndexTree, INDEX_UNIT, RANGE.indexOrder))
+        logs_log(LOG_ERROR, "Attempted to release an invalid chunk geometry range (page %" PRIu16 ")!", RANGE.page);
+}
+#pragma endregion
+#pragma region Operations
+bool chunkGeometryPool_alloc(State_t *restrict pState, const uint32_t VERTEX_COUNT, const uint32_t INDEX_COUNT,
+                             ChunkGeometryRange_t *restrict pOutRange)
+{
+    if (!pState || !pState->renderer.pChunkGeometryPool || !pOutRange || VERTEX_COUNT == 0 || INDEX_COUNT == 0)
+        return false;
+
+    ChunkGeometryPool_t *pPool = pState->renderer.pChunkGeometryPool;
+
+    const uint8_t VERTEX_ORDER = buddyTree_order_forUnits((VERTEX_COUNT + VERTICES_PER_UNIT - 1) / VERTICES_PER_UNIT);
+    const uint8_t INDEX_ORDER = buddyTree_order_forUnits((INDEX_COUNT + INDICES_PER_UNIT - 1) / INDICES_PER_UNIT);
+    if (VERTEX_ORDER > VERTEX_LEVELS || INDEX_ORDER > INDEX_LEVELS)
+    {
+        logs_log(LOG_ERROR, "A chunk mesh of %" PRIu32 " vertices and %" PRIu32 " indices doesn't fit in a geometry page!",
+                 VERTEX_COUNT, INDEX_COUNT);
+        return false;
+    }
+
+    for (uint32_t page = 0; page < pPool->pageCount; page++)
+    {
+        if (chunkGeometryPool_page_alloc(pPool, (uint16_t)page, VERTEX_ORDER, INDEX_ORDER, pOutRange))
+            return true;
+    }
+
+    if (!chunkGeometryPool_page_add(pState, pPool))
+        return false;
+
+    return chunkGeometryPool_page_alloc(pPool, (uint16_t)(pPool->pageCount - 1), VERTEX_ORDER, INDEX_ORDER, pOutRange);
+}
+
+bool chunkGeometryPool_upload(State_t *restrict pState, const ChunkGeometryRange_t *restrict pRANGE,
+                              const ShaderVertexVoxel_t *restrict pVERTICES, const uint32_t VERTEX_COUNT,
+                              const uint32_t *restrict pINDICES, const uint32_t INDEX_COUNT)
+{
+    if (!pState || !pState->renderer.pChunkGeometryPool || !pRANGE || !pVERTICES || !pINDICES)
+        return false;
+
+    ChunkGeometryPool_t *pPool = pState->renderer.pChunkGeometryPool;
+    if (pRANGE->page >= pPool->pageCount)
+        return false;
+
+    const VkDeviceSize VERTEX_BYTES = sizeof(ShaderVertexVoxel_t) * (VkDeviceSize)VERTEX_COUNT;
+    const VkDeviceSize INDEX_BYTES = sizeof(uint32_t) * (VkDeviceSize)INDEX_COUNT;
+    VkBuffer pageBuffer = pPool->pPages[pRANGE->page].buffer;
+
+    // Filled in before the index reserve, which may flush the vertex copy if the slice runs out
+    void *pVertexStaging = stagingRing_reserve(pState, pageBuffer, sizeof(ShaderVertexVoxel_t) * (VkDeviceSize)pRANGE->firstVertex,
+                                               VERTEX_BYTES);
+    if (!pVertexStaging)
+        return false;
+    memcpy(pVertexStaging, pVERTICES, (size_t)VERTEX_BYTES);
+
+    void *pIndexStaging = stagingRing_reserve(pState, pageBuffer, sizeof(uint32_t) * (VkDeviceSize)pRANGE->firstIndex, INDEX_BYTES);
+    if (!pIndexStaging)
+        return false;
+    memcpy(pIndexStaging, pINDICES, (size_t)INDEX_BYTES);
+
+    return true;
+}
+
+void chunkGeometryPool_free(State_t *restrict pState, ChunkGeometryRange_t *restrict pRange)
+{
+    if (!pState || !pState->renderer.pChunkGeometryPool || !pRange || pRange->page == CHUNK_GEOMETRY_PAGE_NONE)
+        return;
+
+    ChunkGeometryPool_t *pPool = pState->renderer.pChunkGeometryPool;
+    const uint32_t FRAME_INDEX = pState->renderer.currentFrame;
+
+    size_t count = pPool->pPendingCounts[FRAME_INDEX];
+    if (count >= pPool->pPendingCapacities[FRAME_INDEX])
+    {
+        const size_t NEW_CAPACITY = pPool->pPendingCapacities[FRAME_INDEX] * 2;
+        PendingRangeFree_t *pNew = realloc(pPool->ppPendingFrees[FRAME_INDEX], sizeof(PendingRangeFree_t) * NEW_CAPACITY);
+        if (!pNew)
+            crashHandler_crash_graceful(CRASH_LOCATION, "Failed to grow the chunk geometry pool's pending frees!");
+
+        pPool->ppPendingFrees[FRAME_INDEX] = pNew;
+        pPool->pPendingCapacities[FRAME_INDEX] = NEW_CAPACITY;
+    }
+
+    pPool->ppPendingFrees[FRAME_INDEX][count] = (PendingRangeFree_t){
+        .uploadSerial = stagingRing_serial_pending(pState),
+        .range = *pRange,
+    };
+    pPool->pPendingCounts[FRAME_INDEX] = count + 1;
+
+    *pRange = chunkGeometryRange_none();
+}
+
+void chunkGeometryPool_flush(State_t *pState, const uint32_t FRAME_INDEX)
+{
+    if (!pState || !pState->renderer.pChunkGeometryPool)
+        return;
+
+    ChunkGeometryPool_t *pPool = pState->renderer.pChunkGeometryPool;
+    if (FRAME_INDEX >= pPool->frameCount)
+        return;
+
+    // Only bookkeeping, so everything that's ready goes at once. Ranges an upload may still be writing wait for the next round
+    const uint64_t COMPLETED_SERIAL = stagingRing_serial_completed(pState);
+    PendingRangeFree_t *pPending = pPool->ppPendingFrees[FRAME_INDEX];
+    size_t kept = 0;
+    for (size_t i = 0; i < pPool->pPendingCounts[FRAME_INDEX]; i++)
+    {
+        if (pPending[i].uploadSerial > COMPLETED_SERIAL)
+            pPending[kept++] = pPending[i];
+        else
+            chunkGeometryPool_range_release(pPool, pPending[i].range);
+    }
+
+    pPool->pPendingCounts[FRAME_INDEX] = kept;
+}
+
+VkBuffer chunkGeometryPool_buffer_get(const State_t *pSTATE, const uint16_t PAGE)
+{
+    const ChunkGeometryPool_t *pPOOL = pSTATE->renderer.pChunkGeometryPool;
+    if (!pPOOL || PAGE >= pPOOL->pageCount)
+        return VK_NULL_HANDLE;
+
+    return pPOOL->pPages[PAGE].buffer;
+}
+#pragma endregion
+#pragma region Create/Destroy
+void chunkGeometryPool_create(State_t *pState)
+{
+    int crashLine = 0;
+    do
+    {
+        ChunkGeometryPool_t *pPool = calloc(1, sizeof(ChunkGeometryPool_t));
+        if (!pPool)
+        {
+            crashLine = __LINE__;
+            break;
+        }
+
+        // Hooked up first so destroy can clean up a partially created pool
+        pState->renderer.pChunkGeometryPool = pPool;
+
+        pPool->frameCount = pState->config.maxFramesInFlight;
+        pPool->ppPendingFrees = calloc(pPool->frameCount, sizeof(PendingRangeFree_t *));
+        pPool->pPendingCounts = calloc(pPool->frameCount, sizeof(size_t));
+        pPool->pPendingCapacities = calloc(pPool->frameCount, sizeof(size_t));
+        if (!pPool->ppPendingFrees || !pPool->pPendingCounts || !pPool->pPendingCapacities)
+        {
+            crashLine = __LINE__;
+            break;
+        }
+
+        for (uint32_t i = 0; i < pPool->frameCount; i++)
+        {
+            pPool->ppPendingFrees[i] = malloc(sizeof(PendingRangeFree_t) * DEFAULT_PENDING_CAPACITY);
+            if (!pPool->ppPendingFrees[i])
+            {
+                crashLine = __LINE__;
+                break;
+            }
+
+            pPool->pPendingCapacities[i] = DEFAULT_PENDING_CAPACITY;
+        }
+    } while (0);
+
+    if (crashLine != 0)
+        crashHandler_crash_graceful(CRASH_LOCATION_LINE(crashLine), "The program cannot continue without a chunk geometry pool!");
+}
+
+void chunkGeometryPool_destroy(State_t *pState)
+{
+    if (!pState || !pState->renderer.pChunkGeometryPool)
+        return;
+
+    ChunkGeometryPool_t *pPool = pState->renderer.pChunkGeometryPool;
+
+    for (uint32_t i = 0; i < pPool->pageCount; i++)
+    {
+        ChunkGeometryPage_t *pPage = &pPool->pPages[i];
+        bufferDestroy(pState, &pPage->buffer, &pPage->allocation);
+        buddyTree_destroy(pPage->pVertexTree);
+        buddyTree_destroy(pPage->pIndexTree);
+    }
+    free(pPool->pPages);
+
+    if (pPool->ppPendingFrees)
+    {
+        for (uint32_t i = 0; i < pPool->frameCount; i++)
+            free(pPool->ppPendingFrees[i]);
+    }
+    free(pPool->ppPendingFrees);
+    free(pPool->pPendingCounts);
+    free(pPool->pPendingCapacities);
+
+    free(pPool);
+    pState->renderer.pChunkGeometryPool = NULL;
+}
+#pragma endregion
+#pragma region Undefines
+#undef VERTICES_PER_UNIT
+#undef INDICES_PER_UNIT
+#undef VERTEX_LEVELS
+#undef INDEX_LEVELS
+#undef VERTEX_REGION_SIZE
+#undef INDEX_REGION_SIZE
+#undef INDEX_REGION_FIRST
+#undef DEFAULT_PENDING_CAPACITY
+#pragma endregion
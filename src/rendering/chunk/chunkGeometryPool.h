@@ -0,0 +1,35 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <vulkan/vulkan.h>
+#include "core/types/state_t.h"
+#include "rendering/types/chunkGeometryRange_t.h"
+#include "rendering/types/shaderVertexVoxel_t.h"
+
+/// @brief Reserves room for a mesh of VERTEX_COUNT vertices and INDEX_COUNT indices in a page of the pool, adding a page when
+/// none has room. MAIN THREAD ONLY.
+bool chunkGeometryPool_alloc(State_t *restrict pState, const uint32_t VERTEX_COUNT, const uint32_t INDEX_COUNT,
+                             ChunkGeometryRange_t *restrict pOutRange);
+
+/// @brief Writes the mesh into the staging ring and queues its copy into the range it was allocated for. The copy is sent with
+/// the next staging ring flush. MAIN THREAD ONLY.
+bool chunkGeometryPool_upload(State_t *restrict pState, const ChunkGeometryRange_t *restrict pRANGE,
+                              const ShaderVertexVoxel_t *restrict pVERTICES, const uint32_t VERTEX_COUNT,
+                              const uint32_t *restrict pINDICES, const uint32_t INDEX_COUNT);
+
+/// @brief Queues the range to be released once the current frame comes back around (the GPU is done reading it) and any copy
+/// into it has landed, then resets it to none. Ranges that are already none are ignored. MAIN THREAD ONLY.
+void chunkGeometryPool_free(State_t *restrict pState, ChunkGeometryRange_t *restrict pRange);
+
+/// @brief Releases the ranges freed during FRAME_INDEX. Call after that frame's fence has been waited on.
+void chunkGeometryPool_flush(State_t *pState, const uint32_t FRAME_INDEX);
+
+/// @brief The buffer backing PAGE. Bind it as both the vertex and the index buffer (offset 0)
+VkBuffer chunkGeometryPool_buffer_get(const State_t *pSTATE, const uint16_t PAGE);
+
+/// @brief Must be called after the GPU allocator is created
+void chunkGeometryPool_create(State_t *pState);
+
+/// @brief Destroys every page. Ranges still held by chunks are released along with them.
+void chunkGeometryPool_destroy(State_t *pState);
@@ -0,0 +1,394 @@
+#pragma region Includes
+#include <stdlib.h>
+#include <string.h>
+#include <threads.h>
+#include "core/logs.h"
+#include "cmath/cmath.h"
+#include "api/chunk/chunkAPI.h"
+#include "rendering/chunk/chunkMesher.h"
+#include "rendering/types/shaderVertexVoxel_t.h"
+#include "rendering/uvs.h"
+#include "world/chunkSolidityGrid.h"
+#include "world/voxel/block_t.h"
+#pragma endregion
+#pragma region Defines
+#if defined(DEBUG)
+// #define DEBUG_CHUNKMESHER
+#endif
+// Vertex slots per direction bucket, enough for a face on every block
+#define BUCKET_VERTEX_COUNT ((size_t)CMATH_CHUNK_BLOCK_CAPACITY * VERTS_PER_FACE)
+// Distinct blocks tracked per super voxel when voting on its material
+#define LOD_MAX_CANDIDATES 8
+// Offset from a cell to its neighbor across each face. The halo means this never leaves the snapshot
+static const int32_t pFACE_STRIDES[CMATH_GEOM_CUBE_FACES] = {
+    [CUBE_FACE_LEFT] = -CHUNK_MESH_INPUT_STRIDE_X,
+    [CUBE_FACE_RIGHT] = CHUNK_MESH_INPUT_STRIDE_X,
+    [CUBE_FACE_TOP] = CHUNK_MESH_INPUT_STRIDE_Y,
+    [CUBE_FACE_BOTTOM] = -CHUNK_MESH_INPUT_STRIDE_Y,
+    [CUBE_FACE_FRONT] = CHUNK_MESH_INPUT_STRIDE_Z,
+    [CUBE_FACE_BACK] = -CHUNK_MESH_INPUT_STRIDE_Z,
+};
+#pragma endregion
+#pragma region Snapshot
+/// @brief Fills the halo slice on the FACE side from the touching border of pNEIGHBOR. It is transparent if the neighbor isn't
+/// loaded or either side is meshed at a reduced LOD, so the border faces stay and no crack opens between resolutions.
+static void chunkMesher_input_copyHalo(ChunkMeshInput_t *restrict pInput, const Chunk_t *restrict pNEIGHBOR, const CubeFace_e FACE)
+{
+    const uint8_t *pNEIGHBOR_GRID = NULL;
+    if (pNEIGHBOR && chunkState_cpu(pNEIGHBOR) && pNEIGHBOR->pTransparencyGrid && pInput->lod == 0 && pNEIGHBOR->meshLod == 0)
+        pNEIGHBOR_GRID = pNEIGHBOR->pTransparencyGrid->pGrid;
+
+    for (uint8_t u = 0; u < CMATH_CHUNK_AXIS_LENGTH; u++)
+    {
+        for (uint8_t v = 0; v < CMATH_CHUNK_AXIS_LENGTH; v++)
+        {
+            const Vec3u8_t BORDER = cmath_chunk_faceBorderPos(FACE, u, v);
+            const size_t HALO_INDEX = (size_t)((int32_t)chunkSolidityGrid_index16(BORDER.x, BORDER.y, BORDER.z) + pFACE_STRIDES[FACE]);
+
+            if (!pNEIGHBOR_GRID)
+            {
+                pInput->pOpacity[HALO_INDEX] = SOLIDITY_TRANSPARENT;
+                continue;
+            }
+
+            // The block across the border is on the opposite side of the neighbor chunk
+            const Vec3u8_t SOURCE = cmath_chunk_wrapLocalPos(BORDER.x, BORDER.y, BORDER.z, FACE);
+            pInput->pOpacity[HALO_INDEX] = pNEIGHBOR_GRID[chunkSolidityGrid_index16(SOURCE.x, SOURCE.y, SOURCE.z)];
+        }
+    }
+}
+
+bool chunkMesher_input_create(ChunkMeshInput_t *restrict pInput, const Chunk_t *restrict pCHUNK, Chunk_t *const *restrict ppNEIGHBORS)
+{
+    if (!pInput || !pCHUNK || !pCHUNK->pBlockVoxels || !pCHUNK->pTransparencyGrid || !ppNEIGHBORS)
+        return false;
+
+    pInput->chunkPos = pCHUNK->chunkPos;
+    pInput->lod = pCHUNK->meshLod < CHUNK_MESH_LOD_COUNT ? pCHUNK->meshLod : CHUNK_MESH_LOD_COUNT - 1;
+
+    for (size_t i = 0; i < CMATH_CHUNK_POINTS_COUNT; i++)
+        pInput->ppBlockDefinitions[i] = pCHUNK->pBlockVoxels[i].pBLOCK_DEFINITION;
+
+    // Same layout, so the center comes over in one copy and the stale halo gets overwritten face by face
+    memcpy(pInput->pOpacity, pCHUNK->pTransparencyGrid->pGrid, sizeof(pInput->pOpacity));
+
+    for (int face = 0; face < CMATH_GEOM_CUBE_FACES; face++)
+        chunkMesher_input_copyHalo(pInput, ppNEIGHBORS[face], (CubeFace_e)face);
+
+    return true;
+}
+
+bool chunkMesher_border_culledByLoad(const Chunk_t *restrict pLOADED, const Chunk_t *restrict pNEIGHBOR, const CubeFace_e FACE)
+{
+    if (!pLOADED || !pLOADED->pTransparencyGrid || !pNEIGHBOR || !pNEIGHBOR->pBlockVoxels)
+        return false;
+
+    const uint8_t *pLOADED_GRID = pLOADED->pTransparencyGrid->pGrid;
+    for (uint8_t u = 0; u < CMATH_CHUNK_AXIS_LENGTH; u++)
+    {
+        for (uint8_t v = 0; v < CMATH_CHUNK_AXIS_LENGTH; v++)
+        {
+            // The halo only carries opacity and an unloaded chunk reads as transparent, so a transparent block of pLOADED
+            // (present or not) looks exactly like what the neighbor was meshed against. Only its solid blocks can cull
+            const Vec3u8_t BORDER = cmath_chunk_faceBorderPos(FACE, u, v);
+            if (pLOADED_GRID[chunkSolidityGrid_index16(BORDER.x, BORDER.y, BORDER.z)] != SOLIDITY_SOLID)
+                continue;
+
+            // Every present block gets faces, not just solid ones
+            const Vec3u8_t TOUCHING = cmath_chunk_wrapLocalPos(BORDER.x, BORDER.y, BORDER.z, FACE);
+            const BlockDefinition_t *pBLOCK =
+                pNEIGHBOR->pBlockVoxels[xyz_to_chunkBlockIndex(TOUCHING.x, TOUCHING.y, TOUCHING.z)].pBLOCK_DEFINITION;
+            if (pBLOCK && pBLOCK->BLOCK_ID != BLOCK_ID_AIR)
+                return true;
+        }
+    }
+
+    return false;
+}
+#pragma endregion
+#pragma region Scratch
+// Bucketed vertex scratch, one per worker thread. It is several MB so it is allocated on a thread's first mesh and reused by
+// every later one, then freed by the tss destructor when the worker exits
+static once_flag scratchOnce = ONCE_FLAG_INIT;
+static tss_t scratchKey;
+static bool scratchKeyValid = false;
+
+static void chunkMesher_scratch_init(void)
+{
+    scratchKeyValid = tss_create(&scratchKey, free) == thrd_success;
+}
+
+static ShaderVertexVoxel_t *chunkMesher_scratch_get(void)
+{
+    call_once(&scratchOnce, chunkMesher_scratch_init);
+    if (!scratchKeyValid)
+        return NULL;
+
+    ShaderVertexVoxel_t *pScratch = tss_get(scratchKey);
+    if (pScratch)
+        return pScratch;
+
+    pScratch = malloc(sizeof(ShaderVertexVoxel_t) * BUCKET_VERTEX_COUNT * CMATH_GEOM_CUBE_FACES);
+    if (pScratch && tss_set(scratchKey, pScratch) != thrd_success)
+    {
+        free(pScratch);
+        return NULL;
+    }
+
+    return pScratch;
+}
+#pragma endregion
+#pragma region Meshing
+/// @brief Index of the block at local (X, Y, Z) in chunk point order
+static inline size_t chunkMesher_blockIndex(const int X, const int Y, const int Z)
+{
+    return (size_t)X * CMATH_CHUNK_AXIS_LENGTH * CMATH_CHUNK_AXIS_LENGTH + (size_t)Y * CMATH_CHUNK_AXIS_LENGTH + (size_t)Z;
+}
+
+static const uint8_t pCCW_QUAD_VERTS[6] = {0, 1, 3, 0, 3, 2};
+
+static inline void write_face_indices_u32(uint32_t *pIndicies, uint32_t base)
+{
+    pIndicies[0] = base + pCCW_QUAD_VERTS[0];
+    pIndicies[1] = base + pCCW_QUAD_VERTS[1];
+    pIndicies[2] = base + pCCW_QUAD_VERTS[2];
+    pIndicies[3] = base + pCCW_QUAD_VERTS[3];
+    pIndicies[4] = base + pCCW_QUAD_VERTS[4];
+    pIndicies[5] = base + pCCW_QUAD_VERTS[5];
+}
+
+/// @brief Writes one face of a cube of SCALE blocks whose min corner is BASE_POS * SCALE into the FACE bucket
+static inline void chunkMesher_face_emit(ShaderVertexVoxel_t *restrict pVertices, uint32_t *restrict pBucketFaceCounts,
+                                         const BlockDefinition_t *restrict pBLOCK, const Vec3i_t BASE_POS, const int SCALE,
+                                         const int FACE)
+{
+    const FaceTexture_t TEX = pBLOCK->pFACE_TEXTURES[FACE];
+    const Vec2f_t *pUVS = pFACE_UVS_ROTATED[TEX.rotation];
+    const size_t VERTEX_CURSOR = FACE * BUCKET_VERTEX_COUNT + (size_t)pBucketFaceCounts[FACE] * VERTS_PER_FACE;
+
+    // Copy per-face vertices
+    for (int v = 0; v < VERTS_PER_FACE; ++v)
+    {
+        ShaderVertexVoxel_t vert = {0};
+        vert.pos = cmath_vec3i_to_vec3f(cmath_vec3i_mult_scalar(cmath_vec3i_add_vec3i(BASE_POS, pFACE_POSITIONS[FACE][v]), SCALE));
+        vert.color = COLOR_WHITE;
+        // The tile repeats once per block, so a face spanning SCALE blocks keeps the same texel size as a full resolution one
+        vert.texCoord = (Vec2f_t){pUVS[v].x * (float)SCALE, pUVS[v].y * (float)SCALE};
+        vert.textureLayer = TEX.atlasIndex;
+        vert.faceID = FACE;
+        pVertices[VERTEX_CURSOR + v] = vert;
+    }
+
+    pBucketFaceCounts[FACE]++;
+}
+
+/// @brief Full resolution pass. Every block gets the faces that border a transparent cell
+static void chunkMesher_faces_full(const ChunkMeshInput_t *restrict pINPUT, ShaderVertexVoxel_t *restrict pVertices,
+                                   uint32_t *restrict pBucketFaceCounts)
+{
+    const Vec3u8_t *pPOINTS = cmath_chunkPoints_Get();
+    const uint8_t *pOPACITY = pINPUT->pOpacity;
+
+    for (size_t i = 0; i < CMATH_CHUNK_POINTS_COUNT; i++)
+    {
+        const BlockDefinition_t *pBLOCK = pINPUT->ppBlockDefinitions[i];
+
+        if (!pBLOCK || pBLOCK->BLOCK_ID == BLOCK_ID_AIR)
+            continue;
+
+        // Build the visible face mask without branching. Every neighbor is a fixed offset into the same array
+        const size_t INDEX_18 = chunkSolidityGrid_index16(pPOINTS[i].x, pPOINTS[i].y, pPOINTS[i].z);
+        uint32_t visibleFaces = 0;
+        for (int face = 0; face < CMATH_GEOM_CUBE_FACES; ++face)
+            visibleFaces |= (uint32_t)(pOPACITY[(int32_t)INDEX_18 + pFACE_STRIDES[face]] == SOLIDITY_TRANSPARENT) << face;
+
+        // Buried block
+        if (visibleFaces == 0)
+            continue;
+
+        const Vec3i_t BASE_POS = cmath_vec3u8_to_vec3i(pPOINTS[i]);
+        for (int face = 0; face < CMATH_GEOM_CUBE_FACES; ++face)
+        {
+            if (visibleFaces & (1U << face))
+                chunkMesher_face_emit(pVertices, pBucketFaceCounts, pBLOCK, BASE_POS, 1, face);
+        }
+    }
+}
+
+/// @brief Reduced resolution pass. Each cube of STEP^3 blocks becomes one super voxel that takes the most common non air
+/// block inside it, and is only present/solid when more than half of it is.
+static void chunkMesher_faces_lod(const ChunkMeshInput_t *restrict pINPUT, ShaderVertexVoxel_t *restrict pVertices,
+                                  uint32_t *restrict pBucketFaceCounts)
+{
+    const int STEP = 1 << pINPUT->lod;
+    const int SIDE = CMATH_CHUNK_AXIS_LENGTH / STEP;
+    const int HALO_SIDE = SIDE + 2;
+    const uint32_t CELL_BLOCKS = (uint32_t)(STEP * STEP * STEP);
+
+    // Super voxel grid with a transparent halo. The halo is never filled in, so border faces always stay. That acts as a skirt
+    // that covers any gap against a neighbor meshed at a different resolution
+    const BlockDefinition_t *ppCells[(CMATH_CHUNK_AXIS_LENGTH / 2) * (CMATH_CHUNK_AXIS_LENGTH / 2) * (CMATH_CHUNK_AXIS_LENGTH / 2)] = {0};
+    uint8_t pCellOpacity[(CMATH_CHUNK_AXIS_LENGTH / 2 + 2) * (CMATH_CHUNK_AXIS_LENGTH / 2 + 2) * (CMATH_CHUNK_AXIS_LENGTH / 2 + 2)] = {0};
+
+    const int32_t pCELL_STRIDES[CMATH_GEOM_CUBE_FACES] = {
+        [CUBE_FACE_LEFT] = -1,
+        [CUBE_FACE_RIGHT] = 1,
+        [CUBE_FACE_TOP] = HALO_SIDE,
+        [CUBE_FACE_BOTTOM] = -HALO_SIDE,
+        [CUBE_FACE_FRONT] = HALO_SIDE * HALO_SIDE,
+        [CUBE_FACE_BACK] = -HALO_SIDE * HALO_SIDE,
+    };
+
+    for (int cx = 0; cx < SIDE; cx++)
+        for (int cy = 0; cy < SIDE; cy++)
+            for (int cz = 0; cz < SIDE; cz++)
+            {
+                const BlockDefinition_t *ppCandidates[LOD_MAX_CANDIDATES] = {0};
+                uint32_t pCandidateVotes[LOD_MAX_CANDIDATES] = {0};
+                uint32_t candidateCount = 0;
+                uint32_t solidCount = 0;
+                uint32_t presentCount = 0;
+
+                for (int x = cx * STEP; x < (cx + 1) * STEP; x++)
+                    for (int y = cy * STEP; y < (cy + 1) * STEP; y++)
+                        for (int z = cz * STEP; z < (cz + 1) * STEP; z++)
+                        {
+                            const BlockDefinition_t *pBLOCK = pINPUT->ppBlockDefinitions[chunkMesher_blockIndex(x, y, z)];
+                            if (!pBLOCK || pBLOCK->BLOCK_ID == BLOCK_ID_AIR)
+                                continue;
+
+                            presentCount++;
+                            solidCount += pINPUT->pOpacity[chunkSolidityGrid_index16((uint8_t)x, (uint8_t)y, (uint8_t)z)] == SOLIDITY_SOLID;
+
+                            uint32_t c = 0;
+                            while (c < candidateCount && ppCandidates[c] != pBLOCK)
+                                c++;
+
+                            // Ran out of slots, the vote is close enough without the rare ones
+                            if (c == LOD_MAX_CANDIDATES)
+                                continue;
+
+                            if (c == candidateCount)
+                                ppCandidates[candidateCount++] = pBLOCK;
+                            pCandidateVotes[c]++;
+                        }
+
+                if (presentCount * 2 <= CELL_BLOCKS)
+                    continue;
+
+                uint32_t winner = 0;
+                for (uint32_t c = 1; c < candidateCount; c++)
+                {
+                    if (pCandidateVotes[c] > pCandidateVotes[winner])
+                        winner = c;
+                }
+
+                ppCells[cx + cy * SIDE + cz * SIDE * SIDE] = ppCandidates[winner];
+                pCellOpacity[(cx + 1) + (cy + 1) * HALO_SIDE + (cz + 1) * HALO_SIDE * HALO_SIDE] =
+                    (uint8_t)(solidCount * 2 > CELL_BLOCKS ? SOLIDITY_SOLID : SOLIDITY_TRANSPARENT);
+            }
+
+    for (int cx = 0; cx < SIDE; cx++)
+        for (int cy = 0; cy < SIDE; cy++)
+            for (int cz = 0; cz < SIDE; cz++)
+            {
+                const BlockDefinition_t *pBLOCK = ppCells[cx + cy * SIDE + cz * SIDE * SIDE];
+                if (!pBLOCK)
+                    continue;
+
+                const int32_t HALO_INDEX = (cx + 1) + (cy + 1) * HALO_SIDE + (cz + 1) * HALO_SIDE * HALO_SIDE;
+                const Vec3i_t BASE_POS = {cx, cy, cz};
+                for (int face = 0; face < CMATH_GEOM_CUBE_FACES; ++face)
+                {
+                    if (pCellOpacity[HALO_INDEX + pCELL_STRIDES[face]] == SOLIDITY_TRANSPARENT)
+                        chunkMesher_face_emit(pVertices, pBucketFaceCounts, pBLOCK, BASE_POS, STEP, face);
+                }
+            }
+}
+
+bool chunkMesher_mesh(const ChunkMeshInput_t *restrict pINPUT, ChunkMesh_t *restrict pOutMesh)
+{
+    if (!pINPUT || !pOutMesh || pINPUT->lod >= CHUNK_MESH_LOD_COUNT)
+        return false;
+
+    memset(pOutMesh, 0, sizeof(*pOutMesh));
+
+    if (!cmath_chunkPoints_Get())
+        return false;
+
+    // Every face direction gets its own bucket big enough for a face on every block, so each bucket can be filled in one pass
+    ShaderVertexVoxel_t *pScratch = chunkMesher_scratch_get();
+    if (!pScratch)
+        return false;
+
+    uint32_t pBucketFaceCounts[CMATH_GEOM_CUBE_FACES] = {0};
+
+    if (pINPUT->lod == 0)
+        chunkMesher_faces_full(pINPUT, pScratch, pBucketFaceCounts);
+    else
+        chunkMesher_faces_lod(pINPUT, pScratch, pBucketFaceCounts);
+
+    uint32_t faceCount = 0;
+    for (int face = 0; face < CMATH_GEOM_CUBE_FACES; ++face)
+        faceCount += pBucketFaceCounts[face];
+
+    // Meshing succeeded and nothing to draw (full chunk and surrounded)
+    if (faceCount == 0)
+        return true;
+
+    // The result is sized exactly, the scratch stays with the worker for its next job
+    ShaderVertexVoxel_t *pVertices = malloc(sizeof(ShaderVertexVoxel_t) * faceCount * VERTS_PER_FACE);
+    uint32_t *pIndices = malloc(sizeof(uint32_t) * faceCount * INDICIES_PER_FACE);
+    if (!pVertices || !pIndices)
+    {
+        free(pVertices);
+        free(pIndices);
+        return false;
+    }
+
+    // Pack the buckets back to back and record each one's index range
+    uint32_t vertexCursor = 0;
+    uint32_t indexCursor = 0;
+    for (int face = 0; face < CMATH_GEOM_CUBE_FACES; ++face)
+    {
+        const uint32_t BUCKET_FACES = pBucketFaceCounts[face];
+        pOutMesh->pSections[face].firstIndex = indexCursor;
+        pOutMesh->pSections[face].indexCount = BUCKET_FACES * INDICIES_PER_FACE;
+
+        if (BUCKET_FACES == 0)
+            continue;
+
+        memcpy(&pVertices[vertexCursor], &pScratch[face * BUCKET_VERTEX_COUNT],
+               sizeof(ShaderVertexVoxel_t) * BUCKET_FACES * VERTS_PER_FACE);
+
+        for (uint32_t f = 0; f < BUCKET_FACES; ++f)
+        {
+            write_face_indices_u32(&pIndices[indexCursor], vertexCursor);
+            vertexCursor += VERTS_PER_FACE;
+            indexCursor += INDICIES_PER_FACE;
+        }
+    }
+
+    pOutMesh->pVertices = pVertices;
+    pOutMesh->pIndices = pIndices;
+    pOutMesh->vertexCount = vertexCursor;
+    pOutMesh->indexCount = indexCursor;
+
+#if defined(DEBUG_CHUNKMESHER)
+    logs_log(LOG_DEBUG, "Meshed chunk (%d, %d, %d) at LOD %u into %u vertices and %u indices.",
+             pINPUT->chunkPos.x, pINPUT->chunkPos.y, pINPUT->chunkPos.z, pINPUT->lod, vertexCursor, indexCursor);
+#endif
+
+    return true;
+}
+
+void chunkMesher_mesh_destroy(ChunkMesh_t *pMesh)
+{
+    if (!pMesh)
+        return;
+
+    free(pMesh->pVertices);
+    free(pMesh->pIndices);
+    memset(pMesh, 0, sizeof(*pMesh));
+}
+#pragma endregion
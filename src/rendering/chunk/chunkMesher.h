@@ -0,0 +1,25 @@
+#pragma region Includes
+#pragma once
+#include <stdbool.h>
+#include "api/chunk/chunkAPI.h"
+#include "rendering/types/chunkMesh_t.h"
+#include "rendering/types/chunkMeshInput_t.h"
+#pragma endregion
+#pragma region Snapshot
+/// @brief Copies the block data and opacity of pCHUNK plus the touching border slice of each loaded neighbor in ppNEIGHBORS
+/// (indexed by CubeFace_e, entries may be NULL) into the 18^3 halo of pInput. MAIN THREAD ONLY.
+bool chunkMesher_input_create(ChunkMeshInput_t *restrict pInput, const Chunk_t *restrict pCHUNK, Chunk_t *const *restrict ppNEIGHBORS);
+
+/// @brief Checks if loading pLOADED culls any face already meshed for pNEIGHBOR, the chunk on its FACE side. That is a present
+/// (non air) neighbor border block touching a solid block of pLOADED. MAIN THREAD ONLY.
+bool chunkMesher_border_culledByLoad(const Chunk_t *restrict pLOADED, const Chunk_t *restrict pNEIGHBOR, const CubeFace_e FACE);
+#pragma endregion
+#pragma region Meshing
+/// @brief Builds the vertex/index data for the snapshot. Pure CPU work that touches nothing but its arguments, the calling
+/// thread's scratch and the read-only cmath lookup tables, so it is safe to run on any thread. pOutMesh is left empty when
+/// nothing is visible.
+bool chunkMesher_mesh(const ChunkMeshInput_t *restrict pINPUT, ChunkMesh_t *restrict pOutMesh);
+
+/// @brief Frees the vertex/index arrays of the mesh
+void chunkMesher_mesh_destroy(ChunkMesh_t *pMesh);
+#pragma endregion
@@ -0,0 +1,324 @@
+#pragma region Includes
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include "core/logs.h"
+#include "core/crash_handler.h"
+#include "world/chunkVisibility.h"
+#include "rendering/chunk/chunkOcclusion.h"
+#pragma endregion
+#pragma region Defines
+#if defined(DEBUG)
+// #define DEBUG_CHUNK_OCCLUSION
+#endif
+#define DEFAULT_CAPACITY 1024
+// Past this many cells (64^3) the grid isn't worth building and everything gathered is treated as visible
+#define MAX_GRID_CELLS (1U << 18)
+
+typedef struct ChunkOcclusion_t
+{
+    // Gathered chunks, compacted down to the reached ones by the search
+    Chunk_t **ppChunks;
+    uint32_t count;
+    uint32_t capacity;
+    // Dense grid over the gathered chunks, rebuilt every search
+    uint64_t *pConnectivity;
+    uint8_t *pEntered;
+    ChunkOcclusionStep_t *pQueue;
+    uint32_t cellCapacity;
+    ChunkOcclusionStats_t stats;
+} ChunkOcclusion_t;
+
+// Step taken when leaving a chunk through each CubeFace_e
+static const Vec3i_t pFACE_STEPS[CMATH_GEOM_CUBE_FACES] = {
+    {-1, 0, 0},
+    {1, 0, 0},
+    {0, 1, 0},
+    {0, -1, 0},
+    {0, 0, 1},
+    {0, 0, -1},
+};
+#pragma endregion
+#pragma region Search
+/// @brief Faces come in opposite pairs (left/right, top/bottom, front/back)
+static inline uint32_t chunkOcclusion_face_opposite(const uint32_t FACE)
+{
+    return FACE ^ 1U;
+}
+
+uint32_t chunkOcclusion_grid_search(const uint64_t *restrict pCONNECTIVITY, const Vec3i_t SIZE, const Vec3i_t START,
+                                    uint8_t *restrict pEntered, ChunkOcclusionStep_t *restrict pQueue)
+{
+    if (!pCONNECTIVITY || !pEntered || !pQueue || SIZE.x <= 0 || SIZE.y <= 0 || SIZE.z <= 0)
+        return 0;
+
+    const uint32_t CELL_COUNT = (uint32_t)SIZE.x * (uint32_t)SIZE.y * (uint32_t)SIZE.z;
+    memset(pEntered, 0, CELL_COUNT);
+
+    if (START.x < 0 || START.y < 0 || START.z < 0 || START.x >= SIZE.x || START.y >= SIZE.y || START.z >= SIZE.z)
+        return 0;
+
+    const int32_t pSTRIDES[CMATH_GEOM_CUBE_FACES] = {
+        -1, 1, SIZE.x, -SIZE.x, SIZE.x * SIZE.y, -SIZE.x * SIZE.y,
+    };
+
+    const uint32_t START_CELL = (uint32_t)(START.x + START.y * SIZE.x + START.z * SIZE.x * SIZE.y);
+    pEntered[START_CELL] = CHUNK_OCCLUSION_ENTERED_START;
+    pQueue[0] = (ChunkOcclusionStep_t){.cell = START_CELL, .enteredFace = CMATH_GEOM_CUBE_FACES, .directions = 0};
+
+    uint32_t head = 0;
+    uint32_t tail = 1;
+    uint32_t reachedCount = 1;
+
+    while (head < tail)
+    {
+        const ChunkOcclusionStep_t STEP = pQueue[head++];
+        const uint64_t CONNECTIVITY = pCONNECTIVITY[STEP.cell];
+
+        const int32_t CELL = (int32_t)STEP.cell;
+        const int32_t X = CELL % SIZE.x;
+        const int32_t Y = (CELL / SIZE.x) % SIZE.y;
+        const int32_t Z = CELL / (SIZE.x * SIZE.y);
+
+        for (uint32_t face = 0; face < CMATH_GEOM_CUBE_FACES; face++)
+        {
+            // Never head back against a direction already taken
+            if (STEP.directions & (1U << chunkOcclusion_face_opposite(face)))
+                continue;
+
+            // The camera's own chunk sees out of every face
+            if (STEP.enteredFace < CMATH_GEOM_CUBE_FACES &&
+                !chunkVisibility_faces_connected(CONNECTIVITY, (CubeFace_e)STEP.enteredFace, (CubeFace_e)face))
+                continue;
+
+            const Vec3i_t NEXT = {X + pFACE_STEPS[face].x, Y + pFACE_STEPS[face].y, Z + pFACE_STEPS[face].z};
+            if (NEXT.x < 0 || NEXT.y < 0 || NEXT.z < 0 || NEXT.x >= SIZE.x || NEXT.y >= SIZE.y || NEXT.z >= SIZE.z)
+                continue;
+
+            // Entering through a face already entered through can't lead anywhere new
+            const uint32_t NEXT_CELL = (uint32_t)(CELL + pSTRIDES[face]);
+            const uint32_t ENTERED_FACE = chunkOcclusion_face_opposite(face);
+            if (pEntered[NEXT_CELL] & (1U << ENTERED_FACE))
+                continue;
+
+            reachedCount += pEntered[NEXT_CELL] == 0;
+            pEntered[NEXT_CELL] |= (uint8_t)(1U << ENTERED_FACE);
+            pQueue[tail++] = (ChunkOcclusionStep_t){
+                .cell = NEXT_CELL,
+                .enteredFace = (uint8_t)ENTERED_FACE,
+                .directions = (uint8_t)(STEP.directions | (1U << face)),
+            };
+        }
+    }
+
+    return reachedCount;
+}
+#pragma endregion
+#pragma region Gathering
+void chunkOcclusion_begin(State_t *pState)
+{
+    if (!pState || !pState->renderer.pChunkOcclusion)
+        return;
+
+    pState->renderer.pChunkOcclusion->count = 0;
+}
+
+void chunkOcclusion_chunk_add(State_t *restrict pState, Chunk_t *restrict pChunk)
+{
+    if (!pState || !pState->renderer.pChunkOcclusion || !pChunk)
+        return;
+
+    ChunkOcclusion_t *pOcclusion = pState->renderer.pChunkOcclusion;
+    if (pOcclusion->count == pOcclusion->capacity)
+    {
+        const uint32_t NEW_CAPACITY = pOcclusion->capacity ? pOcclusion->capacity * 2 : DEFAULT_CAPACITY;
+        Chunk_t **ppNewChunks = realloc(pOcclusion->ppChunks, sizeof(Chunk_t *) * NEW_CAPACITY);
+        if (!ppNewChunks)
+        {
+            logs_log(LOG_ERROR, "Failed to grow the chunk occlusion list!");
+            return;
+        }
+
+        pOcclusion->ppChunks = ppNewChunks;
+        pOcclusion->capacity = NEW_CAPACITY;
+    }
+
+    pOcclusion->ppChunks[pOcclusion->count++] = pChunk;
+}
+
+static bool chunkOcclusion_cells_reserve(ChunkOcclusion_t *pOcclusion, const uint32_t CELL_COUNT)
+{
+    if (CELL_COUNT <= pOcclusion->cellCapacity)
+        return true;
+
+    uint32_t newCapacity = pOcclusion->cellCapacity ? pOcclusion->cellCapacity : DEFAULT_CAPACITY;
+    while (newCapacity < CELL_COUNT)
+        newCapacity *= 2;
+
+    uint64_t *pNewConnectivity = realloc(pOcclusion->pConnectivity, sizeof(uint64_t) * newCapacity);
+    if (!pNewConnectivity)
+        return false;
+    pOcclusion->pConnectivity = pNewConnectivity;
+
+    uint8_t *pNewEntered = realloc(pOcclusion->pEntered, newCapacity);
+    if (!pNewEntered)
+        return false;
+    pOcclusion->pEntered = pNewEntered;
+
+    // Every cell can be entered once through each face, plus the start
+    const size_t QUEUE_LENGTH = (size_t)newCapacity * CMATH_GEOM_CUBE_FACES + 1;
+    ChunkOcclusionStep_t *pNewQueue = realloc(pOcclusion->pQueue, sizeof(ChunkOcclusionStep_t) * QUEUE_LENGTH);
+    if (!pNewQueue)
+        return false;
+    pOcclusion->pQueue = pNewQueue;
+
+    pOcclusion->cellCapacity = newCapacity;
+    return true;
+}
+
+/// @brief Only chunks that finished generating know their connectivity. Anything else could be hiding nothing
+static inline uint64_t chunkOcclusion_chunk_connectivity(const Chunk_t *pCHUNK)
+{
+    const ChunkState_e STATE = pCHUNK->chunkState;
+    if (STATE == CHUNK_STATE_CPU_ONLY || STATE == CHUNK_STATE_CPU_GPU)
+        return pCHUNK->faceConnectivity;
+
+    return CHUNK_VISIBILITY_ALL;
+}
+
+Chunk_t **chunkOcclusion_search(State_t *restrict pState, const Vec3i_t CAMERA_CHUNK_POS, uint32_t *restrict pReachedCount)
+{
+    if (pReachedCount)
+        *pReachedCount = 0;
+    if (!pState || !pState->renderer.pChunkOcclusion || !pReachedCount)
+        return NULL;
+
+    ChunkOcclusion_t *pOcclusion = pState->renderer.pChunkOcclusion;
+
+    // Grid bounds cover every gathered chunk and the camera
+    Vec3i_t min = CAMERA_CHUNK_POS;
+    Vec3i_t max = CAMERA_CHUNK_POS;
+    for (uint32_t i = 0; i < pOcclusion->count; i++)
+    {
+        const Vec3i_t POS = pOcclusion->ppChunks[i]->chunkPos;
+        min = (Vec3i_t){POS.x < min.x ? POS.x : min.x, POS.y < min.y ? POS.y : min.y, POS.z < min.z ? POS.z : min.z};
+        max = (Vec3i_t){POS.x > max.x ? POS.x : max.x, POS.y > max.y ? POS.y : max.y, POS.z > max.z ? POS.z : max.z};
+    }
+
+    const Vec3i_t SIZE = {max.x - min.x + 1, max.y - min.y + 1, max.z - min.z + 1};
+    const uint64_t CELL_COUNT = (uint64_t)SIZE.x * (uint64_t)SIZE.y * (uint64_t)SIZE.z;
+
+    ChunkOcclusionStats_t *pStats = &pOcclusion->stats;
+    pStats->gathered = pOcclusion->count;
+    pStats->frames++;
+    pStats->gatheredTotal += pOcclusion->count;
+
+    if (CELL_COUNT > MAX_GRID_CELLS || !chunkOcclusion_cells_reserve(pOcclusion, (uint32_t)CELL_COUNT))
+    {
+        pStats->reached = pOcclusion->count;
+        pStats->occluded = 0;
+        *pReachedCount = pOcclusion->count;
+        return pOcclusion->ppChunks;
+    }
+
+    // Cells without a chunk are open, so the search carries on past holes in what's loaded
+    for (uint32_t i = 0; i < (uint32_t)CELL_COUNT; i++)
+        pOcclusion->pConnectivity[i] = CHUNK_VISIBILITY_ALL;
+
+    for (uint32_t i = 0; i < pOcclusion->count; i++)
+    {
+        const Chunk_t *pCHUNK = pOcclusion->ppChunks[i];
+        const Vec3i_t CELL = cmath_vec3i_sub_vec3i(pCHUNK->chunkPos, min);
+        pOcclusion->pConnectivity[CELL.x + CELL.y * SIZE.x + CELL.z * SIZE.x * SIZE.y] = chunkOcclusion_chunk_connectivity(pCHUNK);
+    }
+
+    chunkOcclusion_grid_search(pOcclusion->pConnectivity, SIZE, cmath_vec3i_sub_vec3i(CAMERA_CHUNK_POS, min), pOcclusion->pEntered,
+                               pOcclusion->pQueue);
+
+    // Compact the reached chunks to the front, keeping their order
+    uint32_t kept = 0;
+    for (uint32_t i = 0; i < pOcclusion->count; i++)
+    {
+        Chunk_t *pChunk = pOcclusion->ppChunks[i];
+        const Vec3i_t CELL = cmath_vec3i_sub_vec3i(pChunk->chunkPos, min);
+        if (pOcclusion->pEntered[CELL.x + CELL.y * SIZE.x + CELL.z * SIZE.x * SIZE.y])
+            pOcclusion->ppChunks[kept++] = pChunk;
+    }
+
+    pStats->reached = kept;
+    pStats->occluded = pOcclusion->count - kept;
+    pStats->occludedTotal += pStats->occluded;
+
+    *pReachedCount = kept;
+    return pOcclusion->ppChunks;
+}
+#pragma endregion
+#pragma region Stats
+ChunkOcclusionStats_t chunkOcclusion_stats_get(const State_t *pSTATE)
+{
+    if (!pSTATE || !pSTATE->renderer.pChunkOcclusion)
+        return (ChunkOcclusionStats_t){0};
+
+    return pSTATE->renderer.pChunkOcclusion->stats;
+}
+
+void chunkOcclusion_stats_log(const State_t *pSTATE)
+{
+    const ChunkOcclusionStats_t STATS = chunkOcclusion_stats_get(pSTATE);
+    const double OCCLUDED_PERCENT = STATS.gatheredTotal ? 100.0 * (double)STATS.occludedTotal / (double)STATS.gatheredTotal : 0.0;
+
+    logs_log(LOG_DEBUG, "Chunk occlusion: %u of %u chunks reached last frame. %.1f%% occluded over %" PRIu64 " frames.",
+             STATS.reached, STATS.gathered, OCCLUDED_PERCENT, STATS.frames);
+}
+#pragma endregion
+#pragma region Create/Destroy
+void chunkOcclusion_create(State_t *pState)
+{
+    int crashLine = 0;
+    do
+    {
+        ChunkOcclusion_t *pOcclusion = calloc(1, sizeof(ChunkOcclusion_t));
+        if (!pOcclusion)
+        {
+            crashLine = __LINE__;
+            break;
+        }
+
+        // Hooked up first so destroy can clean up partially grown arrays
+        pState->renderer.pChunkOcclusion = pOcclusion;
+
+        if (!chunkOcclusion_cells_reserve(pOcclusion, DEFAULT_CAPACITY))
+        {
+            crashLine = __LINE__;
+            break;
+        }
+    } while (0);
+
+    if (crashLine != 0)
+        crashHandler_crash_graceful(CRASH_LOCATION_LINE(crashLine), "The program cannot continue without chunk occlusion!");
+}
+
+void chunkOcclusion_destroy(State_t *pState)
+{
+    if (!pState || !pState->renderer.pChunkOcclusion)
+        return;
+
+    ChunkOcclusion_t *pOcclusion = pState->renderer.pChunkOcclusion;
+
+#if defined(DEBUG_CHUNK_OCCLUSION)
+    chunkOcclusion_stats_log(pState);
+#endif
+
+    free(pOcclusion->ppChunks);
+    free(pOcclusion->pConnectivity);
+    free(pOcclusion->pEntered);
+    free(pOcclusion->pQueue);
+
+    free(pOcclusion);
+    pState->renderer.pChunkOcclusion = NULL;
+}
+#pragma endregion
+#pragma region Undefines
+#undef DEFAULT_CAPACITY
+#undef MAX_GRID_CELLS
+#pragma endregion
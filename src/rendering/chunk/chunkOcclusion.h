@@ -0,0 +1,56 @@
+#pragma once
+
+#include <stdint.h>
+#include "cmath/cmath.h"
+#include "core/types/state_t.h"
+#include "api/chunk/chunkAPI.h"
+
+// Cells the search starts from have this set, on top of a bit per CubeFace_e they were entered through
+#define CHUNK_OCCLUSION_ENTERED_START (1U << CMATH_GEOM_CUBE_FACES)
+
+typedef struct ChunkOcclusionStep_t
+{
+    uint32_t cell;
+    // CubeFace_e the cell was entered through, CMATH_GEOM_CUBE_FACES for the start
+    uint8_t enteredFace;
+    // Bit per CubeFace_e direction stepped in so far
+    uint8_t directions;
+} ChunkOcclusionStep_t;
+
+typedef struct ChunkOcclusionStats_t
+{
+    // Last searched frame
+    uint32_t gathered;
+    uint32_t reached;
+    uint32_t occluded;
+    // Since startup
+    uint64_t frames;
+    uint64_t gatheredTotal;
+    uint64_t occludedTotal;
+} ChunkOcclusionStats_t;
+
+/// @brief Breadth first search through a dense SIZE grid of chunk face connectivity (see chunkVisibility.h), cell x + y * SIZE.x +
+/// z * SIZE.x * SIZE.y, starting from the camera's cell START. A cell entered through one face is only left through faces that
+/// face connects to, and never back against a direction already stepped in, so paths can't double back around walls.
+/// pEntered gets a bit per face each cell was entered through (nonzero means reached). pQueue needs room for SIZE cells * 6 + 1.
+/// Returns how many cells were reached
+uint32_t chunkOcclusion_grid_search(const uint64_t *restrict pCONNECTIVITY, const Vec3i_t SIZE, const Vec3i_t START,
+                                    uint8_t *restrict pEntered, ChunkOcclusionStep_t *restrict pQueue);
+
+/// @brief Clears the chunks gathered for the last frame. MAIN THREAD ONLY.
+void chunkOcclusion_begin(State_t *pState);
+
+/// @brief Gathers a loaded chunk, meshed or not, so the next search can walk through it. MAIN THREAD ONLY.
+void chunkOcclusion_chunk_add(State_t *restrict pState, Chunk_t *restrict pChunk);
+
+/// @brief Searches out from CAMERA_CHUNK_POS through open chunk faces and returns the gathered chunks that can be seen, with their
+/// count in pReachedCount. The array stays valid until the next begin. MAIN THREAD ONLY.
+Chunk_t **chunkOcclusion_search(State_t *restrict pState, const Vec3i_t CAMERA_CHUNK_POS, uint32_t *restrict pReachedCount);
+
+ChunkOcclusionStats_t chunkOcclusion_stats_get(const State_t *pSTATE);
+
+void chunkOcclusion_stats_log(const State_t *pSTATE);
+
+void chunkOcclusion_create(State_t *pState);
+
+void chunkOcclusion_destroy(State_t *pState);
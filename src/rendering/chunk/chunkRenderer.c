@@ -1,12 +1,23 @@
 #pragma region Includes
 #include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <threads.h>
+#include <GLFW/glfw3.h>
+#include "core/logs.h"
 #include "core/types/state_t.h"
 #include "world/worldState_t.h"
-#include "collection/dynamicStack_t.h"
+#include "collection/ringQueue_t.h"
+#include "collection/linkedList_t.h"
 #include "rendering/chunk/chunkRendering.h"
+#include "rendering/chunk/chunkRenderer.h"
+#include "rendering/chunk/chunkMesher.h"
+#include "rendering/buffers/staging_ring.h"
 #include "world/chunkManager.h"
 #include "core/cpuManager.h"
 #include "api/chunk/chunkAPI.h"
+#include "threading/threadPool.h"
+#include "character/character.h"
 #pragma endregion
 #pragma region Defines
 #if defined(DEBUG)
@@ -16,29 +27,254 @@ static uint32_t remeshQueueSize = 0;
 static uint32_t remeshCount = 0;
 #endif
 #endif
-#define DEFAULT_QUEUE_SIZE 32
+#define DEFAULT_QUEUE_SIZE 256
+// How many chunks from the front of the queue are considered per batch, as a multiple of the batch size. The nearest ones in
+// that window are meshed first, the rest keep their place in line
+#define PRIORITY_WINDOW_FACTOR 8
+// Chunks popped from the remesh queue per frame, per worker thread
 #define MAX_REMESH_PER_FRAME 5
+// Chebyshev distance (in chunks) from the camera at which each coarser LOD takes over
+static const int32_t pLOD_DISTANCES[CHUNK_MESH_LOD_COUNT - 1] = {8, 16, 32};
+// How far (in chunks) past a LOD boundary the camera has to move before a chunk switches, so it doesn't flip back and forth
+#define LOD_HYSTERESIS 1
+// Upper bound on snapshots waiting in the pool per worker. Keeps snapshot memory bounded when the queue is large
+#define MAX_JOBS_IN_FLIGHT_PER_THREAD 8
+
+/// @brief Everything a worker needs to mesh one chunk plus the result it hands back to the main thread
+typedef struct ChunkMeshJob_t
+{
+    ChunkMeshInput_t input;
+    ChunkMesh_t mesh;
+    Chunk_t *pChunk;
+    ChunkRenderer_t *pChunkRenderer;
+    struct ChunkMeshJob_t *pNext;
+    bool result;
+} ChunkMeshJob_t;
+#pragma endregion
+#pragma region LOD
+static inline uint8_t chunkRenderer_lod_forDistance(const int32_t DISTANCE)
+{
+    uint8_t lod = 0;
+    while (lod < CHUNK_MESH_LOD_COUNT - 1 && DISTANCE >= pLOD_DISTANCES[lod])
+        lod++;
+
+    return lod;
+}
+
+/// @brief Picks the LOD for the chunk from its distance to the camera. Only moves away from CURRENT_LOD once the camera is
+/// LOD_HYSTERESIS chunks past the boundary.
+static uint8_t chunkRenderer_lod_select(const Vec3i_t CHUNK_POS, const Vec3i_t CAMERA_CHUNK_POS, const uint8_t CURRENT_LOD)
+{
+    const int32_t DX = abs(CHUNK_POS.x - CAMERA_CHUNK_POS.x);
+    const int32_t DY = abs(CHUNK_POS.y - CAMERA_CHUNK_POS.y);
+    const int32_t DZ = abs(CHUNK_POS.z - CAMERA_CHUNK_POS.z);
+    const int32_t DISTANCE = DX > DY ? (DX > DZ ? DX : DZ) : (DY > DZ ? DY : DZ);
+
+    const uint8_t COARSER = chunkRenderer_lod_forDistance(DISTANCE - LOD_HYSTERESIS);
+    if (COARSER > CURRENT_LOD)
+        return COARSER;
+
+    const uint8_t FINER = chunkRenderer_lod_forDistance(DISTANCE + LOD_HYSTERESIS);
+    if (FINER < CURRENT_LOD)
+        return FINER;
+
+    return CURRENT_LOD;
+}
+
+/// @brief When the camera enters a new chunk, queues every meshed chunk whose LOD should change. The old mesh keeps drawing
+/// until the new one is uploaded, so transitions never leave a hole.
+static void chunkRenderer_lod_update(State_t *pState, const Vec3i_t CAMERA_CHUNK_POS)
+{
+    ChunkRenderer_t *pChunkRenderer = &pState->pWorldState->chunkRenderer;
+    if (pChunkRenderer->lodCameraValid && cmath_vec3i_equals(pChunkRenderer->lodCameraChunkPos, CAMERA_CHUNK_POS, 0))
+        return;
+
+    pChunkRenderer->lodCameraChunkPos = CAMERA_CHUNK_POS;
+    pChunkRenderer->lodCameraValid = true;
+
+    for (LinkedList_t *pCurrent = pState->pWorldState->pChunkManager->pChunksLL; pCurrent; pCurrent = pCurrent->pNext)
+    {
+        Chunk_t *pChunk = (Chunk_t *)pCurrent->pData;
+        if (!pChunk || !chunkState_gpu(pChunk))
+            continue;
+
+        if (chunkRenderer_lod_select(pChunk->chunkPos, CAMERA_CHUNK_POS, pChunk->meshLod) != pChunk->meshLod)
+            chunkRenderer_enqueueRemesh(pState->pWorldState, pChunk);
+    }
+}
+#pragma endregion
+#pragma region Jobs
+/// @brief Worker thread entry. Meshes the snapshot and hands the job back through the completed list
+static void chunkRenderer_job_run(void *pCtx)
+{
+    ChunkMeshJob_t *pJob = (ChunkMeshJob_t *)pCtx;
+
+    pJob->result = chunkMesher_mesh(&pJob->input, &pJob->mesh);
+
+    ChunkRenderer_t *pChunkRenderer = pJob->pChunkRenderer;
+    pJob->pNext = NULL;
+
+    mtx_lock(&pChunkRenderer->completedLock);
+    if (pChunkRenderer->pCompletedTail)
+        pChunkRenderer->pCompletedTail->pNext = pJob;
+    else
+        pChunkRenderer->pCompletedHead = pJob;
+    pChunkRenderer->pCompletedTail = pJob;
+    mtx_unlock(&pChunkRenderer->completedLock);
+}
+
+static ChunkMeshJob_t *chunkRenderer_job_popCompleted(ChunkRenderer_t *pChunkRenderer)
+{
+    mtx_lock(&pChunkRenderer->completedLock);
+    ChunkMeshJob_t *pJob = pChunkRenderer->pCompletedHead;
+    if (pJob)
+    {
+        pChunkRenderer->pCompletedHead = pJob->pNext;
+        if (!pChunkRenderer->pCompletedHead)
+            pChunkRenderer->pCompletedTail = NULL;
+    }
+    mtx_unlock(&pChunkRenderer->completedLock);
+
+    return pJob;
+}
+
+static void chunkRenderer_job_destroy(ChunkMeshJob_t *pJob)
+{
+    if (!pJob)
+        return;
+
+    chunkMesher_mesh_destroy(&pJob->mesh);
+    free(pJob);
+}
+
+/// @brief Snapshots the chunk and its neighbors on the main thread and hands the meshing off to the thread pool. If the chunk
+/// already has a job in flight it is marked stale and remeshed again once that job lands.
+static bool chunkRenderer_job_dispatch(State_t *restrict pState, Chunk_t *restrict pChunk, const Vec3i_t CAMERA_CHUNK_POS)
+{
+    if (!chunkState_cpu(pChunk))
+        return false;
+
+    if (pChunk->meshFlags & CHUNK_MESH_FLAG_JOB_IN_FLIGHT)
+    {
+        pChunk->meshFlags |= CHUNK_MESH_FLAG_STALE;
+        return true;
+    }
+
+    ChunkMeshJob_t *pJob = calloc(1, sizeof(ChunkMeshJob_t));
+    if (!pJob)
+        return false;
+
+    Chunk_t **ppNeighbors = chunkManager_getChunkNeighbors(pState, pChunk->chunkPos);
+    if (!ppNeighbors)
+    {
+        free(pJob);
+        return false;
+    }
+
+    const uint8_t LOD = chunkRenderer_lod_select(pChunk->chunkPos, CAMERA_CHUNK_POS, pChunk->meshLod);
+    if (LOD != pChunk->meshLod)
+    {
+        // Neighbors only read this chunk's border while both sides are at full resolution, so they need a remesh whenever
+        // that stops or starts being true
+        const bool HALO_CHANGED = (LOD == 0) != (pChunk->meshLod == 0);
+        pChunk->meshLod = LOD;
+
+        for (int face = 0; HALO_CHANGED && face < CMATH_GEOM_CUBE_FACES; face++)
+        {
+            if (ppNeighbors[face] && chunkState_gpu(ppNeighbors[face]))
+                chunkRenderer_enqueueRemesh(pState->pWorldState, ppNeighbors[face]);
+        }
+    }
+
+    const bool SNAPSHOT_CREATED = chunkMesher_input_create(&pJob->input, pChunk, ppNeighbors);
+    free(ppNeighbors);
+    if (!SNAPSHOT_CREATED)
+    {
+        free(pJob);
+        return false;
+    }
+
+    ChunkRenderer_t *pChunkRenderer = &pState->pWorldState->chunkRenderer;
+    pJob->pChunk = pChunk;
+    pJob->pChunkRenderer = pChunkRenderer;
+
+    pChunk->meshFlags = (uint8_t)((pChunk->meshFlags | CHUNK_MESH_FLAG_JOB_IN_FLIGHT) & ~CHUNK_MESH_FLAG_STALE);
+    pChunkRenderer->jobsInFlight++;
+
+    // Without a pool (or if it refuses the job) mesh inline so the chunk still shows up
+    if (!pState->pThreadPool || !threadPool_submit(pState->pThreadPool, chunkRenderer_job_run, pJob))
+        chunkRenderer_job_run(pJob);
+
+    return true;
+}
+
+/// @brief Uploads finished meshes until the frame's upload budget runs out. Always uploads at least one so the pipeline
+/// cannot stall.
+static void chunkRenderer_uploadCompleted(State_t *pState)
+{
+    ChunkRenderer_t *pChunkRenderer = &pState->pWorldState->chunkRenderer;
+    const double BUDGET_S = pState->config.chunkUploadBudgetMs / 1000.0;
+    const double START_TIME = glfwGetTime();
+
+    ChunkMeshJob_t *pJob = NULL;
+    while ((pJob = chunkRenderer_job_popCompleted(pChunkRenderer)) != NULL)
+    {
+        Chunk_t *pChunk = pJob->pChunk;
+        pChunk->meshFlags &= (uint8_t)~CHUNK_MESH_FLAG_JOB_IN_FLIGHT;
+        pChunkRenderer->jobsInFlight--;
+
+        bool result = pJob->result && chunkRendering_mesh_upload(pState, pChunk, &pJob->mesh);
+        if (result && !chunkState_gpu(pChunk))
+            chunkState_set(pChunk, CHUNK_STATE_CPU_GPU);
+#if defined(DEBUG_CHUNKRENDER)
+        const Vec3i_t CHUNK_POS = pChunk->chunkPos;
+        if (result)
+            logs_log(LOG_DEBUG, "Remeshed chunk %p at (%d, %d, %d). [#%u]",
+                     pChunk, CHUNK_POS.x, CHUNK_POS.y, CHUNK_POS.z, remeshCount);
+        else
+            logs_log(LOG_DEBUG, "Didn't remesh chunk %p at (%d, %d, %d). [#%u] (Result = false)",
+                     pChunk, CHUNK_POS.x, CHUNK_POS.y, CHUNK_POS.z, remeshCount);
+        remeshCount++;
+#endif
+
+        chunkRenderer_job_destroy(pJob);
+
+        // Something changed while the worker was busy, so what was just uploaded is already out of date
+        if (pChunk->meshFlags & CHUNK_MESH_FLAG_STALE)
+        {
+            pChunk->meshFlags &= (uint8_t)~CHUNK_MESH_FLAG_STALE;
+            chunkRenderer_enqueueRemesh(pState->pWorldState, pChunk);
+        }
+
+        if (glfwGetTime() - START_TIME >= BUDGET_S)
+            break;
+    }
+
+    // Everything uploaded this frame goes to the GPU in one submit
+    stagingRing_flush(pState);
+}
 #pragma endregion
 #pragma region Operations
-// TODO: Change this whole thing to use a FIFO appraoch vice stack
 bool chunkRenderer_enqueueRemesh(WorldState_t *restrict pWorldState, Chunk_t *restrict pChunk)
 {
-    if (!pWorldState || !pWorldState->chunkRenderer.pRemeshCtxQueue || !pChunk)
+    if (!pWorldState || !pWorldState->chunkRenderer.pRemeshQueue || !pChunk)
         return false;
 
-    RenderChunk_t *pRenderChunk = pChunk->pRenderChunk;
+    // The in-flight snapshot is outdated. It is requeued when it lands instead of being meshed twice at once
+    if (pChunk->meshFlags & CHUNK_MESH_FLAG_JOB_IN_FLIGHT)
+    {
+        pChunk->meshFlags |= CHUNK_MESH_FLAG_STALE;
+        return true;
+    }
 
     // Avoid duplicates
-    if (pRenderChunk && pRenderChunk->needsRemesh)
+    if (pChunk->meshFlags & CHUNK_MESH_FLAG_QUEUED)
         return true;
 
-    if (dynamicStack_pushUnique(pWorldState->chunkRenderer.pRemeshCtxQueue, pChunk))
-    {
-        if (pRenderChunk)
-            pRenderChunk->needsRemesh = true;
-    }
-    else
+    if (!ringQueue_pushBack(pWorldState->chunkRenderer.pRemeshQueue, pChunk))
         return false;
+
+    pChunk->meshFlags |= CHUNK_MESH_FLAG_QUEUED;
 #if defined(DEBUG_CHUNKRENDER)
     const Vec3i_t CHUNK_POS = pChunk->chunkPos;
     logs_log(LOG_DEBUG, "Enqueued chunk %p at (%d, %d, %d) for remesh. [#%u]", pChunk, CHUNK_POS.x, CHUNK_POS.y, CHUNK_POS.z,
@@ -49,80 +285,101 @@ bool chunkRenderer_enqueueRemesh(WorldState_t *restrict pWorldState, Chunk_t *re
     return true;
 }
 
-static bool chunkRenderer_meshBatch(State_t *restrict pState, const uint32_t BATCH_SIZE, Vec3u8_t *restrict pPOINTS,
-                                    const Vec3u8_t *restrict pNEIGHBOR_BLOCK_POS,
-                                    const bool *restrict pNEIGHBOR_BLOCK_IN_CHUNK)
+bool chunkRenderer_enqueueRemesh_loaded(State_t *restrict pState, Chunk_t *restrict pChunk)
 {
-    // Max size is assuming each chunk in this batch somehow has no neighbor overlaps, so each remeshed chunk actually causes
-    // itself + its 6 neighbors to be meshed
-    size_t MAX_SIZE = BATCH_SIZE * 7;
-    DynamicStack_t *pStack = dynamicStack_create(MAX_SIZE);
-    if (!pStack)
+    if (!pState || !pChunk)
         return false;
 
-    uint32_t chunkPosIndex = 0;
-    Vec3i_t *pChunkPos = malloc(sizeof(Vec3i_t) * BATCH_SIZE);
-    if (!pChunkPos)
-    {
-        dynamicStack_destroy(pStack);
+    if (!chunkRenderer_enqueueRemesh(pState->pWorldState, pChunk))
         return false;
-    }
 
-    for (uint32_t i = 0; i < BATCH_SIZE; i++)
+    if (!pChunk->pTransparencyGrid)
+        return true;
+
+    Chunk_t **ppNeighbors = chunkManager_getChunkNeighbors(pState, pChunk->chunkPos);
+    if (!ppNeighbors)
+        return true;
+
+    // A neighbor's mesh only changes where its border blocks now touch a solid block of this chunk. Those faces were emitted
+    // against the unloaded (transparent) halo and are now culled, anything else in the neighbor is unaffected
+    for (int face = 0; face < CMATH_GEOM_CUBE_FACES; face++)
     {
-        Chunk_t *pChunk = (Chunk_t *)dynamicStack_pop(pState->pWorldState->chunkRenderer.pRemeshCtxQueue);
-        if (!pChunk)
+        Chunk_t *pNeighbor = ppNeighbors[face];
+        // Reduced LOD meshes never read the halo
+        if (!pNeighbor || !chunkState_cpu(pNeighbor) || !pNeighbor->pTransparencyGrid || pNeighbor->meshLod != 0)
             continue;
 
-        dynamicStack_pushUnique(pStack, pChunk);
-        pChunkPos[chunkPosIndex++] = pChunk->chunkPos;
+        if (chunkMesher_border_culledByLoad(pChunk, pNeighbor, (CubeFace_e)face))
+            chunkRenderer_enqueueRemesh(pState->pWorldState, pNeighbor);
     }
 
-    if (chunkPosIndex == 0)
+    free(ppNeighbors);
+    return true;
+}
+
+static inline int64_t chunkRenderer_chunk_distanceSq(const Vec3i_t CHUNK_POS, const Vec3i_t CAMERA_CHUNK_POS)
+{
+    const int64_t DX = (int64_t)CHUNK_POS.x - CAMERA_CHUNK_POS.x;
+    const int64_t DY = (int64_t)CHUNK_POS.y - CAMERA_CHUNK_POS.y;
+    const int64_t DZ = (int64_t)CHUNK_POS.z - CAMERA_CHUNK_POS.z;
+    return DX * DX + DY * DY + DZ * DZ;
+}
+
+/// @brief Pops a window off the front of the queue, dispatches the BATCH_SIZE chunks nearest the camera, and puts the rest
+/// back at the front in their original order.
+static bool chunkRenderer_meshBatch(State_t *pState, const uint32_t BATCH_SIZE, const Vec3i_t CAMERA_CHUNK_POS)
+{
+    RingQueue_t *pQueue = pState->pWorldState->chunkRenderer.pRemeshQueue;
+    if (pQueue->count == 0 || BATCH_SIZE == 0)
+        return false;
+
+    size_t windowSize = (size_t)BATCH_SIZE * PRIORITY_WINDOW_FACTOR;
+    if (windowSize > pQueue->count)
+        windowSize = pQueue->count;
+
+    Chunk_t **ppWindow = malloc(sizeof(Chunk_t *) * windowSize);
+    int64_t *pDistances = malloc(sizeof(int64_t) * windowSize);
+    if (!ppWindow || !pDistances)
     {
-        free(pChunkPos);
-        dynamicStack_destroy(pStack);
+        free(ppWindow);
+        free(pDistances);
         return false;
     }
 
-    size_t neighborCount = 0;
-    Vec3i_t *pNeighborPos = cmath_chunk_GetNeighborsPosUnique_get(pChunkPos, chunkPosIndex, &neighborCount);
-    const bool RESIZE_COLLECTION = true;
-    Chunk_t **ppNeighbors = chunkManager_getChunks(pState, pNeighborPos, neighborCount, &neighborCount, RESIZE_COLLECTION);
+    for (size_t i = 0; i < windowSize; i++)
+    {
+        ppWindow[i] = (Chunk_t *)ringQueue_popFront(pQueue);
+        pDistances[i] = chunkRenderer_chunk_distanceSq(ppWindow[i]->chunkPos, CAMERA_CHUNK_POS);
+    }
 
-    if (neighborCount > 0)
-        for (uint32_t i = 0; i < neighborCount; i++)
-            dynamicStack_pushUnique(pStack, ppNeighbors[i]);
+    // Selection is stable: on equal distance the chunk that was queued first wins
+    const size_t DISPATCH_COUNT = windowSize < BATCH_SIZE ? windowSize : BATCH_SIZE;
+    for (size_t n = 0; n < DISPATCH_COUNT; n++)
+    {
+        size_t nearest = SIZE_MAX;
+        for (size_t i = 0; i < windowSize; i++)
+        {
+            if (ppWindow[i] && (nearest == SIZE_MAX || pDistances[i] < pDistances[nearest]))
+                nearest = i;
+        }
 
-    free(pChunkPos);
-    free(pNeighborPos);
-    free(ppNeighbors);
+        Chunk_t *pChunk = ppWindow[nearest];
+        ppWindow[nearest] = NULL;
+        pChunk->meshFlags &= (uint8_t)~CHUNK_MESH_FLAG_QUEUED;
+        chunkRenderer_job_dispatch(pState, pChunk, CAMERA_CHUNK_POS);
+    }
 
-    Chunk_t *pRemesh = NULL;
-    do
+    // Back to the front in reverse so the leftovers keep their place in line
+    for (size_t i = windowSize; i-- > 0;)
     {
-        pRemesh = (Chunk_t *)dynamicStack_pop(pStack);
-        if (!pRemesh)
-            break;
-
-        bool result = chunkRenderer_chunk_remesh(pState, pPOINTS, pNEIGHBOR_BLOCK_POS, pNEIGHBOR_BLOCK_IN_CHUNK, pRemesh);
-        result;
-#if defined(DEBUG_CHUNKRENDER)
-        const Vec3i_t CHUNK_POS = pRemesh->chunkPos;
-        if (result)
-            logs_log(LOG_DEBUG, "Remeshed chunk %p at (%d, %d, %d). [#%u]",
-                     pRemesh, CHUNK_POS.x, CHUNK_POS.y, CHUNK_POS.z, remeshCount);
-        else
-            logs_log(LOG_DEBUG, "Didn't remesh chunk %p at (%d, %d, %d). [#%u] (Result = false)",
-                     pRemesh, CHUNK_POS.x, CHUNK_POS.y, CHUNK_POS.z, remeshCount);
-        remeshCount++;
-#endif
-    } while (pRemesh);
+        if (ppWindow[i] && !ringQueue_pushFront(pQueue, ppWindow[i]))
+            ppWindow[i]->meshFlags &= (uint8_t)~CHUNK_MESH_FLAG_QUEUED;
+    }
 
-    dynamicStack_destroy(pStack);
+    free(ppWindow);
+    free(pDistances);
 #if defined(DEBUG_CHUNKRENDER)
-    remeshCount = 0;
-    remeshQueueSize = 0;
+    remeshQueueSize = (uint32_t)pQueue->count;
 #endif
     return true;
 }
@@ -132,18 +389,23 @@ void chunkRenderer_remeshChunks(State_t *pState)
     if (!pState || !pState->pWorldState)
         return;
 
-    Vec3u8_t *pPOINTS = cmath_chunkPoints_Get();
-    Vec3u8_t *pNEIGHBOR_BLOCK_POS = cmath_chunk_blockNeighborPoints_Get();
-    bool *pNEIGHBOR_BLOCK_IN_CHUNK = cmath_chunk_blockNeighborPointsInChunkBool_Get();
-    if (!pPOINTS || !pNEIGHBOR_BLOCK_POS || !pNEIGHBOR_BLOCK_IN_CHUNK)
+    // Land whatever the workers finished since last frame before queueing more
+    chunkRenderer_uploadCompleted(pState);
+
+    const Vec3i_t CAMERA_CHUNK_POS = cmath_chunk_worldPosF_2_chunkPos(character_player_positionLerped_get(pState));
+    chunkRenderer_lod_update(pState, CAMERA_CHUNK_POS);
+
+    const uint32_t THREAD_COUNT = pState->pThreadPool ? threadPool_threadCount(pState->pThreadPool) : 1;
+    const uint32_t MAX_JOBS_IN_FLIGHT = THREAD_COUNT * MAX_JOBS_IN_FLIGHT_PER_THREAD;
+    if (pState->pWorldState->chunkRenderer.jobsInFlight >= MAX_JOBS_IN_FLIGHT)
         return;
 
-    uint32_t batchSize = MAX_REMESH_PER_FRAME;
-    // If the CPU is overloaded, remesh the bare minimum
+    uint32_t batchSize = MAX_REMESH_PER_FRAME * THREAD_COUNT;
+    // If the CPU is overloaded, remesh the bare minimum. Snapshotting still costs main thread time
     if (cpuManager_lightenTheLoad(pState) && pState->renderer.currentFrame % 2 == 0)
-        batchSize = 1;
+        batchSize = THREAD_COUNT;
 
-    chunkRenderer_meshBatch(pState, batchSize, pPOINTS, pNEIGHBOR_BLOCK_POS, pNEIGHBOR_BLOCK_IN_CHUNK);
+    chunkRenderer_meshBatch(pState, batchSize, CAMERA_CHUNK_POS);
 }
 #pragma endregion
 #pragma region Create/Destroy
@@ -152,18 +414,47 @@ bool chunkRenderer_create(WorldState_t *pWorldState)
     if (!pWorldState)
         return false;
 
-    pWorldState->chunkRenderer.pRemeshCtxQueue = dynamicStack_create(DEFAULT_QUEUE_SIZE);
-    if (!pWorldState->chunkRenderer.pRemeshCtxQueue)
+    ChunkRenderer_t *pChunkRenderer = &pWorldState->chunkRenderer;
+    pChunkRenderer->pCompletedHead = NULL;
+    pChunkRenderer->pCompletedTail = NULL;
+    pChunkRenderer->jobsInFlight = 0;
+    pChunkRenderer->lodCameraValid = false;
+
+    if (mtx_init(&pChunkRenderer->completedLock, mtx_plain) != thrd_success)
         return false;
 
+    pChunkRenderer->pRemeshQueue = ringQueue_create(DEFAULT_QUEUE_SIZE);
+    if (!pChunkRenderer->pRemeshQueue)
+    {
+        mtx_destroy(&pChunkRenderer->completedLock);
+        return false;
+    }
+
     return true;
 }
 
-void chunkRenderer_destroy(WorldState_t *pWorldState)
+void chunkRenderer_destroy(State_t *pState)
 {
-    if (!pWorldState)
+    if (!pState || !pState->pWorldState)
         return;
 
-    dynamicStack_destroy(pWorldState->chunkRenderer.pRemeshCtxQueue);
+    ChunkRenderer_t *pChunkRenderer = &pState->pWorldState->chunkRenderer;
+
+    // Workers hold pointers into the chunk renderer and the chunks, so they must be finished first
+    if (pState->pThreadPool)
+        threadPool_waitIdle(pState->pThreadPool);
+
+    ChunkMeshJob_t *pJob = NULL;
+    while ((pJob = chunkRenderer_job_popCompleted(pChunkRenderer)) != NULL)
+    {
+        pJob->pChunk->meshFlags = CHUNK_MESH_FLAG_NONE;
+        chunkRenderer_job_destroy(pJob);
+    }
+    pChunkRenderer->jobsInFlight = 0;
+
+    mtx_destroy(&pChunkRenderer->completedLock);
+
+    ringQueue_destroy(pChunkRenderer->pRemeshQueue);
+    pChunkRenderer->pRemeshQueue = NULL;
 }
-#pragma endregion
\ No newline at end of file
+#pragma endregion
@@ -2,8 +2,18 @@
 #include "api/chunk/chunkAPI.h"
 #include "world/worldState_t.h"
 
+/// @brief Adds the chunk to the back of the remesh queue. Does nothing if it is already queued, and marks it stale if a mesh job
+/// for it is in flight.
 bool chunkRenderer_enqueueRemesh(WorldState_t *restrict pWorldState, Chunk_t *restrict pChunk);
 
+/// @brief Enqueues a freshly loaded chunk along with only those loaded neighbors whose border faces it now culls.
+bool chunkRenderer_enqueueRemesh_loaded(State_t *restrict pState, Chunk_t *restrict pChunk);
+
+/// @brief Uploads meshes finished by the worker threads (within the frame's upload budget) and dispatches new mesh jobs from
+/// the remesh queue. MAIN THREAD ONLY.
 void chunkRenderer_remeshChunks(State_t *pState);
 
-bool chunkRenderer_create(WorldState_t *pWorldState);
\ No newline at end of file
+bool chunkRenderer_create(WorldState_t *pWorldState);
+
+/// @brief Waits for in-flight mesh jobs, discards their results, and frees the remesh queue. Must run before chunks are destroyed.
+void chunkRenderer_destroy(State_t *pState);
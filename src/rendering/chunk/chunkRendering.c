@@ -1,19 +1,21 @@
 #include <vulkan/vulkan.h>
 #include "cmath/cmath.h"
 #include <stdlib.h>
+#include <string.h>
 #include "core/types/state_t.h"
 #include "rendering/types/renderChunk_t.h"
 #include "collection/linkedList_t.h"
 #include "rendering/types/shaderVertexVoxel_t.h"
+#include "rendering/types/chunkMesh_t.h"
 #include "world/chunkManager.h"
-#include "rendering/buffers/index_buffer.h"
-#include "rendering/buffers/vertex_buffer.h"
-#include "rendering/uvs.h"
 #include "rendering/chunk/chunkRenderer.h"
-#include "rendering/renderGC.h"
+#include "rendering/chunk/chunkGeometryPool.h"
+#include "rendering/chunk/chunkDrawList.h"
+#include "rendering/chunk/chunkCulling.h"
+#include "rendering/chunk/chunkOcclusion.h"
+#include "rendering/buffers/staging_ring.h"
 #include "api/chunk/chunkAPI.h"
-#include "world/chunkSolidityGrid.h"
-#include "world/voxel/block_t.h"
+#include "character/character.h"
 
 #pragma region Defines
 #if defined(DEBUG)
@@ -21,336 +23,216 @@
 #endif
 #pragma endregion
 
-static const uint32_t MINIMUM_COLLECTION_SIZE = 256;
+/// @brief Gets a mask (bit per CubeFace_e) of the face directions that can point at EYE from somewhere inside the chunk at
+/// CHUNK_ORIGIN. A face only shows its front when the eye is on its outward side, so e.g. no +X face is visible from an eye
+/// that is left of the whole chunk.
+static inline uint32_t chunkRendering_sections_visibleMask(const Vec3f_t EYE, const Vec3i_t CHUNK_ORIGIN)
+{
+    const float SIZE = (float)CMATH_CHUNK_AXIS_LENGTH;
+    const Vec3f_t MIN = cmath_vec3i_to_vec3f(CHUNK_ORIGIN);
+
+    uint32_t mask = 0;
+    mask |= (uint32_t)(EYE.x < MIN.x + SIZE) << CUBE_FACE_LEFT;
+    mask |= (uint32_t)(EYE.x > MIN.x) << CUBE_FACE_RIGHT;
+    mask |= (uint32_t)(EYE.y > MIN.y) << CUBE_FACE_TOP;
+    mask |= (uint32_t)(EYE.y < MIN.y + SIZE) << CUBE_FACE_BOTTOM;
+    mask |= (uint32_t)(EYE.z > MIN.z) << CUBE_FACE_FRONT;
+    mask |= (uint32_t)(EYE.z < MIN.z + SIZE) << CUBE_FACE_BACK;
+
+    return mask;
+}
 
-void chunkRendering_drawChunks(State_t *restrict pState, VkCommandBuffer *restrict pCmd, VkPipelineLayout *restrict pPipelineLayout)
+/// @brief Swaps the chunk's pending mesh in once the copy carrying it has landed. Until then the previous mesh keeps being
+/// drawn, so a remesh never leaves a hole.
+static inline void chunkRendering_upload_retire(State_t *restrict pState, RenderChunk_t *restrict pRenderChunk,
+                                                const uint64_t COMPLETED_SERIAL)
 {
-    if (!pState || !pState->pWorldState || !pState->pWorldState->pChunkManager->pChunksLL || !pCmd || !pPipelineLayout)
+    if (pRenderChunk->pendingGeometry.page == CHUNK_GEOMETRY_PAGE_NONE || pRenderChunk->pendingSerial > COMPLETED_SERIAL)
         return;
 
+    chunkGeometryPool_free(pState, &pRenderChunk->geometry);
+    chunkDrawList_invalidate(pState);
+    pRenderChunk->geometry = pRenderChunk->pendingGeometry;
+    pRenderChunk->indexCount = pRenderChunk->pendingIndexCount;
+    memcpy(pRenderChunk->pSections, pRenderChunk->pPendingSections, sizeof(pRenderChunk->pSections));
+
+    pRenderChunk->pendingGeometry = chunkGeometryRange_none();
+}
+
+uint32_t chunkRendering_drawChunks(State_t *restrict pState, VkCommandBuffer *restrict pSecondaries, const uint32_t MAX_SECONDARIES)
+{
+    if (!pState || !pState->pWorldState || !pState->pWorldState->pChunkManager->pChunksLL || !pSecondaries)
+        return 0;
+
+    const Vec3f_t EYE = character_player_positionLerped_get(pState);
+    const Vec3i_t EYE_CHUNK_POS = cmath_chunk_worldPosF_2_chunkPos(EYE);
+    const uint64_t COMPLETED_SERIAL = stagingRing_serial_completed(pState);
+
+    // The eye only changes which faces can be seen, and the depth order, when it crosses into another chunk. Everything else that
+    // decides the draws is in the source or invalidates the list, so while none of it moves the last gather is reused as it is
+    const ChunkDrawListSource_t SOURCE = {
+        .frustum = pState->renderer.cameraFrustum,
+        .cameraChunkPos = EYE_CHUNK_POS,
+        .chunkSetGeneration = pState->pWorldState->pChunkManager->generation,
+        .completedUploadSerial = COMPLETED_SERIAL,
+    };
+    if (chunkDrawList_source_matches(pState, &SOURCE))
+        return chunkDrawList_record(pState, pSecondaries, MAX_SECONDARIES);
+
+    // Every loaded chunk is gathered, meshed or not, since an unmeshed one can still be a way through to the ones behind it
+    chunkOcclusion_begin(pState);
+
     LinkedList_t *pCurrent = pState->pWorldState->pChunkManager->pChunksLL;
     while (pCurrent)
     {
         Chunk_t *pChunk = (Chunk_t *)pCurrent->pData;
         pCurrent = pCurrent->pNext;
-        if (!pChunk || !chunkState_gpu(pChunk))
+        if (!pChunk || !chunkState_cpu(pChunk))
             continue;
 
-        RenderChunk_t *pRenderChunk = pChunk->pRenderChunk;
+        chunkOcclusion_chunk_add(pState, pChunk);
 
+        // Retired even when hidden, so finished uploads don't pile up behind the camera
+        if (chunkState_gpu(pChunk) && pChunk->pRenderChunk)
+            chunkRendering_upload_retire(pState, pChunk->pRenderChunk, COMPLETED_SERIAL);
+    }
+
+    uint32_t reachedCount = 0;
+    Chunk_t **ppReached = chunkOcclusion_search(pState, EYE_CHUNK_POS, &reachedCount);
+
+    // Only what can be seen through open chunk faces goes on to the frustum test, which runs over all of it at once
+    chunkCulling_begin(pState);
+
+    for (uint32_t i = 0; i < reachedCount; i++)
+    {
+        Chunk_t *pChunk = ppReached[i];
         // A solid chunk surrounded by solid blocks will have no verticies to draw and will thus have the whole renderchunk be null
-        if (!pRenderChunk || pRenderChunk->indexCount == 0)
+        if (!chunkState_gpu(pChunk) || !pChunk->pRenderChunk || pChunk->pRenderChunk->indexCount == 0)
             continue;
 
-        VkBuffer chunkVB[] = {pRenderChunk->vertexBuffer};
-        VkDeviceSize offs[] = {0};
-        vkCmdBindVertexBuffers(*pCmd, 0, 1, chunkVB, offs);
-        vkCmdBindIndexBuffer(*pCmd, pRenderChunk->indexBuffer, 0, VK_INDEX_TYPE_UINT32);
-
-        vkCmdPushConstants(*pCmd, *pPipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, (uint32_t)sizeof(Mat4c_t), &pRenderChunk->modelMatrix);
-        vkCmdDrawIndexed(*pCmd, pRenderChunk->indexCount, 1, 0, 0, 0);
+        chunkCulling_chunk_add(pState, pChunk);
     }
-}
-
-void chunk_placeRenderInWorld(RenderChunk_t *restrict pChunk, Vec3f_t *restrict pWorldPosition)
-{
-    pChunk->modelMatrix = cmath_mat_rotate(MAT4_IDENTITY, 0.0F, VEC3F_Y_AXIS);
-    pChunk->modelMatrix = cmath_mat_setTranslation(MAT4_IDENTITY, *pWorldPosition);
-}
 
-void chunk_render_Destroy(State_t *restrict pState, RenderChunk_t *restrict pRenderChunk)
-{
-    if (!pRenderChunk)
-        return;
+    uint32_t visibleCount = 0;
+    Chunk_t **ppVisible = chunkCulling_cull(pState, &visibleCount);
 
-    renderGC_pushGarbage(pState->renderer.currentFrame, pRenderChunk->vertexBuffer, pRenderChunk->vertexMemory);
-    renderGC_pushGarbage(pState->renderer.currentFrame, pRenderChunk->indexBuffer, pRenderChunk->indexMemory);
+    chunkDrawList_begin(pState, &SOURCE);
 
-    free(pRenderChunk);
-}
+    for (uint32_t i = 0; i < visibleCount; i++)
+    {
+        Chunk_t *pChunk = ppVisible[i];
+        const RenderChunk_t *pRENDER_CHUNK = pChunk->pRenderChunk;
 
-#pragma region Create Mesh
-static const uint8_t pCCW_QUAD_VERTS[6] = {0, 1, 3, 0, 3, 2};
+        const Vec3i_t CHUNK_ORIGIN = cmath_chunk_chunkPos_2_worldPosI(pChunk->chunkPos);
+        const uint32_t VISIBLE_MASK = chunkRendering_sections_visibleMask(EYE, CHUNK_ORIGIN);
 
-static inline void write_face_indices_u32(uint32_t *pIndicies, uint32_t base)
-{
-    pIndicies[0] = base + pCCW_QUAD_VERTS[0];
-    pIndicies[1] = base + pCCW_QUAD_VERTS[1];
-    pIndicies[2] = base + pCCW_QUAD_VERTS[2];
-    pIndicies[3] = base + pCCW_QUAD_VERTS[3];
-    pIndicies[4] = base + pCCW_QUAD_VERTS[4];
-    pIndicies[5] = base + pCCW_QUAD_VERTS[5];
-}
+        // Whole chunks are close enough for front to back, and integers keep it exact however far out the world goes
+        const Vec3i_t OFFSET = cmath_vec3i_sub_vec3i(pChunk->chunkPos, EYE_CHUNK_POS);
+        const uint32_t DEPTH = (uint32_t)(OFFSET.x * OFFSET.x + OFFSET.y * OFFSET.y + OFFSET.z * OFFSET.z);
 
-static bool emit_face(const Vec3u8_t LOCAL_POS, const Chunk_t **restrict ppNeighbors, const Vec3u8_t *restrict pNEIGHBOR_BLOCK_POS,
-                      const bool *restrict pNEIGHBOR_BLOCK_IN_CHUNK, const Chunk_t *restrict pCHUNK,
-                      const size_t BLOCK_INDEX, const int FACE)
-{
-    LOCAL_POS;
-    bool result = false;
-    do
-    {
-        const Vec3u8_t N_POS = pNEIGHBOR_BLOCK_POS[cmath_blockNeighborIndex(BLOCK_INDEX, FACE)];
-        const bool IN_CHUNK = pNEIGHBOR_BLOCK_IN_CHUNK[cmath_blockNeighborIndex(BLOCK_INDEX, FACE)];
-#if defined(DEBUG_CHUNKRENDER)
-        if (!IN_CHUNK)
-            logs_log(LOG_DEBUG, "Cube face %s of local block (%u, %u, %u) has a neighbor position of (%u, %u, %u)",
-                     pCUBE_FACE_NAMES[FACE], LOCAL_POS.x, LOCAL_POS.y, LOCAL_POS.z, N_POS.x, N_POS.y, N_POS.z);
-#endif
+        const ChunkGeometryRange_t GEOMETRY = pRENDER_CHUNK->geometry;
+        const uint32_t INSTANCE = chunkDrawList_instance_add(pState, CHUNK_ORIGIN, DEPTH);
+        if (INSTANCE == CHUNK_DRAW_LIST_INSTANCE_NONE)
+            continue;
 
-        if (IN_CHUNK && pCHUNK->pTransparencyGrid)
-        {
-            if (pCHUNK->pTransparencyGrid->pGrid[chunkSolidityGrid_index16(N_POS.x, N_POS.y, N_POS.z)] != SOLIDITY_TRANSPARENT)
-                break;
-        }
-        else
+        // Sections are back to back in the index buffer, so neighboring visible ones are merged into a single draw
+        uint32_t firstIndex = 0;
+        uint32_t indexCount = 0;
+        for (int face = 0; face < CMATH_GEOM_CUBE_FACES; face++)
         {
-            const Chunk_t *pN = ppNeighbors[FACE];
-#if defined(DEBUG_CHUNKRENDER)
-            logs_log(LOG_DEBUG, "Checking face %s of local block (%u, %u, %u). It is outside of the local chunk.",
-                     pCUBE_FACE_NAMES[FACE], LOCAL_POS.x, LOCAL_POS.y, LOCAL_POS.z);
+            const ChunkMeshSection_t SECTION = pRENDER_CHUNK->pSections[face];
+            // Empty sections have no length, so they don't break up the run
+            if (SECTION.indexCount == 0)
+                continue;
 
-#endif
-            if (pN && chunkState_cpu(pN) && pN->pTransparencyGrid)
+            if (!(VISIBLE_MASK & (1U << face)))
             {
-                bool notTransparent = pN->pTransparencyGrid->pGrid[chunkSolidityGrid_index16(N_POS.x, N_POS.y, N_POS.z)] !=
-                                      SOLIDITY_TRANSPARENT;
-#if defined(DEBUG_CHUNKRENDER)
-                Vec3u8_t selfPos = cmath_chunk_blockPosPacked_2_localPos((uint16_t)BLOCK_INDEX);
-                Vec3i_t selfChunk = pCHUNK->chunkPos;
-                Vec3i_t neighChunk = pN->chunkPos;
-                logs_log(LOG_DEBUG,
-                         "Boundary check: self chunk (%d,%d,%d) block (%u,%u,%u) face %s -> "
-                         "neighbor chunk (%d,%d,%d) local (%u,%u,%u), val=%u",
-                         selfChunk.x, selfChunk.y, selfChunk.z,
-                         selfPos.x, selfPos.y, selfPos.z,
-                         pCUBE_FACE_NAMES[FACE],
-                         neighChunk.x, neighChunk.y, neighChunk.z,
-                         N_POS.x, N_POS.y, N_POS.z,
-                         notTransparent);
-#endif
-                if (notTransparent)
-                    break;
+                chunkDrawList_draw_add(pState, GEOMETRY.page, indexCount, GEOMETRY.firstIndex + firstIndex,
+                                       (int32_t)GEOMETRY.firstVertex, INSTANCE);
+                indexCount = 0;
+                continue;
             }
+
+            if (indexCount == 0)
+                firstIndex = SECTION.firstIndex;
+            indexCount += SECTION.indexCount;
         }
 
-        result = true;
-    } while (0);
+        chunkDrawList_draw_add(pState, GEOMETRY.page, indexCount, GEOMETRY.firstIndex + firstIndex, (int32_t)GEOMETRY.firstVertex,
+                               INSTANCE);
+    }
 
-    return result;
+    return chunkDrawList_record(pState, pSecondaries, MAX_SECONDARIES);
 }
 
-static bool chunk_mesh_create(State_t *restrict pState, const Vec3u8_t *restrict pPOINTS, const Vec3u8_t *restrict pNEIGHBOR_BLOCK_POS,
-                              const bool *restrict pNEIGHBOR_BLOCK_IN_CHUNK, Chunk_t *restrict pChunk)
+void chunk_render_Destroy(State_t *restrict pState, RenderChunk_t *restrict pRenderChunk)
 {
-    if (!pState || !pState->pWorldState || !pChunk || !pChunk->pBlockVoxels || !pPOINTS || !pNEIGHBOR_BLOCK_POS || !pNEIGHBOR_BLOCK_IN_CHUNK)
-        return false;
-
-    Chunk_t **ppNeighbors = chunkManager_getChunkNeighbors(pState, pChunk->chunkPos);
-    if (!ppNeighbors)
-        return false;
-
-#if defined(DEBUG_CHUNKRENDER)
-    for (int face = 0; face < CMATH_GEOM_CUBE_FACES; face++)
-    {
-        const Chunk_t *pN = ppNeighbors[face];
-        if (!pN)
-            continue;
+    if (!pRenderChunk)
+        return;
 
-        Vec3i_t chunkPos = pChunk->chunkPos;
-        Vec3i_t delta = {
-            pN->chunkPos.x - chunkPos.x,
-            pN->chunkPos.y - chunkPos.y,
-            pN->chunkPos.z - chunkPos.z};
-
-        logs_log(LOG_DEBUG,
-                 "Chunk (%d,%d,%d): face %s has neighbor (%d, %d, %d) (delta %d, %d, %d)",
-                 chunkPos.x, chunkPos.y, chunkPos.z,
-                 pCUBE_FACE_NAMES[face],
-                 pN->chunkPos.x, pN->chunkPos.y, pN->chunkPos.z,
-                 delta.x, delta.y, delta.z);
-        if (chunkState_cpu(ppNeighbors[face]))
-            logs_log(LOG_DEBUG, "Chunk (%d, %d, %d) is using neighbor (%d, %d, %d) during remesh.",
-                     pChunk->chunkPos.x, pChunk->chunkPos.y, pChunk->chunkPos.z,
-                     ppNeighbors[face]->chunkPos.x, ppNeighbors[face]->chunkPos.y, ppNeighbors[face]->chunkPos.z);
-    }
-#endif
+    chunkGeometryPool_free(pState, &pRenderChunk->geometry);
+    chunkGeometryPool_free(pState, &pRenderChunk->pendingGeometry);
+    chunkDrawList_invalidate(pState);
 
-    // max faces in a chunk possible (all transparent faces like glass or something)
-    const size_t MAX_VERTEX_COUNT = CMATH_CHUNK_BLOCK_CAPACITY * CMATH_GEOM_CUBE_FACES * VERTS_PER_FACE;
-    const size_t MAX_INDEX_COUNT = CMATH_CHUNK_BLOCK_CAPACITY * CMATH_GEOM_CUBE_FACES * INDICIES_PER_FACE;
+    free(pRenderChunk);
+}
 
-    ShaderVertexVoxel_t *pVertices = malloc(sizeof(ShaderVertexVoxel_t) * MAX_VERTEX_COUNT);
-    uint32_t *pIndices = malloc(sizeof(uint32_t) * MAX_INDEX_COUNT);
-    if (!pVertices || !pIndices)
-    {
-        free(pVertices);
-        free(pIndices);
-        free(ppNeighbors);
+#pragma region Upload Mesh
+bool chunkRendering_mesh_upload(State_t *restrict pState, Chunk_t *restrict pChunk, const ChunkMesh_t *restrict pMESH)
+{
+    if (!pState || !pChunk || !pMESH || !chunkState_cpu(pChunk))
         return false;
-    }
 
-    uint32_t vertexCursor = 0;
-    uint32_t indexCursor = 0;
+    const uint32_t VERTEX_COUNT = pMESH->vertexCount;
+    const uint32_t INDEX_COUNT = pMESH->indexCount;
 
-    for (size_t i = 0; i < CMATH_CHUNK_POINTS_COUNT; i++)
+    if (INDEX_COUNT == 0 || VERTEX_COUNT == 0 || !pMESH->pVertices || !pMESH->pIndices)
     {
-        const BlockDefinition_t *pBLOCK = pChunk->pBlockVoxels[i].pBLOCK_DEFINITION;
-
-        if (pBLOCK->BLOCK_ID == BLOCK_ID_AIR)
-            continue;
-
-        for (int face = 0; face < 6; ++face)
-        {
-            // if (face == 3)
-            //     continue;
-
-            if (!emit_face(pPOINTS[i], ppNeighbors, pNEIGHBOR_BLOCK_POS, pNEIGHBOR_BLOCK_IN_CHUNK, pChunk, i, face))
-                continue;
-
-            const FaceTexture_t TEX = pBLOCK->pFACE_TEXTURES[face];
-            const AtlasRegion_t *pATLAS_REGION = &pState->renderer.pAtlasRegions[TEX.atlasIndex];
-            const Vec3i_t BASE_POS = cmath_vec3u8_to_vec3i(pPOINTS[i]);
-
-            // Copy per-face vertices
-            for (int v = 0; v < VERTS_PER_FACE; ++v)
-            {
-                ShaderVertexVoxel_t vert = {0};
-                vert.pos = cmath_vec3i_to_vec3f(cmath_vec3i_add_vec3i(BASE_POS, pFACE_POSITIONS[face][v]));
-                vert.color = COLOR_WHITE;
-                vert.atlasIndex = TEX.atlasIndex;
-                vert.faceID = face;
-                pVertices[vertexCursor + v] = vert;
-            }
-
-            uvs_voxel_assignFaceUVs(pVertices, vertexCursor, pATLAS_REGION, TEX.rotation);
-
-            write_face_indices_u32(&pIndices[indexCursor], vertexCursor);
-
-            vertexCursor += VERTS_PER_FACE;
-            indexCursor += INDICIES_PER_FACE;
-        }
-    }
-
-    if (indexCursor == 0 || vertexCursor == 0)
-    {
-        free(pVertices);
-        free(pIndices);
-        free(ppNeighbors);
-
         // Meshing succeeded and nothing to draw (full chunk and surrounded)
         if (pChunk->pRenderChunk)
+        {
+            chunkGeometryPool_free(pState, &pChunk->pRenderChunk->geometry);
+            chunkGeometryPool_free(pState, &pChunk->pRenderChunk->pendingGeometry);
             pChunk->pRenderChunk->indexCount = 0;
+        }
+        // Even with nothing drawn, the chunk's contents decide which ways through it are open
+        chunkDrawList_invalidate(pState);
         return true;
     }
-    // Shrink to used size <= max allocation
-    ShaderVertexVoxel_t *pFinalVerts = realloc(pVertices, sizeof(ShaderVertexVoxel_t) * vertexCursor);
-    uint32_t *pFinalIndices = realloc(pIndices, sizeof(uint32_t) * indexCursor);
-    if (!pFinalVerts)
-        pFinalVerts = pVertices;
-    if (!pFinalIndices)
-        pFinalIndices = pIndices;
 
     RenderChunk_t *pRenderChunk = pChunk->pRenderChunk;
     if (!pRenderChunk)
     {
         pRenderChunk = malloc(sizeof(RenderChunk_t));
         if (!pRenderChunk)
-        {
-            free(pFinalVerts);
-            free(pFinalIndices);
-            free(ppNeighbors);
             return false;
-        }
-
-        pRenderChunk->needsRemesh = false;
 
         memset(pRenderChunk, 0, sizeof(*pRenderChunk));
+        pRenderChunk->geometry = chunkGeometryRange_none();
+        pRenderChunk->pendingGeometry = chunkGeometryRange_none();
 
-        uint32_t vCapacity = vertexCursor < MINIMUM_COLLECTION_SIZE ? MINIMUM_COLLECTION_SIZE : vertexCursor;
-        uint32_t iCapacity = indexCursor < MINIMUM_COLLECTION_SIZE ? MINIMUM_COLLECTION_SIZE : indexCursor;
-
-        vertexBuffer_createEmpty(pState, vCapacity, &pRenderChunk->vertexBuffer, &pRenderChunk->vertexMemory);
-        indexBuffer_createEmpty(pState, iCapacity, &pRenderChunk->indexBuffer, &pRenderChunk->indexMemory);
-
-        pRenderChunk->vertexCapacity = vCapacity;
-        pRenderChunk->indexCapacity = iCapacity;
-
-        vertexBuffer_updateFromData_Voxel(pState, pFinalVerts, vertexCursor, pRenderChunk->vertexBuffer);
-        indexBuffer_updateFromData_Voxel(pState, pFinalIndices, indexCursor, pRenderChunk->indexBuffer);
-
-        pRenderChunk->indexCount = indexCursor;
         pChunk->pRenderChunk = pRenderChunk;
-
-        Vec3f_t worldPosition = cmath_vec3i_to_vec3f(cmath_chunk_chunkPos_2_worldPosI(pChunk->chunkPos));
-        chunk_placeRenderInWorld(pChunk->pRenderChunk, &worldPosition);
-    }
-    else if (vertexCursor <= pRenderChunk->vertexCapacity && indexCursor <= pRenderChunk->indexCapacity)
-    {
-        vertexBuffer_updateFromData_Voxel(pState, pFinalVerts, vertexCursor, pRenderChunk->vertexBuffer);
-        indexBuffer_updateFromData_Voxel(pState, pFinalIndices, indexCursor, pRenderChunk->indexBuffer);
-
-        pRenderChunk->indexCount = indexCursor;
     }
-    else if (vertexCursor > pRenderChunk->vertexCapacity || indexCursor > pRenderChunk->indexCapacity)
-    {
-        uint32_t newVCap = pRenderChunk->vertexCapacity;
-        while (newVCap < vertexCursor)
-            newVCap = newVCap ? newVCap * 2 : vertexCursor;
-
-        uint32_t newICap = pRenderChunk->indexCapacity;
-        while (newICap < indexCursor)
-            newICap = newICap ? newICap * 2 : indexCursor;
 
-        VkBuffer oldVB = pRenderChunk->vertexBuffer;
-        VkDeviceMemory oldVM = pRenderChunk->vertexMemory;
-        VkBuffer oldIB = pRenderChunk->indexBuffer;
-        VkDeviceMemory oldIM = pRenderChunk->indexMemory;
-
-        pRenderChunk->vertexCapacity = newVCap;
-        pRenderChunk->indexCapacity = newICap;
-
-        vertexBuffer_createEmpty(pState, newVCap, &pRenderChunk->vertexBuffer, &pRenderChunk->vertexMemory);
-        indexBuffer_createEmpty(pState, newICap, &pRenderChunk->indexBuffer, &pRenderChunk->indexMemory);
-
-        pRenderChunk->vertexCapacity = newVCap;
-        pRenderChunk->indexCapacity = newICap;
-
-        renderGC_pushGarbage(pState->renderer.currentFrame, oldVB, oldVM);
-        renderGC_pushGarbage(pState->renderer.currentFrame, oldIB, oldIM);
-
-        vertexBuffer_updateFromData_Voxel(pState, pFinalVerts, vertexCursor, pRenderChunk->vertexBuffer);
-        indexBuffer_updateFromData_Voxel(pState, pFinalIndices, indexCursor, pRenderChunk->indexBuffer);
+    // Every remesh gets a fresh range sized to the mesh. The current one keeps being drawn until the copy into the new one lands
+    ChunkGeometryRange_t geometry;
+    if (!chunkGeometryPool_alloc(pState, VERTEX_COUNT, INDEX_COUNT, &geometry))
+        return false;
 
-        pRenderChunk->indexCount = indexCursor;
-    }
-    else
+    if (!chunkGeometryPool_upload(pState, &geometry, pMESH->pVertices, VERTEX_COUNT, pMESH->pIndices, INDEX_COUNT))
     {
-        // This should never happen
-        logs_log(LOG_ERROR, "Reached a theoretically impossible location in createMesh (chunk)!");
-        free(ppNeighbors);
+        chunkGeometryPool_free(pState, &geometry);
         return false;
     }
 
-    free(pFinalVerts);
-    free(pFinalIndices);
-    free(ppNeighbors);
+    // A pending mesh that never landed is already out of date
+    chunkGeometryPool_free(pState, &pRenderChunk->pendingGeometry);
+    pRenderChunk->pendingGeometry = geometry;
+    // Taken after the upload, which may have flushed part of it under an earlier serial
+    pRenderChunk->pendingSerial = stagingRing_serial_pending(pState);
+    pRenderChunk->pendingIndexCount = INDEX_COUNT;
+    memcpy(pRenderChunk->pPendingSections, pMESH->pSections, sizeof(pRenderChunk->pPendingSections));
 
     return true;
 }
-
-bool chunkRenderer_chunk_remesh(State_t *restrict pState, const Vec3u8_t *restrict pPOINTS, const Vec3u8_t *restrict pNEIGHBOR_BLOCK_POS,
-                                const bool *restrict pNEIGHBOR_BLOCK_IN_CHUNK, Chunk_t *restrict pChunk)
-{
-    if (!pState || !pPOINTS || !pNEIGHBOR_BLOCK_POS || !pNEIGHBOR_BLOCK_IN_CHUNK || !pChunk || !chunkState_cpu(pChunk))
-        return false;
-
-    bool result = chunk_mesh_create(pState, pPOINTS, pNEIGHBOR_BLOCK_POS, pNEIGHBOR_BLOCK_IN_CHUNK, pChunk);
-    // The first time a chunk is meshed, the renderchunk just won't exist
-    if (pChunk->pRenderChunk)
-        pChunk->pRenderChunk->needsRemesh = false;
-    if (!chunkState_gpu(pChunk))
-        chunkState_set(pChunk, CHUNK_STATE_CPU_GPU);
-    return result;
-}
 #pragma endregion
\ No newline at end of file
@@ -3,13 +3,15 @@
 #include "cmath/cmath.h"
 #include "api/chunk/chunkAPI.h"
 #include "rendering/types/renderChunk_t.h"
+#include "rendering/types/chunkMesh_t.h"
 
-void chunkRendering_drawChunks(State_t *restrict pState, VkCommandBuffer *restrict pCmd, VkPipelineLayout *restrict pPipelineLayout);
-
-void chunk_placeRenderInWorld(RenderChunk_t *restrict pRenderChunk, Vec3f_t *restrict pWorldPositon);
+/// @brief Gathers the visible parts of every uploaded chunk and records them as indirect draws into secondary command buffers. Returns
+/// how many of pSecondaries were written, to be executed in order inside the render pass. MAIN THREAD ONLY.
+uint32_t chunkRendering_drawChunks(State_t *restrict pState, VkCommandBuffer *restrict pSecondaries, const uint32_t MAX_SECONDARIES);
 
 /// @brief Destroys the chunk's render chunk (frees vulkan-related arrays/buffers)
 void chunk_render_Destroy(State_t *restrict pState, RenderChunk_t *restrict pRenderChunk);
 
-bool chunkRenderer_chunk_remesh(State_t *restrict pState, const Vec3u8_t *restrict pPOINTS, const Vec3u8_t *restrict pNEIGHBOR_BLOCK_POS,
-                                const bool *restrict pNEIGHBOR_BLOCK_IN_CHUNK, Chunk_t *restrict pChunk);
\ No newline at end of file
+/// @brief Queues a finished CPU mesh for upload into the chunk's render chunk. The chunk keeps drawing its previous mesh until the
+/// copy has landed on the GPU. MAIN THREAD ONLY.
+bool chunkRendering_mesh_upload(State_t *restrict pState, Chunk_t *restrict pChunk, const ChunkMesh_t *restrict pMESH);
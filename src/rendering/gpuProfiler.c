@@ -0,0 +1,335 @@
+#pragma region Includes
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <vulkan/vulkan.h>
+#include "core/logs.h"
+#include "rendering/gpuProfiler.h"
+#pragma endregion
+#pragma region Defines
+#if defined(DEBUG)
+// #define DEBUG_GPU_PROFILER
+#endif
+// Samples the rolling average is taken over
+#define SAMPLE_WINDOW 64
+// How often the averages are logged under DEBUG_GPU_PROFILER
+#define LOG_INTERVAL_FRAMES 600
+// Frame scopes are every scope before the uploads. Each takes a begin and end query
+#define FRAME_SCOPE_COUNT GPU_PROFILER_SCOPE_UPLOADS
+#define QUERIES_PER_FRAME (FRAME_SCOPE_COUNT * 2)
+
+typedef struct GpuProfilerScope_t
+{
+    double pSamplesMs[SAMPLE_WINDOW];
+    double windowSumMs;
+    uint32_t next;
+    uint32_t count;
+    double lastMs;
+    uint64_t samplesTotal;
+} GpuProfilerScope_t;
+
+/// @brief One query pool split up as: a begin/end pair per frame scope for every frame in flight, then a begin/end pair per staging
+/// ring slice. Frames and slices are each only reused once their fence has been waited on, so by the time a range is read back its
+/// results are in, and nothing ever waits on the GPU here
+typedef struct GpuProfiler_t
+{
+    VkQueryPool queryPool;
+    uint32_t frameSlotCount;
+    uint32_t uploadSlotCount;
+    // Per frame slot, a bit per scope written into it. Per upload slot, whether its pair was written
+    uint32_t *pFrameScopesWritten;
+    bool *pUploadsWritten;
+    // Ticks are this many nanoseconds
+    double timestampPeriodNs;
+    // Mask of the bits of a timestamp the graphics queue actually writes
+    uint64_t timestampMask;
+    uint64_t framesCollected;
+    GpuProfilerScope_t pScopes[GPU_PROFILER_SCOPE_COUNT];
+} GpuProfiler_t;
+#pragma endregion
+#pragma region Samples
+const char *gpuProfiler_scope_toString(const GpuProfilerScope_e SCOPE)
+{
+    switch (SCOPE)
+    {
+    case GPU_PROFILER_SCOPE_FRAME:
+        return "Frame";
+    case GPU_PROFILER_SCOPE_CHUNKS:
+        return "Chunks";
+    case GPU_PROFILER_SCOPE_MODELS:
+        return "Models";
+    case GPU_PROFILER_SCOPE_UPLOADS:
+        return "Uploads";
+    default:
+        return "Unknown";
+    }
+}
+
+static void gpuProfiler_sample_add(GpuProfilerScope_t *pScope, const double MS)
+{
+    if (pScope->count == SAMPLE_WINDOW)
+        pScope->windowSumMs -= pScope->pSamplesMs[pScope->next];
+    else
+        pScope->count++;
+
+    pScope->pSamplesMs[pScope->next] = MS;
+    pScope->windowSumMs += MS;
+    pScope->next = (pScope->next + 1) % SAMPLE_WINDOW;
+    pScope->lastMs = MS;
+    pScope->samplesTotal++;
+}
+
+/// @brief Reads the begin/end pair at FIRST_QUERY into SCOPE. A pair that isn't available yet is dropped rather than waited on
+static void gpuProfiler_pair_collect(State_t *restrict pState, GpuProfiler_t *restrict pProfiler, const uint32_t FIRST_QUERY,
+                                     const GpuProfilerScope_e SCOPE)
+{
+    // Each query is its value followed by its availability
+    uint64_t pResults[4] = {0};
+    const VkResult RESULT = vkGetQueryPoolResults(pState->context.device, pProfiler->queryPool, FIRST_QUERY, 2, sizeof(pResults),
+                                                  pResults, sizeof(uint64_t) * 2,
+                                                  VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+    if ((RESULT != VK_SUCCESS && RESULT != VK_NOT_READY) || pResults[1] == 0 || pResults[3] == 0)
+        return;
+
+    const uint64_t TICKS = ((pResults[2] & pProfiler->timestampMask) - (pResults[0] & pProfiler->timestampMask)) &
+                           pProfiler->timestampMask;
+    gpuProfiler_sample_add(&pProfiler->pScopes[SCOPE], (double)TICKS * pProfiler->timestampPeriodNs / 1000000.0);
+}
+#pragma endregion
+#pragma region Frame Scopes
+void gpuProfiler_frame_begin(State_t *restrict pState, VkCommandBuffer cmd)
+{
+    if (!pState || !pState->renderer.pGpuProfiler)
+        return;
+
+    GpuProfiler_t *pProfiler = pState->renderer.pGpuProfiler;
+    const uint32_t SLOT = pState->renderer.currentFrame % pProfiler->frameSlotCount;
+    const uint32_t FIRST_QUERY = SLOT * QUERIES_PER_FRAME;
+
+    // The slot's fence was waited on before recording started, so what it measured last time is ready
+    const uint32_t WRITTEN = pProfiler->pFrameScopesWritten[SLOT];
+    for (uint32_t scope = 0; scope < FRAME_SCOPE_COUNT; scope++)
+    {
+        if (WRITTEN & (1U << scope))
+            gpuProfiler_pair_collect(pState, pProfiler, FIRST_QUERY + scope * 2, (GpuProfilerScope_e)scope);
+    }
+
+    if (WRITTEN != 0)
+        pProfiler->framesCollected++;
+    pProfiler->pFrameScopesWritten[SLOT] = 0;
+
+    vkCmdResetQueryPool(cmd, pProfiler->queryPool, FIRST_QUERY, QUERIES_PER_FRAME);
+
+#if defined(DEBUG_GPU_PROFILER)
+    if (WRITTEN != 0 && pProfiler->framesCollected % LOG_INTERVAL_FRAMES == 0)
+        gpuProfiler_stats_log(pState);
+#endif
+}
+
+void gpuProfiler_scope_begin(State_t *restrict pState, VkCommandBuffer cmd, const GpuProfilerScope_e SCOPE)
+{
+    if (!pState || !pState->renderer.pGpuProfiler || SCOPE >= FRAME_SCOPE_COUNT)
+        return;
+
+    GpuProfiler_t *pProfiler = pState->renderer.pGpuProfiler;
+    const uint32_t SLOT = pState->renderer.currentFrame % pProfiler->frameSlotCount;
+    vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, pProfiler->queryPool, SLOT * QUERIES_PER_FRAME + SCOPE * 2);
+    // Marked here rather than at the end, so ending a scope on a worker doesn't write to anything shared
+    pProfiler->pFrameScopesWritten[SLOT] |= 1U << SCOPE;
+}
+
+void gpuProfiler_scope_end(const State_t *restrict pSTATE, VkCommandBuffer cmd, const GpuProfilerScope_e SCOPE)
+{
+    if (!pSTATE || !pSTATE->renderer.pGpuProfiler || SCOPE >= FRAME_SCOPE_COUNT)
+        return;
+
+    const GpuProfiler_t *pPROFILER = pSTATE->renderer.pGpuProfiler;
+    const uint32_t SLOT = pSTATE->renderer.currentFrame % pPROFILER->frameSlotCount;
+    vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, pPROFILER->queryPool, SLOT * QUERIES_PER_FRAME + SCOPE * 2 + 1);
+}
+
+void gpuProfiler_scope_reuse(State_t *pState, const GpuProfilerScope_e SCOPE)
+{
+    if (!pState || !pState->renderer.pGpuProfiler || SCOPE >= FRAME_SCOPE_COUNT)
+        return;
+
+    // The queries the reused commands write to belong to this slot, which frame_begin has just reset
+    GpuProfiler_t *pProfiler = pState->renderer.pGpuProfiler;
+    const uint32_t SLOT = pState->renderer.currentFrame % pProfiler->frameSlotCount;
+    pProfiler->pFrameScopesWritten[SLOT] |= 1U << SCOPE;
+}
+#pragma endregion
+#pragma region Upload Scopes
+void gpuProfiler_upload_begin(State_t *restrict pState, VkCommandBuffer cmd, const uint32_t SLICE)
+{
+    if (!pState || !pState->renderer.pGpuProfiler || SLICE >= pState->renderer.pGpuProfiler->uploadSlotCount)
+        return;
+
+    GpuProfiler_t *pProfiler = pState->renderer.pGpuProfiler;
+    const uint32_t FIRST_QUERY = pProfiler->frameSlotCount * QUERIES_PER_FRAME + SLICE * 2;
+
+    if (pProfiler->pUploadsWritten[SLICE])
+        gpuProfiler_pair_collect(pState, pProfiler, FIRST_QUERY, GPU_PROFILER_SCOPE_UPLOADS);
+    pProfiler->pUploadsWritten[SLICE] = false;
+
+    vkCmdResetQueryPool(cmd, pProfiler->queryPool, FIRST_QUERY, 2);
+    vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, pProfiler->queryPool, FIRST_QUERY);
+}
+
+void gpuProfiler_upload_end(State_t *restrict pState, VkCommandBuffer cmd, const uint32_t SLICE)
+{
+    if (!pState || !pState->renderer.pGpuProfiler || SLICE >= pState->renderer.pGpuProfiler->uploadSlotCount)
+        return;
+
+    GpuProfiler_t *pProfiler = pState->renderer.pGpuProfiler;
+    const uint32_t FIRST_QUERY = pProfiler->frameSlotCount * QUERIES_PER_FRAME + SLICE * 2;
+
+    vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, pProfiler->queryPool, FIRST_QUERY + 1);
+    pProfiler->pUploadsWritten[SLICE] = true;
+}
+#pragma endregion
+#pragma region Stats
+bool gpuProfiler_scope_get(const State_t *restrict pSTATE, const GpuProfilerScope_e SCOPE, GpuProfilerScopeStats_t *restrict pStats)
+{
+    if (!pSTATE || !pSTATE->renderer.pGpuProfiler || !pStats || SCOPE >= GPU_PROFILER_SCOPE_COUNT)
+        return false;
+
+    const GpuProfilerScope_t *pSCOPE = &pSTATE->renderer.pGpuProfiler->pScopes[SCOPE];
+    if (pSCOPE->count == 0)
+        return false;
+
+    double maxMs = 0.0;
+    for (uint32_t i = 0; i < pSCOPE->count; i++)
+        if (pSCOPE->pSamplesMs[i] > maxMs)
+            maxMs = pSCOPE->pSamplesMs[i];
+
+    *pStats = (GpuProfilerScopeStats_t){
+        .lastMs = pSCOPE->lastMs,
+        .averageMs = pSCOPE->windowSumMs / (double)pSCOPE->count,
+        .maxMs = maxMs,
+        .sampleCount = pSCOPE->count,
+        .samplesTotal = pSCOPE->samplesTotal,
+    };
+    return true;
+}
+
+void gpuProfiler_stats_log(const State_t *pSTATE)
+{
+    if (!pSTATE || !pSTATE->renderer.pGpuProfiler)
+        return;
+
+    for (uint32_t scope = 0; scope < GPU_PROFILER_SCOPE_COUNT; scope++)
+    {
+        GpuProfilerScopeStats_t stats;
+        if (!gpuProfiler_scope_get(pSTATE, (GpuProfilerScope_e)scope, &stats))
+            continue;
+
+        logs_log(LOG_DEBUG, "GPU %s: %.3f ms average over the last %u, %.3f ms max, %.3f ms last (%" PRIu64 " samples).",
+                 gpuProfiler_scope_toString((GpuProfilerScope_e)scope), stats.averageMs, stats.sampleCount, stats.maxMs, stats.lastMs,
+                 stats.samplesTotal);
+    }
+}
+#pragma endregion
+#pragma region Create/Destroy
+void gpuProfiler_create(State_t *pState)
+{
+    if (!pState)
+        return;
+
+    uint32_t familyCount = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(pState->context.physicalDevice, &familyCount, NULL);
+    VkQueueFamilyProperties *pFamilies = malloc(sizeof(VkQueueFamilyProperties) * (familyCount ? familyCount : 1));
+    if (!pFamilies)
+        return;
+    vkGetPhysicalDeviceQueueFamilyProperties(pState->context.physicalDevice, &familyCount, pFamilies);
+
+    const uint32_t VALID_BITS = pState->context.queueFamily < familyCount ? pFamilies[pState->context.queueFamily].timestampValidBits : 0;
+    free(pFamilies);
+
+    if (VALID_BITS == 0)
+    {
+        logs_log(LOG_WARN, "The graphics queue can't write timestamps. GPU profiling is off.");
+        return;
+    }
+
+    int failLine = 0;
+    do
+    {
+        GpuProfiler_t *pProfiler = calloc(1, sizeof(GpuProfiler_t));
+        if (!pProfiler)
+        {
+            failLine = __LINE__;
+            break;
+        }
+
+        // Hooked up first so destroy can clean up a partially created profiler
+        pState->renderer.pGpuProfiler = pProfiler;
+
+        VkPhysicalDeviceProperties properties;
+        vkGetPhysicalDeviceProperties(pState->context.physicalDevice, &properties);
+        pProfiler->timestampPeriodNs = (double)properties.limits.timestampPeriod;
+        pProfiler->timestampMask = VALID_BITS >= 64 ? UINT64_MAX : ((uint64_t)1 << VALID_BITS) - 1;
+
+        // Matches the staging ring's slices
+        pProfiler->frameSlotCount = pState->config.maxFramesInFlight ? pState->config.maxFramesInFlight : 1;
+        pProfiler->uploadSlotCount = pProfiler->frameSlotCount;
+        pProfiler->pFrameScopesWritten = calloc(pProfiler->frameSlotCount, sizeof(uint32_t));
+        pProfiler->pUploadsWritten = calloc(pProfiler->uploadSlotCount, sizeof(bool));
+        if (!pProfiler->pFrameScopesWritten || !pProfiler->pUploadsWritten)
+        {
+            failLine = __LINE__;
+            break;
+        }
+
+        const VkQueryPoolCreateInfo CREATE_INFO = {
+            .sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,
+            .queryType = VK_QUERY_TYPE_TIMESTAMP,
+            .queryCount = pProfiler->frameSlotCount * QUERIES_PER_FRAME + pProfiler->uploadSlotCount * 2,
+        };
+
+        if (vkCreateQueryPool(pState->context.device, &CREATE_INFO, pState->context.pAllocator, &pProfiler->queryPool) != VK_SUCCESS)
+        {
+            failLine = __LINE__;
+            logs_log(LOG_ERROR, "Failed to create the timestamp query pool!");
+            break;
+        }
+
+        logs_log(LOG_DEBUG, "GPU profiler running with %u timestamp bits at %.2f ns per tick.", VALID_BITS,
+                 pProfiler->timestampPeriodNs);
+    } while (0);
+
+    if (failLine != 0)
+    {
+        // Profiling is only ever a nice to have
+        logs_log(LOG_WARN, "Failed to set up the GPU profiler (line %d). GPU profiling is off.", failLine);
+        gpuProfiler_destroy(pState);
+    }
+}
+
+void gpuProfiler_destroy(State_t *pState)
+{
+    if (!pState || !pState->renderer.pGpuProfiler)
+        return;
+
+    GpuProfiler_t *pProfiler = pState->renderer.pGpuProfiler;
+
+#if defined(DEBUG_GPU_PROFILER)
+    gpuProfiler_stats_log(pState);
+#endif
+
+    if (pProfiler->queryPool != VK_NULL_HANDLE)
+        vkDestroyQueryPool(pState->context.device, pProfiler->queryPool, pState->context.pAllocator);
+
+    free(pProfiler->pFrameScopesWritten);
+    free(pProfiler->pUploadsWritten);
+
+    free(pProfiler);
+    pState->renderer.pGpuProfiler = NULL;
+}
+#pragma endregion
+#pragma region Undefines
+#undef SAMPLE_WINDOW
+#undef LOG_INTERVAL_FRAMES
+#undef FRAME_SCOPE_COUNT
+#undef QUERIES_PER_FRAME
+#pragma endregion
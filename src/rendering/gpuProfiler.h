@@ -0,0 +1,62 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <vulkan/vulkan.h>
+#include "core/types/state_t.h"
+
+typedef enum GpuProfilerScope_e
+{
+    // The whole frame command buffer
+    GPU_PROFILER_SCOPE_FRAME = 0,
+    GPU_PROFILER_SCOPE_CHUNKS,
+    GPU_PROFILER_SCOPE_MODELS,
+    // One staging ring flush. Only timed when uploads run on the graphics queue
+    GPU_PROFILER_SCOPE_UPLOADS,
+    GPU_PROFILER_SCOPE_COUNT,
+} GpuProfilerScope_e;
+
+typedef struct GpuProfilerScopeStats_t
+{
+    // Most recent sample
+    double lastMs;
+    // Over the last few dozen samples
+    double averageMs;
+    double maxMs;
+    uint32_t sampleCount;
+    // Since startup
+    uint64_t samplesTotal;
+} GpuProfilerScopeStats_t;
+
+const char *gpuProfiler_scope_toString(const GpuProfilerScope_e SCOPE);
+
+/// @brief Reads back whatever the frame slot measured last time around, then resets its queries. Must be recorded outside a render
+/// pass, before any scope of the frame. MAIN THREAD ONLY.
+void gpuProfiler_frame_begin(State_t *restrict pState, VkCommandBuffer cmd);
+
+/// @brief Starts timing SCOPE in the frame being recorded. Not for GPU_PROFILER_SCOPE_UPLOADS. MAIN THREAD ONLY.
+void gpuProfiler_scope_begin(State_t *restrict pState, VkCommandBuffer cmd, const GpuProfilerScope_e SCOPE);
+
+/// @brief Ends SCOPE. cmd may be a different command buffer than the begin's, as long as it executes after it. Safe from any
+/// thread, since it only records
+void gpuProfiler_scope_end(const State_t *restrict pSTATE, VkCommandBuffer cmd, const GpuProfilerScope_e SCOPE);
+
+/// @brief Counts SCOPE as measured this frame without recording anything, for when a command buffer that was recorded with its begin
+/// and end for the current frame slot is executed again. MAIN THREAD ONLY.
+void gpuProfiler_scope_reuse(State_t *pState, const GpuProfilerScope_e SCOPE);
+
+/// @brief Starts timing an upload recorded into staging ring SLICE's graphics queue command buffer. Reads back the slice's previous
+/// upload first, which its fence has already guaranteed is done. Must be recorded outside a render pass. MAIN THREAD ONLY.
+void gpuProfiler_upload_begin(State_t *restrict pState, VkCommandBuffer cmd, const uint32_t SLICE);
+
+void gpuProfiler_upload_end(State_t *restrict pState, VkCommandBuffer cmd, const uint32_t SLICE);
+
+/// @brief Fills pStats with SCOPE's timings. False when the profiler isn't running or SCOPE hasn't been measured yet
+bool gpuProfiler_scope_get(const State_t *restrict pSTATE, const GpuProfilerScope_e SCOPE, GpuProfilerScopeStats_t *restrict pStats);
+
+void gpuProfiler_stats_log(const State_t *pSTATE);
+
+/// @brief Does nothing but log when the graphics queue can't write timestamps. Every other function is then a no-op
+void gpuProfiler_create(State_t *pState);
+
+void gpuProfiler_destroy(State_t *pState);
@@ -1,46 +1,62 @@
 #pragma region Includes / Defines
 #include "core/logs.h"
 #include <vulkan/vulkan.h>
+#include <GLFW/glfw3.h>
 #include "core/types/state_t.h"
 #include "rendering/shaders.h"
 #include "rendering/types/graphicsPipeline_t.h"
+#include "rendering/types/shaderVertexModel_t.h"
 #include "core/crash_handler.h"
+#include "threading/threadPool.h"
 
 #define VIEWPORT_COUNT 1
 #define SCISSOR_COUNT 1
 #define COLOR_BLEND_COUNT 1
+#define GRAPHICS_PIPELINE_JOB_COUNT 4U
+
+typedef struct GraphicsPipelineJob_t
+{
+    State_t *pState;
+    GraphicsPipeline_e pipeline;
+    GraphicsTarget_e target;
+    bool result;
+} GraphicsPipelineJob_t;
 #pragma endregion
 #pragma endregion
 #pragma region Layout
 /// @brief Create info for the pipeline layout
-static void layout_createInfo_get(State_t *pState, const GraphicsPipeline_e GRAPHICS_PIPELINE, const GraphicsTarget_e TARGET,
+static bool layout_createInfo_get(State_t *pState, const GraphicsPipeline_e GRAPHICS_PIPELINE, const GraphicsTarget_e TARGET,
                                   VkPipelineLayout *pLayout)
 {
-    int crashLine = 0;
+    bool failed = false;
     do
     {
         if (!pState || !pLayout)
         {
-            crashLine = __LINE__;
+            failed = true;
             logs_log(LOG_ERROR, "Recieved an invalid pointer!");
             break;
         }
 
+        // Models pick their texture out of the shared table by index. Chunks get their origin from an instance attribute and
+        // the camera from the UBO, so voxels push nothing
         const VkPushConstantRange PC_RANGE = {
-            .stageFlags = VK_SHADER_STAGE_VERTEX_BIT,
+            .stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT,
             .offset = 0,
-            .size = sizeof(Mat4c_t)};
+            .size = sizeof(ShaderPushConstantsModel_t)};
+        const uint32_t PC_RANGE_COUNT = TARGET == GRAPHICS_TARGET_MODEL ? 1 : 0;
 
         const VkPipelineLayoutCreateInfo layoutCreateInfo = {
             .sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
             .setLayoutCount = 1,
-            .pSetLayouts = &pState->renderer.descriptorSetLayout,
-            .pushConstantRangeCount = 1,
-            .pPushConstantRanges = &PC_RANGE};
+            .pSetLayouts = TARGET == GRAPHICS_TARGET_MODEL ? &pState->renderer.modelDescriptorSetLayout
+                                                           : &pState->renderer.descriptorSetLayout,
+            .pushConstantRangeCount = PC_RANGE_COUNT,
+            .pPushConstantRanges = PC_RANGE_COUNT > 0 ? &PC_RANGE : NULL};
 
         if (vkCreatePipelineLayout(pState->context.device, &layoutCreateInfo, pState->context.pAllocator, pLayout) != VK_SUCCESS)
         {
-            crashLine = __LINE__;
+            failed = true;
             logs_log(LOG_ERROR, "Failed to create a graphics pipeline layout for %s", graphicsPipeline_ToString(GRAPHICS_PIPELINE));
             break;
         }
@@ -71,29 +87,27 @@ static void layout_createInfo_get(State_t *pState, const GraphicsPipeline_e GRAP
             }
             break;
         default:
-            crashLine = __LINE__;
+            failed = true;
             logs_log(LOG_ERROR, "Attempted to create an invalid graphics pipeline layout!");
             break;
         }
     } while (0);
 
-    if (crashLine != 0)
-        crashHandler_crash_graceful(CRASH_LOCATION_LINE(crashLine),
-                                    "The program cannot continue without a graphics pipeline layout!");
+    return !failed;
 }
 #pragma endregion
 #pragma region Color Blend
 /// @brief Create info for the color blend state
-static void colorBlendState_createInfo_get(State_t *pState, const GraphicsPipeline_e GRAPHICS_PIPELINE,
+static bool colorBlendState_createInfo_get(State_t *pState, const GraphicsPipeline_e GRAPHICS_PIPELINE,
                                            VkPipelineColorBlendAttachmentState *pColorBlendAttachmentStates,
                                            VkPipelineColorBlendStateCreateInfo *pCreateInfo)
 {
-    int crashLine = 0;
+    bool failed = false;
     do
     {
         if (!pState || !pColorBlendAttachmentStates || !pCreateInfo)
         {
-            crashLine = __LINE__;
+            failed = true;
             logs_log(LOG_ERROR, "Recieved an invalid pointer!");
             break;
         }
@@ -124,29 +138,27 @@ static void colorBlendState_createInfo_get(State_t *pState, const GraphicsPipeli
             createInfo.logicOp = VK_LOGIC_OP_INVERT;
             break;
         default:
-            crashLine = __LINE__;
+            failed = true;
             logs_log(LOG_ERROR, "Attempted to create color blend state for invalid graphics pipeline type!");
         }
 
         *pCreateInfo = createInfo;
     } while (0);
 
-    if (crashLine != 0)
-        crashHandler_crash_graceful(CRASH_LOCATION_LINE(crashLine),
-                                    "The program cannot continue without color blending information.");
+    return !failed;
 }
 #pragma endregion
 #pragma region Rasterization
 /// @brief Create info for the rasterization state
-static void rasterizationState_createInfo_get(State_t *pState, const GraphicsPipeline_e GRAPHICS_PIPELINE,
+static bool rasterizationState_createInfo_get(State_t *pState, const GraphicsPipeline_e GRAPHICS_PIPELINE,
                                               VkPipelineRasterizationStateCreateInfo *pCreateInfo)
 {
-    int crashLine = 0;
+    bool failed = false;
     do
     {
         if (!pState || !pCreateInfo)
         {
-            crashLine = __LINE__;
+            failed = true;
             logs_log(LOG_ERROR, "Recieved an invalid pointer!");
             break;
         }
@@ -162,7 +174,7 @@ static void rasterizationState_createInfo_get(State_t *pState, const GraphicsPip
             polygonMode = VK_POLYGON_MODE_LINE;
             break;
         default:
-            crashLine = __LINE__;
+            failed = true;
             logs_log(LOG_ERROR, "Attempted to create invalid render pipeline type!");
             // Default to avoid unknown behaviour
             polygonMode = VK_POLYGON_MODE_FILL;
@@ -184,14 +196,12 @@ static void rasterizationState_createInfo_get(State_t *pState, const GraphicsPip
             .polygonMode = polygonMode};
     } while (0);
 
-    if (crashLine != 0)
-        crashHandler_crash_graceful(CRASH_LOCATION_LINE(crashLine),
-                                    "The program cannot continue without the creation info for rasterization.");
+    return !failed;
 }
 #pragma endregion
 #pragma region Viewport
 /// @brief Create info for the viewport state
-static void viewportState_createInfo_get(State_t *pState, VkViewport *pViewports, VkRect2D *pScissors,
+static bool viewportState_createInfo_get(State_t *pState, VkViewport *pViewports, VkRect2D *pScissors,
                                          VkPipelineViewportStateCreateInfo *pCreateInfo)
 {
     do
@@ -218,16 +228,16 @@ static void viewportState_createInfo_get(State_t *pState, VkViewport *pViewports
             .pScissors = pScissors,
         };
 
-        return;
+        return true;
     } while (0);
 
-    crashHandler_crash_graceful(CRASH_LOCATION, "The program cannot continue without a the creation info for the graphics pipeline's viewport.");
+    return false;
 }
 #pragma endregion
 #pragma region Shaders
 const char *pSHADER_FUNCTION_ENTRY_POINT = "main";
 /// @brief Load the shader for the graphics pipeline, target, and stage
-static void shader_load(State_t *pState, const GraphicsPipeline_e PIPELINE, const GraphicsTarget_e TARGET,
+static bool shader_load(State_t *pState, const GraphicsPipeline_e PIPELINE, const GraphicsTarget_e TARGET,
                         const ShaderStage_e STAGE, VkShaderModule *pShaderModule)
 {
     ShaderBlob_t pVertexBlobs[GRAPHICS_TARGET_COUNT];
@@ -239,7 +249,7 @@ static void shader_load(State_t *pState, const GraphicsPipeline_e PIPELINE, cons
     pFragmentBlobs[GRAPHICS_PIPELINE_VOXEL_FILL] = (ShaderBlob_t){shaderVoxelFillFragCode, shaderVoxelFillFragCodeSize};
     pFragmentBlobs[GRAPHICS_PIPELINE_WIREFRAME] = (ShaderBlob_t){shaderWireframeFragCode, shaderWireframeFragCodeSize};
 
-    int crashLine = 0;
+    bool failed = false;
     do
     {
         logs_log(LOG_DEBUG, "Loading %s for %s for %s...",
@@ -247,7 +257,7 @@ static void shader_load(State_t *pState, const GraphicsPipeline_e PIPELINE, cons
 
         if (!pShaderModule)
         {
-            crashLine = __LINE__;
+            failed = true;
             logs_log(LOG_ERROR, "Recieved an invalid shader module pointer!");
             break;
         }
@@ -267,7 +277,7 @@ static void shader_load(State_t *pState, const GraphicsPipeline_e PIPELINE, cons
             blob = pFragmentBlobs[PIPELINE];
             break;
         default:
-            crashLine = __LINE__;
+            failed = true;
             break;
         }
 
@@ -276,21 +286,16 @@ static void shader_load(State_t *pState, const GraphicsPipeline_e PIPELINE, cons
 
         if (vkCreateShaderModule(pState->context.device, &createInfo, pState->context.pAllocator, pShaderModule) != VK_SUCCESS)
         {
-            crashLine = __LINE__;
+            failed = true;
             logs_log(LOG_ERROR, "Failed to create a shader module for %s!", graphicsTarget_ToString(TARGET));
             break;
         }
     } while (0);
 
-    if (crashLine != 0)
-    {
-        crashHandler_crash_graceful(
-            CRASH_LOCATION_LINE(crashLine),
-            "The program cannot continue without having shaders to direct GPU actions for image rendering.");
-    }
+    return !failed;
 }
 
-static void shaderStage_createInfo_get(State_t *pState, const GraphicsPipeline_e PIPELINE, const GraphicsTarget_e TARGET,
+static bool shaderStage_createInfo_get(State_t *pState, const GraphicsPipeline_e PIPELINE, const GraphicsTarget_e TARGET,
                                        VkPipelineShaderStageCreateInfo *pShaderStages, VkShaderModule *pVertexShaderModule,
                                        VkShaderModule *pFragmentShaderModule)
 {
@@ -302,7 +307,8 @@ static void shaderStage_createInfo_get(State_t *pState, const GraphicsPipeline_e
             break;
         }
 
-        shader_load(pState, PIPELINE, TARGET, SHADER_STAGE_VERTEX, pVertexShaderModule);
+        if (!shader_load(pState, PIPELINE, TARGET, SHADER_STAGE_VERTEX, pVertexShaderModule))
+            break;
         pShaderStages[SHADER_STAGE_VERTEX] = (VkPipelineShaderStageCreateInfo){
             .sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
             .module = *pVertexShaderModule,
@@ -311,7 +317,8 @@ static void shaderStage_createInfo_get(State_t *pState, const GraphicsPipeline_e
             .pName = pSHADER_FUNCTION_ENTRY_POINT,
         };
 
-        shader_load(pState, PIPELINE, TARGET, SHADER_STAGE_FRAGMENT, pFragmentShaderModule);
+        if (!shader_load(pState, PIPELINE, TARGET, SHADER_STAGE_FRAGMENT, pFragmentShaderModule))
+            break;
         pShaderStages[SHADER_STAGE_FRAGMENT] = (VkPipelineShaderStageCreateInfo){
             .sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
             .module = *pFragmentShaderModule,
@@ -319,19 +326,20 @@ static void shaderStage_createInfo_get(State_t *pState, const GraphicsPipeline_e
             .pName = pSHADER_FUNCTION_ENTRY_POINT,
         };
 
-        return;
+        return true;
     } while (0);
 
-    crashHandler_crash_graceful(CRASH_LOCATION, "The program cannot continue without being able to create the shader stages.");
+    return false;
 }
 #pragma endregion
 #pragma region Create
-static void create(State_t *pState, const GraphicsPipeline_e PIPELINE, const GraphicsTarget_e TARGET)
+/// @brief Builds one pipeline and its layout. Runs on worker threads, so a failure is logged and returned for the caller to act on
+static bool create(State_t *pState, const GraphicsPipeline_e PIPELINE, const GraphicsTarget_e TARGET)
 {
-    VkShaderModule vertexShaderModule = {0};
-    VkShaderModule fragmentShaderModule = {0};
+    VkShaderModule vertexShaderModule = VK_NULL_HANDLE;
+    VkShaderModule fragmentShaderModule = VK_NULL_HANDLE;
     VkPipelineShaderStageCreateInfo pShaderStages[SHADER_STAGE_COUNT];
-    shaderStage_createInfo_get(pState, PIPELINE, TARGET, pShaderStages, &vertexShaderModule, &fragmentShaderModule);
+    bool failed = !shaderStage_createInfo_get(pState, PIPELINE, TARGET, pShaderStages, &vertexShaderModule, &fragmentShaderModule);
 
     const VkDynamicState pDYNAMIC_STATES[] = {VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR};
     VkPipelineDynamicStateCreateInfo dynamicStateCreateInfo = {
@@ -371,17 +379,18 @@ static void create(State_t *pState, const GraphicsPipeline_e PIPELINE, const Gra
     VkViewport pViewports[VIEWPORT_COUNT];
     VkRect2D pScissors[SCISSOR_COUNT];
     VkPipelineViewportStateCreateInfo viewportStateCreateInfo = {0};
-    viewportState_createInfo_get(pState, pViewports, pScissors, &viewportStateCreateInfo);
+    failed = failed || !viewportState_createInfo_get(pState, pViewports, pScissors, &viewportStateCreateInfo);
 
     VkPipelineRasterizationStateCreateInfo rasterizationStateCrateInfo = {0};
-    rasterizationState_createInfo_get(pState, PIPELINE, &rasterizationStateCrateInfo);
+    failed = failed || !rasterizationState_createInfo_get(pState, PIPELINE, &rasterizationStateCrateInfo);
 
     VkPipelineColorBlendAttachmentState pColorBlendAttachmentStates[COLOR_BLEND_COUNT];
     VkPipelineColorBlendStateCreateInfo colorBlendAttachmentStateCreateInfo = {0};
-    colorBlendState_createInfo_get(pState, PIPELINE, pColorBlendAttachmentStates, &colorBlendAttachmentStateCreateInfo);
+    failed = failed ||
+             !colorBlendState_createInfo_get(pState, PIPELINE, pColorBlendAttachmentStates, &colorBlendAttachmentStateCreateInfo);
 
     VkPipelineLayout pipelineLayout = {0};
-    layout_createInfo_get(pState, PIPELINE, TARGET, &pipelineLayout);
+    failed = failed || !layout_createInfo_get(pState, PIPELINE, TARGET, &pipelineLayout);
 
     const VkPipelineDepthStencilStateCreateInfo DEPTH_STENCIL = {
         .sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO,
@@ -419,9 +428,11 @@ static void create(State_t *pState, const GraphicsPipeline_e PIPELINE, const Gra
 
     const VkGraphicsPipelineCreateInfo CREATE_INFOS[] = {createInfo};
 
-    int crashLine = 0;
     do
     {
+        if (failed)
+            break;
+
         const uint32_t CREATE_INFO_COUNT = 1;
 
         switch (PIPELINE)
@@ -431,15 +442,17 @@ static void create(State_t *pState, const GraphicsPipeline_e PIPELINE, const Gra
             switch (TARGET)
             {
             case GRAPHICS_TARGET_MODEL:
-                if (vkCreateGraphicsPipelines(pState->context.device, NULL, CREATE_INFO_COUNT, CREATE_INFOS, pState->context.pAllocator,
+                if (vkCreateGraphicsPipelines(pState->context.device, pState->renderer.pipelineCache, CREATE_INFO_COUNT,
+                                              CREATE_INFOS, pState->context.pAllocator,
                                               &pState->renderer.graphicsPipelineFillModel) != VK_SUCCESS)
-                    crashLine = __LINE__;
+                    failed = true;
                 break;
 
             case GRAPHICS_TARGET_VOXEL:
-                if (vkCreateGraphicsPipelines(pState->context.device, NULL, CREATE_INFO_COUNT, CREATE_INFOS, pState->context.pAllocator,
+                if (vkCreateGraphicsPipelines(pState->context.device, pState->renderer.pipelineCache, CREATE_INFO_COUNT,
+                                              CREATE_INFOS, pState->context.pAllocator,
                                               &pState->renderer.graphicsPipelineFillVoxel) != VK_SUCCESS)
-                    crashLine = __LINE__;
+                    failed = true;
                 break;
             }
             break;
@@ -447,15 +460,17 @@ static void create(State_t *pState, const GraphicsPipeline_e PIPELINE, const Gra
             switch (TARGET)
             {
             case GRAPHICS_TARGET_MODEL:
-                if (vkCreateGraphicsPipelines(pState->context.device, NULL, CREATE_INFO_COUNT, CREATE_INFOS, pState->context.pAllocator,
+                if (vkCreateGraphicsPipelines(pState->context.device, pState->renderer.pipelineCache, CREATE_INFO_COUNT,
+                                              CREATE_INFOS, pState->context.pAllocator,
                                               &pState->renderer.graphicsPipelineWireframeModel) != VK_SUCCESS)
-                    crashLine = __LINE__;
+                    failed = true;
                 break;
 
             case GRAPHICS_TARGET_VOXEL:
-                if (vkCreateGraphicsPipelines(pState->context.device, NULL, CREATE_INFO_COUNT, CREATE_INFOS, pState->context.pAllocator,
+                if (vkCreateGraphicsPipelines(pState->context.device, pState->renderer.pipelineCache, CREATE_INFO_COUNT,
+                                              CREATE_INFOS, pState->context.pAllocator,
                                               &pState->renderer.graphicsPipelineWireframeVoxel) != VK_SUCCESS)
-                    crashLine = __LINE__;
+                    failed = true;
                 break;
             }
             break;
@@ -468,32 +483,51 @@ static void create(State_t *pState, const GraphicsPipeline_e PIPELINE, const Gra
     vkDestroyShaderModule(pState->context.device, fragmentShaderModule, pState->context.pAllocator);
     vkDestroyShaderModule(pState->context.device, vertexShaderModule, pState->context.pAllocator);
 
-    if (crashLine != 0)
-    {
+    if (failed)
         logs_log(LOG_ERROR, "Failed to create the graphics pipeline %s targeting %s!", graphicsPipeline_ToString(PIPELINE), graphicsTarget_ToString(TARGET));
-        crashHandler_crash_graceful(CRASH_LOCATION_LINE(crashLine),
-                                    "The program cannot continue without a graphics pipeline.");
-    }
-}
 
-/// @brief Create the voxels' graphics pipelines
-static void voxel_create(State_t *pState)
-{
-    create(pState, GRAPHICS_PIPELINE_VOXEL_FILL, GRAPHICS_TARGET_VOXEL);
-    create(pState, GRAPHICS_PIPELINE_WIREFRAME, GRAPHICS_TARGET_VOXEL);
+    return !failed;
 }
 
-/// @brief Create the models' graphics pipelines
-static void models_create(State_t *pState)
+/// @brief Worker job creating one pipeline
+static void graphicsPipeline_job_run(void *pCtx)
 {
-    create(pState, GRAPHICS_PIPELINE_MODEL_FILL, GRAPHICS_TARGET_MODEL);
-    create(pState, GRAPHICS_PIPELINE_WIREFRAME, GRAPHICS_TARGET_MODEL);
+    GraphicsPipelineJob_t *pJob = pCtx;
+    pJob->result = create(pJob->pState, pJob->pipeline, pJob->target);
 }
 
 void graphicsPipeline_createAll(State_t *pState)
 {
-    voxel_create(pState);
-    models_create(pState);
+    const double START_TIME = glfwGetTime();
+
+    GraphicsPipelineJob_t pJobs[GRAPHICS_PIPELINE_JOB_COUNT] = {
+        {pState, GRAPHICS_PIPELINE_VOXEL_FILL, GRAPHICS_TARGET_VOXEL},
+        {pState, GRAPHICS_PIPELINE_WIREFRAME, GRAPHICS_TARGET_VOXEL},
+        {pState, GRAPHICS_PIPELINE_MODEL_FILL, GRAPHICS_TARGET_MODEL},
+        {pState, GRAPHICS_PIPELINE_WIREFRAME, GRAPHICS_TARGET_MODEL},
+    };
+
+    // Every pipeline only writes its own handles and the pipeline cache is internally synchronized, so they all compile at once.
+    // Anything the pool won't take is created right here instead
+    ThreadPoolGroup_t group = {0};
+    for (uint32_t i = 0; i < GRAPHICS_PIPELINE_JOB_COUNT; i++)
+    {
+        if (!pState->pThreadPool || !threadPool_submitGroup(pState->pThreadPool, &group, graphicsPipeline_job_run, &pJobs[i]))
+            graphicsPipeline_job_run(&pJobs[i]);
+    }
+
+    // The jobs point at the array above. Only waits for them, not for whatever else is queued
+    threadPool_waitGroup(pState->pThreadPool, &group);
+
+    // Workers only report failures, the crash happens here on the main thread
+    for (uint32_t i = 0; i < GRAPHICS_PIPELINE_JOB_COUNT; i++)
+    {
+        if (!pJobs[i].result)
+            crashHandler_crash_graceful(CRASH_LOCATION, "The program cannot continue without a graphics pipeline.");
+    }
+
+    logs_log(LOG_DEBUG, "Created %u graphics pipelines in %.1f ms (%s pipeline cache).", GRAPHICS_PIPELINE_JOB_COUNT,
+             (glfwGetTime() - START_TIME) * 1000.0, pState->renderer.pipelineCache != VK_NULL_HANDLE ? "with a" : "without a");
 }
 #pragma endregion
 #pragma region Destroy
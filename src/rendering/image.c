@@ -5,20 +5,22 @@
 #include "core/types/state_t.h"
 #include "rendering/buffers/command_buffer.h"
 #include "core/vk_instance.h"
+#include "rendering/image.h"
 
-VkImageView imageViewCreate(State_t *state, VkImage image, VkFormat format, VkImageAspectFlags aspectFlags)
+static VkImageView imageView_create(State_t *state, VkImage image, VkFormat format, VkImageAspectFlags aspectFlags,
+                                    const VkImageViewType VIEW_TYPE, const uint32_t MIP_LEVELS, const uint32_t LAYERS)
 {
 
     VkImageViewCreateInfo createInfo = {
         .sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
         .image = image,
-        .viewType = VK_IMAGE_VIEW_TYPE_2D,
+        .viewType = VIEW_TYPE,
         .format = format,
         .subresourceRange.aspectMask = aspectFlags,
         .subresourceRange.baseMipLevel = 0,
-        .subresourceRange.levelCount = 1,
+        .subresourceRange.levelCount = MIP_LEVELS,
         .subresourceRange.baseArrayLayer = 0,
-        .subresourceRange.layerCount = 1,
+        .subresourceRange.layerCount = LAYERS,
         .components = state->config.swapchainComponentMapping,
     };
 
@@ -29,10 +31,33 @@ VkImageView imageViewCreate(State_t *state, VkImage image, VkFormat format, VkIm
     return imageView;
 }
 
+VkImageView imageViewCreate(State_t *state, VkImage image, VkFormat format, VkImageAspectFlags aspectFlags)
+{
+    return imageView_create(state, image, format, aspectFlags, VK_IMAGE_VIEW_TYPE_2D, 1, 1);
+}
+
+VkImageView imageViewCreateArray(State_t *state, VkImage image, VkFormat format, VkImageAspectFlags aspectFlags,
+                                 const uint32_t MIP_LEVELS, const uint32_t LAYERS)
+{
+    return imageView_create(state, image, format, aspectFlags, VK_IMAGE_VIEW_TYPE_2D_ARRAY, MIP_LEVELS, LAYERS);
+}
+
 void imageLayoutTransition(State_t *state, VkImage image, VkImageLayout oldLayout, VkImageLayout newLayout)
+{
+    imageLayoutTransitionLayered(state, image, 1, 1, oldLayout, newLayout);
+}
+
+void imageLayoutTransitionLayered(State_t *state, VkImage image, const uint32_t MIP_LEVELS, const uint32_t LAYERS,
+                                  VkImageLayout oldLayout, VkImageLayout newLayout)
 {
     VkCommandBuffer commandBuffer = commandBuffer_singleTime_start(state);
+    imageLayoutTransitionRecord(commandBuffer, image, MIP_LEVELS, LAYERS, oldLayout, newLayout);
+    commandBuffer_singleTime_end(state, commandBuffer);
+}
 
+void imageLayoutTransitionRecord(VkCommandBuffer commandBuffer, VkImage image, const uint32_t MIP_LEVELS, const uint32_t LAYERS,
+                                 VkImageLayout oldLayout, VkImageLayout newLayout)
+{
     VkImageMemoryBarrier barrier = {
         .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
         // Can use VK_IMAGE_LAYOUT_UNDEFINED if don't care about existing contents of the image
@@ -41,13 +66,13 @@ void imageLayoutTransition(State_t *state, VkImage image, VkImageLayout oldLayou
         // Used if transferring queue family ownership
         .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
         .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
-        // Specifies the image that is affected and the specific part of the image. Currently just a non array/mipped image
+        // Specifies the image that is affected and the specific part of the image. Every mip level of every array layer
         .image = image,
         .subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
         .subresourceRange.baseMipLevel = 0,
-        .subresourceRange.levelCount = 1,
+        .subresourceRange.levelCount = MIP_LEVELS,
         .subresourceRange.baseArrayLayer = 0,
-        .subresourceRange.layerCount = 1,
+        .subresourceRange.layerCount = LAYERS,
         .srcAccessMask = 0, // TODO
         .dstAccessMask = 0, // TODO
     };
@@ -86,12 +111,17 @@ void imageLayoutTransition(State_t *state, VkImage image, VkImageLayout oldLayou
                          0, VK_NULL_HANDLE,
                          0, VK_NULL_HANDLE,
                          1, &barrier);
-
-    commandBuffer_singleTime_end(state, commandBuffer);
 }
 
 void imageCreate(State_t *state, uint32_t width, uint32_t height, VkFormat format, VkImageTiling tiling, VkImageUsageFlags usage,
                  VkMemoryPropertyFlags properties, VkImage *image, VkDeviceMemory *imageMemory)
+{
+    imageCreateLayered(state, width, height, 1, 1, format, tiling, usage, properties, image, imageMemory);
+}
+
+void imageCreateLayered(State_t *state, uint32_t width, uint32_t height, const uint32_t MIP_LEVELS, const uint32_t LAYERS,
+                        VkFormat format, VkImageTiling tiling, VkImageUsageFlags usage, VkMemoryPropertyFlags properties,
+                        VkImage *image, VkDeviceMemory *imageMemory)
 {
     VkImageCreateInfo createInfo = {
         .sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
@@ -100,8 +130,8 @@ void imageCreate(State_t *state, uint32_t width, uint32_t height, VkFormat forma
         .extent.width = width,
         .extent.height = height,
         .extent.depth = 1,
-        .mipLevels = 1,
-        .arrayLayers = 1,
+        .mipLevels = MIP_LEVELS,
+        .arrayLayers = LAYERS,
         // These formats must match or the copy will fail
         .format = format,
         // Must use the same format for the texels as the pixels in the buffer or the copy will fail
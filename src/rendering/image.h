@@ -6,7 +6,23 @@
 
 VkImageView imageViewCreate(State_t *state, VkImage image, VkFormat format, VkImageAspectFlags aspectFlags);
 
+/// @brief 2D array view over the first MIP_LEVELS levels of the first LAYERS layers of the image
+VkImageView imageViewCreateArray(State_t *state, VkImage image, VkFormat format, VkImageAspectFlags aspectFlags,
+                                 const uint32_t MIP_LEVELS, const uint32_t LAYERS);
+
 void imageLayoutTransition(State_t *state, VkImage image, VkImageLayout oldLayout, VkImageLayout newLayout);
 
+/// @brief Transitions the first MIP_LEVELS levels of the first LAYERS layers of the image together
+void imageLayoutTransitionLayered(State_t *state, VkImage image, const uint32_t MIP_LEVELS, const uint32_t LAYERS,
+                                  VkImageLayout oldLayout, VkImageLayout newLayout);
+
+/// @brief Records the same transition into commandBuffer instead of submitting it, so it can share a submit with the copies
+void imageLayoutTransitionRecord(VkCommandBuffer commandBuffer, VkImage image, const uint32_t MIP_LEVELS, const uint32_t LAYERS,
+                                 VkImageLayout oldLayout, VkImageLayout newLayout);
+
 void imageCreate(State_t *state, uint32_t width, uint32_t height, VkFormat format, VkImageTiling tiling, VkImageUsageFlags usage,
                  VkMemoryPropertyFlags properties, VkImage *image, VkDeviceMemory *imageMemory);
+
+void imageCreateLayered(State_t *state, uint32_t width, uint32_t height, const uint32_t MIP_LEVELS, const uint32_t LAYERS,
+                        VkFormat format, VkImageTiling tiling, VkImageUsageFlags usage, VkMemoryPropertyFlags properties,
+                        VkImage *image, VkDeviceMemory *imageMemory);
@@ -0,0 +1,389 @@
+#pragma region Includes
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <vulkan/vulkan.h>
+#include "core/logs.h"
+#include "core/crash_handler.h"
+#include "core/vk_instance.h"
+#include "collection/buddyTree_t.h"
+#include "rendering/memory/gpuAllocator.h"
+#pragma endregion
+#pragma region Defines
+#if defined(DEBUG)
+// #define DEBUG_GPU_ALLOCATOR
+#endif
+// Smallest range handed out (1 KiB). Also the unit the buddy trees count in
+#define MIN_NODE_SHIFT 10
+// 64 MiB blocks. Keeps the number of vkAllocateMemory calls (capped by maxMemoryAllocationCount) tiny
+#define BLOCK_LEVELS 16
+#define BLOCK_SIZE ((VkDeviceSize)1 << (BLOCK_LEVELS + MIN_NODE_SHIFT))
+// Heaps smaller than this (e.g. a 256 MiB BAR heap) get smaller blocks so one block can't eat most of the heap
+#define SMALL_HEAP_SIZE (BLOCK_SIZE * 8)
+#define DEFAULT_BLOCK_CAPACITY 4
+
+/// @brief One VkDeviceMemory. Either carved up by a buddy tree or owned whole by a single dedicated allocation (pTree NULL)
+typedef struct GpuMemoryBlock_t
+{
+    VkDeviceMemory memory;
+    VkDeviceSize size;
+    void *pMapped;
+    BuddyTree_t *pTree;
+    uint32_t memoryTypeIndex;
+    uint32_t allocationCount;
+    VkDeviceSize usedBytes;
+} GpuMemoryBlock_t;
+
+typedef struct GpuMemoryPool_t
+{
+    GpuMemoryBlock_t **ppBlocks;
+    uint32_t blockCount;
+    uint32_t blockCapacity;
+    // Buddy levels of the blocks in this pool. Fewer than BLOCK_LEVELS for small heaps
+    uint8_t blockLevels;
+} GpuMemoryPool_t;
+
+typedef struct GpuAllocator_t
+{
+    VkPhysicalDeviceMemoryProperties memoryProperties;
+    GpuMemoryPool_t pPools[VK_MAX_MEMORY_TYPES];
+} GpuAllocator_t;
+#pragma endregion
+#pragma region Blocks
+static bool gpuAllocator_pool_add(GpuMemoryPool_t *restrict pPool, GpuMemoryBlock_t *restrict pBlock)
+{
+    if (pPool->blockCount == pPool->blockCapacity)
+    {
+        const uint32_t NEW_CAPACITY = pPool->blockCapacity ? pPool->blockCapacity * 2 : DEFAULT_BLOCK_CAPACITY;
+        GpuMemoryBlock_t **ppNew = realloc(pPool->ppBlocks, sizeof(GpuMemoryBlock_t *) * NEW_CAPACITY);
+        if (!ppNew)
+            return false;
+
+        pPool->ppBlocks = ppNew;
+        pPool->blockCapacity = NEW_CAPACITY;
+    }
+
+    pPool->ppBlocks[pPool->blockCount++] = pBlock;
+    return true;
+}
+
+static void gpuAllocator_pool_remove(GpuMemoryPool_t *restrict pPool, const GpuMemoryBlock_t *restrict pBLOCK)
+{
+    for (uint32_t i = 0; i < pPool->blockCount; i++)
+    {
+        if (pPool->ppBlocks[i] != pBLOCK)
+            continue;
+
+        pPool->ppBlocks[i] = pPool->ppBlocks[--pPool->blockCount];
+        return;
+    }
+}
+
+static void gpuAllocator_block_destroy(State_t *restrict pState, GpuMemoryBlock_t *restrict pBlock)
+{
+    if (!pBlock)
+        return;
+
+    if (pBlock->pMapped)
+        vkUnmapMemory(pState->context.device, pBlock->memory);
+    vkFreeMemory(pState->context.device, pBlock->memory, pState->context.pAllocator);
+    buddyTree_destroy(pBlock->pTree);
+    free(pBlock);
+}
+
+/// @brief Allocates SIZE bytes of MEMORY_TYPE_INDEX from Vulkan, mapping it if it is host visible. LEVELS == 0 means dedicated
+static GpuMemoryBlock_t *gpuAllocator_block_create(State_t *pState, const uint32_t MEMORY_TYPE_INDEX, const VkDeviceSize SIZE,
+                                                   const uint8_t LEVELS)
+{
+    const GpuAllocator_t *pALLOCATOR = pState->renderer.pGpuAllocator;
+
+    GpuMemoryBlock_t *pBlock = calloc(1, sizeof(GpuMemoryBlock_t));
+    if (!pBlock)
+        return NULL;
+
+    pBlock->size = SIZE;
+    pBlock->memoryTypeIndex = MEMORY_TYPE_INDEX;
+
+    if (LEVELS > 0)
+    {
+        pBlock->pTree = buddyTree_create(LEVELS);
+        if (!pBlock->pTree)
+        {
+            free(pBlock);
+            return NULL;
+        }
+    }
+
+    VkMemoryAllocateInfo allocateInfo = {
+        .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+        .allocationSize = SIZE,
+        .memoryTypeIndex = MEMORY_TYPE_INDEX,
+    };
+
+    if (vkAllocateMemory(pState->context.device, &allocateInfo, pState->context.pAllocator, &pBlock->memory) != VK_SUCCESS)
+    {
+        logs_log(LOG_ERROR, "Failed to allocate a %" PRIu64 " byte GPU memory block (type %" PRIu32 ")!", (uint64_t)SIZE,
+                 MEMORY_TYPE_INDEX);
+        buddyTree_destroy(pBlock->pTree);
+        free(pBlock);
+        return NULL;
+    }
+
+    const VkMemoryPropertyFlags FLAGS = pALLOCATOR->memoryProperties.memoryTypes[MEMORY_TYPE_INDEX].propertyFlags;
+    if ((FLAGS & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) &&
+        vkMapMemory(pState->context.device, pBlock->memory, 0, VK_WHOLE_SIZE, 0, &pBlock->pMapped) != VK_SUCCESS)
+    {
+        logs_log(LOG_ERROR, "Failed to map a host visible GPU memory block!");
+        pBlock->pMapped = NULL;
+        gpuAllocator_block_destroy(pState, pBlock);
+        return NULL;
+    }
+
+#if defined(DEBUG_GPU_ALLOCATOR)
+    logs_log(LOG_DEBUG, "Created GPU memory block of %" PRIu64 " bytes (type %" PRIu32 ", %s).", (uint64_t)SIZE, MEMORY_TYPE_INDEX,
+             LEVELS > 0 ? "pooled" : "dedicated");
+#endif
+
+    return pBlock;
+}
+
+static void gpuAllocator_allocation_fill(GpuAllocation_t *restrict pAllocation, GpuMemoryBlock_t *restrict pBlock,
+                                         const VkDeviceSize OFFSET, const VkDeviceSize SIZE, const uint8_t ORDER)
+{
+    pAllocation->memory = pBlock->memory;
+    pAllocation->offset = OFFSET;
+    pAllocation->size = SIZE;
+    pAllocation->pMapped = pBlock->pMapped ? (uint8_t *)pBlock->pMapped + OFFSET : NULL;
+    pAllocation->pBlock = pBlock;
+    pAllocation->order = ORDER;
+
+    pBlock->allocationCount++;
+    pBlock->usedBytes += SIZE;
+}
+#pragma endregion
+#pragma region Operations
+bool gpuAllocator_allocate(State_t *restrict pState, const VkMemoryRequirements *restrict pREQUIREMENTS,
+                           const VkMemoryPropertyFlags PROPERTY_FLAGS, GpuAllocation_t *restrict pOutAllocation)
+{
+    if (!pState || !pState->renderer.pGpuAllocator || !pREQUIREMENTS || !pOutAllocation)
+        return false;
+
+    memset(pOutAllocation, 0, sizeof(*pOutAllocation));
+
+    const uint32_t MEMORY_TYPE_INDEX = vulkan_device_physicalMemoryType_get(pState, pREQUIREMENTS->memoryTypeBits, PROPERTY_FLAGS);
+    if (MEMORY_TYPE_INDEX == UINT32_MAX)
+        return false;
+
+    GpuAllocator_t *pAllocator = pState->renderer.pGpuAllocator;
+    GpuMemoryPool_t *pPool = &pAllocator->pPools[MEMORY_TYPE_INDEX];
+
+    // Alignment is a power of two, and buddy nodes start at a multiple of their own size, so a node at least as big as the
+    // alignment is always aligned
+    const VkDeviceSize NEEDED = pREQUIREMENTS->size > pREQUIREMENTS->alignment ? pREQUIREMENTS->size : pREQUIREMENTS->alignment;
+    const size_t UNITS = (size_t)((NEEDED + ((VkDeviceSize)1 << MIN_NODE_SHIFT) - 1) >> MIN_NODE_SHIFT);
+    const uint8_t ORDER = buddyTree_order_forUnits(UNITS);
+
+    // Bigger than half a block would waste most of one, so it gets its own memory
+    if (ORDER >= pPool->blockLevels)
+    {
+        GpuMemoryBlock_t *pBlock = gpuAllocator_block_create(pState, MEMORY_TYPE_INDEX, pREQUIREMENTS->size, 0);
+        if (!pBlock)
+            return false;
+
+        if (!gpuAllocator_pool_add(pPool, pBlock))
+        {
+            gpuAllocator_block_destroy(pState, pBlock);
+            return false;
+        }
+
+        gpuAllocator_allocation_fill(pOutAllocation, pBlock, 0, pREQUIREMENTS->size, 0);
+        return true;
+    }
+
+    for (uint32_t i = 0; i < pPool->blockCount; i++)
+    {
+        GpuMemoryBlock_t *pBlock = pPool->ppBlocks[i];
+        if (!pBlock->pTree)
+            continue;
+
+        const size_t OFFSET_UNITS = buddyTree_alloc(pBlock->pTree, ORDER);
+        if (OFFSET_UNITS == BUDDY_TREE_INVALID)
+            continue;
+
+        gpuAllocator_allocation_fill(pOutAllocation, pBlock, (VkDeviceSize)OFFSET_UNITS << MIN_NODE_SHIFT,
+                                     (VkDeviceSize)1 << (ORDER + MIN_NODE_SHIFT), ORDER);
+        return true;
+    }
+
+    // Every block is full (or too fragmented), add another one
+    GpuMemoryBlock_t *pBlock = gpuAllocator_block_create(pState, MEMORY_TYPE_INDEX,
+                                                         (VkDeviceSize)1 << (pPool->blockLevels + MIN_NODE_SHIFT),
+                                                         pPool->blockLevels);
+    if (!pBlock)
+        return false;
+
+    if (!gpuAllocator_pool_add(pPool, pBlock))
+    {
+        gpuAllocator_block_destroy(pState, pBlock);
+        return false;
+    }
+
+    const size_t OFFSET_UNITS = buddyTree_alloc(pBlock->pTree, ORDER);
+    gpuAllocator_allocation_fill(pOutAllocation, pBlock, (VkDeviceSize)OFFSET_UNITS << MIN_NODE_SHIFT,
+                                 (VkDeviceSize)1 << (ORDER + MIN_NODE_SHIFT), ORDER);
+
+    return true;
+}
+
+void gpuAllocator_free(State_t *restrict pState, GpuAllocation_t *restrict pAllocation)
+{
+    if (!pState || !pState->renderer.pGpuAllocator || !pAllocation || !pAllocation->pBlock)
+        return;
+
+    GpuAllocator_t *pAllocator = pState->renderer.pGpuAllocator;
+    GpuMemoryBlock_t *pBlock = pAllocation->pBlock;
+    GpuMemoryPool_t *pPool = &pAllocator->pPools[pBlock->memoryTypeIndex];
+
+    if (pBlock->pTree &&
+        !buddyTree_free(pBlock->pTree, (size_t)(pAllocation->offset >> MIN_NODE_SHIFT), pAllocation->order))
+    {
+        logs_log(LOG_ERROR, "Tried to free a GPU allocation that isn't allocated (offset %" PRIu64 ")!",
+                 (uint64_t)pAllocation->offset);
+        memset(pAllocation, 0, sizeof(*pAllocation));
+        return;
+    }
+
+    pBlock->allocationCount--;
+    pBlock->usedBytes -= pAllocation->size;
+    memset(pAllocation, 0, sizeof(*pAllocation));
+
+    if (pBlock->allocationCount > 0)
+        return;
+
+    // Dedicated memory goes straight back. Empty pooled blocks are released too, but one is kept around per memory type so
+    // a steady stream of short lived allocations (staging) doesn't allocate and free a block every time
+    if (pBlock->pTree)
+    {
+        uint32_t pooledBlocks = 0;
+        for (uint32_t i = 0; i < pPool->blockCount; i++)
+            pooledBlocks += pPool->ppBlocks[i]->pTree != NULL;
+
+        if (pooledBlocks <= 1)
+            return;
+    }
+
+    gpuAllocator_pool_remove(pPool, pBlock);
+    gpuAllocator_block_destroy(pState, pBlock);
+}
+
+GpuAllocatorStats_t gpuAllocator_stats_get(const State_t *pSTATE)
+{
+    GpuAllocatorStats_t stats = {0};
+    if (!pSTATE || !pSTATE->renderer.pGpuAllocator)
+        return stats;
+
+    const GpuAllocator_t *pALLOCATOR = pSTATE->renderer.pGpuAllocator;
+    VkDeviceSize freeBytes = 0;
+
+    for (uint32_t type = 0; type < VK_MAX_MEMORY_TYPES; type++)
+    {
+        const GpuMemoryPool_t *pPOOL = &pALLOCATOR->pPools[type];
+        for (uint32_t i = 0; i < pPOOL->blockCount; i++)
+        {
+            const GpuMemoryBlock_t *pBLOCK = pPOOL->ppBlocks[i];
+            stats.reservedBytes += pBLOCK->size;
+            stats.usedBytes += pBLOCK->usedBytes;
+            stats.allocationCount += pBLOCK->allocationCount;
+
+            if (!pBLOCK->pTree)
+            {
+                stats.dedicatedCount++;
+                continue;
+            }
+
+            stats.blockCount++;
+            freeBytes += pBLOCK->size - pBLOCK->usedBytes;
+
+            const int LARGEST_ORDER = buddyTree_largestFreeOrder(pBLOCK->pTree);
+            const VkDeviceSize LARGEST = LARGEST_ORDER < 0 ? 0 : (VkDeviceSize)1 << (LARGEST_ORDER + MIN_NODE_SHIFT);
+            if (LARGEST > stats.largestFreeBytes)
+                stats.largestFreeBytes = LARGEST;
+        }
+    }
+
+    stats.fragmentation = freeBytes > 0 ? 1.0F - (float)((double)stats.largestFreeBytes / (double)freeBytes) : 0.0F;
+
+    return stats;
+}
+
+void gpuAllocator_stats_log(const State_t *pSTATE)
+{
+    const GpuAllocatorStats_t STATS = gpuAllocator_stats_get(pSTATE);
+    logs_log(LOG_DEBUG,
+             "GPU memory: %" PRIu32 " blocks + %" PRIu32 " dedicated, %" PRIu32 " allocations, %" PRIu64 "/%" PRIu64
+             " bytes used, largest free %" PRIu64 " bytes, fragmentation %.2f",
+             STATS.blockCount, STATS.dedicatedCount, STATS.allocationCount, (uint64_t)STATS.usedBytes,
+             (uint64_t)STATS.reservedBytes, (uint64_t)STATS.largestFreeBytes, STATS.fragmentation);
+}
+#pragma endregion
+#pragma region Create/Destroy
+void gpuAllocator_create(State_t *pState)
+{
+    GpuAllocator_t *pAllocator = calloc(1, sizeof(GpuAllocator_t));
+    if (!pAllocator)
+        crashHandler_crash_graceful(CRASH_LOCATION, "The program cannot continue without a GPU memory allocator!");
+
+    vkGetPhysicalDeviceMemoryProperties(pState->context.physicalDevice, &pAllocator->memoryProperties);
+
+    for (uint32_t type = 0; type < pAllocator->memoryProperties.memoryTypeCount; type++)
+    {
+        const uint32_t HEAP_INDEX = pAllocator->memoryProperties.memoryTypes[type].heapIndex;
+        const VkDeviceSize HEAP_SIZE = pAllocator->memoryProperties.memoryHeaps[HEAP_INDEX].size;
+
+        uint8_t levels = BLOCK_LEVELS;
+        while (levels > 1 && HEAP_SIZE < SMALL_HEAP_SIZE && ((VkDeviceSize)1 << (levels + MIN_NODE_SHIFT)) * 8 > HEAP_SIZE)
+            levels--;
+
+        pAllocator->pPools[type].blockLevels = levels;
+    }
+
+    pState->renderer.pGpuAllocator = pAllocator;
+}
+
+void gpuAllocator_destroy(State_t *pState)
+{
+    if (!pState || !pState->renderer.pGpuAllocator)
+        return;
+
+    GpuAllocator_t *pAllocator = pState->renderer.pGpuAllocator;
+
+#if defined(DEBUG_GPU_ALLOCATOR)
+    gpuAllocator_stats_log(pState);
+#endif
+
+    for (uint32_t type = 0; type < VK_MAX_MEMORY_TYPES; type++)
+    {
+        GpuMemoryPool_t *pPool = &pAllocator->pPools[type];
+        for (uint32_t i = 0; i < pPool->blockCount; i++)
+        {
+            if (pPool->ppBlocks[i]->allocationCount > 0)
+                logs_log(LOG_WARN, "Destroying a GPU memory block with %" PRIu32 " live allocations!",
+                         pPool->ppBlocks[i]->allocationCount);
+
+            gpuAllocator_block_destroy(pState, pPool->ppBlocks[i]);
+        }
+
+        free(pPool->ppBlocks);
+    }
+
+    free(pAllocator);
+    pState->renderer.pGpuAllocator = NULL;
+}
+#pragma endregion
+#pragma region Undefines
+#undef MIN_NODE_SHIFT
+#undef BLOCK_LEVELS
+#undef BLOCK_SIZE
+#undef SMALL_HEAP_SIZE
+#undef DEFAULT_BLOCK_CAPACITY
+#pragma endregion
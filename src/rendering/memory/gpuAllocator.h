@@ -0,0 +1,38 @@
+#pragma once
+
+#include <stdbool.h>
+#include <vulkan/vulkan.h>
+#include "core/types/state_t.h"
+#include "rendering/types/gpuAllocation_t.h"
+
+typedef struct GpuAllocatorStats_t
+{
+    uint32_t blockCount;
+    // Allocations too big for a block that got their own VkDeviceMemory
+    uint32_t dedicatedCount;
+    uint32_t allocationCount;
+    // Everything taken from Vulkan (blocks + dedicated)
+    VkDeviceSize reservedBytes;
+    VkDeviceSize usedBytes;
+    VkDeviceSize largestFreeBytes;
+    // 0 when all free memory in the blocks is one contiguous range, approaching 1 as it gets split into small pieces
+    float fragmentation;
+} GpuAllocatorStats_t;
+
+/// @brief Sub-allocates ALLOCATION_REQUIREMENTS from a large block of a memory type matching PROPERTY_FLAGS. Host visible
+/// blocks are persistently mapped. MAIN THREAD ONLY.
+bool gpuAllocator_allocate(State_t *restrict pState, const VkMemoryRequirements *restrict pREQUIREMENTS,
+                           const VkMemoryPropertyFlags PROPERTY_FLAGS, GpuAllocation_t *restrict pOutAllocation);
+
+/// @brief Returns the range to its block and zeroes the allocation. Zeroed allocations are ignored. MAIN THREAD ONLY.
+void gpuAllocator_free(State_t *restrict pState, GpuAllocation_t *restrict pAllocation);
+
+GpuAllocatorStats_t gpuAllocator_stats_get(const State_t *pSTATE);
+
+void gpuAllocator_stats_log(const State_t *pSTATE);
+
+/// @brief Must be called after the logical device is created and before any buffer is created
+void gpuAllocator_create(State_t *pState);
+
+/// @brief Frees every block. Everything allocated from it must already be freed.
+void gpuAllocator_destroy(State_t *pState);
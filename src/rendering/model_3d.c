@@ -7,158 +7,21 @@
 #include "rendering/uvs.h"
 #include "rendering/texture.h"
 #include "rendering/buffers/buffers.h"
-#include "rendering/buffers/index_buffer.h"
-#include "rendering/buffers/vertex_buffer.h"
-#include "rendering/types/uniformBufferObject_t.h"
+#include "rendering/image.h"
+#include "rendering/model_cache.h"
+#include "rendering/pools/descriptor_pool.h"
+#include "core/fileIO.h"
 #include "rendering/types/faceTexture_t.h"
 #include "main.h"
 #include "cgltf.h"
+#include "stb_image.h"
 #include "texture.h"
 
-static VkDescriptorSet allocateDescriptorSet(VkDevice device,
-                                             VkDescriptorPool pool,
-                                             VkDescriptorSetLayout layout)
+/// @brief Accumulates all primitives from all meshes into contiguous, malloc'd arrays with the node transforms baked in
+static bool m3d_geometry_read(cgltf_data *data, const char *glbPath,
+                              ShaderVertexModel_t **outVertices, uint32_t *outVertexCount,
+                              uint32_t **outIndices, uint32_t *outIndexCount)
 {
-    VkDescriptorSetAllocateInfo ai = {
-        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
-        .descriptorPool = pool,
-        .descriptorSetCount = 1,
-        .pSetLayouts = &layout,
-    };
-    VkDescriptorSet set = VK_NULL_HANDLE;
-    VkResult r = vkAllocateDescriptorSets(device, &ai, &set);
-    if (r != VK_SUCCESS)
-        return VK_NULL_HANDLE;
-    return set;
-}
-
-static bool modelDescriptorPoolCreate(State_t *state, RenderModel_t *model)
-{
-    const uint32_t frames = state->config.maxFramesInFlight;
-
-    // We need 1 UBO + 1 sampler per set → multiply by frames
-    VkDescriptorPoolSize sizes[] = {
-        {.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, .descriptorCount = frames},
-        {.type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, .descriptorCount = frames},
-    };
-
-    VkDescriptorPoolCreateInfo ci = {
-        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
-        .maxSets = frames,
-        .poolSizeCount = (uint32_t)(sizeof sizes / sizeof *sizes),
-        .pPoolSizes = sizes,
-    };
-
-    return vkCreateDescriptorPool(state->context.device, &ci, state->context.pAllocator,
-                                  &model->descriptorPool) == VK_SUCCESS;
-}
-
-bool modelDescriptorSetsCreate(State_t *state, RenderModel_t *model)
-{
-    if (!modelDescriptorPoolCreate(state, model))
-    {
-        logs_log(LOG_ERROR, "Model descriptor pool create failed");
-        return false;
-    }
-
-    const uint32_t frames = state->config.maxFramesInFlight;
-    model->pDescriptorSets = (VkDescriptorSet *)calloc(frames, sizeof *model->pDescriptorSets);
-    if (!model->pDescriptorSets)
-        return false;
-
-    for (uint32_t f = 0; f < frames; ++f)
-    {
-        VkDescriptorSet set = allocateDescriptorSet(state->context.device,
-                                                    model->descriptorPool,
-                                                    state->renderer.descriptorSetLayout);
-        if (set == VK_NULL_HANDLE)
-        {
-            logs_log(LOG_ERROR, "Model descriptor set alloc failed (frame %u)", f);
-            return false;
-        }
-        model->pDescriptorSets[f] = set;
-
-        // Binding 0 = UBO (shared per-frame UBO you already update)
-        VkDescriptorBufferInfo uboInfo = {
-            .buffer = state->renderer.pUniformBuffers[f],
-            .offset = 0,
-            .range = sizeof(UniformBufferObject_t),
-        };
-        VkWriteDescriptorSet writeUBO = {
-            .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-            .dstSet = set,
-            .dstBinding = 0,
-            .descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-            .descriptorCount = 1,
-            .pBufferInfo = &uboInfo,
-        };
-
-        // Binding 1 = this model’s texture
-        VkDescriptorImageInfo imgInfo = {
-            .sampler = model->textureSampler,
-            .imageView = model->textureView,
-            .imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-        };
-        VkWriteDescriptorSet writeImg = {
-            .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-            .dstSet = set,
-            .dstBinding = 1,
-            .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-            .descriptorCount = 1,
-            .pImageInfo = &imgInfo,
-        };
-
-        VkWriteDescriptorSet writes[2] = {writeUBO, writeImg};
-        vkUpdateDescriptorSets(state->context.device, 2, writes, 0, NULL);
-    }
-    return true;
-}
-
-void modelDescriptorSetsDestroy(State_t *state, RenderModel_t *model)
-{
-    if (model->pDescriptorSets)
-    {
-        free(model->pDescriptorSets);
-        model->pDescriptorSets = NULL;
-    }
-    if (model->descriptorPool)
-    {
-        vkDestroyDescriptorPool(state->context.device, model->descriptorPool, state->context.pAllocator);
-        model->descriptorPool = VK_NULL_HANDLE;
-    }
-}
-
-RenderModel_t *m3d_load(State_t *state, const char *glbPath, const char *texturePath)
-{
-    cgltf_options options = {0};
-    cgltf_data *data = NULL;
-
-    // Parse + load + validate
-    if (cgltf_parse_file(&options, glbPath, &data) != cgltf_result_success)
-    {
-        logs_log(LOG_ERROR, "cgltf_parse_file failed: %s", glbPath);
-        return NULL;
-    }
-    if (cgltf_load_buffers(&options, data, glbPath) != cgltf_result_success)
-    {
-        logs_log(LOG_ERROR, "cgltf_load_buffers failed: %s", glbPath);
-        cgltf_free(data);
-        return NULL;
-    }
-    if (cgltf_validate(data) != cgltf_result_success)
-    {
-        logs_log(LOG_ERROR, "cgltf_validate failed: %s", glbPath);
-        cgltf_free(data);
-        return NULL;
-    }
-
-    if (data->meshes_count == 0)
-    {
-        logs_log(LOG_ERROR, "Model has no meshes: %s", glbPath);
-        cgltf_free(data);
-        return NULL;
-    }
-
     // Accumulate all primitives from all meshes into contiguous arrays
     ShaderVertexModel_t *vertices = NULL;
     uint32_t verticesCount = 0, verticesCapacity = 0;
@@ -235,8 +98,7 @@ RenderModel_t *m3d_load(State_t *state, const char *glbPath, const char *texture
                     logs_log(LOG_ERROR, "Vertex realloc failed");
                     free(vertices);
                     free(indices);
-                    cgltf_free(data);
-                    return NULL;
+                    return false;
                 }
                 vertices = newVerts;
                 verticesCapacity = newCap;
@@ -304,8 +166,7 @@ RenderModel_t *m3d_load(State_t *state, const char *glbPath, const char *texture
                         logs_log(LOG_ERROR, "Index realloc failed");
                         free(vertices);
                         free(indices);
-                        cgltf_free(data);
-                        return NULL;
+                        return false;
                     }
                     indices = newIdx;
                     indexCapacity = newCap;
@@ -333,8 +194,7 @@ RenderModel_t *m3d_load(State_t *state, const char *glbPath, const char *texture
                         logs_log(LOG_ERROR, "Index realloc failed (no-indices case)");
                         free(vertices);
                         free(indices);
-                        cgltf_free(data);
-                        return NULL;
+                        return false;
                     }
                     indices = newIdx;
                     indexCapacity = newCap;
@@ -342,14 +202,6 @@ RenderModel_t *m3d_load(State_t *state, const char *glbPath, const char *texture
                 for (size_t i = 0; i < icount; ++i)
                 {
                     uint32_t off = baseVertex + (uint32_t)i;
-                    if (off > 0xFFFFu)
-                    {
-                        logs_log(LOG_ERROR, "Index overflow (>65535) in no-indices case.");
-                        free(vertices);
-                        free(indices);
-                        cgltf_free(data);
-                        return NULL;
-                    }
                     indices[indexCount + (uint32_t)i] = (uint32_t)off;
                 }
                 indexCount += (uint32_t)icount;
@@ -367,57 +219,255 @@ RenderModel_t *m3d_load(State_t *state, const char *glbPath, const char *texture
         logs_log(LOG_ERROR, "No drawable geometry in: %s", glbPath);
         free(vertices);
         free(indices);
+        return false;
+    }
+
+    *outVertices = vertices;
+    *outVertexCount = verticesCount;
+    *outIndices = indices;
+    *outIndexCount = indexCount;
+    return true;
+}
+
+/// @brief Parses the GLB, decodes the texture and cooks both into one malloc'd blob laid out as *outLayout describes. Missing
+/// textures cook as a single white texel so the model still draws
+static uint8_t *m3d_cook(const void *pGlb, size_t glbSize, const void *pPng, size_t pngSize,
+                         const char *glbPath, const char *texturePath, ModelCacheLayout_t *outLayout)
+{
+    cgltf_options options = {0};
+    cgltf_data *data = NULL;
+
+    // Parse + load + validate
+    if (cgltf_parse(&options, pGlb, glbSize, &data) != cgltf_result_success)
+    {
+        logs_log(LOG_ERROR, "cgltf_parse failed: %s", glbPath);
+        return NULL;
+    }
+    if (cgltf_load_buffers(&options, data, glbPath) != cgltf_result_success)
+    {
+        logs_log(LOG_ERROR, "cgltf_load_buffers failed: %s", glbPath);
+        cgltf_free(data);
+        return NULL;
+    }
+    if (cgltf_validate(data) != cgltf_result_success)
+    {
+        logs_log(LOG_ERROR, "cgltf_validate failed: %s", glbPath);
         cgltf_free(data);
         return NULL;
     }
 
-    // Create the GPU buffers for the combined model
-    RenderModel_t *model = (RenderModel_t *)calloc(1, sizeof(RenderModel_t));
-    if (!model)
+    if (data->meshes_count == 0)
     {
-        free(vertices);
-        free(indices);
+        logs_log(LOG_ERROR, "Model has no meshes: %s", glbPath);
         cgltf_free(data);
         return NULL;
     }
 
-    // (NOTE: your helpers populate renderer's shared buffers)
-    vertexBuffer_createFromData_Model(state, vertices, verticesCount);
-    indexBuffer_createFromData(state, indices, indexCount);
+    ShaderVertexModel_t *vertices = NULL;
+    uint32_t *indices = NULL;
+    uint32_t vertexCount = 0, indexCount = 0;
+    const bool READ = m3d_geometry_read(data, glbPath, &vertices, &vertexCount, &indices, &indexCount);
+    cgltf_free(data);
+    if (!READ)
+        return NULL;
+
+    // Force 4 channels (RGBA) for a predictable VkFormat. Flipped to match the V flip above
+    static const uint8_t pWHITE[MODEL_CACHE_TEXTURE_BPP] = {255, 255, 255, 255};
+    int width = 1, height = 1, channels = 0;
+    stbi_uc *pixels = NULL;
+    if (pPng)
+    {
+        stbi_set_flip_vertically_on_load(true);
+        pixels = stbi_load_from_memory(pPng, (int)pngSize, &width, &height, &channels, STBI_rgb_alpha);
+    }
+    if (!pixels)
+    {
+        logs_log(LOG_WARN, "Failed to load texture '%s'. The model will be drawn white.", texturePath);
+        width = 1;
+        height = 1;
+    }
+
+    // Triangles first so the vertices end up in the order the optimized triangles reach them
+    if (!modelCache_triangles_optimize(indices, indexCount, vertexCount))
+        logs_log(LOG_WARN, "Failed to optimize the triangle order of '%s'. Drawing it as exported.", glbPath);
+    vertexCount = modelCache_vertices_reorder(vertices, vertexCount, indices, indexCount);
+
+    uint8_t *pBlob = NULL;
+    if (modelCache_layout_get(vertexCount, indexCount, (uint32_t)width, (uint32_t)height, outLayout))
+        pBlob = malloc(outLayout->totalSize);
+
+    if (pBlob)
+        modelCache_cook(outLayout, vertices, indices, pixels ? pixels : pWHITE, pBlob);
+    else
+        logs_log(LOG_ERROR, "Failed to cook '%s' (%u verts, %u indices, %dx%d texture)",
+                 glbPath, vertexCount, indexCount, width, height);
+
+    stbi_image_free(pixels);
+    free(vertices);
+    free(indices);
+    return pBlob;
+}
+
+/// @brief Copies the cooked vertices, indices and texture out of the one staging buffer in a single submit
+static void m3d_upload(State_t *state, RenderModel_t *model, VkBuffer staging, const ModelCacheLayout_t *pLAYOUT)
+{
+    const VkDeviceSize VERTEX_BYTES = (VkDeviceSize)pLAYOUT->indexOffset;
+    const VkDeviceSize INDEX_BYTES = (VkDeviceSize)pLAYOUT->indexCount * pLAYOUT->indexSize;
+
+    // (NOTE: the renderer's shared buffers still own the model's geometry and destroy it)
+    bufferCreate(state, VERTEX_BYTES,
+                 VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+                 VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                 &state->renderer.vertexBuffer, &state->renderer.vertexBufferAllocation);
+    bufferCreate(state, INDEX_BYTES,
+                 VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+                 VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                 &state->renderer.indexBuffer, &state->renderer.indexBufferAllocation);
+    imageCreate(state, pLAYOUT->textureWidth, pLAYOUT->textureHeight,
+                VK_FORMAT_R8G8B8A8_SRGB,
+                VK_IMAGE_TILING_OPTIMAL,
+                VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                &model->textureImage, &model->textureMemory);
+
+    VkCommandBuffer cmd = commandBuffer_singleTime_start(state);
+
+    const VkBufferCopy VERTEX_COPY = {.srcOffset = 0, .dstOffset = 0, .size = VERTEX_BYTES};
+    const VkBufferCopy INDEX_COPY = {.srcOffset = (VkDeviceSize)pLAYOUT->indexOffset, .dstOffset = 0, .size = INDEX_BYTES};
+    vkCmdCopyBuffer(cmd, staging, state->renderer.vertexBuffer, 1, &VERTEX_COPY);
+    vkCmdCopyBuffer(cmd, staging, state->renderer.indexBuffer, 1, &INDEX_COPY);
+
+    imageLayoutTransitionRecord(cmd, model->textureImage, 1, 1,
+                                VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+
+    const VkBufferImageCopy TEXTURE_COPY = {
+        .bufferOffset = (VkDeviceSize)pLAYOUT->textureOffset,
+        .imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+        .imageSubresource.layerCount = 1,
+        .imageExtent = {pLAYOUT->textureWidth, pLAYOUT->textureHeight, 1},
+    };
+    vkCmdCopyBufferToImage(cmd, staging, model->textureImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &TEXTURE_COPY);
+
+    imageLayoutTransitionRecord(cmd, model->textureImage, 1, 1,
+                                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+
+    commandBuffer_singleTime_end(state, cmd);
 
     model->vertexBuffer = state->renderer.vertexBuffer;
-    model->vertexMemory = state->renderer.vertexBufferMemory;
+    model->vertexAllocation = state->renderer.vertexBufferAllocation;
     model->indexBuffer = state->renderer.indexBuffer;
-    model->indexMemory = state->renderer.indexBufferMemory;
-    model->indexCount = indexCount;
+    model->indexAllocation = state->renderer.indexBufferAllocation;
+    model->indexCount = pLAYOUT->indexCount;
+    model->indexType = pLAYOUT->indexSize == sizeof(uint16_t) ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32;
+}
 
-    // Texture
-    if (!texture2DCreateFromFile(state, texturePath, &model->textureImage, &model->textureMemory,
-                                 &model->textureView, &model->textureSampler))
-    {
-        logs_log(LOG_WARN, "Failed to load texture '%s'. Using renderer default.", texturePath);
-    }
+/// @brief Destroys everything m3d_upload created, for a model that fails to load after its upload
+static void m3d_upload_discard(State_t *state, RenderModel_t *model)
+{
+    // The geometry went into the renderer's shared buffers, so clear those too or the renderer frees them a second time
+    bufferDestroy(state, &state->renderer.vertexBuffer, &state->renderer.vertexBufferAllocation);
+    bufferDestroy(state, &state->renderer.indexBuffer, &state->renderer.indexBufferAllocation);
+    model->vertexBuffer = VK_NULL_HANDLE;
+    model->indexBuffer = VK_NULL_HANDLE;
+
+    vkDestroyImage(state->context.device, model->textureImage, state->context.pAllocator);
+    vkFreeMemory(state->context.device, model->textureMemory, state->context.pAllocator);
+    model->textureImage = VK_NULL_HANDLE;
+    model->textureMemory = VK_NULL_HANDLE;
+}
 
-    // Descriptor sets (model-local)
-    const uint32_t frames = state->config.maxFramesInFlight;
-    model->pDescriptorSets = (VkDescriptorSet *)calloc(frames, sizeof(VkDescriptorSet));
-    if (!modelDescriptorSetsCreate(state, model))
+RenderModel_t *m3d_load(State_t *state, const char *glbPath, const char *texturePath)
+{
+    size_t glbSize = 0, pngSize = 0;
+    void *pGlb = fileIO_file_read(glbPath, &glbSize, glbPath);
+    if (!pGlb)
     {
-        logs_log(LOG_ERROR, "Failed to create model descriptor sets");
-        free(vertices);
-        free(indices);
-        cgltf_free(data);
-        free(model->pDescriptorSets);
-        free(model);
+        logs_log(LOG_ERROR, "Failed to read model: %s", glbPath);
         return NULL;
     }
+    void *pPng = fileIO_file_read(texturePath, &pngSize, texturePath);
 
-    model->modelMatrix = MAT4_IDENTITY; // per-instance transform (additional to baked node TRS)
+    // Cooked models are keyed by everything they were cooked from, so editing either file recooks
+    const uint64_t SOURCE_HASH = fileIO_hash(pPng, pPng ? pngSize : 0, fileIO_hash(pGlb, glbSize, FILE_IO_HASH_SEED));
+    const char *pSlash = strrchr(glbPath, '/');
+    const char *pBackslash = strrchr(glbPath, '\\');
+    const char *pName = pBackslash > pSlash ? pBackslash + 1 : (pSlash ? pSlash + 1 : glbPath);
 
-    // Cleanup CPU arrays + glTF
-    free(vertices);
-    free(indices);
-    cgltf_free(data);
+    RenderModel_t *model = NULL;
+    uint8_t *pBlob = NULL;
+    VkBuffer staging = VK_NULL_HANDLE;
+    GpuAllocation_t stagingAllocation = {0};
+    const VkMemoryPropertyFlags STAGING_PROPERTIES = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+
+    do
+    {
+        // A cache hit reads the blob straight into the staging buffer, with nothing to parse, decode or optimize
+        ModelCacheLayout_t layout;
+        FILE *pCache = modelCache_cache_open(pName, SOURCE_HASH, &layout);
+        bool cached = false;
+        if (pCache)
+        {
+            bufferCreate(state, layout.totalSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, STAGING_PROPERTIES, &staging, &stagingAllocation);
+            cached = modelCache_cache_read(pCache, &layout, stagingAllocation.pMapped);
+            if (!cached)
+                bufferDestroy(state, &staging, &stagingAllocation);
+        }
+
+        if (!cached)
+        {
+            pBlob = m3d_cook(pGlb, glbSize, pPng, pngSize, glbPath, texturePath, &layout);
+            if (!pBlob)
+                break;
+
+            modelCache_cache_write(pName, SOURCE_HASH, &layout, pBlob);
+
+            bufferCreate(state, layout.totalSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, STAGING_PROPERTIES, &staging, &stagingAllocation);
+            if (!stagingAllocation.pMapped)
+            {
+                logs_log(LOG_ERROR, "Failed to map model staging memory.");
+                break;
+            }
+            memcpy(stagingAllocation.pMapped, pBlob, layout.totalSize);
+        }
+
+        model = (RenderModel_t *)calloc(1, sizeof(RenderModel_t));
+        if (!model)
+            break;
+
+        m3d_upload(state, model, staging, &layout);
+        logs_log(LOG_DEBUG, "Model %s: %u verts, %u %u-bit indices, %ux%u texture (%zu bytes)",
+                 cached ? "loaded from the cook cache" : "cooked", layout.vertexCount, layout.indexCount,
+                 layout.indexSize * 8, layout.textureWidth, layout.textureHeight, layout.totalSize);
+
+        if (!texture2DViewSamplerCreate(state, model->textureImage, &model->textureView, &model->textureSampler))
+        {
+            logs_log(LOG_ERROR, "Failed to create the texture view and sampler for '%s'", texturePath);
+            m3d_upload_discard(state, model);
+            free(model);
+            model = NULL;
+            break;
+        }
+
+        // Slot in the shared model texture table, picked with a push constant at draw time
+        model->textureIndex = descriptorPool_modelTexture_add(state, model->textureView, model->textureSampler);
+        if (model->textureIndex == DESCRIPTOR_POOL_MODEL_TEXTURE_INVALID)
+        {
+            logs_log(LOG_ERROR, "Failed to add the texture of '%s' to the model texture table", glbPath);
+            vkDestroySampler(state->context.device, model->textureSampler, state->context.pAllocator);
+            vkDestroyImageView(state->context.device, model->textureView, state->context.pAllocator);
+            m3d_upload_discard(state, model);
+            free(model);
+            model = NULL;
+            break;
+        }
+
+        model->modelMatrix = MAT4_IDENTITY; // per-instance transform (additional to baked node TRS)
+    } while (0);
+
+    bufferDestroy(state, &staging, &stagingAllocation);
+    free(pBlob);
+    free(pPng);
+    free(pGlb);
 
     return model;
 }
@@ -0,0 +1,384 @@
+#pragma region Includes
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "core/logs.h"
+#include "core/fileIO.h"
+#include "rendering/model_cache.h"
+#pragma endregion
+#pragma region Defines
+static const char *pMODEL_CACHE_FOLDER_NAME = "config";
+static const char *pMODEL_CACHE_FILE_EXTENSION = ".model.cache";
+static const char *pMODEL_CACHE_DEBUG_NAME = "cooked model";
+// "VXMD"
+#define CACHE_MAGIC 0x444D5856U
+// Bump whenever the cook's output changes, so older caches get recooked
+#define CACHE_VERSION 1U
+// Bounds the blob's size. Well past any model this loads
+#define MAX_TEXTURE_SIDE 16384U
+#define MAX_ELEMENT_COUNT (1U << 28)
+// Post-transform cache the optimizer models. Bigger than most real ones, which still works well on smaller ones
+#define VERTEX_CACHE_SIZE 32
+// Scores from Forsyth's "Linear-Speed Vertex Cache Optimisation"
+#define CACHE_DECAY_POWER 1.5F
+#define LAST_TRIANGLE_SCORE 0.75F
+#define VALENCE_BOOST_SCALE 2.0F
+#define VALENCE_BOOST_POWER 0.5F
+#pragma endregion
+#pragma region Layout
+bool modelCache_layout_get(const uint32_t VERTEX_COUNT, const uint32_t INDEX_COUNT, const uint32_t TEXTURE_WIDTH,
+                           const uint32_t TEXTURE_HEIGHT, ModelCacheLayout_t *pLayout)
+{
+    if (!pLayout || VERTEX_COUNT == 0 || INDEX_COUNT == 0 || VERTEX_COUNT > MAX_ELEMENT_COUNT || INDEX_COUNT > MAX_ELEMENT_COUNT ||
+        TEXTURE_WIDTH == 0 || TEXTURE_HEIGHT == 0 || TEXTURE_WIDTH > MAX_TEXTURE_SIDE || TEXTURE_HEIGHT > MAX_TEXTURE_SIDE)
+        return false;
+
+    const uint32_t INDEX_SIZE = VERTEX_COUNT <= MODEL_CACHE_INDEX16_MAX_VERTICES ? sizeof(uint16_t) : sizeof(uint32_t);
+    const size_t INDEX_OFFSET = (size_t)VERTEX_COUNT * sizeof(ShaderVertexModel_t);
+    const size_t INDICES_END = INDEX_OFFSET + (size_t)INDEX_COUNT * INDEX_SIZE;
+    const size_t TEXTURE_OFFSET = (INDICES_END + MODEL_CACHE_TEXTURE_BPP - 1) / MODEL_CACHE_TEXTURE_BPP * MODEL_CACHE_TEXTURE_BPP;
+
+    *pLayout = (ModelCacheLayout_t){
+        .vertexCount = VERTEX_COUNT,
+        .indexCount = INDEX_COUNT,
+        .indexSize = INDEX_SIZE,
+        .textureWidth = TEXTURE_WIDTH,
+        .textureHeight = TEXTURE_HEIGHT,
+        .indexOffset = INDEX_OFFSET,
+        .textureOffset = TEXTURE_OFFSET,
+        .totalSize = TEXTURE_OFFSET + (size_t)TEXTURE_WIDTH * TEXTURE_HEIGHT * MODEL_CACHE_TEXTURE_BPP,
+    };
+
+    return true;
+}
+#pragma endregion
+#pragma region Optimize
+/// @brief How much adding a triangle that uses this vertex is worth. Recently used vertices are cheap to reuse, and vertices
+/// with few triangles left are worth finishing off before they get evicted
+static float modelCache_vertex_score(const int32_t CACHE_POSITION, const uint32_t REMAINING)
+{
+    if (REMAINING == 0)
+        return -1.0F;
+
+    float score = 0.0F;
+    if (CACHE_POSITION >= 0)
+    {
+        // The last triangle's vertices get a fixed score so its neighbors aren't preferred over each other by order alone
+        if (CACHE_POSITION < 3)
+            score = LAST_TRIANGLE_SCORE;
+        else
+            score = powf(1.0F - (float)(CACHE_POSITION - 3) / (float)(VERTEX_CACHE_SIZE - 3), CACHE_DECAY_POWER);
+    }
+
+    return score + VALENCE_BOOST_SCALE * powf((float)REMAINING, -VALENCE_BOOST_POWER);
+}
+
+bool modelCache_triangles_optimize(uint32_t *pIndices, const uint32_t INDEX_COUNT, const uint32_t VERTEX_COUNT)
+{
+    if (!pIndices || INDEX_COUNT == 0 || INDEX_COUNT % 3 != 0 || VERTEX_COUNT == 0)
+        return false;
+
+    for (uint32_t i = 0; i < INDEX_COUNT; i++)
+        if (pIndices[i] >= VERTEX_COUNT)
+            return false;
+
+    const uint32_t TRIANGLE_COUNT = INDEX_COUNT / 3;
+    uint32_t *pRemaining = calloc(VERTEX_COUNT, sizeof(uint32_t));
+    uint32_t *pAdjacencyStarts = calloc((size_t)VERTEX_COUNT + 1, sizeof(uint32_t));
+    uint32_t *pAdjacency = malloc(sizeof(uint32_t) * INDEX_COUNT);
+    int32_t *pCachePositions = malloc(sizeof(int32_t) * VERTEX_COUNT);
+    float *pVertexScores = malloc(sizeof(float) * VERTEX_COUNT);
+    float *pTriangleScores = malloc(sizeof(float) * TRIANGLE_COUNT);
+    bool *pAdded = calloc(TRIANGLE_COUNT, sizeof(bool));
+    uint32_t *pOut = malloc(sizeof(uint32_t) * INDEX_COUNT);
+
+    const bool ALLOCATED = pRemaining && pAdjacencyStarts && pAdjacency && pCachePositions && pVertexScores && pTriangleScores &&
+                           pAdded && pOut;
+    if (ALLOCATED)
+    {
+        // Every vertex's triangles, packed back to back
+        for (uint32_t i = 0; i < INDEX_COUNT; i++)
+            pRemaining[pIndices[i]]++;
+        for (uint32_t v = 0; v < VERTEX_COUNT; v++)
+            pAdjacencyStarts[v + 1] = pAdjacencyStarts[v] + pRemaining[v];
+        // Cache positions double as each vertex's fill cursor until the cache starts
+        for (uint32_t v = 0; v < VERTEX_COUNT; v++)
+            pCachePositions[v] = 0;
+        for (uint32_t i = 0; i < INDEX_COUNT; i++)
+        {
+            const uint32_t VERTEX = pIndices[i];
+            pAdjacency[pAdjacencyStarts[VERTEX] + (uint32_t)pCachePositions[VERTEX]++] = i / 3;
+        }
+
+        for (uint32_t v = 0; v < VERTEX_COUNT; v++)
+        {
+            pCachePositions[v] = -1;
+            pVertexScores[v] = modelCache_vertex_score(-1, pRemaining[v]);
+        }
+
+        uint32_t best = 0;
+        for (uint32_t t = 0; t < TRIANGLE_COUNT; t++)
+        {
+            pTriangleScores[t] = pVertexScores[pIndices[t * 3]] + pVertexScores[pIndices[t * 3 + 1]] +
+                                 pVertexScores[pIndices[t * 3 + 2]];
+            if (pTriangleScores[t] > pTriangleScores[best])
+                best = t;
+        }
+
+        uint32_t pCache[VERTEX_CACHE_SIZE];
+        uint32_t cacheCount = 0;
+        uint32_t scanCursor = 0;
+
+        for (uint32_t out = 0; out < TRIANGLE_COUNT; out++)
+        {
+            pAdded[best] = true;
+            const uint32_t *pTRIANGLE = &pIndices[best * 3];
+            memcpy(&pOut[out * 3], pTRIANGLE, sizeof(uint32_t) * 3);
+
+            // The triangle's vertices move to the front and everything else shifts back behind them, so there's room for the
+            // whole cache plus the three that can fall out the end
+            uint32_t pNewCache[VERTEX_CACHE_SIZE + 3];
+            uint32_t newCount = 0;
+            for (uint32_t corner = 0; corner < 3; corner++)
+            {
+                pRemaining[pTRIANGLE[corner]]--;
+
+                // Degenerate triangles repeat a vertex, which only needs the one slot
+                bool repeated = false;
+                for (uint32_t previous = 0; previous < corner; previous++)
+                    repeated |= pTRIANGLE[previous] == pTRIANGLE[corner];
+                if (!repeated)
+                    pNewCache[newCount++] = pTRIANGLE[corner];
+            }
+            for (uint32_t i = 0; i < cacheCount; i++)
+                if (pCache[i] != pTRIANGLE[0] && pCache[i] != pTRIANGLE[1] && pCache[i] != pTRIANGLE[2])
+                    pNewCache[newCount++] = pCache[i];
+
+            for (uint32_t i = 0; i < newCount; i++)
+            {
+                const uint32_t VERTEX = pNewCache[i];
+                pCachePositions[VERTEX] = i < VERTEX_CACHE_SIZE ? (int32_t)i : -1;
+                pVertexScores[VERTEX] = modelCache_vertex_score(pCachePositions[VERTEX], pRemaining[VERTEX]);
+            }
+
+            cacheCount = newCount < VERTEX_CACHE_SIZE ? newCount : VERTEX_CACHE_SIZE;
+            memcpy(pCache, pNewCache, sizeof(uint32_t) * cacheCount);
+
+            // Only triangles touching a vertex whose score changed can change, and the next pick is almost always among them
+            float bestScore = -1.0F;
+            for (uint32_t i = 0; i < newCount; i++)
+            {
+                const uint32_t VERTEX = pNewCache[i];
+                for (uint32_t a = pAdjacencyStarts[VERTEX]; a < pAdjacencyStarts[VERTEX + 1]; a++)
+                {
+                    const uint32_t T = pAdjacency[a];
+                    if (pAdded[T])
+                        continue;
+
+                    pTriangleScores[T] = pVertexScores[pIndices[T * 3]] + pVertexScores[pIndices[T * 3 + 1]] +
+                                         pVertexScores[pIndices[T * 3 + 2]];
+                    if (pTriangleScores[T] > bestScore)
+                    {
+                        bestScore = pTriangleScores[T];
+                        best = T;
+                    }
+                }
+            }
+
+            // Nothing left around the cache, so start again from the best triangle anywhere
+            if (bestScore < 0.0F && out + 1 < TRIANGLE_COUNT)
+            {
+                while (pAdded[scanCursor])
+                    scanCursor++;
+
+                best = scanCursor;
+                for (uint32_t t = scanCursor; t < TRIANGLE_COUNT; t++)
+                    if (!pAdded[t] && pTriangleScores[t] > pTriangleScores[best])
+                        best = t;
+            }
+        }
+
+        memcpy(pIndices, pOut, sizeof(uint32_t) * INDEX_COUNT);
+    }
+
+    free(pRemaining);
+    free(pAdjacencyStarts);
+    free(pAdjacency);
+    free(pCachePositions);
+    free(pVertexScores);
+    free(pTriangleScores);
+    free(pAdded);
+    free(pOut);
+    return ALLOCATED;
+}
+
+uint32_t modelCache_vertices_reorder(ShaderVertexModel_t *restrict pVertices, const uint32_t VERTEX_COUNT,
+                                     uint32_t *restrict pIndices, const uint32_t INDEX_COUNT)
+{
+    if (!pVertices || !pIndices || VERTEX_COUNT == 0)
+        return VERTEX_COUNT;
+
+    for (uint32_t i = 0; i < INDEX_COUNT; i++)
+        if (pIndices[i] >= VERTEX_COUNT)
+            return VERTEX_COUNT;
+
+    uint32_t *pRemap = malloc(sizeof(uint32_t) * VERTEX_COUNT);
+    ShaderVertexModel_t *pReordered = malloc(sizeof(ShaderVertexModel_t) * VERTEX_COUNT);
+    if (!pRemap || !pReordered)
+    {
+        free(pRemap);
+        free(pReordered);
+        return VERTEX_COUNT;
+    }
+
+    memset(pRemap, 0xFF, sizeof(uint32_t) * VERTEX_COUNT);
+
+    uint32_t vertexCount = 0;
+    for (uint32_t i = 0; i < INDEX_COUNT; i++)
+    {
+        const uint32_t OLD = pIndices[i];
+        if (pRemap[OLD] == UINT32_MAX)
+        {
+            pRemap[OLD] = vertexCount;
+            pReordered[vertexCount++] = pVertices[OLD];
+        }
+
+        pIndices[i] = pRemap[OLD];
+    }
+
+    memcpy(pVertices, pReordered, sizeof(ShaderVertexModel_t) * vertexCount);
+
+    free(pRemap);
+    free(pReordered);
+    return vertexCount;
+}
+#pragma endregion
+#pragma region Cook
+void modelCache_cook(const ModelCacheLayout_t *restrict pLAYOUT, const ShaderVertexModel_t *restrict pVERTICES,
+                     const uint32_t *restrict pINDICES, const uint8_t *restrict pTEXTURE, uint8_t *restrict pDst)
+{
+    if (!pLAYOUT || !pVERTICES || !pINDICES || !pTEXTURE || !pDst)
+        return;
+
+    memcpy(pDst, pVERTICES, sizeof(ShaderVertexModel_t) * pLAYOUT->vertexCount);
+
+    if (pLAYOUT->indexSize == sizeof(uint16_t))
+    {
+        for (uint32_t i = 0; i < pLAYOUT->indexCount; i++)
+        {
+            const uint16_t INDEX = (uint16_t)pINDICES[i];
+            memcpy(pDst + pLAYOUT->indexOffset + (size_t)i * sizeof(uint16_t), &INDEX, sizeof(uint16_t));
+        }
+    }
+    else
+        memcpy(pDst + pLAYOUT->indexOffset, pINDICES, sizeof(uint32_t) * pLAYOUT->indexCount);
+
+    // Whatever alignment padding sits between the indices and the texture stays deterministic on disk
+    memset(pDst + pLAYOUT->indexOffset + (size_t)pLAYOUT->indexCount * pLAYOUT->indexSize, 0,
+           pLAYOUT->textureOffset - pLAYOUT->indexOffset - (size_t)pLAYOUT->indexCount * pLAYOUT->indexSize);
+
+    memcpy(pDst + pLAYOUT->textureOffset, pTEXTURE,
+           (size_t)pLAYOUT->textureWidth * pLAYOUT->textureHeight * MODEL_CACHE_TEXTURE_BPP);
+}
+#pragma endregion
+#pragma region Cache
+bool modelCache_header_valid(const ModelCacheHeader_t *pHEADER, const uint64_t SOURCE_HASH)
+{
+    return pHEADER && pHEADER->magic == CACHE_MAGIC && pHEADER->version == CACHE_VERSION && pHEADER->sourceHash == SOURCE_HASH;
+}
+
+/// @brief pNAME with the cache extension. False when it doesn't fit
+static bool modelCache_fileName_get(const char *pNAME, char pFileName[MAX_FILE_NAME_LENGTH])
+{
+    const int LENGTH = snprintf(pFileName, MAX_FILE_NAME_LENGTH, "%s%s", pNAME, pMODEL_CACHE_FILE_EXTENSION);
+    return LENGTH > 0 && LENGTH < MAX_FILE_NAME_LENGTH;
+}
+
+FILE *modelCache_cache_open(const char *pNAME, const uint64_t SOURCE_HASH, ModelCacheLayout_t *pLayout)
+{
+    char pFileName[MAX_FILE_NAME_LENGTH];
+    if (!pNAME || !pLayout || !modelCache_fileName_get(pNAME, pFileName))
+        return NULL;
+
+    char pPath[MAX_DIR_PATH_LENGTH];
+    if (!fileIO_file_exists(pMODEL_CACHE_FOLDER_NAME, pFileName, pPath))
+        return NULL;
+
+    FILE *pFile = NULL;
+    if (fileIO_file_open(&pFile, pPath, "rb", pFileName) != FILE_IO_RESULT_SUCCESS)
+        return NULL;
+
+    ModelCacheHeader_t header;
+    if (fread(&header, sizeof(header), 1, pFile) == 1 && modelCache_header_valid(&header, SOURCE_HASH) &&
+        modelCache_layout_get(header.vertexCount, header.indexCount, header.textureWidth, header.textureHeight, pLayout) &&
+        header.dataSize == (uint64_t)pLayout->totalSize)
+        return pFile;
+
+    logs_log(LOG_DEBUG, "The cooked model '%s' is stale and will be recooked.", pFileName);
+    fileIO_file_close(pFile, pFileName);
+    return NULL;
+}
+
+bool modelCache_cache_read(FILE *pFile, const ModelCacheLayout_t *restrict pLAYOUT, void *restrict pDst)
+{
+    if (!pFile)
+        return false;
+
+    const bool READ = pLAYOUT && pDst && fread(pDst, 1, pLAYOUT->totalSize, pFile) == pLAYOUT->totalSize;
+    if (!READ)
+        logs_log(LOG_WARN, "Failed to read a cooked model. It will be recooked.");
+
+    fileIO_file_close(pFile, pMODEL_CACHE_DEBUG_NAME);
+    return READ;
+}
+
+void modelCache_cache_write(const char *pNAME, const uint64_t SOURCE_HASH, const ModelCacheLayout_t *restrict pLAYOUT,
+                            const void *restrict pDATA)
+{
+    char pFileName[MAX_FILE_NAME_LENGTH];
+    if (!pNAME || !pLAYOUT || !pDATA || !modelCache_fileName_get(pNAME, pFileName))
+        return;
+
+    char pFullDir[MAX_DIR_PATH_LENGTH];
+    if (fileIO_dir_create(pMODEL_CACHE_FOLDER_NAME, pFullDir) == FILE_IO_RESULT_FAILURE)
+        return;
+
+    char pPath[MAX_DIR_PATH_LENGTH];
+    snprintf(pPath, sizeof(pPath), "%s/%s", pFullDir, pFileName);
+
+    FILE *pFile = NULL;
+    if (fileIO_file_open(&pFile, pPath, "wb", pFileName) != FILE_IO_RESULT_SUCCESS)
+        return;
+
+    const ModelCacheHeader_t HEADER = {
+        .magic = CACHE_MAGIC,
+        .version = CACHE_VERSION,
+        .sourceHash = SOURCE_HASH,
+        .vertexCount = pLAYOUT->vertexCount,
+        .indexCount = pLAYOUT->indexCount,
+        .textureWidth = pLAYOUT->textureWidth,
+        .textureHeight = pLAYOUT->textureHeight,
+        .dataSize = pLAYOUT->totalSize,
+    };
+
+    if (fwrite(&HEADER, sizeof(HEADER), 1, pFile) != 1 || fwrite(pDATA, 1, pLAYOUT->totalSize, pFile) != pLAYOUT->totalSize)
+        logs_log(LOG_WARN, "Failed to write the cooked model to '%s'.", pPath);
+    else
+        logs_log(LOG_DEBUG, "Saved %zu bytes of cooked model to '%s'.", pLAYOUT->totalSize, pPath);
+
+    fileIO_file_close(pFile, pFileName);
+}
+#pragma endregion
+#pragma region Undefines
+#undef CACHE_MAGIC
+#undef CACHE_VERSION
+#undef MAX_TEXTURE_SIDE
+#undef MAX_ELEMENT_COUNT
+#undef VERTEX_CACHE_SIZE
+#undef CACHE_DECAY_POWER
+#undef LAST_TRIANGLE_SCORE
+#undef VALENCE_BOOST_SCALE
+#undef VALENCE_BOOST_POWER
+#pragma endregion
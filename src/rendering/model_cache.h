@@ -0,0 +1,73 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "rendering/types/shaderVertexModel_t.h"
+
+// RGBA8
+#define MODEL_CACHE_TEXTURE_BPP 4
+// Every index of a model with at most this many vertices fits in 16 bits
+#define MODEL_CACHE_INDEX16_MAX_VERTICES 65536U
+
+/// @brief Where each part of a cooked model sits in its blob. Vertices, then indices, then the decoded texture
+typedef struct ModelCacheLayout_t
+{
+    uint32_t vertexCount;
+    uint32_t indexCount;
+    // 2 or 4 bytes
+    uint32_t indexSize;
+    uint32_t textureWidth;
+    uint32_t textureHeight;
+    size_t indexOffset;
+    // Aligned to the texel size, as buffer to image copies require
+    size_t textureOffset;
+    size_t totalSize;
+} ModelCacheLayout_t;
+
+/// @brief Start of a cooked model file, followed by ModelCacheLayout_t.totalSize bytes of blob
+typedef struct ModelCacheHeader_t
+{
+    uint32_t magic;
+    uint32_t version;
+    // Of the GLB's bytes, then the texture's
+    uint64_t sourceHash;
+    uint32_t vertexCount;
+    uint32_t indexCount;
+    uint32_t textureWidth;
+    uint32_t textureHeight;
+    uint64_t dataSize;
+} ModelCacheHeader_t;
+
+/// @brief False when there's no geometry or texture, or the blob would be too big to address. Picks 16 bit indices whenever
+/// the vertex count allows it
+bool modelCache_layout_get(const uint32_t VERTEX_COUNT, const uint32_t INDEX_COUNT, const uint32_t TEXTURE_WIDTH,
+                           const uint32_t TEXTURE_HEIGHT, ModelCacheLayout_t *pLayout);
+
+/// @brief Reorders the triangles so consecutive ones share vertices still in the GPU's post-transform cache (Forsyth's linear
+/// speed optimizer). Triangles keep their winding. False, with the indices untouched, when they're invalid or memory runs out
+bool modelCache_triangles_optimize(uint32_t *pIndices, const uint32_t INDEX_COUNT, const uint32_t VERTEX_COUNT);
+
+/// @brief Renumbers the vertices in the order the indices first use them, so fetches walk the vertex buffer forwards. Vertices
+/// no index uses are dropped. Returns the new vertex count, or VERTEX_COUNT with nothing changed on failure
+uint32_t modelCache_vertices_reorder(ShaderVertexModel_t *restrict pVertices, const uint32_t VERTEX_COUNT,
+                                     uint32_t *restrict pIndices, const uint32_t INDEX_COUNT);
+
+/// @brief Writes the blob pLAYOUT describes into pDst, narrowing the indices when the layout uses 16 bit ones
+void modelCache_cook(const ModelCacheLayout_t *restrict pLAYOUT, const ShaderVertexModel_t *restrict pVERTICES,
+                     const uint32_t *restrict pINDICES, const uint8_t *restrict pTEXTURE, uint8_t *restrict pDst);
+
+/// @brief Checks that a cooked model header belongs to this version and source
+bool modelCache_header_valid(const ModelCacheHeader_t *pHEADER, const uint64_t SOURCE_HASH);
+
+/// @brief Opens pNAME's cooked model when it was cooked from SOURCE_HASH and fills pLayout from it. The file is left at the blob
+/// for modelCache_cache_read. NULL when there's no usable cache
+FILE *modelCache_cache_open(const char *pNAME, const uint64_t SOURCE_HASH, ModelCacheLayout_t *pLayout);
+
+/// @brief Reads the blob into pDst and closes the file
+bool modelCache_cache_read(FILE *pFile, const ModelCacheLayout_t *restrict pLAYOUT, void *restrict pDst);
+
+/// @brief Writes pNAME's cooked model to the config folder. Failing only costs the next launch a cook
+void modelCache_cache_write(const char *pNAME, const uint64_t SOURCE_HASH, const ModelCacheLayout_t *restrict pLAYOUT,
+                            const void *restrict pDATA);
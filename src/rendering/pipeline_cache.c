@@ -0,0 +1,183 @@
+#pragma region Includes
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <vulkan/vulkan.h>
+#include "core/logs.h"
+#include "core/fileIO.h"
+#include "core/types/state_t.h"
+#include "rendering/pipeline_cache.h"
+#pragma endregion
+#pragma region Defines
+static const char *pPIPELINE_CACHE_FOLDER_NAME = "config";
+static const char *pPIPELINE_CACHE_FILE_NAME = "pipeline.cache";
+static const char *pPIPELINE_CACHE_TEMP_FILE_NAME = "pipeline.cache.tmp";
+// VkPipelineCacheHeaderVersionOne: header size, header version, vendor ID, device ID, then the pipeline cache UUID
+#define HEADER_SIZE (4 * sizeof(uint32_t) + VK_UUID_SIZE)
+// Anything bigger than this on disk isn't a pipeline cache this program wrote
+#define MAX_FILE_SIZE ((size_t)64 * 1024 * 1024)
+#pragma endregion
+#pragma region Header
+/// @brief Cache headers are always stored least significant byte first, whatever the host is
+static inline uint32_t pipelineCache_u32_read(const uint8_t *pBYTES)
+{
+    return (uint32_t)pBYTES[0] | (uint32_t)pBYTES[1] << 8 | (uint32_t)pBYTES[2] << 16 | (uint32_t)pBYTES[3] << 24;
+}
+
+bool pipelineCache_header_valid(const void *pDATA, const size_t SIZE, const VkPhysicalDeviceProperties *pPROPERTIES)
+{
+    if (!pDATA || !pPROPERTIES || SIZE < HEADER_SIZE)
+        return false;
+
+    const uint8_t *pBYTES = pDATA;
+    const uint32_t HEADER_LENGTH = pipelineCache_u32_read(pBYTES);
+    const uint32_t HEADER_VERSION = pipelineCache_u32_read(pBYTES + 4);
+    const uint32_t VENDOR_ID = pipelineCache_u32_read(pBYTES + 8);
+    const uint32_t DEVICE_ID = pipelineCache_u32_read(pBYTES + 12);
+
+    return HEADER_LENGTH >= HEADER_SIZE && HEADER_LENGTH <= SIZE && HEADER_VERSION == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+           VENDOR_ID == pPROPERTIES->vendorID && DEVICE_ID == pPROPERTIES->deviceID &&
+           memcmp(pBYTES + 16, pPROPERTIES->pipelineCacheUUID, VK_UUID_SIZE) == 0;
+}
+#pragma endregion
+#pragma region Load/Save
+/// @brief Reads the saved cache into a malloc'd buffer. Returns NULL when there is none or it can't be read
+static void *pipelineCache_file_read(size_t *pSize)
+{
+    *pSize = 0;
+
+    char pPath[MAX_DIR_PATH_LENGTH];
+    if (!fileIO_file_exists(pPIPELINE_CACHE_FOLDER_NAME, pPIPELINE_CACHE_FILE_NAME, pPath))
+        return NULL;
+
+    void *pData = fileIO_file_read(pPath, pSize, pPIPELINE_CACHE_FILE_NAME);
+    if (pData && *pSize > MAX_FILE_SIZE)
+    {
+        free(pData);
+        *pSize = 0;
+        return NULL;
+    }
+
+    return pData;
+}
+
+void pipelineCache_save(State_t *pState)
+{
+    if (!pState || pState->renderer.pipelineCache == VK_NULL_HANDLE)
+        return;
+
+    const VkDevice DEVICE = pState->context.device;
+    size_t size = 0;
+    if (vkGetPipelineCacheData(DEVICE, pState->renderer.pipelineCache, &size, NULL) != VK_SUCCESS || size == 0)
+        return;
+
+    void *pData = malloc(size);
+    if (!pData)
+        return;
+
+    do
+    {
+        if (vkGetPipelineCacheData(DEVICE, pState->renderer.pipelineCache, &size, pData) != VK_SUCCESS)
+        {
+            logs_log(LOG_WARN, "Failed to read back the pipeline cache. It will not be saved.");
+            break;
+        }
+
+        char pFullDir[MAX_DIR_PATH_LENGTH];
+        if (fileIO_dir_create(pPIPELINE_CACHE_FOLDER_NAME, pFullDir) == FILE_IO_RESULT_FAILURE)
+            break;
+
+        char pPath[MAX_DIR_PATH_LENGTH];
+        char pTempPath[MAX_DIR_PATH_LENGTH];
+        snprintf(pPath, sizeof(pPath), "%s/%s", pFullDir, pPIPELINE_CACHE_FILE_NAME);
+        snprintf(pTempPath, sizeof(pTempPath), "%s/%s", pFullDir, pPIPELINE_CACHE_TEMP_FILE_NAME);
+
+        // Binary, so fileIO_file_create's text mode won't do. Written beside the old cache and only moved over it once
+        // complete, so quitting mid-write can't leave a truncated cache for the next launch
+        FILE *pFile = NULL;
+        if (fileIO_file_open(&pFile, pTempPath, "wb", pPIPELINE_CACHE_TEMP_FILE_NAME) != FILE_IO_RESULT_SUCCESS)
+            break;
+
+        const bool WRITTEN = fwrite(pData, 1, size, pFile) == size;
+        fileIO_file_close(pFile, pPIPELINE_CACHE_TEMP_FILE_NAME);
+
+        if (!WRITTEN)
+        {
+            logs_log(LOG_WARN, "Failed to write the pipeline cache to '%s'.", pTempPath);
+            remove(pTempPath);
+            break;
+        }
+
+        if (fileIO_file_replace(pTempPath, pPath, pPIPELINE_CACHE_FILE_NAME) == FILE_IO_RESULT_SUCCESS)
+            logs_log(LOG_DEBUG, "Saved %zu bytes of pipeline cache to '%s'.", size, pPath);
+    } while (0);
+
+    free(pData);
+}
+#pragma endregion
+#pragma region Create/Destroy
+void pipelineCache_create(State_t *pState)
+{
+    if (!pState)
+        return;
+
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(pState->context.physicalDevice, &properties);
+
+    size_t size = 0;
+    void *pData = pipelineCache_file_read(&size);
+    if (pData && !pipelineCache_header_valid(pData, size, &properties))
+    {
+        // A different GPU or driver. Handing its blobs to this one is at best useless
+        logs_log(LOG_WARN, "Discarding a saved pipeline cache that was written by a different device or driver.");
+        free(pData);
+        pData = NULL;
+        size = 0;
+    }
+
+    VkPipelineCacheCreateInfo createInfo = {
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
+        .initialDataSize = size,
+        .pInitialData = pData,
+    };
+
+    VkResult result = vkCreatePipelineCache(pState->context.device, &createInfo, pState->context.pAllocator,
+                                            &pState->renderer.pipelineCache);
+    if (result != VK_SUCCESS && pData)
+    {
+        // The driver can still reject data that passed the header check, so fall back to starting empty
+        logs_log(LOG_WARN, "The saved pipeline cache was rejected by the driver (VkResult = %d). Starting empty.", (int)result);
+        createInfo.initialDataSize = 0;
+        createInfo.pInitialData = NULL;
+        result = vkCreatePipelineCache(pState->context.device, &createInfo, pState->context.pAllocator,
+                                       &pState->renderer.pipelineCache);
+    }
+
+    if (result != VK_SUCCESS)
+    {
+        // Pipelines still get created without one, just slower
+        logs_log(LOG_WARN, "Failed to create a pipeline cache (VkResult = %d).", (int)result);
+        pState->renderer.pipelineCache = VK_NULL_HANDLE;
+    }
+    else
+        logs_log(LOG_DEBUG, "Created the pipeline cache from %zu bytes of saved data.", createInfo.initialDataSize);
+
+    free(pData);
+}
+
+void pipelineCache_destroy(State_t *pState)
+{
+    if (!pState || pState->renderer.pipelineCache == VK_NULL_HANDLE)
+        return;
+
+    pipelineCache_save(pState);
+
+    vkDestroyPipelineCache(pState->context.device, pState->renderer.pipelineCache, pState->context.pAllocator);
+    pState->renderer.pipelineCache = VK_NULL_HANDLE;
+}
+#pragma endregion
+#pragma region Undefines
+#undef HEADER_SIZE
+#undef MAX_FILE_SIZE
+#pragma endregion
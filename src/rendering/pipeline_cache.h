@@ -0,0 +1,18 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <vulkan/vulkan.h>
+#include "core/types/state_t.h"
+
+/// @brief Checks that the cache data starts with a valid header written by the same vendor, device and driver (pipeline cache UUID)
+bool pipelineCache_header_valid(const void *pDATA, const size_t SIZE, const VkPhysicalDeviceProperties *pPROPERTIES);
+
+/// @brief Creates the pipeline cache, seeded from the config folder when the saved data belongs to this device and driver
+void pipelineCache_create(State_t *pState);
+
+/// @brief Writes the pipeline cache to the config folder. Failing to save only costs the next launch some time
+void pipelineCache_save(State_t *pState);
+
+/// @brief Saves and then destroys the pipeline cache
+void pipelineCache_destroy(State_t *pState);
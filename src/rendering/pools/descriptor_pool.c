@@ -6,6 +6,9 @@
 #include "core/types/state_t.h"
 #include "rendering/types/uniformBufferObject_t.h"
 #include "core/crash_handler.h"
+#include "rendering/image.h"
+#include "rendering/buffers/command_buffer.h"
+#include "rendering/pools/descriptor_pool.h"
 #pragma endregion
 #pragma region Layout Binding
 void descriptorSet_layout_create(State_t *pState)
@@ -51,6 +54,33 @@ void descriptorSet_layout_create(State_t *pState)
             break;
         }
 
+        // Models share one set per frame and pick their texture out of this table with a push constant index
+        const VkDescriptorSetLayoutBinding MODEL_TEXTURES_BINDING = {
+            .binding = 1,
+            .descriptorCount = DESCRIPTOR_POOL_MODEL_TEXTURE_MAX,
+            .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+            .pImmutableSamplers = VK_NULL_HANDLE,
+            .stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT,
+        };
+
+        const VkDescriptorSetLayoutBinding pMODEL_BINDINGS[] = {
+            UBO_LAYOUT_BINDING,
+            MODEL_TEXTURES_BINDING,
+        };
+
+        const VkDescriptorSetLayoutCreateInfo MODEL_CREATE_INFO = {
+            .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+            .bindingCount = sizeof(pMODEL_BINDINGS) / sizeof(*pMODEL_BINDINGS),
+            .pBindings = pMODEL_BINDINGS,
+        };
+
+        if (vkCreateDescriptorSetLayout(pState->context.device, &MODEL_CREATE_INFO, pState->context.pAllocator,
+                                        &pState->renderer.modelDescriptorSetLayout) != VK_SUCCESS)
+        {
+            logs_log(LOG_ERROR, "Failed to create the Vulkan model descriptor set layout!");
+            break;
+        }
+
         return;
     } while (0);
 
@@ -58,8 +88,8 @@ void descriptorSet_layout_create(State_t *pState)
 }
 #pragma endregion
 #pragma region Sets Create/Dest
-/// @brief Allocates the state's descriptor sets with their descriptor set layouts
-static void sets_allocate(State_t *pState)
+/// @brief Allocates one set per frame in flight with the given layout
+static void sets_allocate(State_t *pState, VkDescriptorSetLayout layout, VkDescriptorSet **ppSets)
 {
     VkDescriptorSetLayout *pLayouts = NULL;
     int crashLine = 0;
@@ -74,7 +104,7 @@ static void sets_allocate(State_t *pState)
         }
 
         for (uint32_t i = 0; i < pState->config.maxFramesInFlight; i++)
-            pLayouts[i] = pState->renderer.descriptorSetLayout;
+            pLayouts[i] = layout;
 
         const VkDescriptorSetAllocateInfo ALLOCATE_INFO = {
             .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
@@ -83,10 +113,10 @@ static void sets_allocate(State_t *pState)
             .pSetLayouts = pLayouts,
         };
 
-        pState->renderer.pDescriptorSets = malloc(sizeof(VkDescriptorSet) * pState->config.maxFramesInFlight);
+        *ppSets = malloc(sizeof(VkDescriptorSet) * pState->config.maxFramesInFlight);
 
-        if (!pState->renderer.pDescriptorSets ||
-            vkAllocateDescriptorSets(pState->context.device, &ALLOCATE_INFO, pState->renderer.pDescriptorSets) != VK_SUCCESS)
+        if (!*ppSets ||
+            vkAllocateDescriptorSets(pState->context.device, &ALLOCATE_INFO, *ppSets) != VK_SUCCESS)
         {
             crashLine = __LINE__;
             logs_log(LOG_ERROR, "Failed to allocate memory for Vulkan descriptor sets!");
@@ -99,7 +129,8 @@ static void sets_allocate(State_t *pState)
 
     if (crashLine != 0)
     {
-        free(pState->renderer.pDescriptorSets);
+        free(*ppSets);
+        *ppSets = NULL;
         crashHandler_crash_graceful(
             CRASH_LOCATION_LINE(crashLine),
             "The program cannot continue without the Vulkan descriptor sets being allocated for use in image presentation.");
@@ -153,19 +184,193 @@ static void sets_populate(State_t *pState)
         VkCopyDescriptorSet *pDestination = VK_NULL_HANDLE;
         vkUpdateDescriptorSets(pState->context.device, sizeof(DESCRIPTOR_WRITES) / sizeof(*DESCRIPTOR_WRITES), DESCRIPTOR_WRITES,
                                numCopies, pDestination);
+
+        // The model table's textures are written as models load and fall back to modelFallbackImageView until then
+        const VkWriteDescriptorSet MODEL_UBO_WRITE = {
+            .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+            .dstSet = pState->renderer.pModelDescriptorSets[i],
+            .dstBinding = 0,
+            .dstArrayElement = 0,
+            .descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+            .descriptorCount = 1,
+            .pBufferInfo = &BUFFER_INFO,
+        };
+        vkUpdateDescriptorSets(pState->context.device, 1, &MODEL_UBO_WRITE, numCopies, pDestination);
     }
 }
 
+_Static_assert(DESCRIPTOR_POOL_MODEL_TEXTURE_MAX <= 32, "The model texture dirty masks hold a bit per slot");
+
+/// @brief Points the model table slot INDEX at the view. Every frame's set is only written at its next flush
+static void modelTexture_slot_set(State_t *pState, const uint32_t INDEX, VkImageView view, VkSampler sampler)
+{
+    pState->renderer.pModelTextureInfos[INDEX] = (VkDescriptorImageInfo){
+        .imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+        .imageView = view,
+        .sampler = sampler,
+    };
+
+    for (uint32_t i = 0; i < pState->config.maxFramesInFlight; i++)
+        pState->renderer.pModelTextureDirtyMasks[i] |= 1U << INDEX;
+}
+
+void descriptorPool_modelTexture_flush(State_t *pState, const uint32_t FRAME_INDEX)
+{
+    if (!pState || !pState->renderer.pModelTextureDirtyMasks || FRAME_INDEX >= pState->config.maxFramesInFlight)
+        return;
+
+    const uint32_t DIRTY = pState->renderer.pModelTextureDirtyMasks[FRAME_INDEX];
+    if (DIRTY == 0)
+        return;
+
+    // One write per run of neighboring dirty slots, since the infos are laid out like the table
+    VkWriteDescriptorSet pWrites[DESCRIPTOR_POOL_MODEL_TEXTURE_MAX];
+    uint32_t writeCount = 0;
+    for (uint32_t slot = 0; slot < DESCRIPTOR_POOL_MODEL_TEXTURE_MAX;)
+    {
+        if (!(DIRTY & (1U << slot)))
+        {
+            slot++;
+            continue;
+        }
+
+        const uint32_t FIRST = slot;
+        while (slot < DESCRIPTOR_POOL_MODEL_TEXTURE_MAX && (DIRTY & (1U << slot)))
+            slot++;
+
+        pWrites[writeCount++] = (VkWriteDescriptorSet){
+            .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+            .dstSet = pState->renderer.pModelDescriptorSets[FRAME_INDEX],
+            .dstBinding = 1,
+            .dstArrayElement = FIRST,
+            .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+            .descriptorCount = slot - FIRST,
+            .pImageInfo = &pState->renderer.pModelTextureInfos[FIRST],
+        };
+    }
+
+    vkUpdateDescriptorSets(pState->context.device, writeCount, pWrites, 0, VK_NULL_HANDLE);
+    pState->renderer.pModelTextureDirtyMasks[FRAME_INDEX] = 0;
+}
+
+/// @brief Creates the 1x1 texture that fills model table slots no model owns. Magenta so a model sampling one stands out
+static void modelTexture_fallback_create(State_t *pState)
+{
+    const VkFormat FORMAT = VK_FORMAT_R8G8B8A8_SRGB;
+    imageCreate(pState, 1, 1, FORMAT, VK_IMAGE_TILING_OPTIMAL,
+                VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                &pState->renderer.modelFallbackImage, &pState->renderer.modelFallbackImageMemory);
+
+    const VkClearColorValue COLOR = {.float32 = {1.0f, 0.0f, 1.0f, 1.0f}};
+    const VkImageSubresourceRange RANGE = {
+        .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+        .baseMipLevel = 0,
+        .levelCount = 1,
+        .baseArrayLayer = 0,
+        .layerCount = 1,
+    };
+
+    VkCommandBuffer commandBuffer = commandBuffer_singleTime_start(pState);
+    imageLayoutTransitionRecord(commandBuffer, pState->renderer.modelFallbackImage, 1, 1,
+                                VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+    vkCmdClearColorImage(commandBuffer, pState->renderer.modelFallbackImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                         &COLOR, 1, &RANGE);
+    imageLayoutTransitionRecord(commandBuffer, pState->renderer.modelFallbackImage, 1, 1,
+                                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    commandBuffer_singleTime_end(pState, commandBuffer);
+
+    pState->renderer.modelFallbackImageView = imageViewCreate(pState, pState->renderer.modelFallbackImage, FORMAT,
+                                                              VK_IMAGE_ASPECT_COLOR_BIT);
+}
+
+static void modelTexture_fallback_destroy(State_t *pState)
+{
+    vkDestroyImageView(pState->context.device, pState->renderer.modelFallbackImageView, pState->context.pAllocator);
+    vkDestroyImage(pState->context.device, pState->renderer.modelFallbackImage, pState->context.pAllocator);
+    vkFreeMemory(pState->context.device, pState->renderer.modelFallbackImageMemory, pState->context.pAllocator);
+    pState->renderer.modelFallbackImageView = VK_NULL_HANDLE;
+    pState->renderer.modelFallbackImage = VK_NULL_HANDLE;
+    pState->renderer.modelFallbackImageMemory = VK_NULL_HANDLE;
+}
+
+/// @brief Chains every slot of the model table onto the free list and points them all at the fallback texture
+static void modelTexture_slots_reset(State_t *pState)
+{
+    pState->renderer.pModelTextureNextFree = malloc(sizeof(uint32_t) * DESCRIPTOR_POOL_MODEL_TEXTURE_MAX);
+    pState->renderer.pModelTextureInfos = malloc(sizeof(VkDescriptorImageInfo) * DESCRIPTOR_POOL_MODEL_TEXTURE_MAX);
+    pState->renderer.pModelTextureDirtyMasks = calloc(pState->config.maxFramesInFlight, sizeof(uint32_t));
+    if (!pState->renderer.pModelTextureNextFree || !pState->renderer.pModelTextureInfos || !pState->renderer.pModelTextureDirtyMasks)
+        crashHandler_crash_graceful(CRASH_LOCATION, "The program cannot continue without the model texture table.");
+
+    for (uint32_t i = 0; i < DESCRIPTOR_POOL_MODEL_TEXTURE_MAX; i++)
+        pState->renderer.pModelTextureNextFree[i] = i + 1 < DESCRIPTOR_POOL_MODEL_TEXTURE_MAX ? i + 1
+                                                                                              : DESCRIPTOR_POOL_MODEL_TEXTURE_INVALID;
+    pState->renderer.modelTextureFreeSlot = 0;
+
+    // The whole table is statically used by the shader, so every slot needs a valid descriptor before the first draw. Each
+    // frame's first flush writes them all
+    for (uint32_t i = 0; i < DESCRIPTOR_POOL_MODEL_TEXTURE_MAX; i++)
+        modelTexture_slot_set(pState, i, pState->renderer.modelFallbackImageView, pState->renderer.textureSampler);
+}
+
 void sets_create(State_t *pState)
 {
-    sets_allocate(pState);
+    sets_allocate(pState, pState->renderer.descriptorSetLayout, &pState->renderer.pDescriptorSets);
+    sets_allocate(pState, pState->renderer.modelDescriptorSetLayout, &pState->renderer.pModelDescriptorSets);
     sets_populate(pState);
+    modelTexture_fallback_create(pState);
+    modelTexture_slots_reset(pState);
 }
 
 void sets_destroy(State_t *pState)
 {
-    // The descriptor set itself is freed by Vulkan when the descriptor pool is freed
+    // The descriptor sets themselves are freed by Vulkan when the descriptor pool is freed
     vkDestroyDescriptorSetLayout(pState->context.device, pState->renderer.descriptorSetLayout, pState->context.pAllocator);
+    vkDestroyDescriptorSetLayout(pState->context.device, pState->renderer.modelDescriptorSetLayout, pState->context.pAllocator);
+    free(pState->renderer.pDescriptorSets);
+    free(pState->renderer.pModelDescriptorSets);
+    free(pState->renderer.pModelTextureNextFree);
+    free(pState->renderer.pModelTextureInfos);
+    free(pState->renderer.pModelTextureDirtyMasks);
+    pState->renderer.pDescriptorSets = NULL;
+    pState->renderer.pModelDescriptorSets = NULL;
+    pState->renderer.pModelTextureNextFree = NULL;
+    pState->renderer.pModelTextureInfos = NULL;
+    pState->renderer.pModelTextureDirtyMasks = NULL;
+    modelTexture_fallback_destroy(pState);
+}
+
+uint32_t descriptorPool_modelTexture_add(State_t *pState, VkImageView view, VkSampler sampler)
+{
+    if (!pState || !pState->renderer.pModelDescriptorSets || view == VK_NULL_HANDLE || sampler == VK_NULL_HANDLE)
+        return DESCRIPTOR_POOL_MODEL_TEXTURE_INVALID;
+
+    const uint32_t INDEX = pState->renderer.modelTextureFreeSlot;
+    if (INDEX == DESCRIPTOR_POOL_MODEL_TEXTURE_INVALID)
+    {
+        logs_log(LOG_ERROR, "The model texture table is full! At most %u models (DESCRIPTOR_POOL_MODEL_TEXTURE_MAX) can be loaded at "
+                            "once, so this one won't be. Release a model first or raise the cap along with shader_model_fill.frag.",
+                 DESCRIPTOR_POOL_MODEL_TEXTURE_MAX);
+        return DESCRIPTOR_POOL_MODEL_TEXTURE_INVALID;
+    }
+
+    pState->renderer.modelTextureFreeSlot = pState->renderer.pModelTextureNextFree[INDEX];
+    pState->renderer.pModelTextureNextFree[INDEX] = DESCRIPTOR_POOL_MODEL_TEXTURE_INVALID;
+    modelTexture_slot_set(pState, INDEX, view, sampler);
+
+    return INDEX;
+}
+
+void descriptorPool_modelTexture_release(State_t *pState, const uint32_t INDEX)
+{
+    if (!pState || !pState->renderer.pModelDescriptorSets || INDEX >= DESCRIPTOR_POOL_MODEL_TEXTURE_MAX)
+        return;
+
+    // The owner's view is going away, so the slot has to stop naming it before any frame binds the table again
+    modelTexture_slot_set(pState, INDEX, pState->renderer.modelFallbackImageView, pState->renderer.textureSampler);
+
+    pState->renderer.pModelTextureNextFree[INDEX] = pState->renderer.modelTextureFreeSlot;
+    pState->renderer.modelTextureFreeSlot = INDEX;
 }
 #pragma endregion
 #pragma region Pool Create/Dest
@@ -173,16 +378,17 @@ void descriptorPool_create(State_t *pState)
 {
     do
     {
+        // Each frame has the voxel set and the model set
         const VkDescriptorPoolSize pPOOL_SIZES[] = {
             {
                 // ubo
                 .type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-                .descriptorCount = pState->config.maxFramesInFlight,
+                .descriptorCount = 2 * pState->config.maxFramesInFlight,
             },
             {
-                // sampler
+                // atlas sampler and the model texture table
                 .type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-                .descriptorCount = pState->config.maxFramesInFlight,
+                .descriptorCount = (1 + DESCRIPTOR_POOL_MODEL_TEXTURE_MAX) * pState->config.maxFramesInFlight,
             },
         };
 
@@ -192,7 +398,7 @@ void descriptorPool_create(State_t *pState)
             .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
             .poolSizeCount = numPools,
             .pPoolSizes = pPOOL_SIZES,
-            .maxSets = pState->config.maxFramesInFlight,
+            .maxSets = 2 * pState->config.maxFramesInFlight,
         };
 
         if (vkCreateDescriptorPool(pState->context.device, &CREATE_INFO, pState->context.pAllocator,
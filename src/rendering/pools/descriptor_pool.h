@@ -1,7 +1,14 @@
 #pragma once
 
+#include <stdint.h>
 #include "core/types/state_t.h"
 
+// Textures every model shares through one table, which caps how many models can be loaded at once. Sixteen is the minimum
+// maxPerStageDescriptorSamplers every device guarantees, and the dirty masks hold a bit per slot, so it can't pass 32. Keep in
+// sync with shader_model_fill.frag
+#define DESCRIPTOR_POOL_MODEL_TEXTURE_MAX 16U
+#define DESCRIPTOR_POOL_MODEL_TEXTURE_INVALID UINT32_MAX
+
 /// @brief Creates and binds the descriptor set layouts. Must be done before creating the descriptor pool and graphics pipelines.
 void descriptorSet_layout_create(State_t *pState);
 
@@ -10,3 +17,16 @@ void descriptorPool_create(State_t *pState);
 
 /// @brief Destroys the descriptor pool
 void descriptorPool_destroy(State_t *pState);
+
+/// @brief Adds a model texture to the model table and returns its index for the model's push constants, or
+/// DESCRIPTOR_POOL_MODEL_TEXTURE_INVALID when all DESCRIPTOR_POOL_MODEL_TEXTURE_MAX slots are taken. Each frame's set picks the
+/// texture up at that frame's next descriptorPool_modelTexture_flush. MAIN THREAD ONLY.
+uint32_t descriptorPool_modelTexture_add(State_t *pState, VkImageView view, VkSampler sampler);
+
+/// @brief Returns a slot handed out by descriptorPool_modelTexture_add to the table and points it back at the fallback texture.
+/// The view may only be destroyed once no frame in flight uses it. MAIN THREAD ONLY.
+void descriptorPool_modelTexture_release(State_t *pState, const uint32_t INDEX);
+
+/// @brief Writes the model table slots that changed since FRAME_INDEX last flushed into that frame's set. Call after that frame's
+/// fence has been waited on and before recording it. MAIN THREAD ONLY.
+void descriptorPool_modelTexture_flush(State_t *pState, const uint32_t FRAME_INDEX);
@@ -1,123 +1,256 @@
+#pragma region Includes
+#include <stdlib.h>
+#include <inttypes.h>
 #include <vulkan/vulkan.h>
 #include "core/types/state_t.h"
+#include "core/logs.h"
 #include "core/crash_handler.h"
 #include "renderGC.h"
-#include "collection/dynamicStack_t.h"
+#include "rendering/buffers/buffers.h"
+#pragma endregion
+#pragma region Defines
+#if defined(DEBUG)
+// #define DEBUG_RENDER_GC
+#endif
+// Recycled buffers are bucketed by power of two size from 1 KiB up to 64 MiB. Anything bigger is always destroyed
+#define RECYCLE_MIN_ORDER 10
+#define RECYCLE_MAX_ORDER 26
+#define RECYCLE_BUCKET_COUNT (RECYCLE_MAX_ORDER - RECYCLE_MIN_ORDER + 1)
+// Free buffers kept per bucket. Past this they are destroyed so a burst of releases doesn't pin memory forever
+#define RECYCLE_BUCKET_CAPACITY 8
+
+typedef struct RecycledBuffer_t
+{
+    VkBuffer buffer;
+    GpuAllocation_t allocation;
+    VkBufferUsageFlags usage;
+    VkMemoryPropertyFlags properties;
+} RecycledBuffer_t;
 
 static const size_t FLUSH_COUNT_PER_FRAME = 8;
-static size_t *pCount = NULL;
-static size_t *pCapacity = NULL;
-static PendingBufferDestroy_t **ppPendingBufferDestroys = NULL;
+static const size_t DEFAULT_CAPACITY = 256;
+static size_t pendingCount = 0;
+static size_t pendingCapacity = 0;
+static PendingBufferDestroy_t *pPendingBufferDestroys = NULL;
+static RecycledBuffer_t ppRecycled[RECYCLE_BUCKET_COUNT][RECYCLE_BUCKET_CAPACITY];
+static uint32_t pRecycledCounts[RECYCLE_BUCKET_COUNT];
+static RenderGCStats_t stats = {0};
+#pragma endregion
+#pragma region Buckets
+/// @brief Order of the smallest bucket SIZE fits in, or above RECYCLE_MAX_ORDER when it's too big for any
+static inline uint32_t renderGC_bucket_order(const VkDeviceSize SIZE)
+{
+    uint32_t order = RECYCLE_MIN_ORDER;
+    while (order <= RECYCLE_MAX_ORDER && ((VkDeviceSize)1 << order) < SIZE)
+        order++;
 
-void renderGC_pushGarbage(const uint32_t FRAME_INDEX, VkBuffer buffer, VkDeviceMemory memory)
+    return order;
+}
+
+/// @brief Files the buffer under its bucket. Returns false when the bucket is full and the buffer should be destroyed
+static bool renderGC_bucket_push(const PendingBufferDestroy_t *pGARBAGE)
 {
-    size_t count = pCount[FRAME_INDEX];
-    size_t capacity = pCapacity[FRAME_INDEX];
+    const uint32_t BUCKET = renderGC_bucket_order(pGARBAGE->bucketSize) - RECYCLE_MIN_ORDER;
+    if (pRecycledCounts[BUCKET] >= RECYCLE_BUCKET_CAPACITY)
+        return false;
 
-    if (count >= capacity)
+    ppRecycled[BUCKET][pRecycledCounts[BUCKET]++] = (RecycledBuffer_t){
+        .buffer = pGARBAGE->buffer,
+        .allocation = pGARBAGE->allocation,
+        .usage = pGARBAGE->usage,
+        .properties = pGARBAGE->properties,
+    };
+    stats.recycled++;
+    return true;
+}
+#pragma endregion
+#pragma region Garbage
+static void renderGC_pending_push(const PendingBufferDestroy_t GARBAGE)
+{
+    if (pendingCount >= pendingCapacity)
     {
-        size_t newCap = capacity * 2;
-        PendingBufferDestroy_t *pNew = realloc(ppPendingBufferDestroys[FRAME_INDEX], newCap * sizeof(PendingBufferDestroy_t));
+        const size_t NEW_CAPACITY = pendingCapacity ? pendingCapacity * 2 : DEFAULT_CAPACITY;
+        PendingBufferDestroy_t *pNew = realloc(pPendingBufferDestroys, NEW_CAPACITY * sizeof(PendingBufferDestroy_t));
 
         if (!pNew)
             crashHandler_crash_graceful(CRASH_LOCATION, "Failed to grow rendering garbage collector array!");
 
-        ppPendingBufferDestroys[FRAME_INDEX] = pNew;
-        pCapacity[FRAME_INDEX] = newCap;
-        capacity = newCap;
+        pPendingBufferDestroys = pNew;
+        pendingCapacity = NEW_CAPACITY;
     }
 
-    ppPendingBufferDestroys[FRAME_INDEX][count] = (PendingBufferDestroy_t){
-        .buffer = buffer,
-        .memory = memory};
-
-    pCount[FRAME_INDEX] = count + 1;
+    pPendingBufferDestroys[pendingCount++] = GARBAGE;
 }
 
-void renderGC_flushGarbage(State_t *pState, const uint32_t FRAME_INDEX, const bool FLUSH_ALL)
+void renderGC_pushGarbage(State_t *pState, VkBuffer buffer, GpuAllocation_t allocation)
 {
-    if (!pState)
+    if (!pState || buffer == VK_NULL_HANDLE)
         return;
 
-    size_t count = pCount[FRAME_INDEX];
-    if (count == 0)
-        return;
+    renderGC_pending_push((PendingBufferDestroy_t){
+        .buffer = buffer,
+        .allocation = allocation,
+        .frameNumber = pState->renderer.frameNumber,
+    });
+}
 
-    PendingBufferDestroy_t *pGarbage = ppPendingBufferDestroys[FRAME_INDEX];
+VkDeviceSize renderGC_buffer_acquire(State_t *restrict pState, const VkDeviceSize SIZE, const VkBufferUsageFlags USAGE,
+                                     const VkMemoryPropertyFlags PROPERTIES, VkBuffer *restrict pBuffer,
+                                     GpuAllocation_t *restrict pAllocation)
+{
+    if (!pState || !pBuffer || !pAllocation || SIZE == 0)
+        return 0;
 
-    size_t flushCount = 0;
-    for (size_t i = 0; i < count; ++i)
-    {
-        VkBuffer buffer = pGarbage[i].buffer;
-        VkDeviceMemory memory = pGarbage[i].memory;
+    const uint32_t ORDER = renderGC_bucket_order(SIZE);
+    const VkDeviceSize BUCKET_SIZE = ORDER <= RECYCLE_MAX_ORDER ? (VkDeviceSize)1 << ORDER : SIZE;
 
-        if (buffer != VK_NULL_HANDLE)
-            vkDestroyBuffer(pState->context.device, buffer, pState->context.pAllocator);
-        if (memory != VK_NULL_HANDLE)
-            vkFreeMemory(pState->context.device, memory, pState->context.pAllocator);
+    if (ORDER <= RECYCLE_MAX_ORDER)
+    {
+        const uint32_t BUCKET = ORDER - RECYCLE_MIN_ORDER;
+        for (uint32_t i = 0; i < pRecycledCounts[BUCKET]; i++)
+        {
+            const RecycledBuffer_t RECYCLED = ppRecycled[BUCKET][i];
+            if (RECYCLED.usage != USAGE || RECYCLED.properties != PROPERTIES)
+                continue;
 
-        pCount[FRAME_INDEX]--;
+            ppRecycled[BUCKET][i] = ppRecycled[BUCKET][--pRecycledCounts[BUCKET]];
+            *pBuffer = RECYCLED.buffer;
+            *pAllocation = RECYCLED.allocation;
+            stats.reused++;
+            return BUCKET_SIZE;
+        }
+    }
 
-        flushCount++;
-        if (flushCount >= FLUSH_COUNT_PER_FRAME && !FLUSH_ALL)
-            break;
+    bufferCreate(pState, BUCKET_SIZE, USAGE, PROPERTIES, pBuffer, pAllocation);
+    if (*pBuffer == VK_NULL_HANDLE || pAllocation->memory == VK_NULL_HANDLE)
+    {
+        bufferDestroy(pState, pBuffer, pAllocation);
+        return 0;
     }
+
+    stats.created++;
+    return BUCKET_SIZE;
 }
 
-void renderGC_init(State_t *pState)
+void renderGC_buffer_release(State_t *restrict pState, const VkDeviceSize SIZE, const VkBufferUsageFlags USAGE,
+                             const VkMemoryPropertyFlags PROPERTIES, VkBuffer *restrict pBuffer,
+                             GpuAllocation_t *restrict pAllocation)
 {
-    bool crash = false;
-    do
-    {
-        if (!pState)
-            break;
+    if (!pState || !pBuffer || !pAllocation || *pBuffer == VK_NULL_HANDLE)
+        return;
+
+    const uint32_t ORDER = renderGC_bucket_order(SIZE);
+    renderGC_pending_push((PendingBufferDestroy_t){
+        .buffer = *pBuffer,
+        .allocation = *pAllocation,
+        .frameNumber = pState->renderer.frameNumber,
+        .bucketSize = ORDER <= RECYCLE_MAX_ORDER ? (VkDeviceSize)1 << ORDER : 0,
+        .usage = USAGE,
+        .properties = PROPERTIES,
+    });
+
+    *pBuffer = VK_NULL_HANDLE;
+    *pAllocation = (GpuAllocation_t){0};
+}
+
+void renderGC_flushGarbage(State_t *pState, const bool FLUSH_ALL)
+{
+    if (!pState || pendingCount == 0)
+        return;
 
-        uint32_t maxFramesInFlight = pState->config.maxFramesInFlight;
-        ppPendingBufferDestroys = calloc(maxFramesInFlight, sizeof(PendingBufferDestroy_t *));
-        pCount = calloc(maxFramesInFlight, sizeof(size_t));
-        pCapacity = calloc(maxFramesInFlight, sizeof(size_t));
-        if (!ppPendingBufferDestroys || !pCount || !pCapacity)
-            break;
+    const uint64_t FRAMES_COMPLETED = pState->renderer.framesCompleted;
 
-        for (uint32_t i = 0; i < maxFramesInFlight; i++)
+    // Kept garbage is compacted to the front in order, so the oldest always goes first
+    size_t kept = 0;
+    size_t destroyCount = 0;
+    for (size_t i = 0; i < pendingCount; ++i)
+    {
+        PendingBufferDestroy_t *pGarbage = &pPendingBufferDestroys[i];
+
+        if (!FLUSH_ALL)
         {
-            const size_t DEFAULT_CAPACITY = 256;
-            ppPendingBufferDestroys[i] = malloc(sizeof(PendingBufferDestroy_t) * DEFAULT_CAPACITY);
-            pCapacity[i] = DEFAULT_CAPACITY;
-            pCount[i] = 0;
-            if (!ppPendingBufferDestroys[i])
+            // The GPU may still be reading it
+            if (pGarbage->frameNumber >= FRAMES_COMPLETED)
             {
-                crash = true;
-                break;
+                pPendingBufferDestroys[kept++] = *pGarbage;
+                continue;
+            }
+
+            if (pGarbage->bucketSize != 0 && renderGC_bucket_push(pGarbage))
+                continue;
+
+            if (destroyCount >= FLUSH_COUNT_PER_FRAME)
+            {
+                pPendingBufferDestroys[kept++] = *pGarbage;
+                continue;
             }
         }
 
-        if (!crash)
-            return;
-    } while (0);
+        bufferDestroy(pState, &pGarbage->buffer, &pGarbage->allocation);
+        destroyCount++;
+        stats.destroyed++;
+    }
+
+    pendingCount = kept;
+}
+#pragma endregion
+#pragma region Stats
+RenderGCStats_t renderGC_stats_get(void)
+{
+    return stats;
+}
+
+void renderGC_stats_log(void)
+{
+    logs_log(LOG_DEBUG, "Render GC: %" PRIu64 " buffers created, %" PRIu64 " reused, %" PRIu64 " recycled and %" PRIu64 " destroyed.",
+             stats.created, stats.reused, stats.recycled, stats.destroyed);
+}
+#pragma endregion
+#pragma region Init/Destroy
+void renderGC_init(State_t *pState)
+{
+    if (!pState)
+        return;
+
+    pPendingBufferDestroys = malloc(sizeof(PendingBufferDestroy_t) * DEFAULT_CAPACITY);
+    if (!pPendingBufferDestroys)
+        crashHandler_crash_graceful(CRASH_LOCATION, "The program cannot continue without an intialized rendering garbage collector!");
 
-    crashHandler_crash_graceful(CRASH_LOCATION, "The program cannot continue without an intialized rendering garbage collector!");
+    pendingCapacity = DEFAULT_CAPACITY;
+    pendingCount = 0;
+    for (uint32_t i = 0; i < RECYCLE_BUCKET_COUNT; i++)
+        pRecycledCounts[i] = 0;
+    stats = (RenderGCStats_t){0};
 }
 
 void renderGC_destroy(State_t *pState)
 {
-    if (!pState || !ppPendingBufferDestroys)
+    if (!pState || !pPendingBufferDestroys)
         return;
 
-    uint32_t maxFramesInFlight = pState->config.maxFramesInFlight;
+#if defined(DEBUG_RENDER_GC)
+    renderGC_stats_log();
+#endif
 
     // Flush dangling garbage
-    for (uint32_t i = 0; i < maxFramesInFlight; ++i)
+    renderGC_flushGarbage(pState, true);
+
+    for (uint32_t bucket = 0; bucket < RECYCLE_BUCKET_COUNT; bucket++)
     {
-        renderGC_flushGarbage(pState, i, true);
-        free(ppPendingBufferDestroys[i]);
+        for (uint32_t i = 0; i < pRecycledCounts[bucket]; i++)
+            bufferDestroy(pState, &ppRecycled[bucket][i].buffer, &ppRecycled[bucket][i].allocation);
+        pRecycledCounts[bucket] = 0;
     }
 
-    free(ppPendingBufferDestroys);
-    free(pCount);
-    free(pCapacity);
-
-    ppPendingBufferDestroys = NULL;
-    pCount = NULL;
-    pCapacity = NULL;
-}
\ No newline at end of file
+    free(pPendingBufferDestroys);
+    pPendingBufferDestroys = NULL;
+    pendingCount = 0;
+    pendingCapacity = 0;
+}
+#pragma endregion
+#pragma region Undefines
+#undef RECYCLE_MIN_ORDER
+#undef RECYCLE_MAX_ORDER
+#undef RECYCLE_BUCKET_COUNT
+#undef RECYCLE_BUCKET_CAPACITY
+#pragma endregion
@@ -1,17 +1,53 @@
 #pragma once
+#include <stdbool.h>
 #include <vulkan/vulkan.h>
-#include "collection/dynamicStack_t.h"
+#include "core/types/state_t.h"
+#include "rendering/types/gpuAllocation_t.h"
 
 typedef struct PendingBufferDestroy_t
 {
     VkBuffer buffer;
-    VkDeviceMemory memory;
+    GpuAllocation_t allocation;
+    // Frame number the buffer was let go during. Only touched once the GPU has finished that frame
+    uint64_t frameNumber;
+    // Recycle bucket size, or 0 when the buffer is destroyed instead of reused
+    VkDeviceSize bucketSize;
+    VkBufferUsageFlags usage;
+    VkMemoryPropertyFlags properties;
 } PendingBufferDestroy_t;
 
-void renderGC_pushGarbage(const uint32_t FRAME_INDEX, VkBuffer buffer, VkDeviceMemory memory);
+typedef struct RenderGCStats_t
+{
+    uint64_t created;
+    uint64_t reused;
+    uint64_t recycled;
+    uint64_t destroyed;
+} RenderGCStats_t;
+
+/// @brief Queues the buffer and its memory to be released once the GPU has finished the frame being recorded
+void renderGC_pushGarbage(State_t *pState, VkBuffer buffer, GpuAllocation_t allocation);
+
+/// @brief Hands out a buffer of at least SIZE bytes, reusing a released one of the same size bucket, usage and memory properties
+/// before creating a new one. Returns the usable size (SIZE rounded up to its bucket) or 0 on failure. MAIN THREAD ONLY.
+VkDeviceSize renderGC_buffer_acquire(State_t *restrict pState, const VkDeviceSize SIZE, const VkBufferUsageFlags USAGE,
+                                     const VkMemoryPropertyFlags PROPERTIES, VkBuffer *restrict pBuffer,
+                                     GpuAllocation_t *restrict pAllocation);
+
+/// @brief Gives back a buffer from acquire, with the SIZE, USAGE and PROPERTIES it was acquired with. It becomes reusable once the
+/// GPU has finished the frame being recorded. Both handles are reset to null. MAIN THREAD ONLY.
+void renderGC_buffer_release(State_t *restrict pState, const VkDeviceSize SIZE, const VkBufferUsageFlags USAGE,
+                             const VkMemoryPropertyFlags PROPERTIES, VkBuffer *restrict pBuffer,
+                             GpuAllocation_t *restrict pAllocation);
+
+/// @brief Recycles or destroys whatever the GPU is done with, going by renderer.framesCompleted. Destroys are spread over frames.
+/// FLUSH_ALL destroys everything no matter what and must only be used once the device is idle
+void renderGC_flushGarbage(State_t *pState, const bool FLUSH_ALL);
+
+RenderGCStats_t renderGC_stats_get(void);
 
-void renderGC_flushGarbage(State_t *pState, const uint32_t FRAME_INDEX, const bool FLUSH_ALL);
+void renderGC_stats_log(void);
 
 void renderGC_init(State_t *pState);
 
-void renderGC_destroy(State_t *pState);
\ No newline at end of file
+/// @brief The device must be idle. Must be called before the GPU allocator is destroyed
+void renderGC_destroy(State_t *pState);
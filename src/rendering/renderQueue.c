@@ -0,0 +1,85 @@
+#pragma region Includes
+#include <stdint.h>
+#include <string.h>
+#include "core/logs.h"
+#include "rendering/renderQueue.h"
+#pragma endregion
+#pragma region Defines
+#define KEY_BYTES 8
+#define RADIX 256
+#pragma endregion
+#pragma region Sort
+void renderQueue_sort(RenderQueueItem_t *restrict pItems, RenderQueueItem_t *restrict pScratch, const uint32_t COUNT)
+{
+    if (!pItems || !pScratch || COUNT < 2)
+        return;
+
+    // Every byte's histogram in one go
+    uint32_t ppCounts[KEY_BYTES][RADIX];
+    memset(ppCounts, 0, sizeof(ppCounts));
+    for (uint32_t i = 0; i < COUNT; i++)
+    {
+        const uint64_t KEY = pItems[i].key;
+        for (uint32_t byte = 0; byte < KEY_BYTES; byte++)
+            ppCounts[byte][(KEY >> (byte * 8)) & 0xFF]++;
+    }
+
+    RenderQueueItem_t *pFrom = pItems;
+    RenderQueueItem_t *pTo = pScratch;
+    for (uint32_t byte = 0; byte < KEY_BYTES; byte++)
+    {
+        uint32_t *pCounts = ppCounts[byte];
+
+        // A byte all keys share can't change the order
+        const uint32_t FIRST_BUCKET = (uint32_t)((pFrom[0].key >> (byte * 8)) & 0xFF);
+        if (pCounts[FIRST_BUCKET] == COUNT)
+            continue;
+
+        uint32_t offset = 0;
+        for (uint32_t bucket = 0; bucket < RADIX; bucket++)
+        {
+            const uint32_t BUCKET_COUNT = pCounts[bucket];
+            pCounts[bucket] = offset;
+            offset += BUCKET_COUNT;
+        }
+
+        for (uint32_t i = 0; i < COUNT; i++)
+            pTo[pCounts[(pFrom[i].key >> (byte * 8)) & 0xFF]++] = pFrom[i];
+
+        RenderQueueItem_t *pSwap = pFrom;
+        pFrom = pTo;
+        pTo = pSwap;
+    }
+
+    if (pFrom != pItems)
+        memcpy(pItems, pFrom, sizeof(RenderQueueItem_t) * COUNT);
+}
+#pragma endregion
+#pragma region Stats
+void renderQueue_stats_add(RenderFrameStats_t *restrict pTotal, const RenderFrameStats_t *restrict pSTATS)
+{
+    if (!pTotal || !pSTATS)
+        return;
+
+    pTotal->pipelineBinds += pSTATS->pipelineBinds;
+    pTotal->descriptorSetBinds += pSTATS->descriptorSetBinds;
+    pTotal->vertexBufferBinds += pSTATS->vertexBufferBinds;
+    pTotal->indexBufferBinds += pSTATS->indexBufferBinds;
+    pTotal->drawCalls += pSTATS->drawCalls;
+    pTotal->drawCommands += pSTATS->drawCommands;
+}
+
+void renderQueue_stats_log(const RenderFrameStats_t *pSTATS)
+{
+    if (!pSTATS)
+        return;
+
+    logs_log(LOG_DEBUG, "Frame: %u pipeline, %u descriptor set, %u vertex and %u index buffer binds. %u draw calls carrying %u draws.",
+             pSTATS->pipelineBinds, pSTATS->descriptorSetBinds, pSTATS->vertexBufferBinds, pSTATS->indexBufferBinds,
+             pSTATS->drawCalls, pSTATS->drawCommands);
+}
+#pragma endregion
+#pragma region Undefines
+#undef KEY_BYTES
+#undef RADIX
+#pragma endregion
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#include "rendering/types/renderFrameStats_t.h"
+
+// Sort key layout, most significant first: pipeline (8 bits), bound state such as a geometry page or descriptor set (24 bits), then
+// depth (32 bits). Sorting by key keeps draws sharing a bind together and, within those, goes front to back for early-Z
+#define RENDER_QUEUE_STATE_MAX 0xFFFFFFU
+
+/// @brief A draw waiting to be recorded. index points back into whatever array the caller built its draws in
+typedef struct RenderQueueItem_t
+{
+    uint64_t key;
+    uint32_t index;
+} RenderQueueItem_t;
+
+static inline uint64_t renderQueue_key_make(const uint32_t PIPELINE, const uint32_t STATE, const uint32_t DEPTH)
+{
+    const uint64_t STATE_CLAMPED = STATE < RENDER_QUEUE_STATE_MAX ? STATE : RENDER_QUEUE_STATE_MAX;
+    return (uint64_t)(PIPELINE & 0xFFU) << 56 | STATE_CLAMPED << 32 | DEPTH;
+}
+
+static inline uint32_t renderQueue_key_state(const uint64_t KEY)
+{
+    return (uint32_t)(KEY >> 32) & RENDER_QUEUE_STATE_MAX;
+}
+
+/// @brief Depth key of a non-negative float distance. Positive IEEE floats order the same as their bits, so no precision is lost
+static inline uint32_t renderQueue_depth_fromFloat(const float DISTANCE)
+{
+    if (!(DISTANCE > 0.0F))
+        return 0;
+
+    uint32_t bits;
+    memcpy(&bits, &DISTANCE, sizeof(bits));
+    return bits;
+}
+
+/// @brief Stable sort of the items by key, ascending. pScratch must hold COUNT items. Bytes every key shares are skipped, so
+/// sorting draws that only differ by page and depth takes a handful of passes
+void renderQueue_sort(RenderQueueItem_t *restrict pItems, RenderQueueItem_t *restrict pScratch, const uint32_t COUNT);
+
+/// @brief Adds pSTATS into pTotal. Lets threads count into their own stats and merge them once they're done
+void renderQueue_stats_add(RenderFrameStats_t *restrict pTotal, const RenderFrameStats_t *restrict pSTATS);
+
+void renderQueue_stats_log(const RenderFrameStats_t *pSTATS);
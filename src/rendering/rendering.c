@@ -11,6 +11,7 @@
 #include "rendering/buffers/buffers.h"
 #include "rendering/model_3d.h"
 #include "rendering/buffers/command_buffer.h"
+#include "rendering/buffers/secondary_command_buffer.h"
 #include "rendering/buffers/index_buffer.h"
 #include "rendering/buffers/vertex_buffer.h"
 #include "rendering/buffers/frame_buffer.h"
@@ -33,6 +34,14 @@
 #include "scene/scene.h"
 #include "rendering/model_3d.h"
 #include "rendering/renderGC.h"
+#include "rendering/pipeline_cache.h"
+#include "rendering/gpuProfiler.h"
+#include "rendering/memory/gpuAllocator.h"
+#include "rendering/chunk/chunkGeometryPool.h"
+#include "rendering/chunk/chunkDrawList.h"
+#include "rendering/chunk/chunkCulling.h"
+#include "rendering/chunk/chunkOcclusion.h"
+#include "rendering/buffers/staging_ring.h"
 #pragma endregion
 #pragma region Wireframe
 /// @brief Toggle wireframe pipeline
@@ -126,6 +135,13 @@ void rendering_recreate(State_t *pState)
 
 void rendering_create(State_t *pState)
 {
+    // Every buffer below is sub-allocated from this
+    gpuAllocator_create(pState);
+    chunkGeometryPool_create(pState);
+    chunkDrawList_create(pState);
+    chunkCulling_create(pState);
+    chunkOcclusion_create(pState);
+
     // Must exist before anything that references it
     renderpass_create(pState);
 
@@ -134,10 +150,16 @@ void rendering_create(State_t *pState)
 
     // Create all graphics pipelines and set the active (default) one
     pState->renderer.activeGraphicsPipeline = GRAPHICS_PIPELINE_MODEL_FILL;
+    pipelineCache_create(pState);
     graphicsPipeline_createAll(pState);
 
+    // Timestamps for the frame and upload command buffers
+    gpuProfiler_create(pState);
+
     // Needed for all staging/copies and one-time commands
     commandPool_create(pState);
+    // Records its copies into buffers from the command pool
+    stagingRing_create(pState);
 
     // Voxel texture atlas
     atlasTexture_create(pState);
@@ -156,6 +178,7 @@ void rendering_create(State_t *pState)
 
     // Command buffers and sync last
     commandBuffer_create(pState);
+    secondaryCommandBuffers_create(pState);
     syncObjects_create(pState);
 
     renderGC_init(pState);
@@ -187,10 +210,23 @@ void rendering_destroy(State_t *pState)
     atlasTexture_destroy(pState);
 
     // Command pool after any single-time buffers etc. are destroyed
+    stagingRing_destroy(pState);
+    secondaryCommandBuffers_destroy(pState);
     commandPool_destroy(pState);
+    gpuProfiler_destroy(pState);
 
     // Pipeline objects last
     graphicsPipeline_destroyAll(pState);
+    pipelineCache_destroy(pState);
     renderpass_destroy(pState);
+
+    chunkOcclusion_destroy(pState);
+    chunkCulling_destroy(pState);
+    chunkDrawList_destroy(pState);
+    chunkGeometryPool_destroy(pState);
+    renderGC_destroy(pState);
+
+    // Every buffer (including the render GC's) has been released by now
+    gpuAllocator_destroy(pState);
 }
 #pragma endregion
@@ -37,42 +37,54 @@ typedef struct
     size_t codeSize;
 } ShaderBlob_t;
 
-static const uint32_t NUM_SHADER_VERTEX_BINDING_DESCRIPTIONS_MODEL = 1;
+static const uint32_t NUM_SHADER_VERTEX_BINDING_DESCRIPTIONS_MODEL = 2;
 // A vertex binding describes at which rate to load data from memory throughout the vertices. It specifies the number
 // of bytes between data entries and whether to move to the next data entry after each vertex or after each instance.
 static inline const VkVertexInputBindingDescription *shaderVertexGetBindingDescriptionModel(void)
 {
-    static const VkVertexInputBindingDescription descriptions[1] = {
+    static const VkVertexInputBindingDescription descriptions[2] = {
         {
             .binding = 0,
             .stride = sizeof(ShaderVertexModel_t),
             .inputRate = VK_VERTEX_INPUT_RATE_VERTEX,
         },
+        // One transform per placed model
+        {
+            .binding = 1,
+            .stride = sizeof(ShaderInstanceModel_t),
+            .inputRate = VK_VERTEX_INPUT_RATE_INSTANCE,
+        },
     };
 
     return descriptions;
 }
 
-static const uint32_t NUM_SHADER_VERTEX_BINDING_DESCRIPTIONS_VOXEL = 1;
+static const uint32_t NUM_SHADER_VERTEX_BINDING_DESCRIPTIONS_VOXEL = 2;
 static inline const VkVertexInputBindingDescription *shaderVertexGetBindingDescriptionVoxel(void)
 {
-    static const VkVertexInputBindingDescription descriptions[1] = {
+    static const VkVertexInputBindingDescription descriptions[2] = {
         {
             .binding = 0,
             .stride = sizeof(ShaderVertexVoxel_t),
             .inputRate = VK_VERTEX_INPUT_RATE_VERTEX,
         },
+        // One entry per chunk, picked by the draw's firstInstance
+        {
+            .binding = 1,
+            .stride = sizeof(ShaderInstanceVoxel_t),
+            .inputRate = VK_VERTEX_INPUT_RATE_INSTANCE,
+        },
     };
 
     return descriptions;
 }
 
-static const uint32_t NUM_SHADER_VERTEX_ATTRIBUTES_MODEL = 3;
+static const uint32_t NUM_SHADER_VERTEX_ATTRIBUTES_MODEL = 7;
 // An attribute description struct describes how to extract a vertex attribute from a chunk of vertex data originating
 // from a binding description. We have two attributes, position and color, so we need two attribute description structs.
 static inline const VkVertexInputAttributeDescription *shaderVertexGetInputAttributeDescriptionsModel(void)
 {
-    static const VkVertexInputAttributeDescription descriptions[3] = {
+    static const VkVertexInputAttributeDescription descriptions[7] = {
         // Position
         {
             .binding = 0,
@@ -101,15 +113,40 @@ static inline const VkVertexInputAttributeDescription *shaderVertexGetInputAttri
             .format = VK_FORMAT_R32G32_SFLOAT,
             .offset = offsetof(ShaderVertexModel_t, texCoord),
         },
+        // Model matrix. A mat4 attribute is read as one vec4 column per location
+        {
+            .binding = 1,
+            .location = 3,
+            .format = VK_FORMAT_R32G32B32A32_SFLOAT,
+            .offset = offsetof(ShaderInstanceModel_t, modelMatrix) + sizeof(Vec4f_t) * 0,
+        },
+        {
+            .binding = 1,
+            .location = 4,
+            .format = VK_FORMAT_R32G32B32A32_SFLOAT,
+            .offset = offsetof(ShaderInstanceModel_t, modelMatrix) + sizeof(Vec4f_t) * 1,
+        },
+        {
+            .binding = 1,
+            .location = 5,
+            .format = VK_FORMAT_R32G32B32A32_SFLOAT,
+            .offset = offsetof(ShaderInstanceModel_t, modelMatrix) + sizeof(Vec4f_t) * 2,
+        },
+        {
+            .binding = 1,
+            .location = 6,
+            .format = VK_FORMAT_R32G32B32A32_SFLOAT,
+            .offset = offsetof(ShaderInstanceModel_t, modelMatrix) + sizeof(Vec4f_t) * 3,
+        },
     };
 
     return descriptions;
 }
 
-static const uint32_t NUM_SHADER_VERTEX_ATTRIBUTES_VOXEL = 4;
+static const uint32_t NUM_SHADER_VERTEX_ATTRIBUTES_VOXEL = 6;
 static inline const VkVertexInputAttributeDescription *shaderVertexGetInputAttributeDescriptionsVoxel(void)
 {
-    static const VkVertexInputAttributeDescription descriptions[4] = {
+    static const VkVertexInputAttributeDescription descriptions[6] = {
         // Position
         {
             .binding = 0,
@@ -131,13 +168,27 @@ static inline const VkVertexInputAttributeDescription *shaderVertexGetInputAttri
             .format = VK_FORMAT_R32G32_SFLOAT,
             .offset = offsetof(ShaderVertexVoxel_t, texCoord),
         },
-        // // Face normal
+        // Texture array layer
         {
             .binding = 0,
             .location = 3,
+            .format = VK_FORMAT_R32_UINT,
+            .offset = offsetof(ShaderVertexVoxel_t, textureLayer),
+        },
+        // // Face normal
+        {
+            .binding = 0,
+            .location = 4,
             .format = VK_FORMAT_R32_SINT,
             .offset = offsetof(ShaderVertexVoxel_t, faceID),
         },
+        // Chunk origin
+        {
+            .binding = 1,
+            .location = 5,
+            .format = VK_FORMAT_R32G32B32_SINT,
+            .offset = offsetof(ShaderInstanceVoxel_t, chunkOrigin),
+        },
     };
 
     return descriptions;
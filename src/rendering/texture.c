@@ -3,9 +3,7 @@
 #include <stdlib.h>
 #include "core/logs.h"
 #include "core/types/state_t.h"
-#include "stb_image.h"
 #include "image.h"
-#include "buffers/buffers.h"
 
 /// @brief Checks if the config's AF is available in the device options. Returns 0 if not.
 static float tex_AFGet(State_t *pState)
@@ -38,9 +36,10 @@ void tex_samplerCreate(State_t *pState)
         .minFilter = VK_FILTER_NEAREST,
         // Addressing can be defined per-axis and for some reason its UVW instead of XYZ (texture space convention)
         // Repeat is the most commonly used (floors, etc.) for tiling
-        .addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
-        .addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
-        .addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
+        // Every atlas tile is its own array layer, so a face can repeat its tile without running into a neighbor
+        .addressModeU = VK_SAMPLER_ADDRESS_MODE_REPEAT,
+        .addressModeV = VK_SAMPLER_ADDRESS_MODE_REPEAT,
+        .addressModeW = VK_SAMPLER_ADDRESS_MODE_REPEAT,
         .anisotropyEnable = VK_TRUE,
         .maxAnisotropy = tex_AFGet(pState),
         // Which color is returned when sampling beyond the image with clamp to border addressing mode. It is possible to
@@ -53,11 +52,12 @@ void tex_samplerCreate(State_t *pState)
         .unnormalizedCoordinates = VK_FALSE,
         .compareEnable = VK_FALSE,
         .compareOp = VK_COMPARE_OP_ALWAYS,
-        // Mipmapping not implemneted at this time
+        // Blending between the atlas' baked levels is what keeps distant terrain from shimmering. Texels within a level stay
+        // nearest for the pixel art look
         .mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR,
         .mipLodBias = 0.0F,
         .minLod = 0.0F,
-        .maxLod = 0.0F,
+        .maxLod = pState->renderer.atlasMipLevels > 1 ? (float)(pState->renderer.atlasMipLevels - 1) : 0.0F,
     };
 
     logs_logIfError(vkCreateSampler(pState->context.device, &createInfo, pState->context.pAllocator, &pState->renderer.textureSampler),
@@ -69,86 +69,17 @@ void tex_samplerDestroy(State_t *state)
     vkDestroySampler(state->context.device, state->renderer.textureSampler, state->context.pAllocator);
 }
 
-// Create a single 2D texture (no atlas, no mipmaps). sRGB format.
-// Returns true on success. Out params are valid on success.
-bool texture2DCreateFromFile(State_t *state,
-                             const char *imagePath,
-                             VkImage *outImage,
-                             VkDeviceMemory *outMemory,
-                             VkImageView *outView,
-                             VkSampler *outSampler)
+// View + sampler for a single 2D sRGB texture (no atlas, no mipmaps) that is already uploaded.
+// Returns true on success. On failure nothing is left for the caller to destroy but the image.
+bool texture2DViewSamplerCreate(State_t *state,
+                                VkImage image,
+                                VkImageView *outView,
+                                VkSampler *outSampler)
 {
-    int width = 0, height = 0, channels = 0;
-
-    stbi_set_flip_vertically_on_load(true);
-
-    // Force 4 channels (RGBA) for a predictable VkFormat
-    stbi_uc *pixels = stbi_load(imagePath, &width, &height, &channels, STBI_rgb_alpha);
-    if (!pixels)
-    {
-        logs_log(LOG_ERROR, "Failed to load model texture: %s", imagePath);
-        return false;
-    }
-
-    const VkDeviceSize imageSize = (VkDeviceSize)width * (VkDeviceSize)height * 4;
-    logs_log(LOG_DEBUG, "Model texture: %s (%dx%d, RGBA8, %zu bytes)",
-             imagePath, width, height, (size_t)imageSize);
-
-    // --- Staging buffer ---
-    VkBuffer stagingBuffer = VK_NULL_HANDLE;
-    VkDeviceMemory stagingMemory = VK_NULL_HANDLE;
-    bufferCreate(state, imageSize,
-                 VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                 &stagingBuffer, &stagingMemory);
-
-    void *mapped = NULL;
-    if (vkMapMemory(state->context.device, stagingMemory, 0, imageSize, 0, &mapped) != VK_SUCCESS)
-    {
-        logs_log(LOG_ERROR, "Failed to map model texture staging memory.");
-        stbi_image_free(pixels);
-        vkDestroyBuffer(state->context.device, stagingBuffer, state->context.pAllocator);
-        vkFreeMemory(state->context.device, stagingMemory, state->context.pAllocator);
-        return false;
-    }
-    memcpy(mapped, pixels, (size_t)imageSize);
-    vkUnmapMemory(state->context.device, stagingMemory);
-    stbi_image_free(pixels);
-
-    // --- GPU image ---
-    imageCreate(state, width, height,
-                VK_FORMAT_R8G8B8A8_SRGB,
-                VK_IMAGE_TILING_OPTIMAL,
-                VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
-                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-                outImage, outMemory);
-
-    // Layout: UNDEFINED -> TRANSFER_DST_OPTIMAL
-    imageLayoutTransition(state, *outImage,
-                          VK_IMAGE_LAYOUT_UNDEFINED,
-                          VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
-
-    // Copy staging -> image
-    bufferCopyToImage(state, stagingBuffer, *outImage, (uint32_t)width, (uint32_t)height);
-
-    // Layout: TRANSFER_DST_OPTIMAL -> SHADER_READ_ONLY_OPTIMAL
-    imageLayoutTransition(state, *outImage,
-                          VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                          VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-
-    // Free staging
-    vkDestroyBuffer(state->context.device, stagingBuffer, state->context.pAllocator);
-    vkFreeMemory(state->context.device, stagingMemory, state->context.pAllocator);
-
-    // --- Image view ---
-    *outView = imageViewCreate(state, *outImage, VK_FORMAT_R8G8B8A8_SRGB, VK_IMAGE_ASPECT_COLOR_BIT);
+    *outView = imageViewCreate(state, image, VK_FORMAT_R8G8B8A8_SRGB, VK_IMAGE_ASPECT_COLOR_BIT);
     if (*outView == VK_NULL_HANDLE)
     {
         logs_log(LOG_ERROR, "Failed to create image view for model texture.");
-        vkDestroyImage(state->context.device, *outImage, state->context.pAllocator);
-        vkFreeMemory(state->context.device, *outMemory, state->context.pAllocator);
-        *outImage = VK_NULL_HANDLE;
-        *outMemory = VK_NULL_HANDLE;
         return false;
     }
 
@@ -173,14 +104,9 @@ bool texture2DCreateFromFile(State_t *state,
     {
         logs_log(LOG_ERROR, "Failed to create sampler for model texture.");
         vkDestroyImageView(state->context.device, *outView, state->context.pAllocator);
-        vkDestroyImage(state->context.device, *outImage, state->context.pAllocator);
-        vkFreeMemory(state->context.device, *outMemory, state->context.pAllocator);
         *outView = VK_NULL_HANDLE;
-        *outImage = VK_NULL_HANDLE;
-        *outMemory = VK_NULL_HANDLE;
         return false;
     }
 
-    logs_log(LOG_DEBUG, "Created model texture: %s", imagePath);
     return true;
 }
@@ -56,9 +56,7 @@ void tex_samplerCreate(State_t *state);
 
 void tex_samplerDestroy(State_t *state);
 
-bool texture2DCreateFromFile(State_t *state,
-                             const char *imagePath,
-                             VkImage *outImage,
-                             VkDeviceMemory *outMemory,
-                             VkImageView *outView,
-                             VkSampler *outSampler);
\ No newline at end of file
+bool texture2DViewSamplerCreate(State_t *state,
+                                VkImage image,
+                                VkImageView *outView,
+                                VkSampler *outSampler);
\ No newline at end of file
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <stdint.h>
+
+#define CHUNK_GEOMETRY_PAGE_NONE UINT16_MAX
+// Most pages the chunk geometry pool will ever hold
+#define CHUNK_GEOMETRY_MAX_PAGES 64
+
+/// @brief Where a chunk's vertices and indices live inside the chunk geometry pool. Both are already in the units the draw call
+/// takes, so a chunk draws with vkCmdDrawIndexed(..., firstIndex, firstVertex, ...) straight off its page buffer.
+typedef struct ChunkGeometryRange_t
+{
+    // Added to every index of the chunk (vertexOffset of the draw)
+    uint32_t firstVertex;
+    // Counted from the start of the page buffer
+    uint32_t firstIndex;
+    // CHUNK_GEOMETRY_PAGE_NONE when nothing is allocated
+    uint16_t page;
+    uint8_t vertexOrder;
+    uint8_t indexOrder;
+} ChunkGeometryRange_t;
+
+static inline ChunkGeometryRange_t chunkGeometryRange_none(void)
+{
+    return (ChunkGeometryRange_t){.page = CHUNK_GEOMETRY_PAGE_NONE};
+}
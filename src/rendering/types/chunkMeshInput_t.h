@@ -0,0 +1,29 @@
+#pragma once
+
+#include <stdint.h>
+#include "cmath/cmath.h"
+
+// Same 18^3 layout as ChunkSolidityGrid_t (x + y * 18 + z * 18 * 18) so chunkSolidityGrid_index16 indexes both
+#define CHUNK_MESH_INPUT_SIDE (CMATH_CHUNK_AXIS_LENGTH + 2)
+#define CHUNK_MESH_INPUT_STRIDE_X 1
+#define CHUNK_MESH_INPUT_STRIDE_Y CHUNK_MESH_INPUT_SIDE
+#define CHUNK_MESH_INPUT_STRIDE_Z (CHUNK_MESH_INPUT_SIDE * CHUNK_MESH_INPUT_SIDE)
+#define CHUNK_MESH_INPUT_SIZE (CHUNK_MESH_INPUT_SIDE * CHUNK_MESH_INPUT_SIDE * CHUNK_MESH_INPUT_SIDE)
+// LOD n merges 2^n blocks per axis into one super voxel (16, 8, 4 and 2 cells per axis)
+#define CHUNK_MESH_LOD_COUNT 4
+
+struct BlockDefinition_t;
+
+/// @brief Snapshot of everything the mesher reads. Taken on the main thread so that meshing can run on a worker thread
+/// while the world keeps changing. Fully self-contained (no heap pointers) so it can be copied or freed as one block.
+typedef struct ChunkMeshInput_t
+{
+    // Block definitions are static const data so the pointer is the block's identity
+    const struct BlockDefinition_t *ppBlockDefinitions[CMATH_CHUNK_BLOCK_CAPACITY];
+    // SolidityType_e per cell. The chunk's own opacity in the center and a one block halo copied from the border of each
+    // face neighbor. The halo of an unloaded neighbor is transparent so the border faces stay visible
+    uint8_t pOpacity[CHUNK_MESH_INPUT_SIZE];
+    Vec3i_t chunkPos;
+    // Level of detail to mesh at, < CHUNK_MESH_LOD_COUNT
+    uint8_t lod;
+} ChunkMeshInput_t;
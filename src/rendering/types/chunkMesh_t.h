@@ -0,0 +1,23 @@
+#pragma once
+
+#include <stdint.h>
+#include "cmath/cmath.h"
+#include "rendering/types/shaderVertexVoxel_t.h"
+
+/// @brief Index sub-range holding every face that points in one direction
+typedef struct ChunkMeshSection_t
+{
+    uint32_t firstIndex;
+    uint32_t indexCount;
+} ChunkMeshSection_t;
+
+/// @brief CPU-side mesh produced by the mesher and consumed by the upload stage. Owns both arrays. Faces are grouped by
+/// direction and pSections (indexed by CubeFace_e) records where each group sits in pIndices.
+typedef struct ChunkMesh_t
+{
+    ShaderVertexVoxel_t *pVertices;
+    uint32_t *pIndices;
+    uint32_t vertexCount;
+    uint32_t indexCount;
+    ChunkMeshSection_t pSections[CMATH_GEOM_CUBE_FACES];
+} ChunkMesh_t;
@@ -1,10 +1,25 @@
 #pragma region Includes
 #pragma once
-#include "collection/dynamicStack_t.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <threads.h>
+#include "cmath/cmath.h"
+#include "collection/ringQueue_t.h"
 #pragma endregion
 #pragma region Defines
+struct ChunkMeshJob_t;
 typedef struct ChunkRenderer_t
 {
-    DynamicStack_t *pRemeshCtxQueue;
+    // FIFO of chunks waiting to be meshed. Membership is tracked with CHUNK_MESH_FLAG_QUEUED
+    RingQueue_t *pRemeshQueue;
+    // Meshes finished by the workers, waiting for the main thread to upload them (FIFO, guarded by completedLock)
+    struct ChunkMeshJob_t *pCompletedHead;
+    struct ChunkMeshJob_t *pCompletedTail;
+    mtx_t completedLock;
+    // Jobs dispatched but not yet uploaded. Only touched by the main thread
+    uint32_t jobsInFlight;
+    // Camera chunk the LODs were last picked for. Every chunk's LOD is rechecked when this changes
+    Vec3i_t lodCameraChunkPos;
+    bool lodCameraValid;
 } ChunkRenderer_t;
-#pragma endregion
\ No newline at end of file
+#pragma endregion
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <stdint.h>
+#include <vulkan/vulkan.h>
+
+struct GpuMemoryBlock_t;
+
+/// @brief A range of device memory handed out by the GPU allocator. Bind resources to memory at offset. A zeroed allocation
+/// is the "no allocation" value.
+typedef struct GpuAllocation_t
+{
+    VkDeviceMemory memory;
+    VkDeviceSize offset;
+    // Bytes reserved, which can be more than what was asked for
+    VkDeviceSize size;
+    // Persistent CPU pointer to offset for host visible memory, otherwise NULL. Never call vkMapMemory on memory
+    void *pMapped;
+    struct GpuMemoryBlock_t *pBlock;
+    uint8_t order;
+} GpuAllocation_t;
@@ -2,20 +2,22 @@
 
 #include <vulkan/vulkan.h>
 #include "cmath/cmath.h"
+#include "rendering/types/chunkMesh_t.h"
+#include "rendering/types/chunkGeometryRange_t.h"
 #include <stdbool.h>
 
 typedef struct RenderChunk_t
 {
-    bool needsRemesh;
-    VkBuffer vertexBuffer;
-    VkDeviceMemory vertexMemory;
-    // Capacity of verticies
-    uint32_t vertexCapacity;
-    VkBuffer indexBuffer;
-    VkDeviceMemory indexMemory;
-    // Capacity of indicies
-    uint32_t indexCapacity;
+    // Staging ring serial carrying the pending mesh
+    uint64_t pendingSerial;
+    // Range of the shared chunk geometry buffer holding this chunk's mesh
+    ChunkGeometryRange_t geometry;
+    // Newest mesh, still being copied to the GPU. Replaces geometry once its serial completes
+    ChunkGeometryRange_t pendingGeometry;
     // How many indicies to draw for the current frame
     uint32_t indexCount;
-    Mat4c_t modelMatrix;
-} RenderChunk_t;
\ No newline at end of file
+    uint32_t pendingIndexCount;
+    // Where each face direction sits in the chunk's index range (indexed by CubeFace_e)
+    ChunkMeshSection_t pSections[CMATH_GEOM_CUBE_FACES];
+    ChunkMeshSection_t pPendingSections[CMATH_GEOM_CUBE_FACES];
+} RenderChunk_t;
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <stdint.h>
+
+/// @brief What recording one frame's command buffer cost in binds and draws
+typedef struct RenderFrameStats_t
+{
+    uint32_t pipelineBinds;
+    uint32_t descriptorSetBinds;
+    uint32_t vertexBufferBinds;
+    uint32_t indexBufferBinds;
+    // vkCmdDraw* calls recorded
+    uint32_t drawCalls;
+    // Draws those calls carry. An indirect call counts every command in it, and an instanced draw counts once
+    uint32_t drawCommands;
+} RenderFrameStats_t;
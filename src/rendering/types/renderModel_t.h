@@ -3,24 +3,25 @@
 #include <stdint.h>
 #include <vulkan/vulkan.h>
 #include "cmath/cmath.h"
+#include "rendering/types/gpuAllocation_t.h"
 
 typedef struct
 {
     VkBuffer vertexBuffer;
-    VkDeviceMemory vertexMemory;
+    GpuAllocation_t vertexAllocation;
     VkBuffer indexBuffer;
-    VkDeviceMemory indexMemory;
+    GpuAllocation_t indexAllocation;
     uint32_t indexCount;
-
-    // Per-frame descriptor set (one per swapchain image) so we can point to the shared UBO + this model's texture
-    VkDescriptorSet *pDescriptorSets; // size = renderer.maxFramesInFlight
-    VkDescriptorPool descriptorPool;  // per-model pool
+    // 16 bit whenever the model has few enough vertices
+    VkIndexType indexType;
 
     // Texture owned by this model (from /res/textures)
     VkImage textureImage;
     VkDeviceMemory textureMemory;
     VkImageView textureView;
     VkSampler textureSampler;
+    // Slot of the texture in the renderer's shared model texture table, pushed with each draw
+    uint32_t textureIndex;
 
     // world transform (set externally)
     Mat4c_t modelMatrix;
@@ -9,4 +9,16 @@ typedef struct
     Vec3f_t color;
     Vec2f_t texCoord;
     uint32_t atlasIndex;
-} ShaderVertexModel_t;
\ No newline at end of file
+} ShaderVertexModel_t;
+
+/// @brief Per-instance data read at instance rate. Each model's batch draws from its first instance onwards
+typedef struct
+{
+    Mat4c_t modelMatrix;
+} ShaderInstanceModel_t;
+
+/// @brief Pushed per batch. Picks the model's texture out of the shared model texture table
+typedef struct
+{
+    uint32_t textureIndex;
+} ShaderPushConstantsModel_t;
@@ -8,7 +8,16 @@ typedef struct
 {
     Vec3f_t pos;
     Vec3f_t color;
+    // Within the face's layer. Past 1 repeats the tile
     Vec2f_t texCoord;
-    uint32_t atlasIndex;
+    // Atlas array layer, which is the face's AtlasFace_e
+    uint32_t textureLayer;
     int faceID;
-} ShaderVertexVoxel_t;
\ No newline at end of file
+} ShaderVertexVoxel_t;
+
+/// @brief Per-draw data read at instance rate. The firstInstance of every chunk draw points at its chunk's entry
+typedef struct
+{
+    // World position of the chunk's minimum corner
+    Vec3i_t chunkOrigin;
+} ShaderInstanceVoxel_t;
\ No newline at end of file
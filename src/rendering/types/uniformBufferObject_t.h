@@ -1,5 +1,6 @@
 #include "cmath/cmath.h"
 #include <stdalign.h>
+#include <stdint.h>
 
 // https://www.opengl-tutorial.org/beginners-tutorials/tutorial-3-matrices/
 // Struct members are the same as the shader codes'
@@ -12,4 +13,7 @@ typedef struct
     // alignas(16) Mat4c_t model;
     alignas(16) Mat4c_t view;
     alignas(16) Mat4c_t projection;
+    // Integer world position the view is relative to (ivec4, w unused). Shaders subtract it from integer chunk origins before
+    // anything turns into a float
+    alignas(16) int32_t pRenderOrigin[4];
 } UniformBufferObject_t;
@@ -4,6 +4,7 @@
 #include "core/types/state_t.h"
 #include "rendering/shaders.h"
 #include "rendering/atlas_texture.h"
+#include "rendering/types/textureRotation_t.h"
 #include "rendering/texture.h"
 
 static const Vec2f_t faceUVs[4] = {
@@ -13,15 +14,13 @@ static const Vec2f_t faceUVs[4] = {
     {1.0F, 0.0F}, // bottom-right
 };
 
-static inline void uvs_voxel_assignFaceUVs(ShaderVertexVoxel_t *restrict pVerts, const size_t START,
-                                           const AtlasRegion_t *restrict REGION, const TextureRotation_e ROTATION)
-{
-    Vec2f_t rotatedUVs[4];
-    applyTextureRotation(rotatedUVs, faceUVs, ROTATION);
-
-    for (int i = 0; i < 4; ++i)
-    {
-        pVerts[START + i].texCoord.x = cmath_clampF(REGION->uvMin.x + rotatedUVs[i].x * (REGION->uvMax.x - REGION->uvMin.x), 0.0F, 1.0F);
-        pVerts[START + i].texCoord.y = cmath_clampF(REGION->uvMin.y + rotatedUVs[i].y * (REGION->uvMax.y - REGION->uvMin.y), 0.0F, 1.0F);
-    }
-}
\ No newline at end of file
+/// @brief faceUVs after applyTextureRotation for every TextureRotation_e. Voxel UVs are local to the face's atlas layer, so the
+/// mesher can look its corners up instead of rotating and remapping them per face
+static const Vec2f_t pFACE_UVS_ROTATED[TEX_FLIP_Y + 1][4] = {
+    [TEX_ROT_0] = {{0.0F, 1.0F}, {0.0F, 0.0F}, {1.0F, 1.0F}, {1.0F, 0.0F}},
+    [TEX_ROT_90] = {{0.0F, 0.0F}, {1.0F, 0.0F}, {0.0F, 1.0F}, {1.0F, 1.0F}},
+    [TEX_ROT_180] = {{1.0F, 0.0F}, {1.0F, 1.0F}, {0.0F, 0.0F}, {0.0F, 1.0F}},
+    [TEX_ROT_270] = {{1.0F, 1.0F}, {0.0F, 1.0F}, {1.0F, 0.0F}, {0.0F, 0.0F}},
+    [TEX_FLIP_X] = {{1.0F, 1.0F}, {1.0F, 0.0F}, {0.0F, 1.0F}, {0.0F, 0.0F}},
+    [TEX_FLIP_Y] = {{0.0F, 0.0F}, {0.0F, 1.0F}, {1.0F, 0.0F}, {1.0F, 1.0F}},
+};
@@ -1,10 +1,32 @@
 #pragma once
 
+#include <stdint.h>
 #include "cmath/cmath.h"
 #include "rendering/types/renderModel_t.h"
 
+// Handed out when an instance couldn't be placed. Never matches a live instance
+#define SCENE_INSTANCE_HANDLE_INVALID ((SceneInstanceHandle_t){.slot = UINT32_MAX, .generation = 0})
+
 typedef struct
 {
     RenderModel_t *pModel;
     Mat4c_t modelMatrix;
-} SceneModelInstance_t;
\ No newline at end of file
+    // Entry in the scene's slot table that points back here
+    uint32_t slot;
+} SceneModelInstance_t;
+
+/// @brief Names one placed instance for as long as it exists, however the instance array gets reordered. A handle whose
+/// generation no longer matches its slot's was removed and refers to nothing
+typedef struct SceneInstanceHandle_t
+{
+    uint32_t slot;
+    uint32_t generation;
+} SceneInstanceHandle_t;
+
+/// @brief Where a handle's instance currently sits. Free slots chain to the next free one through instance
+typedef struct SceneInstanceSlot_t
+{
+    uint32_t instance;
+    // Bumped on removal so every handle to the old instance goes stale
+    uint32_t generation;
+} SceneInstanceSlot_t;
@@ -1,61 +1,303 @@
 #include <stdlib.h>
 #include <string.h>
+#include <math.h>
+#include <stdbool.h>
 #include "main.h"
 #include "core/logs.h"
 #include "core/types/state_t.h"
 #include "core/types/scene_t.h"
 #include "rendering/model_3d.h"
 #include "rendering/types/renderModel_t.h"
+#include "rendering/types/shaderVertexModel_t.h"
+#include "rendering/buffers/buffers.h"
+#include "rendering/renderGC.h"
+#include "rendering/renderQueue.h"
+#include "rendering/pools/descriptor_pool.h"
+#include "rendering/types/graphicsPipeline_t.h"
+#include "character/character.h"
 #include "scene/SceneModelInstance_t.h"
+#include "scene/scene.h"
 #include "core/random.h"
 
+// Grow strategy: x2, starting from 4
+static inline uint32_t scene_next_capacity(uint32_t current)
+{
+    return current ? (current << 1) : 4u;
+}
+
+/// @brief Makes sure the current frame's instance buffer fits COUNT transforms. A buffer that's too small goes back to the render GC
+/// and a bigger one is taken, so it only happens while the scene is growing
+static bool scene_instanceFrame_reserve(State_t *pState, SceneInstanceFrame_t *pFrame, const uint32_t COUNT)
+{
+    if (COUNT <= pFrame->capacity && pFrame->buffer != VK_NULL_HANDLE)
+        return true;
+
+    const VkBufferUsageFlags USAGE = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
+    const VkMemoryPropertyFlags PROPERTIES = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+
+    uint32_t capacity = pFrame->capacity ? pFrame->capacity : 1;
+    while (capacity < COUNT)
+        capacity *= 2;
+
+    renderGC_buffer_release(pState, (VkDeviceSize)sizeof(ShaderInstanceModel_t) * pFrame->capacity, USAGE, PROPERTIES,
+                            &pFrame->buffer, &pFrame->allocation);
+    pFrame->capacity = 0;
+
+    const VkDeviceSize SIZE = renderGC_buffer_acquire(pState, (VkDeviceSize)sizeof(ShaderInstanceModel_t) * capacity, USAGE,
+                                                      PROPERTIES, &pFrame->buffer, &pFrame->allocation);
+    if (SIZE == 0 || !pFrame->allocation.pMapped)
+    {
+        bufferDestroy(pState, &pFrame->buffer, &pFrame->allocation);
+        return false;
+    }
+
+    pFrame->capacity = (uint32_t)(SIZE / sizeof(ShaderInstanceModel_t));
+    return true;
+}
+
+/// @brief Orders the batches front to back by their nearest instance. Every batch binds its own model and descriptor set anyway,
+/// so depth is all the key has to go on. Returns false when there's no room for the order
+static bool scene_batches_sort(State_t *pState, Scene_t *pScene)
+{
+    if (pScene->batchOrderCap < pScene->batchCount)
+    {
+        void *pNewOrder = realloc(pScene->pBatchOrder, sizeof(RenderQueueItem_t) * pScene->batchCap);
+        if (!pNewOrder)
+            return false;
+        pScene->pBatchOrder = pNewOrder;
+
+        void *pNewScratch = realloc(pScene->pBatchOrderScratch, sizeof(RenderQueueItem_t) * pScene->batchCap);
+        if (!pNewScratch)
+            return false;
+        pScene->pBatchOrderScratch = pNewScratch;
+        pScene->batchOrderCap = pScene->batchCap;
+    }
+
+    const Vec3f_t EYE = character_player_positionLerped_get(pState);
+    for (uint32_t b = 0; b < pScene->batchCount; ++b)
+    {
+        const SceneModelBatch_t BATCH = pScene->pBatches[b];
+
+        float nearest = INFINITY;
+        for (uint32_t i = BATCH.firstInstance; i < BATCH.firstInstance + BATCH.instanceCount; ++i)
+        {
+            // Translation column
+            const Vec4f_t POSITION = pScene->pModelInstances[i].modelMatrix.m[3];
+            const float DX = POSITION.x - EYE.x;
+            const float DY = POSITION.y - EYE.y;
+            const float DZ = POSITION.z - EYE.z;
+            const float DISTANCE_SQ = DX * DX + DY * DY + DZ * DZ;
+            if (DISTANCE_SQ < nearest)
+                nearest = DISTANCE_SQ;
+        }
+
+        // Batches sharing a texture sit together, so each texture is pushed once
+        pScene->pBatchOrder[b] = (RenderQueueItem_t){
+            .key = renderQueue_key_make(GRAPHICS_TARGET_MODEL, BATCH.pModel->textureIndex, renderQueue_depth_fromFloat(nearest)),
+            .index = b};
+    }
+
+    renderQueue_sort(pScene->pBatchOrder, pScene->pBatchOrderScratch, pScene->batchCount);
+    return true;
+}
+
 void scene_drawModels(State_t *pState, VkCommandBuffer *pCmd, VkPipelineLayout *pPipelineLayout)
 {
-    for (uint32_t i = 0; i < pState->scene.instCount; ++i)
+    Scene_t *pScene = &pState->scene;
+    if (pScene->instCount == 0)
+        return;
+
+    if (!pScene->pInstanceFrames)
+    {
+        pScene->pInstanceFrames = calloc(pState->config.maxFramesInFlight, sizeof(SceneInstanceFrame_t));
+        if (!pScene->pInstanceFrames)
+            return;
+        pScene->instanceFrameCount = pState->config.maxFramesInFlight;
+    }
+
+    SceneInstanceFrame_t *pFrame = &pScene->pInstanceFrames[pState->renderer.currentFrame % pScene->instanceFrameCount];
+    if (!scene_instanceFrame_reserve(pState, pFrame, pScene->instCount))
+    {
+        logs_log(LOG_ERROR, "Failed to grow the model instance buffer to %u instances!", pScene->instCount);
+        return;
+    }
+
+    if (!scene_batches_sort(pState, pScene))
+    {
+        logs_log(LOG_ERROR, "Failed to grow the model draw order to %u batches!", pScene->batchCount);
+        return;
+    }
+
+    // Transforms move every tick, so they're all rewritten. The order (and so every batch's range) only changes on add/remove
+    ShaderInstanceModel_t *pInstances = pFrame->allocation.pMapped;
+    for (uint32_t i = 0; i < pScene->instCount; ++i)
+        pInstances[i].modelMatrix = pScene->pModelInstances[i].modelMatrix;
+
+    const VkDeviceSize INSTANCE_OFFSET = 0;
+    vkCmdBindVertexBuffers(*pCmd, 1, 1, &pFrame->buffer, &INSTANCE_OFFSET);
+    pState->renderer.frameStats.vertexBufferBinds++;
+
+    // The frame's model set is already bound, so switching textures is just a push
+    uint32_t pushedTextureIndex = UINT32_MAX;
+    for (uint32_t i = 0; i < pScene->batchCount; ++i)
     {
-        SceneModelInstance_t m = pState->scene.pModelInstances[i];
+        const SceneModelBatch_t BATCH = pScene->pBatches[pScene->pBatchOrder[i].index];
 
-        // access violation
-        vkCmdBindDescriptorSets(*pCmd, VK_PIPELINE_BIND_POINT_GRAPHICS, *pPipelineLayout,
-                                0, 1, &m.pModel->pDescriptorSets[pState->renderer.currentFrame],
-                                0, NULL);
+        if (BATCH.pModel->textureIndex != pushedTextureIndex)
+        {
+            const ShaderPushConstantsModel_t PUSH_CONSTANTS = {.textureIndex = BATCH.pModel->textureIndex};
+            vkCmdPushConstants(*pCmd, *pPipelineLayout, VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(PUSH_CONSTANTS), &PUSH_CONSTANTS);
+            pushedTextureIndex = BATCH.pModel->textureIndex;
+        }
 
-        VkBuffer modelVBs[] = {m.pModel->vertexBuffer};
+        VkBuffer modelVBs[] = {BATCH.pModel->vertexBuffer};
         VkDeviceSize offs[] = {0};
         vkCmdBindVertexBuffers(*pCmd, 0, 1, modelVBs, offs);
-        // 16 limits verticies to 65535 (consider once making own models and having a check?)
-        vkCmdBindIndexBuffer(*pCmd, m.pModel->indexBuffer, 0, VK_INDEX_TYPE_UINT32);
+        vkCmdBindIndexBuffer(*pCmd, BATCH.pModel->indexBuffer, 0, BATCH.pModel->indexType);
+
+        // Every placed copy of the model in one draw, reading its transforms from firstInstance onwards
+        vkCmdDrawIndexed(*pCmd, BATCH.pModel->indexCount, BATCH.instanceCount, 0, 0, BATCH.firstInstance);
 
-        vkCmdPushConstants(*pCmd, *pPipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, (uint32_t)sizeof(Mat4c_t), &m.modelMatrix);
-        // // Not using instanced rendering so just 1 instance with nothing for the offset
-        vkCmdDrawIndexed(*pCmd, m.pModel->indexCount, 1, 0, 0, 0);
+        pState->renderer.frameStats.vertexBufferBinds++;
+        pState->renderer.frameStats.indexBufferBinds++;
+        pState->renderer.frameStats.drawCalls++;
+        pState->renderer.frameStats.drawCommands++;
     }
 }
 
-// Grow strategy: x2, starting from 4
-static inline uint32_t scene_next_capacity(uint32_t current)
+/// @brief Index of the model's batch, or batchCount when it has no instances
+static uint32_t scene_batch_find(const Scene_t *pSCENE, const RenderModel_t *pMODEL)
 {
-    return current ? (current << 1) : 4u;
+    for (uint32_t i = 0; i < pSCENE->batchCount; ++i)
+        if (pSCENE->pBatches[i].pModel == pMODEL)
+            return i;
+
+    return pSCENE->batchCount;
 }
 
-void scene_modelAdd(Scene_t *pScene, RenderModel_t *pModel, Mat4c_t matrix)
+/// @brief Takes a free slot, growing the table when there's none. UINT32_MAX when memory runs out
+static uint32_t scene_slot_acquire(Scene_t *pScene)
 {
-    if (!pScene)
-        return;
+    if (!pScene->pSlots)
+        pScene->freeSlot = UINT32_MAX;
+
+    if (pScene->freeSlot != UINT32_MAX)
+    {
+        const uint32_t SLOT = pScene->freeSlot;
+        pScene->freeSlot = pScene->pSlots[SLOT].instance;
+        return SLOT;
+    }
+
+    if (pScene->slotCount >= pScene->slotCap)
+    {
+        uint32_t newCap = scene_next_capacity(pScene->slotCap);
+        void *pNewMem = realloc(pScene->pSlots, sizeof(SceneInstanceSlot_t) * newCap);
+        if (!pNewMem)
+            return UINT32_MAX;
+        pScene->pSlots = pNewMem;
+        pScene->slotCap = newCap;
+    }
+
+    pScene->pSlots[pScene->slotCount] = (SceneInstanceSlot_t){.instance = UINT32_MAX, .generation = 0};
+    return pScene->slotCount++;
+}
+
+/// @brief Points the slots of instances FIRST onwards back at where they now sit
+static void scene_slots_update(Scene_t *pScene, const uint32_t FIRST)
+{
+    for (uint32_t i = FIRST; i < pScene->instCount; ++i)
+        pScene->pSlots[pScene->pModelInstances[i].slot].instance = i;
+}
+
+SceneInstanceHandle_t scene_modelAdd(Scene_t *pScene, RenderModel_t *pModel, Mat4c_t matrix)
+{
+    if (!pScene || !pModel)
+        return SCENE_INSTANCE_HANDLE_INVALID;
 
     if (pScene->instCount >= pScene->instCap)
     {
         uint32_t newCap = scene_next_capacity(pScene->instCap);
         void *pNewMem = realloc(pScene->pModelInstances, sizeof(SceneModelInstance_t) * newCap);
         if (!pNewMem)
-            return;
+            return SCENE_INSTANCE_HANDLE_INVALID;
         pScene->pModelInstances = pNewMem;
         pScene->instCap = newCap;
     }
 
-    pScene->pModelInstances[pScene->instCount++] = (SceneModelInstance_t){
+    uint32_t batch = scene_batch_find(pScene, pModel);
+    if (batch == pScene->batchCount && pScene->batchCount >= pScene->batchCap)
+    {
+        uint32_t newCap = scene_next_capacity(pScene->batchCap);
+        void *pNewMem = realloc(pScene->pBatches, sizeof(SceneModelBatch_t) * newCap);
+        if (!pNewMem)
+            return SCENE_INSTANCE_HANDLE_INVALID;
+        pScene->pBatches = pNewMem;
+        pScene->batchCap = newCap;
+    }
+
+    // Last thing that can fail, so nothing has to be undone after it
+    const uint32_t SLOT = scene_slot_acquire(pScene);
+    if (SLOT == UINT32_MAX)
+        return SCENE_INSTANCE_HANDLE_INVALID;
+
+    if (batch == pScene->batchCount)
+    {
+        // New models start their run at the end
+        pScene->pBatches[pScene->batchCount++] = (SceneModelBatch_t){
+            .pModel = pModel,
+            .firstInstance = pScene->instCount,
+            .instanceCount = 0};
+    }
+
+    // Insert at the end of the model's run, shifting every later run up by one
+    const uint32_t INDEX = pScene->pBatches[batch].firstInstance + pScene->pBatches[batch].instanceCount;
+    memmove(&pScene->pModelInstances[INDEX + 1], &pScene->pModelInstances[INDEX],
+            sizeof(SceneModelInstance_t) * (pScene->instCount - INDEX));
+    for (uint32_t i = batch + 1; i < pScene->batchCount; ++i)
+        pScene->pBatches[i].firstInstance++;
+
+    pScene->pBatches[batch].instanceCount++;
+    pScene->pModelInstances[INDEX] = (SceneModelInstance_t){
         .modelMatrix = matrix,
-        .pModel = pModel};
+        .pModel = pModel,
+        .slot = SLOT};
+    pScene->instCount++;
+    scene_slots_update(pScene, INDEX);
+
+    return (SceneInstanceHandle_t){.slot = SLOT, .generation = pScene->pSlots[SLOT].generation};
+}
+
+bool scene_modelRemove(Scene_t *pScene, const SceneInstanceHandle_t HANDLE)
+{
+    if (!pScene || HANDLE.slot >= pScene->slotCount || pScene->pSlots[HANDLE.slot].generation != HANDLE.generation)
+        return false;
+
+    const uint32_t INDEX = pScene->pSlots[HANDLE.slot].instance;
+    const uint32_t BATCH = scene_batch_find(pScene, pScene->pModelInstances[INDEX].pModel);
+    if (BATCH == pScene->batchCount)
+        return false;
+
+    memmove(&pScene->pModelInstances[INDEX], &pScene->pModelInstances[INDEX + 1],
+            sizeof(SceneModelInstance_t) * (pScene->instCount - INDEX - 1));
+    pScene->instCount--;
+    scene_slots_update(pScene, INDEX);
+
+    // Stale from here on, then back on the free chain
+    pScene->pSlots[HANDLE.slot].generation++;
+    pScene->pSlots[HANDLE.slot].instance = pScene->freeSlot;
+    pScene->freeSlot = HANDLE.slot;
+
+    for (uint32_t i = BATCH + 1; i < pScene->batchCount; ++i)
+        pScene->pBatches[i].firstInstance--;
+
+    // An empty run isn't worth a draw
+    if (--pScene->pBatches[BATCH].instanceCount == 0)
+    {
+        memmove(&pScene->pBatches[BATCH], &pScene->pBatches[BATCH + 1], sizeof(SceneModelBatch_t) * (pScene->batchCount - BATCH - 1));
+        pScene->batchCount--;
+    }
+
+    return true;
 }
 
 void scene_modelCreate(Scene_t *pScene, RenderModel_t *pMdl)
@@ -90,6 +332,13 @@ void scene_modelDestroy(State_t *pState, RenderModel_t *pMdl)
 
     pMdl->indexCount = 0;
 
+    // Hand the table slot back first so it never names the view destroyed below
+    if (pMdl->textureIndex != DESCRIPTOR_POOL_MODEL_TEXTURE_INVALID)
+    {
+        descriptorPool_modelTexture_release(pState, pMdl->textureIndex);
+        pMdl->textureIndex = DESCRIPTOR_POOL_MODEL_TEXTURE_INVALID;
+    }
+
     if (pMdl->textureSampler != VK_NULL_HANDLE)
     {
         vkDestroySampler(DEVICE, pMdl->textureSampler, pAllocator);
@@ -114,18 +363,6 @@ void scene_modelDestroy(State_t *pState, RenderModel_t *pMdl)
         pMdl->textureMemory = VK_NULL_HANDLE;
     }
 
-    if (pMdl->descriptorPool != VK_NULL_HANDLE)
-    {
-        vkDestroyDescriptorPool(DEVICE, pMdl->descriptorPool, pAllocator);
-        pMdl->descriptorPool = VK_NULL_HANDLE;
-    }
-
-    if (pMdl->pDescriptorSets)
-    {
-        free(pMdl->pDescriptorSets);
-        pMdl->pDescriptorSets = NULL;
-    }
-
     memset(&pMdl->modelMatrix, 0, sizeof(pMdl->modelMatrix));
     free(pMdl);
 }
@@ -150,6 +387,36 @@ void scene_destroy(State_t *state)
     state->scene.ppModels = NULL;
     state->scene.modelCap = 0;
     state->scene.modelCount = 0;
+
+    if (state->scene.pInstanceFrames)
+    {
+        for (uint32_t i = 0; i < state->scene.instanceFrameCount; ++i)
+            bufferDestroy(state, &state->scene.pInstanceFrames[i].buffer, &state->scene.pInstanceFrames[i].allocation);
+        free(state->scene.pInstanceFrames);
+        state->scene.pInstanceFrames = NULL;
+        state->scene.instanceFrameCount = 0;
+    }
+
+    free(state->scene.pModelInstances);
+    state->scene.pModelInstances = NULL;
+    state->scene.instCount = 0;
+    state->scene.instCap = 0;
+
+    free(state->scene.pSlots);
+    state->scene.pSlots = NULL;
+    state->scene.slotCount = 0;
+    state->scene.slotCap = 0;
+
+    free(state->scene.pBatches);
+    state->scene.pBatches = NULL;
+    state->scene.batchCount = 0;
+    state->scene.batchCap = 0;
+
+    free(state->scene.pBatchOrder);
+    free(state->scene.pBatchOrderScratch);
+    state->scene.pBatchOrder = NULL;
+    state->scene.pBatchOrderScratch = NULL;
+    state->scene.batchOrderCap = 0;
 }
 
 void scene_debug_rotateAllRandom(Scene_t *pScene, float rad)
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <stdbool.h>
 #include <vulkan/vulkan.h>
 #include "core/types/state_t.h"
 #include "core/types/scene_t.h"
@@ -8,5 +9,12 @@
 void scene_debug_rotateAllRandom(Scene_t *pScene, float rad);
 void scene_drawModels(State_t *pState, VkCommandBuffer *pCmd, VkPipelineLayout *pPipelineLayout);
 void scene_modelCreate(Scene_t *scene, RenderModel_t *mdl);
+
+/// @brief Places an instance of the model. It's slotted in with the model's other instances so they draw together. The handle
+/// stays valid until the instance is removed. SCENE_INSTANCE_HANDLE_INVALID when memory runs out
+SceneInstanceHandle_t scene_modelAdd(Scene_t *pScene, RenderModel_t *pModel, Mat4c_t matrix);
+
+/// @brief Removes the instance the handle names. False when it was already removed or never placed
+bool scene_modelRemove(Scene_t *pScene, const SceneInstanceHandle_t HANDLE);
 void scene_destroy(State_t *state);
 void scene_model_createAll(State_t *pState);
\ No newline at end of file
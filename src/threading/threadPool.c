@@ -0,0 +1,251 @@
+#pragma region Includes
+#include "compat/intellisense_shims.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <threads.h>
+#include "core/logs.h"
+#include "threading/threadPool.h"
+#pragma endregion
+#pragma region Defines
+#if defined(DEBUG)
+// #define DEBUG_THREADPOOL
+#endif
+#define THREADPOOL_DEFAULT_JOB_CAPACITY 64
+#define THREADPOOL_RESIZE_FACTOR 2
+
+typedef struct ThreadPoolJob_t
+{
+    ThreadPoolJobFunc_t pFunc;
+    void *pCtx;
+    // NULL for ungrouped jobs
+    ThreadPoolGroup_t *pGroup;
+} ThreadPoolJob_t;
+
+struct ThreadPool_t
+{
+    thrd_t *pThreads;
+    // Ring buffer of pending jobs (FIFO)
+    ThreadPoolJob_t *pJobs;
+    size_t jobCapacity;
+    size_t jobHead;
+    size_t jobCount;
+    // Jobs that have been dequeued but haven't finished executing yet
+    size_t jobsActive;
+    mtx_t lock;
+    cnd_t workAvailable;
+    cnd_t workDone;
+    uint32_t threadCount;
+    bool shutdown;
+};
+#pragma endregion
+#pragma region Worker
+static int threadPool_worker(void *pArg)
+{
+    ThreadPool_t *pPool = (ThreadPool_t *)pArg;
+
+    while (true)
+    {
+        mtx_lock(&pPool->lock);
+        while (pPool->jobCount == 0 && !pPool->shutdown)
+            cnd_wait(&pPool->workAvailable, &pPool->lock);
+
+        // Drain the queue before honoring shutdown so no submitted job is silently dropped
+        if (pPool->jobCount == 0 && pPool->shutdown)
+        {
+            mtx_unlock(&pPool->lock);
+            break;
+        }
+
+        const ThreadPoolJob_t JOB = pPool->pJobs[pPool->jobHead];
+        pPool->jobHead = (pPool->jobHead + 1) % pPool->jobCapacity;
+        pPool->jobCount--;
+        pPool->jobsActive++;
+        mtx_unlock(&pPool->lock);
+
+        JOB.pFunc(JOB.pCtx);
+
+        mtx_lock(&pPool->lock);
+        pPool->jobsActive--;
+        const bool GROUP_DONE = JOB.pGroup && --JOB.pGroup->pending == 0;
+        if (GROUP_DONE || (pPool->jobCount == 0 && pPool->jobsActive == 0))
+            cnd_broadcast(&pPool->workDone);
+        mtx_unlock(&pPool->lock);
+    }
+
+    return 0;
+}
+#pragma endregion
+#pragma region Operations
+/// @brief Grows the job ring, unwrapping it so the head is at index 0. Must be called with the lock held.
+static bool threadPool_jobs_grow(ThreadPool_t *pPool)
+{
+    const size_t NEW_CAPACITY = pPool->jobCapacity * THREADPOOL_RESIZE_FACTOR;
+    ThreadPoolJob_t *pNew = malloc(sizeof(ThreadPoolJob_t) * NEW_CAPACITY);
+    if (!pNew)
+        return false;
+
+    for (size_t i = 0; i < pPool->jobCount; i++)
+        pNew[i] = pPool->pJobs[(pPool->jobHead + i) % pPool->jobCapacity];
+
+    free(pPool->pJobs);
+    pPool->pJobs = pNew;
+    pPool->jobCapacity = NEW_CAPACITY;
+    pPool->jobHead = 0;
+
+    return true;
+}
+
+/// @brief Shared by both submit functions. pGroup may be NULL
+static bool threadPool_job_push(ThreadPool_t *pPool, ThreadPoolGroup_t *pGroup, ThreadPoolJobFunc_t pFunc, void *pCtx)
+{
+    if (!pPool || !pFunc)
+        return false;
+
+    mtx_lock(&pPool->lock);
+
+    if (pPool->shutdown || (pPool->jobCount == pPool->jobCapacity && !threadPool_jobs_grow(pPool)))
+    {
+        mtx_unlock(&pPool->lock);
+        logs_log(LOG_ERROR, "Failed to submit a job to thread pool %p!", pPool);
+        return false;
+    }
+
+    const size_t TAIL = (pPool->jobHead + pPool->jobCount) % pPool->jobCapacity;
+    pPool->pJobs[TAIL] = (ThreadPoolJob_t){
+        .pFunc = pFunc,
+        .pCtx = pCtx,
+        .pGroup = pGroup};
+    pPool->jobCount++;
+    if (pGroup)
+        pGroup->pending++;
+
+    cnd_signal(&pPool->workAvailable);
+    mtx_unlock(&pPool->lock);
+
+    return true;
+}
+
+bool threadPool_submit(ThreadPool_t *restrict pPool, ThreadPoolJobFunc_t pFunc, void *restrict pCtx)
+{
+    return threadPool_job_push(pPool, NULL, pFunc, pCtx);
+}
+
+bool threadPool_submitGroup(ThreadPool_t *restrict pPool, ThreadPoolGroup_t *restrict pGroup, ThreadPoolJobFunc_t pFunc,
+                            void *restrict pCtx)
+{
+    if (!pGroup)
+        return false;
+
+    return threadPool_job_push(pPool, pGroup, pFunc, pCtx);
+}
+
+void threadPool_waitGroup(ThreadPool_t *restrict pPool, ThreadPoolGroup_t *restrict pGroup)
+{
+    if (!pPool || !pGroup)
+        return;
+
+    mtx_lock(&pPool->lock);
+    while (pGroup->pending > 0)
+        cnd_wait(&pPool->workDone, &pPool->lock);
+    mtx_unlock(&pPool->lock);
+}
+
+void threadPool_waitIdle(ThreadPool_t *pPool)
+{
+    if (!pPool)
+        return;
+
+    mtx_lock(&pPool->lock);
+    while (pPool->jobCount > 0 || pPool->jobsActive > 0)
+        cnd_wait(&pPool->workDone, &pPool->lock);
+    mtx_unlock(&pPool->lock);
+}
+
+uint32_t threadPool_threadCount(const ThreadPool_t *pPOOL)
+{
+    return pPOOL ? pPOOL->threadCount : 0;
+}
+#pragma endregion
+#pragma region Create/Destroy
+ThreadPool_t *threadPool_create(const uint32_t THREAD_COUNT)
+{
+    ThreadPool_t *pPool = calloc(1, sizeof(ThreadPool_t));
+    if (!pPool)
+        return NULL;
+
+    const uint32_t COUNT = THREAD_COUNT > 0 ? THREAD_COUNT : 1;
+
+    pPool->pJobs = malloc(sizeof(ThreadPoolJob_t) * THREADPOOL_DEFAULT_JOB_CAPACITY);
+    pPool->pThreads = calloc(COUNT, sizeof(thrd_t));
+    if (!pPool->pJobs || !pPool->pThreads)
+    {
+        free(pPool->pJobs);
+        free(pPool->pThreads);
+        free(pPool);
+        return NULL;
+    }
+
+    pPool->jobCapacity = THREADPOOL_DEFAULT_JOB_CAPACITY;
+
+    if (mtx_init(&pPool->lock, mtx_plain) != thrd_success ||
+        cnd_init(&pPool->workAvailable) != thrd_success ||
+        cnd_init(&pPool->workDone) != thrd_success)
+    {
+        logs_log(LOG_ERROR, "Failed to initialize thread pool synchronization primitives!");
+        free(pPool->pJobs);
+        free(pPool->pThreads);
+        free(pPool);
+        return NULL;
+    }
+
+    for (uint32_t i = 0; i < COUNT; i++)
+    {
+        if (thrd_create(&pPool->pThreads[i], threadPool_worker, pPool) != thrd_success)
+        {
+            logs_log(LOG_ERROR, "Failed to create worker thread %u of %u! Continuing with %u.", i + 1, COUNT, i);
+            break;
+        }
+        pPool->threadCount++;
+    }
+
+    if (pPool->threadCount == 0)
+    {
+        threadPool_destroy(pPool);
+        return NULL;
+    }
+
+#if defined(DEBUG_THREADPOOL)
+    logs_log(LOG_DEBUG, "Created thread pool %p with %u worker thread(s).", pPool, pPool->threadCount);
+#endif
+
+    return pPool;
+}
+
+void threadPool_destroy(ThreadPool_t *pPool)
+{
+    if (!pPool)
+        return;
+
+    mtx_lock(&pPool->lock);
+    pPool->shutdown = true;
+    cnd_broadcast(&pPool->workAvailable);
+    mtx_unlock(&pPool->lock);
+
+    for (uint32_t i = 0; i < pPool->threadCount; i++)
+        thrd_join(pPool->pThreads[i], NULL);
+
+    cnd_destroy(&pPool->workDone);
+    cnd_destroy(&pPool->workAvailable);
+    mtx_destroy(&pPool->lock);
+
+    free(pPool->pThreads);
+    free(pPool->pJobs);
+    free(pPool);
+}
+#pragma endregion
+#pragma region Undefines
+#undef THREADPOOL_DEFAULT_JOB_CAPACITY
+#undef THREADPOOL_RESIZE_FACTOR
+#pragma endregion
@@ -0,0 +1,45 @@
+#pragma region Includes
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#pragma endregion
+#pragma region Defines
+/// @brief Work function executed on a worker thread. pCtx is owned by the caller of threadPool_submit.
+typedef void (*ThreadPoolJobFunc_t)(void *pCtx);
+
+/// @brief Fixed-size pool of worker threads consuming a FIFO job queue
+typedef struct ThreadPool_t ThreadPool_t;
+
+/// @brief Counts the unfinished jobs submitted with it so a caller can wait on just those. Zero-initialize before first use and
+/// keep it alive until threadPool_waitGroup returns. Only touched under the pool's lock.
+typedef struct ThreadPoolGroup_t
+{
+    size_t pending;
+} ThreadPoolGroup_t;
+#pragma endregion
+#pragma region Operations
+/// @brief Queues pFunc(pCtx) to run on the next free worker. The job queue grows as needed. Returns false on invalid input,
+/// allocation failure, or if the pool is shutting down.
+bool threadPool_submit(ThreadPool_t *restrict pPool, ThreadPoolJobFunc_t pFunc, void *restrict pCtx);
+
+/// @brief Same as threadPool_submit but counted in pGroup, so threadPool_waitGroup can wait for it without waiting on unrelated jobs
+bool threadPool_submitGroup(ThreadPool_t *restrict pPool, ThreadPoolGroup_t *restrict pGroup, ThreadPoolJobFunc_t pFunc,
+                            void *restrict pCtx);
+
+/// @brief Blocks the calling thread until every job submitted with pGroup has finished. Must not be called from a worker
+void threadPool_waitGroup(ThreadPool_t *restrict pPool, ThreadPoolGroup_t *restrict pGroup);
+
+/// @brief Blocks the calling thread until the job queue is empty and no worker is executing a job
+void threadPool_waitIdle(ThreadPool_t *pPool);
+
+/// @brief Number of worker threads owned by the pool
+uint32_t threadPool_threadCount(const ThreadPool_t *pPOOL);
+#pragma endregion
+#pragma region Create/Destroy
+/// @brief Creates a pool with THREAD_COUNT workers (clamped to at least 1). Returns NULL on failure.
+ThreadPool_t *threadPool_create(const uint32_t THREAD_COUNT);
+
+/// @brief Finishes every queued job, joins the workers, and frees the pool
+void threadPool_destroy(ThreadPool_t *pPool);
+#pragma endregion
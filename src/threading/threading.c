@@ -6,6 +6,14 @@
 #include <time.h>
 #include <inttypes.h>
 #include "core/logs.h"
+#include "threading/threading.h"
+
+// OS-specific inclusions for querying the core count
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
 
 static thrd_t s_mainThread;
 static bool s_mainThreadCached;
@@ -42,4 +50,17 @@ bool threading_thread_errorIfNotMain(void)
                     thrd_current()._Tid, s_mainThread._Tid);
 
     return isMain;
+}
+
+uint32_t threading_cpu_coreCount(void)
+{
+#ifdef _WIN32
+    SYSTEM_INFO systemInfo;
+    GetSystemInfo(&systemInfo);
+    const long CORES = (long)systemInfo.dwNumberOfProcessors;
+#else
+    const long CORES = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+
+    return CORES > 0 ? (uint32_t)CORES : 1U;
 }
\ No newline at end of file
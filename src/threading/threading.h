@@ -1,9 +1,13 @@
 #pragma once
 
 #include <stdbool.h>
+#include <stdint.h>
 
 void threading_thread_thisIsMain(void);
 
 bool threading_thread_isMain(void);
 
 bool threading_thread_errorIfNotMain(void);
+
+/// @brief Gets the number of logical CPU cores available to the process. Always at least 1.
+uint32_t threading_cpu_coreCount(void);
@@ -9,6 +9,7 @@
 #include "core/randomNoise.h"
 #include "chunkManager.h"
 #include "chunkSolidityGrid.h"
+#include "chunkVisibility.h"
 #include "api/chunk/chunkAPI.h"
 #include "core/random.h"
 #pragma endregion
@@ -258,6 +259,7 @@ bool chunkGen_genChunk(const WeightMaps_t *pWEIGHTED_MAPS, const BlockDefinition
         chunkGen_paintStone(pWEIGHTED_MAPS, pBLOCK_DEFINITIONS, pChunk, CHUNK_POS, pStoneSolidity);
 
     pChunk->pTransparencyGrid = chunkGen_transparencyGrid(pChunk);
+    pChunk->faceConnectivity = chunkVisibility_faces_build(pChunk->pTransparencyGrid);
 
     free(pPackedPos);
     pPackedPos = NULL;
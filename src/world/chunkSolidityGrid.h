@@ -1,5 +1,6 @@
 #pragma region Includes
 #pragma once
+#include <stdbool.h>
 #include <stdint.h>
 #include <string.h>
 #include "cmath/cmath.h"
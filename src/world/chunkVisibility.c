@@ -0,0 +1,107 @@
+#pragma region Includes
+#include <string.h>
+#include "world/chunkVisibility.h"
+#pragma endregion
+#pragma region Defines
+#define AXIS CMATH_CHUNK_AXIS_LENGTH
+// Local index is x + y * 16 + z * 256
+#define STRIDE_Y AXIS
+#define STRIDE_Z (AXIS * AXIS)
+#pragma endregion
+#pragma region Flood Fill
+/// @brief Faces (bit per CubeFace_e) of the chunk that the block at X, Y, Z sits against
+static inline uint8_t chunkVisibility_borderFaces(const int X, const int Y, const int Z)
+{
+    uint8_t faces = 0;
+    faces |= (uint8_t)((X == 0) << CUBE_FACE_LEFT);
+    faces |= (uint8_t)((X == AXIS - 1) << CUBE_FACE_RIGHT);
+    faces |= (uint8_t)((Y == AXIS - 1) << CUBE_FACE_TOP);
+    faces |= (uint8_t)((Y == 0) << CUBE_FACE_BOTTOM);
+    faces |= (uint8_t)((Z == AXIS - 1) << CUBE_FACE_FRONT);
+    faces |= (uint8_t)((Z == 0) << CUBE_FACE_BACK);
+    return faces;
+}
+
+uint64_t chunkVisibility_faces_build(const ChunkSolidityGrid_t *pTRANSPARENCY)
+{
+    // Nothing known, so nothing can be hidden behind it
+    if (!pTRANSPARENCY || !pTRANSPARENCY->pGrid)
+        return CHUNK_VISIBILITY_ALL;
+
+    // Visited doubles as "solid", so each block is looked at once
+    uint8_t pVisited[CMATH_CHUNK_BLOCK_CAPACITY];
+    uint32_t transparentCount = 0;
+    for (int z = 0; z < AXIS; z++)
+        for (int y = 0; y < AXIS; y++)
+            for (int x = 0; x < AXIS; x++)
+            {
+                const uint8_t SOLID = pTRANSPARENCY->pGrid[chunkSolidityGrid_index16((uint8_t)x, (uint8_t)y, (uint8_t)z)] ==
+                                      SOLIDITY_SOLID;
+                pVisited[x + y * STRIDE_Y + z * STRIDE_Z] = SOLID;
+                transparentCount += !SOLID;
+            }
+
+    if (transparentCount == 0)
+        return 0;
+    if (transparentCount == CMATH_CHUNK_BLOCK_CAPACITY)
+        return CHUNK_VISIBILITY_ALL;
+
+    uint16_t pStack[CMATH_CHUNK_BLOCK_CAPACITY];
+    uint64_t connectivity = 0;
+
+    for (uint16_t start = 0; start < CMATH_CHUNK_BLOCK_CAPACITY; start++)
+    {
+        if (pVisited[start])
+            continue;
+
+        // One pocket of transparent blocks. Every face it touches can see every other face it touches
+        uint8_t faces = 0;
+        uint32_t stackSize = 0;
+        pVisited[start] = 1;
+        pStack[stackSize++] = start;
+
+        while (stackSize > 0)
+        {
+            const uint16_t INDEX = pStack[--stackSize];
+            const int X = INDEX % AXIS;
+            const int Y = (INDEX / STRIDE_Y) % AXIS;
+            const int Z = INDEX / STRIDE_Z;
+            faces |= chunkVisibility_borderFaces(X, Y, Z);
+
+            const int pNEIGHBORS[CMATH_GEOM_CUBE_FACES][2] = {
+                {X > 0, -1},
+                {X < AXIS - 1, 1},
+                {Y < AXIS - 1, STRIDE_Y},
+                {Y > 0, -STRIDE_Y},
+                {Z < AXIS - 1, STRIDE_Z},
+                {Z > 0, -STRIDE_Z},
+            };
+
+            for (int n = 0; n < CMATH_GEOM_CUBE_FACES; n++)
+            {
+                if (!pNEIGHBORS[n][0])
+                    continue;
+
+                const uint16_t NEIGHBOR = (uint16_t)(INDEX + pNEIGHBORS[n][1]);
+                if (pVisited[NEIGHBOR])
+                    continue;
+
+                pVisited[NEIGHBOR] = 1;
+                pStack[stackSize++] = NEIGHBOR;
+            }
+        }
+
+        connectivity = chunkVisibility_faces_join(connectivity, faces);
+        // Nothing left to learn once every face reaches every other
+        if (connectivity == CHUNK_VISIBILITY_ALL)
+            break;
+    }
+
+    return connectivity;
+}
+#pragma endregion
+#pragma region Undefines
+#undef AXIS
+#undef STRIDE_Y
+#undef STRIDE_Z
+#pragma endregion
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "cmath/cmath.h"
+#include "world/chunkSolidityGrid.h"
+
+// Every face reaches every other face. What a chunk reports before its blocks are known
+#define CHUNK_VISIBILITY_ALL ((UINT64_C(1) << (CMATH_GEOM_CUBE_FACES * CMATH_GEOM_CUBE_FACES)) - 1)
+
+/// @brief Bit of the connectivity matrix saying faces A and B (CubeFace_e) are joined
+static inline uint64_t chunkVisibility_bit(const CubeFace_e A, const CubeFace_e B)
+{
+    return UINT64_C(1) << ((unsigned)A * CMATH_GEOM_CUBE_FACES + (unsigned)B);
+}
+
+/// @brief Whether something looking in through face A of the chunk could see out through face B
+static inline bool chunkVisibility_faces_connected(const uint64_t CONNECTIVITY, const CubeFace_e A, const CubeFace_e B)
+{
+    return (CONNECTIVITY & chunkVisibility_bit(A, B)) != 0;
+}
+
+/// @brief Joins every pair of faces in FACE_MASK (bit per CubeFace_e) in both directions
+static inline uint64_t chunkVisibility_faces_join(const uint64_t CONNECTIVITY, const uint8_t FACE_MASK)
+{
+    uint64_t connectivity = CONNECTIVITY;
+    for (int a = 0; a < CMATH_GEOM_CUBE_FACES; a++)
+    {
+        if (!(FACE_MASK & (1U << a)))
+            continue;
+
+        for (int b = 0; b < CMATH_GEOM_CUBE_FACES; b++)
+        {
+            if (FACE_MASK & (1U << b))
+                connectivity |= chunkVisibility_bit((CubeFace_e)a, (CubeFace_e)b);
+        }
+    }
+
+    return connectivity;
+}
+
+/// @brief Flood fills the transparent blocks of the chunk and builds its 6x6 face connectivity matrix (bit A * 6 + B). Two faces
+/// are connected when one pocket of transparent blocks touches both. A face touched by any pocket is connected to itself.
+uint64_t chunkVisibility_faces_build(const ChunkSolidityGrid_t *pTRANSPARENCY);
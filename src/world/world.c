@@ -55,7 +55,7 @@ void world_chunks_load(State_t *restrict pState, Entity_t *restrict pLoadingEnti
     }
 
     for (size_t i = 0; i < newCount; i++)
-        chunkRenderer_enqueueRemesh(pState->pWorldState, ppNewChunks[i]);
+        chunkRenderer_enqueueRemesh_loaded(pState, ppNewChunks[i]);
 
     free(ppNewChunks);
     free(ppExistingChunks);
@@ -114,6 +114,8 @@ void world_destroy(State_t *pState)
     // Ensure nothing is in-flight that still uses these buffers
     vkDeviceWaitIdle(pState->context.device);
 
+    // Mesh workers reference chunks directly so they have to finish before the chunks go away
+    chunkRenderer_destroy(pState);
     chunkManager_destroyNew(pState, pState->pWorldState->pChunkManager);
 
     pState->pWorldState = NULL;
@@ -0,0 +1,107 @@
+#include "../../unit_tests.h"
+#include <stdbool.h>
+#include <stdlib.h>
+#include "cmath/cmath.h"
+#include "rendering/chunk/chunkCulling.h"
+
+static int fails = 0;
+
+/// @brief Eye at EYE looking down -Z, 90 degree square frustum out to FAR
+static Frustumf_t test_frustum_get(const Vec3f_t EYE, const float FAR)
+{
+    const Mat4c_t VIEW = cmath_lookAt(EYE, cmath_vec3f_add_vec3f(EYE, VEC3F_FORWARD), VEC3F_UP);
+    const Mat4c_t PROJECTION = cmath_perspective(cmath_deg2radF(90.0F), 1.0F, 0.1F, FAR);
+    return cmath_frustum_fromViewProjection(cmath_mat_mult_mat(PROJECTION, VIEW));
+}
+
+/// @brief The batched test has to agree with the plain AABB test for every chunk of a cube of chunks around the eye
+static bool test_chunkCulling_matchesScalar(void)
+{
+    const int RADIUS = 6;
+    const int SIDE = RADIUS * 2 + 1;
+    // Not a multiple of the batch width, so the leftover path runs too
+    const uint32_t COUNT = (uint32_t)(SIDE * SIDE * SIDE);
+
+    float *pMinX = malloc(sizeof(float) * COUNT);
+    float *pMinY = malloc(sizeof(float) * COUNT);
+    float *pMinZ = malloc(sizeof(float) * COUNT);
+    uint8_t *pVisible = malloc(COUNT);
+    if (!pMinX || !pMinY || !pMinZ || !pVisible)
+    {
+        free(pMinX);
+        free(pMinY);
+        free(pMinZ);
+        free(pVisible);
+        return false;
+    }
+
+    uint32_t i = 0;
+    for (int x = -RADIUS; x <= RADIUS; x++)
+        for (int y = -RADIUS; y <= RADIUS; y++)
+            for (int z = -RADIUS; z <= RADIUS; z++, i++)
+            {
+                const Boundsi_t BOUNDS = cmath_chunk_getBoundsi((Vec3i_t){x, y, z});
+                pMinX[i] = (float)BOUNDS.A.x;
+                pMinY[i] = (float)BOUNDS.A.y;
+                pMinZ[i] = (float)BOUNDS.A.z;
+            }
+
+    const Frustumf_t FRUSTUM = test_frustum_get((Vec3f_t){3.5F, 20.25F, -7.0F}, 80.0F);
+    const uint32_t VISIBLE_COUNT = chunkCulling_frustum_test(&FRUSTUM, pMinX, pMinY, pMinZ, COUNT, pVisible);
+
+    bool result = true;
+    uint32_t expectedCount = 0;
+    const float SIZE = (float)CMATH_CHUNK_AXIS_LENGTH;
+    for (i = 0; i < COUNT; i++)
+    {
+        const Vec3f_t MIN = {pMinX[i], pMinY[i], pMinZ[i]};
+        const Vec3f_t MAX = {MIN.x + SIZE, MIN.y + SIZE, MIN.z + SIZE};
+        const bool EXPECTED = cmath_frustum_AABB_intersects(&FRUSTUM, MIN, MAX);
+        expectedCount += EXPECTED;
+        if ((pVisible[i] != 0) != EXPECTED)
+            result = false;
+    }
+
+    // Looking down one axis with a 90 degree frustum keeps well under half of the cube
+    if (VISIBLE_COUNT != expectedCount || VISIBLE_COUNT == 0 || VISIBLE_COUNT >= COUNT / 2)
+        result = false;
+
+    free(pMinX);
+    free(pMinY);
+    free(pMinZ);
+    free(pVisible);
+    return result;
+}
+
+static bool test_chunkCulling_behindAndAhead(void)
+{
+    const Frustumf_t FRUSTUM = test_frustum_get(VEC3F_ZERO, 200.0F);
+
+    // Ahead, behind, containing the eye, past the far plane, and far off to the side
+    const float pMIN_X[] = {-8.0F, -8.0F, -8.0F, -8.0F, 400.0F};
+    const float pMIN_Y[] = {-8.0F, -8.0F, -8.0F, -8.0F, -8.0F};
+    const float pMIN_Z[] = {-48.0F, 32.0F, -8.0F, -320.0F, -48.0F};
+    const uint8_t pEXPECTED[] = {1, 0, 1, 0, 0};
+    uint8_t pVisible[5] = {0};
+
+    const uint32_t VISIBLE_COUNT = chunkCulling_frustum_test(&FRUSTUM, pMIN_X, pMIN_Y, pMIN_Z, 5, pVisible);
+    if (VISIBLE_COUNT != 2)
+        return false;
+
+    for (int i = 0; i < 5; i++)
+    {
+        if (pVisible[i] != pEXPECTED[i])
+            return false;
+    }
+
+    return chunkCulling_frustum_test(&FRUSTUM, pMIN_X, pMIN_Y, pMIN_Z, 0, pVisible) == 0 &&
+           chunkCulling_frustum_test(NULL, pMIN_X, pMIN_Y, pMIN_Z, 5, pVisible) == 0;
+}
+
+int chunkCulling_tests_run(void)
+{
+    fails += ut_assert(test_chunkCulling_matchesScalar() == true, "Chunk culling batches match the scalar frustum test");
+    fails += ut_assert(test_chunkCulling_behindAndAhead() == true, "Chunk culling keeps chunks ahead and drops the rest");
+
+    return fails;
+}
@@ -0,0 +1,3 @@
+#pragma once
+
+int chunkCulling_tests_run(void);
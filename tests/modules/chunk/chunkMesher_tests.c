@@ -0,0 +1,332 @@
+#include "../../unit_tests.h"
+#include <stdbool.h>
+#include <string.h>
+#include "cmath/cmath.h"
+#include "api/chunk/chunkAPI.h"
+#include "rendering/chunk/chunkMesher.h"
+#include "world/chunkSolidityGrid.h"
+#include "world/voxel/block_t.h"
+
+static int fails = 0;
+
+static BlockVoxel_t pTestVoxels[CMATH_GEOM_CUBE_FACES + 1][CMATH_CHUNK_BLOCK_CAPACITY];
+// Large, so keep it off the stack
+static ChunkMeshInput_t testInput;
+
+/// @brief Fills a stack chunk with either all stone or all air and builds its transparency grid
+static bool test_chunk_fill(Chunk_t *pChunk, BlockVoxel_t *pVoxels, const Vec3i_t CHUNK_POS, const bool SOLID)
+{
+    const BlockDefinition_t *const *pBLOCK_DEFINITIONS = block_defs_getAll();
+
+    memset(pChunk, 0, sizeof(*pChunk));
+    pChunk->chunkPos = CHUNK_POS;
+    pChunk->pBlockVoxels = pVoxels;
+    pChunk->pTransparencyGrid = chunkSolidityGrid_init(SOLIDITY_AIR);
+    if (!pChunk->pTransparencyGrid)
+        return false;
+
+    chunkState_set(pChunk, CHUNK_STATE_CPU_ONLY);
+
+    const Vec3u8_t *pPOINTS = cmath_chunkPoints_Get();
+    for (size_t i = 0; i < CMATH_CHUNK_POINTS_COUNT; i++)
+    {
+        pVoxels[i].pBLOCK_DEFINITION = pBLOCK_DEFINITIONS[SOLID ? BLOCK_ID_STONE : BLOCK_ID_AIR];
+        pChunk->pTransparencyGrid->pGrid[chunkSolidityGrid_index16(pPOINTS[i].x, pPOINTS[i].y, pPOINTS[i].z)] =
+            SOLID ? SOLIDITY_SOLID : SOLIDITY_TRANSPARENT;
+    }
+
+    return true;
+}
+
+static uint32_t test_mesh_faceCount(Chunk_t *pChunk, Chunk_t *const *ppNeighbors)
+{
+    if (!chunkMesher_input_create(&testInput, pChunk, ppNeighbors))
+        return UINT32_MAX;
+
+    ChunkMesh_t mesh = {0};
+    if (!chunkMesher_mesh(&testInput, &mesh))
+        return UINT32_MAX;
+
+    const uint32_t FACES = mesh.indexCount / INDICIES_PER_FACE;
+    if (mesh.vertexCount != FACES * VERTS_PER_FACE)
+        return UINT32_MAX;
+
+    chunkMesher_mesh_destroy(&mesh);
+    return FACES;
+}
+
+static bool test_chunkMesher_unloadedNeighbors(void)
+{
+    Chunk_t chunk;
+    if (!test_chunk_fill(&chunk, pTestVoxels[0], VEC3I_ZERO, true))
+        return false;
+
+    Chunk_t *ppNeighbors[CMATH_GEOM_CUBE_FACES] = {0};
+
+    // Nothing is known about unloaded neighbors, so every border face of a solid chunk is visible
+    const uint32_t FACES = test_mesh_faceCount(&chunk, ppNeighbors);
+    chunkSolidityGrid_destroy(chunk.pTransparencyGrid);
+
+    return FACES == CMATH_GEOM_CUBE_FACES * CMATH_CHUNK_AXIS_LENGTH * CMATH_CHUNK_AXIS_LENGTH;
+}
+
+static bool test_chunkMesher_haloFromNeighbors(void)
+{
+    Chunk_t chunk;
+    Chunk_t pNeighbors[CMATH_GEOM_CUBE_FACES];
+    Chunk_t *ppNeighbors[CMATH_GEOM_CUBE_FACES] = {0};
+
+    if (!test_chunk_fill(&chunk, pTestVoxels[0], VEC3I_ZERO, true))
+        return false;
+
+    // Solid on every side except an air chunk on the right
+    for (int face = 0; face < CMATH_GEOM_CUBE_FACES; face++)
+    {
+        const bool SOLID = face != CUBE_FACE_RIGHT;
+        if (!test_chunk_fill(&pNeighbors[face], pTestVoxels[face + 1], pCMATH_CUBE_NEIGHBOR_OFFSETS[face], SOLID))
+            return false;
+        ppNeighbors[face] = &pNeighbors[face];
+    }
+
+    const uint32_t FACES = test_mesh_faceCount(&chunk, ppNeighbors);
+
+    // Only the slice touching this chunk (x = 0 of the right neighbor) should matter
+    for (uint8_t y = 0; y < CMATH_CHUNK_AXIS_LENGTH; y++)
+        for (uint8_t z = 0; z < CMATH_CHUNK_AXIS_LENGTH; z++)
+            pNeighbors[CUBE_FACE_RIGHT].pTransparencyGrid->pGrid[chunkSolidityGrid_index16(0, y, z)] = SOLIDITY_SOLID;
+    const uint32_t FACES_RIGHT_BORDER_SOLID = test_mesh_faceCount(&chunk, ppNeighbors);
+
+    // An unloaded-looking neighbor (bad state) must be treated the same as a missing one
+    chunkState_set(&pNeighbors[CUBE_FACE_LEFT], CHUNK_STATE_UNLOADED);
+    const uint32_t FACES_LEFT_UNLOADED = test_mesh_faceCount(&chunk, ppNeighbors);
+
+    chunkSolidityGrid_destroy(chunk.pTransparencyGrid);
+    for (int face = 0; face < CMATH_GEOM_CUBE_FACES; face++)
+        chunkSolidityGrid_destroy(pNeighbors[face].pTransparencyGrid);
+
+    const uint32_t FACE_AREA = CMATH_CHUNK_AXIS_LENGTH * CMATH_CHUNK_AXIS_LENGTH;
+    return FACES == FACE_AREA && FACES_RIGHT_BORDER_SOLID == 0 && FACES_LEFT_UNLOADED == FACE_AREA;
+}
+
+static bool test_chunkMesher_emptyChunk(void)
+{
+    Chunk_t chunk;
+    if (!test_chunk_fill(&chunk, pTestVoxels[0], VEC3I_ZERO, false))
+        return false;
+
+    Chunk_t *ppNeighbors[CMATH_GEOM_CUBE_FACES] = {0};
+
+    if (!chunkMesher_input_create(&testInput, &chunk, ppNeighbors))
+        return false;
+
+    ChunkMesh_t mesh = {0};
+    const bool RESULT = chunkMesher_mesh(&testInput, &mesh);
+    chunkSolidityGrid_destroy(chunk.pTransparencyGrid);
+
+    // Success with nothing to draw
+    return RESULT && mesh.pVertices == NULL && mesh.pIndices == NULL && mesh.indexCount == 0;
+}
+
+static bool test_chunkMesher_invalidArgs(void)
+{
+    Chunk_t *ppNeighbors[CMATH_GEOM_CUBE_FACES] = {0};
+    ChunkMesh_t mesh = {0};
+
+    if (chunkMesher_input_create(NULL, NULL, ppNeighbors) != false)
+        return false;
+    if (chunkMesher_mesh(NULL, &mesh) != false)
+        return false;
+    if (chunkMesher_mesh(&testInput, NULL) != false)
+        return false;
+
+    // Must not crash
+    chunkMesher_mesh_destroy(NULL);
+
+    return true;
+}
+
+static bool test_chunkMesher_directionSections(void)
+{
+    Chunk_t chunk;
+    if (!test_chunk_fill(&chunk, pTestVoxels[0], VEC3I_ZERO, true))
+        return false;
+
+    Chunk_t *ppNeighbors[CMATH_GEOM_CUBE_FACES] = {0};
+
+    ChunkMesh_t mesh = {0};
+    bool result = chunkMesher_input_create(&testInput, &chunk, ppNeighbors) &&
+                  chunkMesher_mesh(&testInput, &mesh);
+
+    // A solid chunk with unloaded neighbors shows one 16x16 side per direction, packed back to back in CubeFace_e order
+    uint32_t expectedFirst = 0;
+    for (int face = 0; result && face < CMATH_GEOM_CUBE_FACES; face++)
+    {
+        const ChunkMeshSection_t SECTION = mesh.pSections[face];
+        if (SECTION.firstIndex != expectedFirst || SECTION.indexCount != CMATH_CHUNK_AXIS_LENGTH * CMATH_CHUNK_AXIS_LENGTH * 6)
+            result = false;
+
+        // Every face in the section must point the section's way
+        for (uint32_t i = SECTION.firstIndex; result && i < SECTION.firstIndex + SECTION.indexCount; i++)
+        {
+            if (mesh.pVertices[mesh.pIndices[i]].faceID != face)
+                result = false;
+        }
+
+        expectedFirst += SECTION.indexCount;
+    }
+
+    if (expectedFirst != mesh.indexCount)
+        result = false;
+
+    chunkMesher_mesh_destroy(&mesh);
+    chunkSolidityGrid_destroy(chunk.pTransparencyGrid);
+    return result;
+}
+
+static bool test_chunkMesher_lod(void)
+{
+    Chunk_t chunk;
+    if (!test_chunk_fill(&chunk, pTestVoxels[0], VEC3I_ZERO, true))
+        return false;
+
+    Chunk_t *ppNeighbors[CMATH_GEOM_CUBE_FACES] = {0};
+    bool result = true;
+
+    // A solid chunk is one (16 >> lod)^2 side per direction
+    for (uint8_t lod = 1; result && lod < CHUNK_MESH_LOD_COUNT; lod++)
+    {
+        chunk.meshLod = lod;
+        const uint32_t SIDE = CMATH_CHUNK_AXIS_LENGTH >> lod;
+        if (test_mesh_faceCount(&chunk, ppNeighbors) != CMATH_GEOM_CUBE_FACES * SIDE * SIDE)
+            result = false;
+    }
+
+    // Super voxels still span the whole chunk
+    chunk.meshLod = CHUNK_MESH_LOD_COUNT - 1;
+    ChunkMesh_t mesh = {0};
+    if (result && chunkMesher_input_create(&testInput, &chunk, ppNeighbors) &&
+        chunkMesher_mesh(&testInput, &mesh))
+    {
+        float maxX = 0.0F;
+        for (uint32_t i = 0; i < mesh.vertexCount; i++)
+            maxX = mesh.pVertices[i].pos.x > maxX ? mesh.pVertices[i].pos.x : maxX;
+
+        if (maxX != (float)CMATH_CHUNK_AXIS_LENGTH)
+            result = false;
+    }
+    else
+        result = false;
+
+    chunkMesher_mesh_destroy(&mesh);
+
+    // A super voxel that is mostly air is dropped
+    for (size_t i = 0; i < CMATH_CHUNK_POINTS_COUNT; i += 2)
+        pTestVoxels[0][i].pBLOCK_DEFINITION = block_defs_getAll()[BLOCK_ID_AIR];
+    for (size_t i = 1; i < CMATH_CHUNK_POINTS_COUNT; i += 4)
+        pTestVoxels[0][i].pBLOCK_DEFINITION = block_defs_getAll()[BLOCK_ID_AIR];
+    chunk.meshLod = 1;
+    if (result && test_mesh_faceCount(&chunk, ppNeighbors) != 0)
+        result = false;
+
+    chunkSolidityGrid_destroy(chunk.pTransparencyGrid);
+    return result;
+}
+
+static bool test_chunkMesher_textureLayers(void)
+{
+    Chunk_t chunk;
+    if (!test_chunk_fill(&chunk, pTestVoxels[0], VEC3I_ZERO, true))
+        return false;
+
+    Chunk_t *ppNeighbors[CMATH_GEOM_CUBE_FACES] = {0};
+    const BlockDefinition_t *pSTONE = block_defs_getAll()[BLOCK_ID_STONE];
+    bool result = true;
+
+    // Every face samples its own layer with UVs local to it, repeating once per block at lower LODs
+    for (uint8_t lod = 0; result && lod < CHUNK_MESH_LOD_COUNT; lod++)
+    {
+        chunk.meshLod = lod;
+        const float SCALE = (float)(1 << lod);
+
+        ChunkMesh_t mesh = {0};
+        if (!chunkMesher_input_create(&testInput, &chunk, ppNeighbors) || !chunkMesher_mesh(&testInput, &mesh))
+            result = false;
+
+        for (uint32_t i = 0; result && i < mesh.vertexCount; i++)
+        {
+            const ShaderVertexVoxel_t VERTEX = mesh.pVertices[i];
+            if (VERTEX.textureLayer != (uint32_t)pSTONE->pFACE_TEXTURES[VERTEX.faceID].atlasIndex ||
+                (VERTEX.texCoord.x != 0.0F && VERTEX.texCoord.x != SCALE) ||
+                (VERTEX.texCoord.y != 0.0F && VERTEX.texCoord.y != SCALE))
+                result = false;
+        }
+
+        chunkMesher_mesh_destroy(&mesh);
+    }
+
+    chunkSolidityGrid_destroy(chunk.pTransparencyGrid);
+    return result;
+}
+
+static bool test_chunkMesher_borderCulledByLoad(void)
+{
+    Chunk_t loaded;
+    Chunk_t neighbor;
+    if (!test_chunk_fill(&loaded, pTestVoxels[0], VEC3I_ZERO, false))
+        return false;
+    if (!test_chunk_fill(&neighbor, pTestVoxels[1], (Vec3i_t){1, 0, 0}, false))
+    {
+        chunkSolidityGrid_destroy(loaded.pTransparencyGrid);
+        return false;
+    }
+
+    const BlockDefinition_t *pSTONE = block_defs_getAll()[BLOCK_ID_STONE];
+    bool result = true;
+
+    // A transparent but present border block reads the same as the unloaded halo did
+    pTestVoxels[0][xyz_to_chunkBlockIndex(15, 3, 7)].pBLOCK_DEFINITION = pSTONE;
+    pTestVoxels[1][xyz_to_chunkBlockIndex(0, 3, 7)].pBLOCK_DEFINITION = pSTONE;
+    if (chunkMesher_border_culledByLoad(&loaded, &neighbor, CUBE_FACE_RIGHT))
+        result = false;
+
+    // Solid on the +X border but nothing present across it
+    loaded.pTransparencyGrid->pGrid[chunkSolidityGrid_index16(15, 3, 7)] = SOLIDITY_SOLID;
+    pTestVoxels[1][xyz_to_chunkBlockIndex(0, 3, 7)].pBLOCK_DEFINITION = block_defs_getAll()[BLOCK_ID_AIR];
+    pTestVoxels[1][xyz_to_chunkBlockIndex(0, 3, 8)].pBLOCK_DEFINITION = pSTONE;
+    if (chunkMesher_border_culledByLoad(&loaded, &neighbor, CUBE_FACE_RIGHT))
+        result = false;
+
+    // The touching neighbor block only has to be present, its own opacity doesn't matter
+    pTestVoxels[1][xyz_to_chunkBlockIndex(0, 3, 7)].pBLOCK_DEFINITION = pSTONE;
+    if (!chunkMesher_border_culledByLoad(&loaded, &neighbor, CUBE_FACE_RIGHT))
+        result = false;
+    // Other sides are unaffected
+    if (chunkMesher_border_culledByLoad(&loaded, &neighbor, CUBE_FACE_LEFT))
+        result = false;
+
+    chunkSolidityGrid_destroy(loaded.pTransparencyGrid);
+    chunkSolidityGrid_destroy(neighbor.pTransparencyGrid);
+    return result;
+}
+
+int chunkMesher_tests_run(void)
+{
+    fails += ut_assert(test_chunkMesher_unloadedNeighbors() == true,
+                       "ChunkMesher unloaded neighbors leave borders visible");
+    fails += ut_assert(test_chunkMesher_haloFromNeighbors() == true,
+                       "ChunkMesher halo culls faces against loaded neighbors");
+    fails += ut_assert(test_chunkMesher_emptyChunk() == true,
+                       "ChunkMesher empty chunk yields empty mesh");
+    fails += ut_assert(test_chunkMesher_invalidArgs() == true,
+                       "ChunkMesher invalid args handling");
+    fails += ut_assert(test_chunkMesher_directionSections() == true,
+                       "ChunkMesher groups faces into direction sections");
+    fails += ut_assert(test_chunkMesher_lod() == true,
+                       "ChunkMesher reduced LOD super voxels");
+    fails += ut_assert(test_chunkMesher_textureLayers() == true,
+                       "ChunkMesher writes texture layers and local UVs");
+    fails += ut_assert(test_chunkMesher_borderCulledByLoad() == true,
+                       "ChunkMesher border faces culled by a loaded neighbor");
+
+    return fails;
+}
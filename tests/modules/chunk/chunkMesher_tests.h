@@ -0,0 +1,3 @@
+#pragma once
+
+int chunkMesher_tests_run(void);
@@ -0,0 +1,248 @@
+#include "../../unit_tests.h"
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cmath/cmath.h"
+#include "chunk/chunk.h"
+#include "world/chunkGenerator.h"
+#include "world/chunkSolidityGrid.h"
+#include "world/chunkVisibility.h"
+#include "cmath/weightedMaps.h"
+#include "core/randomNoise.h"
+#include "rendering/chunk/chunkOcclusion.h"
+
+static int fails = 0;
+
+#define AXIS CMATH_CHUNK_AXIS_LENGTH
+
+static void test_grid_set(ChunkSolidityGrid_t *pGrid, const int X, const int Y, const int Z, const uint8_t SOLIDITY)
+{
+    pGrid->pGrid[chunkSolidityGrid_index16((uint8_t)X, (uint8_t)Y, (uint8_t)Z)] = SOLIDITY;
+}
+
+static bool test_chunkVisibility_airAndSolid(void)
+{
+    ChunkSolidityGrid_t *pGrid = chunkSolidityGrid_init(SOLIDITY_AIR);
+    if (!pGrid)
+        return false;
+
+    const uint64_t AIR = chunkVisibility_faces_build(pGrid);
+    chunkSolidityGrid_fill(pGrid, SOLIDITY_SOLID);
+    const uint64_t SOLID = chunkVisibility_faces_build(pGrid);
+    chunkSolidityGrid_destroy(pGrid);
+
+    return AIR == CHUNK_VISIBILITY_ALL && SOLID == 0 && chunkVisibility_faces_build(NULL) == CHUNK_VISIBILITY_ALL;
+}
+
+static bool test_chunkVisibility_wallAndTunnel(void)
+{
+    ChunkSolidityGrid_t *pGrid = chunkSolidityGrid_init(SOLIDITY_AIR);
+    if (!pGrid)
+        return false;
+
+    // A solid wall across X splits the chunk into a left and a right pocket
+    for (int y = 0; y < AXIS; y++)
+        for (int z = 0; z < AXIS; z++)
+            test_grid_set(pGrid, 8, y, z, SOLIDITY_SOLID);
+
+    const uint64_t WALL = chunkVisibility_faces_build(pGrid);
+    bool result = !chunkVisibility_faces_connected(WALL, CUBE_FACE_LEFT, CUBE_FACE_RIGHT) &&
+                  !chunkVisibility_faces_connected(WALL, CUBE_FACE_RIGHT, CUBE_FACE_LEFT) &&
+                  chunkVisibility_faces_connected(WALL, CUBE_FACE_LEFT, CUBE_FACE_TOP) &&
+                  chunkVisibility_faces_connected(WALL, CUBE_FACE_RIGHT, CUBE_FACE_BACK) &&
+                  chunkVisibility_faces_connected(WALL, CUBE_FACE_TOP, CUBE_FACE_BOTTOM);
+
+    // A single block wide tunnel along Z through otherwise solid stone
+    chunkSolidityGrid_fill(pGrid, SOLIDITY_SOLID);
+    for (int z = 0; z < AXIS; z++)
+        test_grid_set(pGrid, 5, 5, z, SOLIDITY_AIR);
+
+    const uint64_t TUNNEL = chunkVisibility_faces_build(pGrid);
+    const uint64_t EXPECTED = chunkVisibility_faces_join(0, (uint8_t)((1U << CUBE_FACE_FRONT) | (1U << CUBE_FACE_BACK)));
+    result = result && TUNNEL == EXPECTED;
+
+    chunkSolidityGrid_destroy(pGrid);
+    return result;
+}
+
+/// @brief Reference connectivity, flooding from each face on its own instead of once per pocket
+static uint64_t test_chunkVisibility_bruteForce(const ChunkSolidityGrid_t *pGRID)
+{
+    static uint16_t pStack[CMATH_CHUNK_BLOCK_CAPACITY];
+    static uint8_t pVisited[CMATH_CHUNK_BLOCK_CAPACITY];
+    uint64_t connectivity = 0;
+
+    for (int from = 0; from < CMATH_GEOM_CUBE_FACES; from++)
+    {
+        memset(pVisited, 0, sizeof(pVisited));
+        uint32_t stackSize = 0;
+
+        for (uint8_t u = 0; u < AXIS; u++)
+            for (uint8_t v = 0; v < AXIS; v++)
+            {
+                const Vec3u8_t POS = cmath_chunk_faceBorderPos((CubeFace_e)from, u, v);
+                const uint16_t INDEX = (uint16_t)(POS.x + POS.y * AXIS + POS.z * AXIS * AXIS);
+                if (pGRID->pGrid[chunkSolidityGrid_index16(POS.x, POS.y, POS.z)] == SOLIDITY_SOLID || pVisited[INDEX])
+                    continue;
+                pVisited[INDEX] = 1;
+                pStack[stackSize++] = INDEX;
+            }
+
+        uint8_t faces = 0;
+        while (stackSize > 0)
+        {
+            const uint16_t INDEX = pStack[--stackSize];
+            const int POS[3] = {INDEX % AXIS, (INDEX / AXIS) % AXIS, INDEX / (AXIS * AXIS)};
+            faces |= (uint8_t)((POS[0] == 0) << CUBE_FACE_LEFT | (POS[0] == AXIS - 1) << CUBE_FACE_RIGHT |
+                               (POS[1] == AXIS - 1) << CUBE_FACE_TOP | (POS[1] == 0) << CUBE_FACE_BOTTOM |
+                               (POS[2] == AXIS - 1) << CUBE_FACE_FRONT | (POS[2] == 0) << CUBE_FACE_BACK);
+
+            for (int axis = 0; axis < 3; axis++)
+                for (int sign = -1; sign <= 1; sign += 2)
+                {
+                    int next[3] = {POS[0], POS[1], POS[2]};
+                    next[axis] += sign;
+                    if (next[axis] < 0 || next[axis] >= AXIS)
+                        continue;
+
+                    const uint16_t NEXT = (uint16_t)(next[0] + next[1] * AXIS + next[2] * AXIS * AXIS);
+                    if (pVisited[NEXT] ||
+                        pGRID->pGrid[chunkSolidityGrid_index16((uint8_t)next[0], (uint8_t)next[1], (uint8_t)next[2])] ==
+                            SOLIDITY_SOLID)
+                        continue;
+                    pVisited[NEXT] = 1;
+                    pStack[stackSize++] = NEXT;
+                }
+        }
+
+        for (int to = 0; to < CMATH_GEOM_CUBE_FACES; to++)
+        {
+            if (faces & (1U << to))
+                connectivity |= chunkVisibility_bit((CubeFace_e)from, (CubeFace_e)to);
+        }
+    }
+
+    return connectivity;
+}
+
+/// @brief Walls of closed cells cut the search off, and an all open grid is reached everywhere
+static bool test_chunkOcclusion_gridSearch(void)
+{
+    const Vec3i_t SIZE = {5, 5, 5};
+    const uint32_t CELL_COUNT = 5 * 5 * 5;
+    uint64_t pConnectivity[5 * 5 * 5];
+    uint8_t pEntered[5 * 5 * 5];
+    ChunkOcclusionStep_t pQueue[5 * 5 * 5 * CMATH_GEOM_CUBE_FACES + 1];
+
+    for (uint32_t i = 0; i < CELL_COUNT; i++)
+        pConnectivity[i] = CHUNK_VISIBILITY_ALL;
+
+    const Vec3i_t START = {1, 2, 2};
+    if (chunkOcclusion_grid_search(pConnectivity, SIZE, START, pEntered, pQueue) != CELL_COUNT)
+        return false;
+
+    // Closed cells at x == 3 still get seen, but nothing past them does
+    for (int z = 0; z < SIZE.z; z++)
+        for (int y = 0; y < SIZE.y; y++)
+            pConnectivity[3 + y * SIZE.x + z * SIZE.x * SIZE.y] = 0;
+
+    if (chunkOcclusion_grid_search(pConnectivity, SIZE, START, pEntered, pQueue) != 4 * 25)
+        return false;
+
+    for (int z = 0; z < SIZE.z; z++)
+        for (int y = 0; y < SIZE.y; y++)
+        {
+            if (pEntered[4 + y * SIZE.x + z * SIZE.x * SIZE.y] != 0)
+                return false;
+        }
+
+    // The camera's own chunk sees out of every face even when closed
+    pConnectivity[1 + 2 * SIZE.x + 2 * SIZE.x * SIZE.y] = 0;
+    return chunkOcclusion_grid_search(pConnectivity, SIZE, START, pEntered, pQueue) == 4 * 25 &&
+           chunkOcclusion_grid_search(pConnectivity, SIZE, (Vec3i_t){9, 0, 0}, pEntered, pQueue) == 0;
+}
+
+/// @brief Runs the flood fill over real generated terrain and checks it against the brute force reference, then searches the
+/// generated block of chunks from its middle
+static bool test_chunkVisibility_generatedTerrain(void)
+{
+    const Vec3i_t SIZE = {5, 3, 5};
+    const uint32_t CELL_COUNT = (uint32_t)(SIZE.x * SIZE.y * SIZE.z);
+    const Vec3i_t MIN = {-2, -1, -2};
+
+    randomNoise_init(1337U);
+    const bool OWNS_MAPS = weightedMaps_get() == NULL;
+    if (OWNS_MAPS)
+        weightedMaps_instantiate();
+
+    const BlockDefinition_t *const *pBLOCK_DEFINITIONS = block_defs_getAll();
+    uint64_t *pConnectivity = malloc(sizeof(uint64_t) * CELL_COUNT);
+    uint8_t *pEntered = malloc(CELL_COUNT);
+    ChunkOcclusionStep_t *pQueue = malloc(sizeof(ChunkOcclusionStep_t) * (CELL_COUNT * CMATH_GEOM_CUBE_FACES + 1));
+
+    bool result = pConnectivity && pEntered && pQueue;
+    for (uint32_t i = 0; i < CELL_COUNT && result; i++)
+    {
+        const Vec3i_t POS = {MIN.x + (int)(i % (uint32_t)SIZE.x), MIN.y + (int)((i / (uint32_t)SIZE.x) % (uint32_t)SIZE.y),
+                             MIN.z + (int)(i / (uint32_t)(SIZE.x * SIZE.y))};
+        Chunk_t *pChunk = chunk_world_create(POS);
+        if (!pChunk || !chunkGen_genChunk(weightedMaps_get(), pBLOCK_DEFINITIONS, pChunk) || !pChunk->pTransparencyGrid)
+            result = false;
+
+        if (result)
+        {
+            const uint64_t CONNECTIVITY = pChunk->faceConnectivity;
+            result = CONNECTIVITY == chunkVisibility_faces_build(pChunk->pTransparencyGrid) &&
+                     CONNECTIVITY == test_chunkVisibility_bruteForce(pChunk->pTransparencyGrid);
+
+            // Seeing B from A means seeing A from B
+            for (int a = 0; a < CMATH_GEOM_CUBE_FACES && result; a++)
+                for (int b = 0; b < CMATH_GEOM_CUBE_FACES; b++)
+                {
+                    if (chunkVisibility_faces_connected(CONNECTIVITY, (CubeFace_e)a, (CubeFace_e)b) !=
+                        chunkVisibility_faces_connected(CONNECTIVITY, (CubeFace_e)b, (CubeFace_e)a))
+                        result = false;
+                }
+
+            pConnectivity[i] = CONNECTIVITY;
+        }
+
+        if (pChunk)
+        {
+            chunk_world_destroy(pChunk);
+            free(pChunk);
+        }
+    }
+
+    if (result)
+    {
+        // Every neighbor of the camera's chunk is always reached, and closed chunks can only take away from an open grid
+        const Vec3i_t START = {SIZE.x / 2, SIZE.y / 2, SIZE.z / 2};
+        const uint32_t REACHED = chunkOcclusion_grid_search(pConnectivity, SIZE, START, pEntered, pQueue);
+        const uint32_t START_CELL = (uint32_t)(START.x + START.y * SIZE.x + START.z * SIZE.x * SIZE.y);
+        const int32_t pSTRIDES[CMATH_GEOM_CUBE_FACES] = {-1, 1, SIZE.x, -SIZE.x, SIZE.x * SIZE.y, -SIZE.x * SIZE.y};
+
+        result = REACHED >= 1 + CMATH_GEOM_CUBE_FACES && REACHED <= CELL_COUNT;
+        for (int face = 0; face < CMATH_GEOM_CUBE_FACES && result; face++)
+            result = pEntered[(int32_t)START_CELL + pSTRIDES[face]] != 0;
+    }
+
+    free(pConnectivity);
+    free(pEntered);
+    free(pQueue);
+    if (OWNS_MAPS)
+        weightedMaps_destroy();
+    return result;
+}
+
+int chunkVisibility_tests_run(void)
+{
+    fails += ut_assert(test_chunkVisibility_airAndSolid() == true, "Chunk visibility of all air and all solid chunks");
+    fails += ut_assert(test_chunkVisibility_wallAndTunnel() == true, "Chunk visibility splits faces around walls and tunnels");
+    fails += ut_assert(test_chunkOcclusion_gridSearch() == true, "Chunk occlusion search stops at closed chunks");
+    fails += ut_assert(test_chunkVisibility_generatedTerrain() == true, "Chunk visibility matches brute force on generated terrain");
+
+    return fails;
+}
+
+#undef AXIS
@@ -0,0 +1,3 @@
+#pragma once
+
+int chunkVisibility_tests_run(void);
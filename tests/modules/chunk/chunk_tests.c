@@ -2,6 +2,7 @@
 #include <stdbool.h>
 #include "cmath/cmath.h"
 #include "chunk/chunk.h"
+#include "world/chunkVisibility.h"
 
 static int fails = 0;
 
@@ -30,6 +31,9 @@ static bool test_chunk_world_create_basic(void)
         return false;
     if (pChunk->pEntitiesLoadingChunkLL != NULL)
         return false;
+    // Nothing known yet, so nothing can be hidden behind it
+    if (pChunk->faceConnectivity != CHUNK_VISIBILITY_ALL)
+        return false;
 
     // Cleanup via chunk_destroy (normal path)
     int dummyCtx = 0;
@@ -0,0 +1,159 @@
+#include "../../unit_tests.h"
+#include <stdbool.h>
+#include "collection/buddyTree_t.h"
+
+static int fails = 0;
+
+static bool test_buddyTree_create(void)
+{
+    if (buddyTree_create(BUDDY_TREE_MAX_LEVELS + 1) != NULL)
+        return false;
+
+    BuddyTree_t *pTree = buddyTree_create(4);
+    if (!pTree)
+        return false;
+
+    const bool RESULT = pTree->nodeCount == 31 && buddyTree_largestFreeOrder(pTree) == 4 && buddyTree_isEmpty(pTree);
+    buddyTree_destroy(pTree);
+
+    return RESULT;
+}
+
+static bool test_buddyTree_alloc_alignedAndDisjoint(void)
+{
+    BuddyTree_t *pTree = buddyTree_create(4);
+    if (!pTree)
+        return false;
+
+    bool result = true;
+    const size_t A = buddyTree_alloc(pTree, 0);
+    const size_t B = buddyTree_alloc(pTree, 2);
+    const size_t C = buddyTree_alloc(pTree, 1);
+
+    // Every node starts at a multiple of its own size
+    if (A == BUDDY_TREE_INVALID || B == BUDDY_TREE_INVALID || C == BUDDY_TREE_INVALID)
+        result = false;
+    else if (B % 4 != 0 || C % 2 != 0)
+        result = false;
+    // [A, A + 1), [B, B + 4), [C, C + 2) must not overlap
+    else if ((A >= B && A < B + 4) || (A >= C && A < C + 2) || (C < B + 4 && B < C + 2))
+        result = false;
+
+    buddyTree_destroy(pTree);
+    return result;
+}
+
+static bool test_buddyTree_exhaust(void)
+{
+    BuddyTree_t *pTree = buddyTree_create(3);
+    if (!pTree)
+        return false;
+
+    bool result = true;
+    for (int i = 0; i < 8; i++)
+    {
+        if (buddyTree_alloc(pTree, 0) == BUDDY_TREE_INVALID)
+            result = false;
+    }
+
+    if (buddyTree_alloc(pTree, 0) != BUDDY_TREE_INVALID || buddyTree_largestFreeOrder(pTree) != -1)
+        result = false;
+
+    // Too big for the tree
+    if (buddyTree_alloc(pTree, 4) != BUDDY_TREE_INVALID)
+        result = false;
+
+    buddyTree_destroy(pTree);
+    return result;
+}
+
+static bool test_buddyTree_free_merges(void)
+{
+    BuddyTree_t *pTree = buddyTree_create(3);
+    if (!pTree)
+        return false;
+
+    bool result = true;
+    size_t pOffsets[8];
+    for (int i = 0; i < 8; i++)
+        pOffsets[i] = buddyTree_alloc(pTree, 0);
+
+    // Free every other unit. Nothing can merge, so no node bigger than one unit is free
+    for (int i = 0; i < 8; i += 2)
+        result &= buddyTree_free(pTree, pOffsets[i], 0);
+    if (buddyTree_largestFreeOrder(pTree) != 0)
+        result = false;
+
+    for (int i = 1; i < 8; i += 2)
+        result &= buddyTree_free(pTree, pOffsets[i], 0);
+    if (!buddyTree_isEmpty(pTree))
+        result = false;
+
+    // Whole range is available again
+    if (buddyTree_alloc(pTree, 3) != 0)
+        result = false;
+
+    buddyTree_destroy(pTree);
+    return result;
+}
+
+static bool test_buddyTree_free_invalid(void)
+{
+    BuddyTree_t *pTree = buddyTree_create(3);
+    if (!pTree)
+        return false;
+
+    bool result = true;
+    const size_t OFFSET = buddyTree_alloc(pTree, 1);
+
+    // Misaligned, wrong order, and a double free
+    if (buddyTree_free(pTree, OFFSET + 1, 1))
+        result = false;
+    if (buddyTree_free(pTree, 4, 1))
+        result = false;
+    if (!buddyTree_free(pTree, OFFSET, 1))
+        result = false;
+    if (buddyTree_free(pTree, OFFSET, 1))
+        result = false;
+    if (buddyTree_free(NULL, 0, 0))
+        result = false;
+
+    buddyTree_destroy(pTree);
+
+    // Two live units fill their order 1 parent, which must not be freeable as if it had been allocated whole
+    pTree = buddyTree_create(2);
+    if (!pTree)
+        return false;
+
+    if (buddyTree_alloc(pTree, 0) != 0 || buddyTree_alloc(pTree, 0) != 1)
+        result = false;
+    if (buddyTree_free(pTree, 0, 1))
+        result = false;
+    // So the next order 1 block can't overlap them
+    if (buddyTree_alloc(pTree, 1) != 2)
+        result = false;
+    // Nor can a unit be freed out of a block allocated whole
+    if (buddyTree_free(pTree, 2, 0))
+        result = false;
+
+    buddyTree_destroy(pTree);
+    return result;
+}
+
+static bool test_buddyTree_order_forUnits(void)
+{
+    return buddyTree_order_forUnits(0) == 0 && buddyTree_order_forUnits(1) == 0 && buddyTree_order_forUnits(2) == 1 &&
+           buddyTree_order_forUnits(3) == 2 && buddyTree_order_forUnits(1024) == 10 && buddyTree_order_forUnits(1025) == 11;
+}
+
+int buddyTree_tests_run(void)
+{
+    fails += ut_assert(test_buddyTree_create() == true, "BuddyTree create and level clamp");
+    fails += ut_assert(test_buddyTree_alloc_alignedAndDisjoint() == true, "BuddyTree allocations are aligned and disjoint");
+    fails += ut_assert(test_buddyTree_exhaust() == true, "BuddyTree exhaustion");
+    fails += ut_assert(test_buddyTree_free_merges() == true, "BuddyTree free merges buddies");
+    fails += ut_assert(test_buddyTree_free_invalid() == true, "BuddyTree rejects invalid frees");
+    fails += ut_assert(test_buddyTree_order_forUnits() == true, "BuddyTree order for units");
+
+    return fails;
+}
@@ -0,0 +1,3 @@
+#pragma once
+
+int buddyTree_tests_run(void);
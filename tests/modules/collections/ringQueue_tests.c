@@ -0,0 +1,134 @@
+#include "../../unit_tests.h"
+#include <stdbool.h>
+#include "collection/ringQueue_t.h"
+
+static int fails = 0;
+
+static bool test_ringQueue_create_and_clamp(void)
+{
+    RingQueue_t *pQueue0 = ringQueue_create(0);
+    if (!pQueue0 || !pQueue0->ppCollection)
+        return false;
+    if (pQueue0->capacity != 1 || pQueue0->count != 0)
+        return false;
+    ringQueue_destroy(pQueue0);
+
+    RingQueue_t *pQueueMax = ringQueue_create(RING_QUEUE_MAX_CAPACITY + 1000);
+    if (!pQueueMax)
+        return false;
+    if (pQueueMax->capacity != RING_QUEUE_MAX_CAPACITY)
+        return false;
+    ringQueue_destroy(pQueueMax);
+
+    return true;
+}
+
+static bool test_ringQueue_fifo_order(void)
+{
+    RingQueue_t *pQueue = ringQueue_create(4);
+    if (!pQueue)
+        return false;
+
+    int a = 1, b = 2, c = 3;
+
+    if (!ringQueue_pushBack(pQueue, &a) || !ringQueue_pushBack(pQueue, &b) || !ringQueue_pushBack(pQueue, &c))
+        return false;
+
+    // FIFO order: a, b, c
+    if (ringQueue_popFront(pQueue) != &a || ringQueue_popFront(pQueue) != &b || ringQueue_popFront(pQueue) != &c)
+        return false;
+
+    // Pop from empty queue -> NULL
+    if (ringQueue_popFront(pQueue) != NULL || pQueue->count != 0)
+        return false;
+
+    ringQueue_destroy(pQueue);
+    return true;
+}
+
+static bool test_ringQueue_pushFront(void)
+{
+    RingQueue_t *pQueue = ringQueue_create(4);
+    if (!pQueue)
+        return false;
+
+    int a = 1, b = 2, c = 3;
+
+    if (!ringQueue_pushBack(pQueue, &b) || !ringQueue_pushBack(pQueue, &c) || !ringQueue_pushFront(pQueue, &a))
+        return false;
+
+    if (ringQueue_popFront(pQueue) != &a || ringQueue_popFront(pQueue) != &b || ringQueue_popFront(pQueue) != &c)
+        return false;
+
+    ringQueue_destroy(pQueue);
+    return true;
+}
+
+static bool test_ringQueue_wrap_and_grow(void)
+{
+    RingQueue_t *pQueue = ringQueue_create(4);
+    if (!pQueue)
+        return false;
+
+    int pValues[10] = {0};
+
+    // Move the head forward so the next pushes wrap around the end of the buffer
+    for (int i = 0; i < 3; i++)
+        if (!ringQueue_pushBack(pQueue, &pValues[0]) || ringQueue_popFront(pQueue) != &pValues[0])
+            return false;
+
+    // Wrapped and then grown past the initial capacity
+    for (int i = 0; i < 10; i++)
+        if (!ringQueue_pushBack(pQueue, &pValues[i]))
+            return false;
+
+    if (pQueue->count != 10 || pQueue->capacity < 10)
+        return false;
+
+    for (int i = 0; i < 10; i++)
+        if (ringQueue_popFront(pQueue) != &pValues[i])
+            return false;
+
+    ringQueue_destroy(pQueue);
+    return true;
+}
+
+static bool test_ringQueue_invalidArgs(void)
+{
+    int a = 1;
+
+    if (ringQueue_pushBack(NULL, &a) != false || ringQueue_pushFront(NULL, &a) != false)
+        return false;
+    if (ringQueue_popFront(NULL) != NULL)
+        return false;
+
+    RingQueue_t *pQueue = ringQueue_create(2);
+    if (!pQueue)
+        return false;
+
+    // NULL data is rejected so NULL can mean empty on pop
+    if (ringQueue_pushBack(pQueue, NULL) != false || pQueue->count != 0)
+        return false;
+
+    // Must not crash
+    ringQueue_destroy(NULL);
+
+    ringQueue_destroy(pQueue);
+    return true;
+}
+
+int ringQueue_tests_run(void)
+{
+    fails += ut_assert(test_ringQueue_create_and_clamp() == true,
+                       "RingQueue create & clamp");
+    fails += ut_assert(test_ringQueue_fifo_order() == true,
+                       "RingQueue push/pop FIFO");
+    fails += ut_assert(test_ringQueue_pushFront() == true,
+                       "RingQueue pushFront");
+    fails += ut_assert(test_ringQueue_wrap_and_grow() == true,
+                       "RingQueue wrap around & grow preserves order");
+    fails += ut_assert(test_ringQueue_invalidArgs() == true,
+                       "RingQueue invalid args handling");
+
+    return fails;
+}
@@ -0,0 +1,3 @@
+#pragma once
+
+int ringQueue_tests_run(void);
@@ -295,6 +295,51 @@ static void test_matrix(void)
     }
 }
 
+static void test_frustum(void)
+{
+    // Eye at the origin looking down -Z with a 90 degree square frustum from 0.1 to 100
+    const Mat4c_t VIEW = cmath_lookAt(VEC3F_ZERO, VEC3F_FORWARD, VEC3F_UP);
+    const Mat4c_t PROJECTION = cmath_perspective(cmath_deg2radF(90.0F), 1.0F, 0.1F, 100.0F);
+    const Frustumf_t FRUSTUM = cmath_frustum_fromViewProjection(cmath_mat_mult_mat(PROJECTION, VIEW));
+
+    bool normalized = true;
+    for (int i = 0; i < CMATH_FRUSTUM_PLANES; i++)
+    {
+        const Vec4f_t P = FRUSTUM.pPlanes[i];
+        normalized &= fabsf(sqrtf(P.x * P.x + P.y * P.y + P.z * P.z) - 1.0F) < EPS_BIG;
+    }
+    fails += ut_assert(normalized, "frustum planes normalized");
+
+    // Near plane faces down -Z and sits 0.1 out, far plane faces back toward the eye 100 out
+    const Vec4f_t NEAR = FRUSTUM.pPlanes[4];
+    const Vec4f_t FAR = FRUSTUM.pPlanes[5];
+    fails += ut_assert(almost_eq(NEAR.z, -1.0F, EPS_BIG) && almost_eq(NEAR.w, -0.1F, EPS_BIG), "frustum near plane");
+    fails += ut_assert(almost_eq(FAR.z, 1.0F, EPS_BIG) && almost_eq(FAR.w, 100.0F, 0.05F), "frustum far plane");
+
+    const Vec3f_t ONE = {1.0F, 1.0F, 1.0F};
+    const Vec3f_t AHEAD = {-0.5F, -0.5F, -10.5F};
+    fails += ut_assert(cmath_frustum_AABB_intersects(&FRUSTUM, AHEAD, cmath_vec3f_add_vec3f(AHEAD, ONE)) == true,
+                       "frustum AABB: box ahead inside");
+
+    const Vec3f_t BEHIND = {-0.5F, -0.5F, 10.0F};
+    fails += ut_assert(cmath_frustum_AABB_intersects(&FRUSTUM, BEHIND, cmath_vec3f_add_vec3f(BEHIND, ONE)) == false,
+                       "frustum AABB: box behind outside");
+
+    const Vec3f_t BEYOND_FAR = {-0.5F, -0.5F, -150.0F};
+    fails += ut_assert(cmath_frustum_AABB_intersects(&FRUSTUM, BEYOND_FAR, cmath_vec3f_add_vec3f(BEYOND_FAR, ONE)) == false,
+                       "frustum AABB: box past far plane outside");
+
+    // 90 degrees wide, so at 10 out the sides are at x = +-10
+    const Vec3f_t OFF_SIDE = {12.0F, -0.5F, -10.5F};
+    fails += ut_assert(cmath_frustum_AABB_intersects(&FRUSTUM, OFF_SIDE, cmath_vec3f_add_vec3f(OFF_SIDE, ONE)) == false,
+                       "frustum AABB: box off to the side outside");
+
+    // Straddles the right plane
+    const Vec3f_t STRADDLE = {9.5F, -0.5F, -10.5F};
+    fails += ut_assert(cmath_frustum_AABB_intersects(&FRUSTUM, STRADDLE, cmath_vec3f_add_vec3f(STRADDLE, ONE)) == true,
+                       "frustum AABB: box straddling a side inside");
+}
+
 static void test_vector(void)
 {
     const int TOLERANCE_I = 0;
@@ -1184,6 +1229,7 @@ int math_tests_run(void)
     test_aabb();
     test_quaternion();
     test_matrix();
+    test_frustum();
     test_vector();
     test_chunk();
     test_algorithms();
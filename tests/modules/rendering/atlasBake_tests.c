@@ -0,0 +1,152 @@
+#include "../../unit_tests.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "core/fileIO.h"
+#include "rendering/atlas_bake.h"
+
+static int fails = 0;
+
+#define TEST_TILE_PX 4
+
+static const uint8_t *test_pixel(const uint8_t *pLAYER, const uint32_t SIDE, const uint32_t X, const uint32_t Y)
+{
+    return pLAYER + ((size_t)Y * SIDE + X) * ATLAS_BAKE_BPP;
+}
+
+static bool test_atlasBake_levelCount(void)
+{
+    // Halves until the side is odd, so power of two tiles reach 1x1
+    return atlasBake_levelCount(16) == 5 &&
+           atlasBake_levelCount(1) == 1 &&
+           atlasBake_levelCount(12) == 3 &&
+           atlasBake_levelCount(0) == 0;
+}
+
+static bool test_atlasBake_layout(void)
+{
+    AtlasBakeLayout_t layout;
+    if (!atlasBake_layout_get(16, 3, 2, &layout) || layout.levelCount != 5 || layout.layerCount != 6)
+        return false;
+
+    size_t expectedOffset = 0;
+    for (uint32_t level = 0; level < layout.levelCount; level++)
+    {
+        // Every level is exactly half the one above, as a Vulkan mip chain must be, and holds all six layers
+        if (layout.pLevelSizes[level] != 16U >> level || layout.pLevelOffsets[level] != expectedOffset)
+            return false;
+        expectedOffset += (size_t)layout.pLevelSizes[level] * layout.pLevelSizes[level] * ATLAS_BAKE_BPP * 6;
+    }
+
+    // No padding, so level 0 is exactly the source
+    return layout.totalSize == expectedOffset && layout.pLevelOffsets[1] == (size_t)3 * 16 * 2 * 16 * ATLAS_BAKE_BPP &&
+           !atlasBake_layout_get(0, 3, 2, &layout) && !atlasBake_layout_get(16, 0, 2, &layout);
+}
+
+static bool test_atlasBake_bake(void)
+{
+    // Two solid tiles side by side with one odd pixel in the first one's first corner
+    const uint32_t SRC_WIDTH = 2 * TEST_TILE_PX;
+    uint8_t pSrc[2 * TEST_TILE_PX * TEST_TILE_PX * ATLAS_BAKE_BPP];
+    for (uint32_t y = 0; y < TEST_TILE_PX; y++)
+        for (uint32_t x = 0; x < SRC_WIDTH; x++)
+        {
+            uint8_t *pPixel = pSrc + ((size_t)y * SRC_WIDTH + x) * ATLAS_BAKE_BPP;
+            const bool LEFT = x < TEST_TILE_PX;
+            pPixel[0] = LEFT ? 255 : 0;
+            pPixel[1] = 0;
+            pPixel[2] = LEFT ? 0 : 255;
+            pPixel[3] = 255;
+        }
+    pSrc[1] = 200;
+
+    AtlasBakeLayout_t layout;
+    if (!atlasBake_layout_get(TEST_TILE_PX, 2, 1, &layout) || layout.levelCount != 3 || layout.layerCount != 2)
+        return false;
+
+    uint8_t *pBaked = calloc(1, layout.totalSize);
+    if (!pBaked)
+        return false;
+
+    atlasBake_bake(pSrc, &layout, pBaked);
+
+    bool passed = true;
+    const size_t LAYER_BYTES = (size_t)TEST_TILE_PX * TEST_TILE_PX * ATLAS_BAKE_BPP;
+    const uint8_t *pLAYER_1 = pBaked + LAYER_BYTES;
+
+    // Each tile lands whole in its own layer
+    passed &= test_pixel(pBaked, TEST_TILE_PX, 0, 0)[1] == 200;
+    passed &= test_pixel(pBaked, TEST_TILE_PX, 1, 0)[1] == 0;
+    passed &= test_pixel(pBaked, TEST_TILE_PX, TEST_TILE_PX - 1, TEST_TILE_PX - 1)[0] == 255;
+    passed &= test_pixel(pLAYER_1, TEST_TILE_PX, 0, 0)[2] == 255;
+    passed &= test_pixel(pLAYER_1, TEST_TILE_PX, 0, 0)[0] == 0;
+
+    // Every level of the second layer is still solid blue, down to 1x1
+    for (uint32_t level = 1; level < layout.levelCount; level++)
+    {
+        const uint32_t SIDE = layout.pLevelSizes[level];
+        const uint8_t *pLAYER = pBaked + layout.pLevelOffsets[level] + (size_t)SIDE * SIDE * ATLAS_BAKE_BPP;
+        for (uint32_t y = 0; y < SIDE; y++)
+            for (uint32_t x = 0; x < SIDE; x++)
+            {
+                const uint8_t *pPIXEL = test_pixel(pLAYER, SIDE, x, y);
+                passed &= pPIXEL[0] == 0 && pPIXEL[1] == 0 && pPIXEL[2] == 255 && pPIXEL[3] == 255;
+            }
+    }
+
+    // The odd pixel is averaged in linear space, which comes out brighter than the plain sRGB average of 50
+    const uint8_t *pCORNER = pBaked + layout.pLevelOffsets[1];
+    passed &= pCORNER[0] == 255 && pCORNER[1] > 50 && pCORNER[2] == 0;
+
+    free(pBaked);
+    return passed;
+}
+
+static bool test_atlasBake_header(void)
+{
+    AtlasBakeLayout_t layout;
+    if (!atlasBake_layout_get(16, 4, 4, &layout))
+        return false;
+
+    const uint8_t pPNG[] = {0x89, 'P', 'N', 'G', 1, 2, 3};
+    const uint64_t HASH = fileIO_hash(pPNG, sizeof(pPNG), FILE_IO_HASH_SEED);
+    const AtlasBakeHeader_t HEADER = {
+        .magic = 0x54415856U,
+        .version = 2,
+        .sourceHash = HASH,
+        .tilePx = 16,
+        .tilesX = 4,
+        .tilesY = 4,
+        .levelCount = layout.levelCount,
+        .dataSize = layout.totalSize,
+    };
+
+    AtlasBakeHeader_t wrongMagic = HEADER;
+    wrongMagic.magic = 0;
+    AtlasBakeHeader_t oldVersion = HEADER;
+    oldVersion.version = 1;
+
+    // Any change to the source, the tile size or the bake itself must miss the cache
+    return atlasBake_header_valid(&HEADER, HASH, 16) &&
+           !atlasBake_header_valid(&HEADER, HASH ^ 1, 16) &&
+           !atlasBake_header_valid(&HEADER, HASH, 32) &&
+           !atlasBake_header_valid(&wrongMagic, HASH, 16) &&
+           !atlasBake_header_valid(&oldVersion, HASH, 16) &&
+           !atlasBake_header_valid(NULL, HASH, 16) &&
+           fileIO_hash(pPNG, sizeof(pPNG), FILE_IO_HASH_SEED) != fileIO_hash(pPNG, sizeof(pPNG) - 1, FILE_IO_HASH_SEED);
+}
+
+int atlasBake_tests_run(void)
+{
+    fails += ut_assert(test_atlasBake_levelCount() == true,
+                       "AtlasBake level count halves the tile until it is odd");
+    fails += ut_assert(test_atlasBake_layout() == true,
+                       "AtlasBake layout packs every layer of every level tightly");
+    fails += ut_assert(test_atlasBake_bake() == true,
+                       "AtlasBake splits tiles into layers and mips them");
+    fails += ut_assert(test_atlasBake_header() == true,
+                       "AtlasBake cache header checks source, tile size and version");
+
+    return fails;
+}
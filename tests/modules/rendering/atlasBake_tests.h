@@ -0,0 +1,3 @@
+#pragma once
+
+int atlasBake_tests_run(void);
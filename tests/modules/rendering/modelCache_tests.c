@@ -0,0 +1,261 @@
+#include "../../unit_tests.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "core/fileIO.h"
+#include "rendering/model_cache.h"
+
+static int fails = 0;
+
+// Quads per side of the test grid
+#define TEST_GRID 32
+#define TEST_GRID_VERTICES ((TEST_GRID + 1) * (TEST_GRID + 1))
+#define TEST_GRID_INDICES (TEST_GRID * TEST_GRID * 6)
+// Smaller than the optimizer's own cache, as real GPUs can be
+#define TEST_FIFO_SIZE 16
+
+static void test_grid_fill(uint32_t *pIndices)
+{
+    uint32_t cursor = 0;
+    for (uint32_t y = 0; y < TEST_GRID; y++)
+        for (uint32_t x = 0; x < TEST_GRID; x++)
+        {
+            const uint32_t V = y * (TEST_GRID + 1) + x;
+            const uint32_t pQUAD[6] = {V, V + TEST_GRID + 1, V + 1, V + 1, V + TEST_GRID + 1, V + TEST_GRID + 2};
+            memcpy(&pIndices[cursor], pQUAD, sizeof(pQUAD));
+            cursor += 6;
+        }
+
+    // Shuffle whole triangles so the input has no locality left to start from
+    uint32_t seed = 12345U;
+    for (uint32_t t = TEST_GRID_INDICES / 3 - 1; t > 0; t--)
+    {
+        seed = seed * 1664525U + 1013904223U;
+        const uint32_t OTHER = (seed >> 8) % (t + 1);
+        uint32_t pTemp[3];
+        memcpy(pTemp, &pIndices[t * 3], sizeof(pTemp));
+        memcpy(&pIndices[t * 3], &pIndices[OTHER * 3], sizeof(pTemp));
+        memcpy(&pIndices[OTHER * 3], pTemp, sizeof(pTemp));
+    }
+}
+
+/// @brief Average vertex shader invocations per triangle through a FIFO post-transform cache
+static float test_acmr(const uint32_t *pINDICES, const uint32_t INDEX_COUNT)
+{
+    uint32_t pFifo[TEST_FIFO_SIZE];
+    uint32_t fifoCount = 0, fifoHead = 0, misses = 0;
+    for (uint32_t i = 0; i < INDEX_COUNT; i++)
+    {
+        bool hit = false;
+        for (uint32_t f = 0; f < fifoCount; f++)
+            hit |= pFifo[f] == pINDICES[i];
+        if (hit)
+            continue;
+
+        misses++;
+        pFifo[fifoHead] = pINDICES[i];
+        fifoHead = (fifoHead + 1) % TEST_FIFO_SIZE;
+        if (fifoCount < TEST_FIFO_SIZE)
+            fifoCount++;
+    }
+
+    return (float)misses / (float)(INDEX_COUNT / 3);
+}
+
+/// @brief Rotates the triangle so its smallest index leads, which keeps the winding
+static uint64_t test_triangle_key(const uint32_t *pTRIANGLE)
+{
+    uint32_t first = 0;
+    for (uint32_t c = 1; c < 3; c++)
+        if (pTRIANGLE[c] < pTRIANGLE[first])
+            first = c;
+
+    return (uint64_t)pTRIANGLE[first] << 40 | (uint64_t)pTRIANGLE[(first + 1) % 3] << 20 | pTRIANGLE[(first + 2) % 3];
+}
+
+static int test_key_compare(const void *pA, const void *pB)
+{
+    const uint64_t A = *(const uint64_t *)pA;
+    const uint64_t B = *(const uint64_t *)pB;
+    return (A > B) - (A < B);
+}
+
+static bool test_triangles_same(const uint32_t *pA, const uint32_t *pB, const uint32_t INDEX_COUNT)
+{
+    const uint32_t TRIANGLE_COUNT = INDEX_COUNT / 3;
+    uint64_t *pKeysA = malloc(sizeof(uint64_t) * TRIANGLE_COUNT);
+    uint64_t *pKeysB = malloc(sizeof(uint64_t) * TRIANGLE_COUNT);
+    bool same = pKeysA && pKeysB;
+    if (same)
+    {
+        for (uint32_t t = 0; t < TRIANGLE_COUNT; t++)
+        {
+            pKeysA[t] = test_triangle_key(&pA[t * 3]);
+            pKeysB[t] = test_triangle_key(&pB[t * 3]);
+        }
+        qsort(pKeysA, TRIANGLE_COUNT, sizeof(uint64_t), test_key_compare);
+        qsort(pKeysB, TRIANGLE_COUNT, sizeof(uint64_t), test_key_compare);
+        same = memcmp(pKeysA, pKeysB, sizeof(uint64_t) * TRIANGLE_COUNT) == 0;
+    }
+
+    free(pKeysA);
+    free(pKeysB);
+    return same;
+}
+
+static bool test_modelCache_layout(void)
+{
+    ModelCacheLayout_t small, large;
+    if (!modelCache_layout_get(100, 301, 3, 5, &small) || !modelCache_layout_get(70000, 300, 3, 5, &large))
+        return false;
+
+    // An odd number of 16 bit indices leaves the texture needing padding to stay texel aligned
+    return small.indexSize == sizeof(uint16_t) &&
+           small.indexOffset == 100 * sizeof(ShaderVertexModel_t) &&
+           small.textureOffset % MODEL_CACHE_TEXTURE_BPP == 0 &&
+           small.textureOffset >= small.indexOffset + 301 * sizeof(uint16_t) &&
+           small.totalSize == small.textureOffset + 3 * 5 * MODEL_CACHE_TEXTURE_BPP &&
+           large.indexSize == sizeof(uint32_t) &&
+           !modelCache_layout_get(0, 3, 1, 1, &small) &&
+           !modelCache_layout_get(3, 3, 0, 1, &small) &&
+           !modelCache_layout_get(3, 3, 1, 1, NULL);
+}
+
+static bool test_modelCache_optimize(void)
+{
+    uint32_t *pIndices = malloc(sizeof(uint32_t) * TEST_GRID_INDICES);
+    uint32_t *pOriginal = malloc(sizeof(uint32_t) * TEST_GRID_INDICES);
+    bool passed = pIndices && pOriginal;
+    if (passed)
+    {
+        test_grid_fill(pIndices);
+        memcpy(pOriginal, pIndices, sizeof(uint32_t) * TEST_GRID_INDICES);
+
+        const float BEFORE = test_acmr(pIndices, TEST_GRID_INDICES);
+        passed = modelCache_triangles_optimize(pIndices, TEST_GRID_INDICES, TEST_GRID_VERTICES);
+        const float AFTER = test_acmr(pIndices, TEST_GRID_INDICES);
+
+        // A shuffled grid misses on nearly every vertex. Optimized, each new triangle should mostly cost one
+        passed = passed && test_triangles_same(pOriginal, pIndices, TEST_GRID_INDICES) && BEFORE > 2.0F && AFTER < 1.0F;
+    }
+
+    // Out of range indices are refused and left alone
+    uint32_t pBAD[3] = {0, 1, 5};
+    passed = passed && !modelCache_triangles_optimize(pBAD, 3, 3) && pBAD[2] == 5 &&
+             !modelCache_triangles_optimize(pBAD, 2, 6);
+
+    free(pIndices);
+    free(pOriginal);
+    return passed;
+}
+
+static bool test_modelCache_degenerate(void)
+{
+    // Repeated vertices within a triangle must not confuse the cache
+    uint32_t pIndices[] = {0, 0, 1, 1, 2, 3, 2, 2, 2, 3, 2, 1};
+    uint32_t pOriginal[sizeof(pIndices) / sizeof(pIndices[0])];
+    memcpy(pOriginal, pIndices, sizeof(pIndices));
+
+    return modelCache_triangles_optimize(pIndices, 12, 4) && test_triangles_same(pOriginal, pIndices, 12);
+}
+
+static bool test_modelCache_reorder(void)
+{
+    ShaderVertexModel_t pVertices[5];
+    for (uint32_t v = 0; v < 5; v++)
+        pVertices[v] = (ShaderVertexModel_t){.atlasIndex = v};
+
+    // Vertex 1 is never used
+    uint32_t pIndices[] = {4, 2, 0, 0, 2, 3};
+    const uint32_t COUNT = modelCache_vertices_reorder(pVertices, 5, pIndices, 6);
+
+    const uint32_t pEXPECTED_INDICES[] = {0, 1, 2, 2, 1, 3};
+    return COUNT == 4 &&
+           memcmp(pIndices, pEXPECTED_INDICES, sizeof(pEXPECTED_INDICES)) == 0 &&
+           pVertices[0].atlasIndex == 4 && pVertices[1].atlasIndex == 2 &&
+           pVertices[2].atlasIndex == 0 && pVertices[3].atlasIndex == 3;
+}
+
+static bool test_modelCache_cook(void)
+{
+    ShaderVertexModel_t pVertices[3];
+    for (uint32_t v = 0; v < 3; v++)
+        pVertices[v] = (ShaderVertexModel_t){.atlasIndex = v + 7};
+    const uint32_t pINDICES[3] = {2, 0, 1};
+    const uint8_t pTEXTURE[2 * 1 * MODEL_CACHE_TEXTURE_BPP] = {1, 2, 3, 4, 5, 6, 7, 8};
+
+    ModelCacheLayout_t layout;
+    if (!modelCache_layout_get(3, 3, 2, 1, &layout))
+        return false;
+
+    uint8_t *pBlob = malloc(layout.totalSize);
+    if (!pBlob)
+        return false;
+
+    memset(pBlob, 0xAB, layout.totalSize);
+    modelCache_cook(&layout, pVertices, pINDICES, pTEXTURE, pBlob);
+
+    uint16_t pIndices16[3];
+    memcpy(pIndices16, pBlob + layout.indexOffset, sizeof(pIndices16));
+
+    // Padding is zeroed so identical sources always cook to identical files
+    bool paddingZero = true;
+    for (size_t i = layout.indexOffset + sizeof(pIndices16); i < layout.textureOffset; i++)
+        paddingZero &= pBlob[i] == 0;
+
+    const bool PASSED = memcmp(pBlob, pVertices, sizeof(pVertices)) == 0 &&
+                        pIndices16[0] == 2 && pIndices16[1] == 0 && pIndices16[2] == 1 &&
+                        paddingZero &&
+                        memcmp(pBlob + layout.textureOffset, pTEXTURE, sizeof(pTEXTURE)) == 0;
+
+    free(pBlob);
+    return PASSED;
+}
+
+static bool test_modelCache_header(void)
+{
+    const uint8_t pGLB[] = {'g', 'l', 'T', 'F', 2, 0, 0, 0};
+    const uint8_t pPNG[] = {0x89, 'P', 'N', 'G'};
+    const uint64_t HASH = fileIO_hash(pPNG, sizeof(pPNG), fileIO_hash(pGLB, sizeof(pGLB), FILE_IO_HASH_SEED));
+    const ModelCacheHeader_t HEADER = {
+        .magic = 0x444D5856U,
+        .version = 1,
+        .sourceHash = HASH,
+        .vertexCount = 3,
+        .indexCount = 3,
+        .textureWidth = 1,
+        .textureHeight = 1,
+    };
+
+    ModelCacheHeader_t wrongMagic = HEADER;
+    wrongMagic.magic = 0;
+    ModelCacheHeader_t newerVersion = HEADER;
+    newerVersion.version = 2;
+
+    // Changing the texture alone must still miss the cache
+    const uint64_t NEW_TEXTURE_HASH = fileIO_hash(pPNG, sizeof(pPNG) - 1, fileIO_hash(pGLB, sizeof(pGLB), FILE_IO_HASH_SEED));
+    return modelCache_header_valid(&HEADER, HASH) &&
+           !modelCache_header_valid(&HEADER, NEW_TEXTURE_HASH) &&
+           !modelCache_header_valid(&wrongMagic, HASH) &&
+           !modelCache_header_valid(&newerVersion, HASH) &&
+           !modelCache_header_valid(NULL, HASH);
+}
+
+int modelCache_tests_run(void)
+{
+    fails += ut_assert(test_modelCache_layout() == true,
+                       "ModelCache layout picks the index size and aligns the texture");
+    fails += ut_assert(test_modelCache_optimize() == true,
+                       "ModelCache optimizer keeps every triangle and cuts cache misses");
+    fails += ut_assert(test_modelCache_degenerate() == true,
+                       "ModelCache optimizer handles degenerate triangles");
+    fails += ut_assert(test_modelCache_reorder() == true,
+                       "ModelCache reorders vertices by first use and drops unused ones");
+    fails += ut_assert(test_modelCache_cook() == true,
+                       "ModelCache cook narrows indices and packs the texture");
+    fails += ut_assert(test_modelCache_header() == true,
+                       "ModelCache header checks source and version");
+
+    return fails;
+}
@@ -0,0 +1,3 @@
+#pragma once
+
+int modelCache_tests_run(void);
@@ -0,0 +1,78 @@
+#include "../../unit_tests.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <vulkan/vulkan.h>
+#include "rendering/pipeline_cache.h"
+
+static int fails = 0;
+
+#define TEST_HEADER_SIZE (4 * sizeof(uint32_t) + VK_UUID_SIZE)
+
+static void test_u32_write(uint8_t *pBytes, const uint32_t VALUE)
+{
+    pBytes[0] = (uint8_t)VALUE;
+    pBytes[1] = (uint8_t)(VALUE >> 8);
+    pBytes[2] = (uint8_t)(VALUE >> 16);
+    pBytes[3] = (uint8_t)(VALUE >> 24);
+}
+
+/// @brief Writes a header for PROPERTIES followed by some payload, the way a driver would
+static void test_cache_write(uint8_t *pData, const VkPhysicalDeviceProperties *pPROPERTIES)
+{
+    test_u32_write(pData, (uint32_t)TEST_HEADER_SIZE);
+    test_u32_write(pData + 4, (uint32_t)VK_PIPELINE_CACHE_HEADER_VERSION_ONE);
+    test_u32_write(pData + 8, pPROPERTIES->vendorID);
+    test_u32_write(pData + 12, pPROPERTIES->deviceID);
+    memcpy(pData + 16, pPROPERTIES->pipelineCacheUUID, VK_UUID_SIZE);
+    memset(pData + TEST_HEADER_SIZE, 0xAB, 16);
+}
+
+static bool test_pipelineCache_header(void)
+{
+    VkPhysicalDeviceProperties properties = {0};
+    properties.vendorID = 0x10DE;
+    properties.deviceID = 0x2684;
+    for (uint32_t i = 0; i < VK_UUID_SIZE; i++)
+        properties.pipelineCacheUUID[i] = (uint8_t)(i * 7 + 3);
+
+    uint8_t pData[TEST_HEADER_SIZE + 16];
+    test_cache_write(pData, &properties);
+    if (!pipelineCache_header_valid(pData, sizeof(pData), &properties))
+        return false;
+
+    // Too short, or nothing at all
+    if (pipelineCache_header_valid(pData, TEST_HEADER_SIZE - 1, &properties) || pipelineCache_header_valid(NULL, 0, &properties))
+        return false;
+
+    // Same device, newer driver
+    VkPhysicalDeviceProperties other = properties;
+    other.pipelineCacheUUID[5] ^= 0xFF;
+    if (pipelineCache_header_valid(pData, sizeof(pData), &other))
+        return false;
+
+    // Different device from the same vendor
+    other = properties;
+    other.deviceID++;
+    if (pipelineCache_header_valid(pData, sizeof(pData), &other))
+        return false;
+
+    // Different vendor
+    other = properties;
+    other.vendorID = 0x1002;
+    if (pipelineCache_header_valid(pData, sizeof(pData), &other))
+        return false;
+
+    // Header claiming to be longer than the data
+    test_u32_write(pData, (uint32_t)sizeof(pData) + 1);
+    return !pipelineCache_header_valid(pData, sizeof(pData), &properties);
+}
+
+int pipelineCache_tests_run(void)
+{
+    fails += ut_assert(test_pipelineCache_header() == true, "Pipeline cache header only matches its own device and driver");
+
+    return fails;
+}
+
+#undef TEST_HEADER_SIZE
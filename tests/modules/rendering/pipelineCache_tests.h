@@ -0,0 +1,3 @@
+#pragma once
+
+int pipelineCache_tests_run(void);
@@ -0,0 +1,75 @@
+#include "../../unit_tests.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include "rendering/renderQueue.h"
+
+#define TEST_ITEM_COUNT 4096
+
+static int fails = 0;
+
+/// @brief Fixed seed so a failure reproduces
+static uint32_t test_xorshift(uint32_t *pState)
+{
+    uint32_t x = *pState;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *pState = x;
+}
+
+static bool test_renderQueue_sort(void)
+{
+    static RenderQueueItem_t pItems[TEST_ITEM_COUNT];
+    static RenderQueueItem_t pScratch[TEST_ITEM_COUNT];
+
+    uint32_t seed = 0x9E3779B9U;
+    for (uint32_t i = 0; i < TEST_ITEM_COUNT; i++)
+    {
+        // Few pages and a small depth range, so plenty of equal keys to check stability with
+        const uint32_t PAGE = test_xorshift(&seed) % 5;
+        const uint32_t DEPTH = test_xorshift(&seed) % 300;
+        pItems[i] = (RenderQueueItem_t){.key = renderQueue_key_make(1, PAGE, DEPTH), .index = i};
+    }
+
+    renderQueue_sort(pItems, pScratch, TEST_ITEM_COUNT);
+
+    for (uint32_t i = 1; i < TEST_ITEM_COUNT; i++)
+    {
+        if (pItems[i - 1].key > pItems[i].key)
+            return false;
+        // Equal keys keep the order they were added in
+        if (pItems[i - 1].key == pItems[i].key && pItems[i - 1].index > pItems[i].index)
+            return false;
+    }
+
+    return true;
+}
+
+static bool test_renderQueue_key(void)
+{
+    // State outranks depth, pipeline outranks both
+    if (!(renderQueue_key_make(0, 1, 0) > renderQueue_key_make(0, 0, UINT32_MAX)))
+        return false;
+    if (!(renderQueue_key_make(1, 0, 0) > renderQueue_key_make(0, RENDER_QUEUE_STATE_MAX, UINT32_MAX)))
+        return false;
+    if (renderQueue_key_state(renderQueue_key_make(3, 42, 7)) != 42)
+        return false;
+
+    // Float depths keep their order
+    const float pDEPTHS[] = {0.0F, 1e-6F, 0.5F, 1.0F, 2.0F, 1000.0F, 1e30F};
+    for (uint32_t i = 1; i < sizeof(pDEPTHS) / sizeof(*pDEPTHS); i++)
+        if (!(renderQueue_depth_fromFloat(pDEPTHS[i - 1]) < renderQueue_depth_fromFloat(pDEPTHS[i])))
+            return false;
+
+    return renderQueue_depth_fromFloat(-1.0F) == 0;
+}
+
+int renderQueue_tests_run(void)
+{
+    fails += ut_assert(test_renderQueue_key() == true, "Render queue keys order by pipeline, then state, then depth");
+    fails += ut_assert(test_renderQueue_sort() == true, "Render queue sort is ordered and stable");
+
+    return fails;
+}
+
+#undef TEST_ITEM_COUNT
@@ -0,0 +1,3 @@
+#pragma once
+
+int renderQueue_tests_run(void);
@@ -0,0 +1,122 @@
+#include "../../unit_tests.h"
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "core/types/scene_t.h"
+#include "scene/scene.h"
+
+static int fails = 0;
+
+/// @brief Every batch covers its model's instances exactly, back to back and in batch order
+static bool test_scene_batches_valid(const Scene_t *pSCENE)
+{
+    uint32_t next = 0;
+    for (uint32_t b = 0; b < pSCENE->batchCount; b++)
+    {
+        const SceneModelBatch_t BATCH = pSCENE->pBatches[b];
+        if (BATCH.firstInstance != next || BATCH.instanceCount == 0)
+            return false;
+
+        for (uint32_t i = BATCH.firstInstance; i < BATCH.firstInstance + BATCH.instanceCount; i++)
+            if (pSCENE->pModelInstances[i].pModel != BATCH.pModel)
+                return false;
+
+        next += BATCH.instanceCount;
+    }
+
+    return next == pSCENE->instCount;
+}
+
+static void test_scene_free(Scene_t *pScene)
+{
+    free(pScene->pModelInstances);
+    free(pScene->pBatches);
+    free(pScene->pSlots);
+    memset(pScene, 0, sizeof(*pScene));
+}
+
+static bool test_scene_add_interleaved(void)
+{
+    // Only the pointers are compared, so the models never need to be loaded
+    RenderModel_t pModels[3];
+    Scene_t scene = {0};
+
+    for (uint32_t i = 0; i < 300; i++)
+        scene_modelAdd(&scene, &pModels[i % 3], cmath_mat_setTranslation(MAT4_IDENTITY, (Vec3f_t){(float)i, 0.0F, 0.0F}));
+
+    bool passed = scene.instCount == 300 && scene.batchCount == 3 && test_scene_batches_valid(&scene);
+
+    // Instances of a model keep the order they were added in
+    for (uint32_t i = 0; passed && i < 100; i++)
+        passed = scene.pModelInstances[i].modelMatrix.m[3].x == (float)(i * 3);
+
+    test_scene_free(&scene);
+    return passed;
+}
+
+static bool test_scene_remove(void)
+{
+    RenderModel_t pModels[3];
+    Scene_t scene = {0};
+    SceneInstanceHandle_t pHandles[9];
+
+    for (uint32_t i = 0; i < 9; i++)
+        pHandles[i] = scene_modelAdd(&scene, &pModels[i % 3], MAT4_IDENTITY);
+
+    // Empty out the middle model. Its batch should go with its last instance
+    bool passed = scene_modelRemove(&scene, pHandles[1]) && scene_modelRemove(&scene, pHandles[4]);
+    passed = passed && scene.batchCount == 3 && test_scene_batches_valid(&scene);
+    passed = passed && scene_modelRemove(&scene, pHandles[7]);
+    passed = passed && scene.instCount == 6 && scene.batchCount == 2 && test_scene_batches_valid(&scene) &&
+             scene.pBatches[0].pModel == &pModels[0] && scene.pBatches[1].pModel == &pModels[2];
+
+    // Removed and never placed handles do nothing
+    passed = passed && !scene_modelRemove(&scene, pHandles[4]) && !scene_modelRemove(&scene, SCENE_INSTANCE_HANDLE_INVALID);
+    passed = passed && scene.instCount == 6;
+
+    // Coming back starts a new batch
+    scene_modelAdd(&scene, &pModels[1], MAT4_IDENTITY);
+    passed = passed && scene.batchCount == 3 && test_scene_batches_valid(&scene);
+
+    test_scene_free(&scene);
+    return passed;
+}
+
+static bool test_scene_handles_stable(void)
+{
+    RenderModel_t pModels[2];
+    Scene_t scene = {0};
+    SceneInstanceHandle_t pHandles[6];
+
+    // Each instance is told apart by its translation
+    for (uint32_t i = 0; i < 6; i++)
+        pHandles[i] =
+            scene_modelAdd(&scene, &pModels[i % 2], cmath_mat_setTranslation(MAT4_IDENTITY, (Vec3f_t){(float)i, 0.0F, 0.0F}));
+
+    // Both removals shift instances the later handles name
+    bool passed = scene_modelRemove(&scene, pHandles[0]) && scene_modelRemove(&scene, pHandles[3]);
+
+    // A reused slot doesn't bring the removed instance's handle back
+    const SceneInstanceHandle_t REUSED =
+        scene_modelAdd(&scene, &pModels[0], cmath_mat_setTranslation(MAT4_IDENTITY, (Vec3f_t){6.0F, 0.0F, 0.0F}));
+    passed = passed && REUSED.slot == pHandles[3].slot && !scene_modelRemove(&scene, pHandles[3]);
+
+    passed = passed && scene_modelRemove(&scene, pHandles[4]);
+    for (uint32_t i = 0; passed && i < scene.instCount; i++)
+        passed = scene.pModelInstances[i].modelMatrix.m[3].x != 4.0F;
+
+    passed = passed && scene.instCount == 4 && test_scene_batches_valid(&scene);
+
+    test_scene_free(&scene);
+    return passed;
+}
+
+int scene_tests_run(void)
+{
+    fails += ut_assert(test_scene_add_interleaved() == true, "Scene groups instances added in any order by model");
+    fails += ut_assert(test_scene_remove() == true, "Scene keeps batches contiguous through removal");
+    fails += ut_assert(test_scene_handles_stable() == true, "Scene handles remove the instance they were given for");
+
+    return fails;
+}
@@ -0,0 +1,3 @@
+#pragma once
+
+int scene_tests_run(void);
@@ -0,0 +1,184 @@
+#include "../../unit_tests.h"
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include "threading/threadPool.h"
+
+static int fails = 0;
+
+#define TEST_JOB_COUNT 1000
+
+typedef struct TestJobCtx_t
+{
+    atomic_uint *pCounter;
+    uint32_t *pSlot;
+    uint32_t value;
+} TestJobCtx_t;
+
+static void test_job_increment(void *pCtx)
+{
+    TestJobCtx_t *pJob = (TestJobCtx_t *)pCtx;
+    *pJob->pSlot = pJob->value;
+    atomic_fetch_add(pJob->pCounter, 1U);
+}
+
+static bool test_threadPool_create_and_clamp(void)
+{
+    ThreadPool_t *pPool = threadPool_create(0);
+    if (!pPool)
+        return false;
+
+    // Zero workers would never run anything, so it must clamp up to one
+    if (threadPool_threadCount(pPool) != 1)
+        return false;
+
+    threadPool_destroy(pPool);
+    return true;
+}
+
+static bool test_threadPool_runsEveryJob(void)
+{
+    ThreadPool_t *pPool = threadPool_create(4);
+    if (!pPool)
+        return false;
+
+    static TestJobCtx_t pJobs[TEST_JOB_COUNT];
+    static uint32_t pSlots[TEST_JOB_COUNT];
+    atomic_uint counter = 0;
+
+    // More jobs than the initial queue capacity forces the ring buffer to grow while workers are consuming it
+    for (uint32_t i = 0; i < TEST_JOB_COUNT; i++)
+    {
+        pSlots[i] = 0;
+        pJobs[i] = (TestJobCtx_t){.pCounter = &counter, .pSlot = &pSlots[i], .value = i + 1};
+        if (!threadPool_submit(pPool, test_job_increment, &pJobs[i]))
+            return false;
+    }
+
+    threadPool_waitIdle(pPool);
+
+    if (atomic_load(&counter) != TEST_JOB_COUNT)
+        return false;
+
+    for (uint32_t i = 0; i < TEST_JOB_COUNT; i++)
+        if (pSlots[i] != i + 1)
+            return false;
+
+    threadPool_destroy(pPool);
+    return true;
+}
+
+static bool test_threadPool_destroyDrainsQueue(void)
+{
+    ThreadPool_t *pPool = threadPool_create(2);
+    if (!pPool)
+        return false;
+
+    static TestJobCtx_t pJobs[TEST_JOB_COUNT];
+    static uint32_t pSlots[TEST_JOB_COUNT];
+    atomic_uint counter = 0;
+
+    for (uint32_t i = 0; i < TEST_JOB_COUNT; i++)
+    {
+        pJobs[i] = (TestJobCtx_t){.pCounter = &counter, .pSlot = &pSlots[i], .value = i};
+        if (!threadPool_submit(pPool, test_job_increment, &pJobs[i]))
+            return false;
+    }
+
+    // No waitIdle. Destroy must still finish whatever was queued
+    threadPool_destroy(pPool);
+
+    return atomic_load(&counter) == TEST_JOB_COUNT;
+}
+
+typedef struct TestBlockCtx_t
+{
+    atomic_bool *pRelease;
+    atomic_bool *pFinished;
+} TestBlockCtx_t;
+
+static void test_job_block(void *pCtx)
+{
+    TestBlockCtx_t *pJob = (TestBlockCtx_t *)pCtx;
+    while (!atomic_load(pJob->pRelease))
+    {
+    }
+    atomic_store(pJob->pFinished, true);
+}
+
+static bool test_threadPool_waitGroup(void)
+{
+    ThreadPool_t *pPool = threadPool_create(2);
+    if (!pPool)
+        return false;
+
+    // An unrelated job that won't finish until told to. Waiting on the group must not wait for it
+    atomic_bool release = false;
+    atomic_bool blockerFinished = false;
+    TestBlockCtx_t blocker = {.pRelease = &release, .pFinished = &blockerFinished};
+    if (!threadPool_submit(pPool, test_job_block, &blocker))
+        return false;
+
+    static TestJobCtx_t pJobs[TEST_JOB_COUNT];
+    static uint32_t pSlots[TEST_JOB_COUNT];
+    atomic_uint counter = 0;
+    ThreadPoolGroup_t group = {0};
+
+    for (uint32_t i = 0; i < TEST_JOB_COUNT; i++)
+    {
+        pSlots[i] = 0;
+        pJobs[i] = (TestJobCtx_t){.pCounter = &counter, .pSlot = &pSlots[i], .value = i + 1};
+        if (!threadPool_submitGroup(pPool, &group, test_job_increment, &pJobs[i]))
+            return false;
+    }
+
+    threadPool_waitGroup(pPool, &group);
+
+    const bool GROUP_DONE = atomic_load(&counter) == TEST_JOB_COUNT && group.pending == 0;
+    const bool BLOCKER_RUNNING = !atomic_load(&blockerFinished);
+
+    atomic_store(&release, true);
+    threadPool_destroy(pPool);
+
+    return GROUP_DONE && BLOCKER_RUNNING;
+}
+
+static bool test_threadPool_invalidArgs(void)
+{
+    ThreadPool_t *pPool = threadPool_create(1);
+    if (!pPool)
+        return false;
+
+    if (threadPool_submit(NULL, test_job_increment, NULL) != false)
+        return false;
+    if (threadPool_submit(pPool, NULL, NULL) != false)
+        return false;
+    if (threadPool_threadCount(NULL) != 0)
+        return false;
+    if (threadPool_submitGroup(pPool, NULL, test_job_increment, NULL) != false)
+        return false;
+
+    // Must not crash
+    threadPool_waitIdle(NULL);
+    threadPool_waitGroup(NULL, NULL);
+    threadPool_destroy(NULL);
+
+    threadPool_destroy(pPool);
+    return true;
+}
+
+int threadPool_tests_run(void)
+{
+    fails += ut_assert(test_threadPool_create_and_clamp() == true,
+                       "ThreadPool create clamps thread count");
+    fails += ut_assert(test_threadPool_runsEveryJob() == true,
+                       "ThreadPool runs every submitted job");
+    fails += ut_assert(test_threadPool_destroyDrainsQueue() == true,
+                       "ThreadPool destroy drains queued jobs");
+    fails += ut_assert(test_threadPool_waitGroup() == true,
+                       "ThreadPool waitGroup only waits for its own jobs");
+    fails += ut_assert(test_threadPool_invalidArgs() == true,
+                       "ThreadPool invalid args handling");
+
+    return fails;
+}
@@ -0,0 +1,3 @@
+#pragma once
+
+int threadPool_tests_run(void);
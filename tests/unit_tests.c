@@ -4,12 +4,23 @@
 #include "modules/random/random_tests.h"
 #include "modules/collections/linkedList_tests.h"
 #include "modules/collections/dynamicStack_tests.h"
+#include "modules/collections/ringQueue_tests.h"
+#include "modules/collections/buddyTree_tests.h"
 #include "modules/collections/flags64_tests.h"
 #include "modules/chunk/chunk_tests.h"
 #include "modules/chunk/chunkState_tests.h"
 #include "modules/chunk/chunkAPI_tests.h"
+#include "modules/chunk/chunkMesher_tests.h"
+#include "modules/chunk/chunkCulling_tests.h"
+#include "modules/chunk/chunkVisibility_tests.h"
 #include "modules/events/event_tests.h"
+#include "modules/rendering/pipelineCache_tests.h"
+#include "modules/rendering/atlasBake_tests.h"
+#include "modules/rendering/modelCache_tests.h"
+#include "modules/rendering/renderQueue_tests.h"
+#include "modules/scene/scene_tests.h"
 #include "modules/voxel/voxel_tests.h"
+#include "modules/threading/threadPool_tests.h"
 
 int unitTests_run(void)
 {
@@ -30,6 +41,12 @@ int unitTests_run(void)
     ut_section("Dynamic Stack Tests");
     fails += dynamicStack_tests_run();
 
+    ut_section("Ring Queue Tests");
+    fails += ringQueue_tests_run();
+
+    ut_section("Buddy Tree Tests");
+    fails += buddyTree_tests_run();
+
     ut_section("Flags64 Tests");
     fails += flags64_tests_run();
 
@@ -40,10 +57,25 @@ int unitTests_run(void)
     fails += chunk_tests_run();
     fails += chunkState_tests_run();
     fails += chunkAPI_tests_run();
+    fails += chunkMesher_tests_run();
+    fails += chunkCulling_tests_run();
+    fails += chunkVisibility_tests_run();
+
+    ut_section("Rendering Tests");
+    fails += pipelineCache_tests_run();
+    fails += atlasBake_tests_run();
+    fails += modelCache_tests_run();
+    fails += renderQueue_tests_run();
+
+    ut_section("Scene Tests");
+    fails += scene_tests_run();
 
     ut_section("Voxel Tests");
     fails += voxel_tests_run();
 
+    ut_section("Thread Pool Tests");
+    fails += threadPool_tests_run();
+
     if (fails == 0)
         printf("\nAll tests passed!\n");
     else